@@ -0,0 +1,346 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Offline render tool: streams a WAV/RF64 file through a chain of effects
+// SPDX-License-Identifier: MIT
+
+#include "mapped_file.h"
+#include "wav_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/graph/detail/processor_traits.h>
+#include <jonssonic/effects/_effects.h>
+#include <jonssonic/jonssonic_config.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace jnsc;
+using namespace jnsc::render;
+
+namespace {
+
+/// Options parsed from the command line
+struct Options {
+    std::string inputPath, outputPath;
+    std::vector<std::string> chain;
+    size_t blockFrames = 65536;     // Frames per pipeline block (file I/O granularity)
+    size_t processFrames = 1024;    // Frames per effect processBlock call
+    size_t numSlots = 4;            // Blocks in flight between the three threads
+    double tailSeconds = 0.0;       // Silence appended to the input to let tails ring out
+    bool keepFormat = true;
+    SampleFormat outputFormat = SampleFormat::Float32;
+};
+
+/**
+ * @brief Bounded single-producer single-consumer queue of block indices.
+ * @details Each pipeline edge (reader to processor, processor to writer, writer back to reader) has exactly one
+ *          producer and one consumer thread, so two atomic counters are enough to hand blocks over without locks.
+ */
+class IndexQueue {
+  public:
+    explicit IndexQueue(size_t capacity) : slots(capacity + 1) {}
+
+    bool push(size_t value) {
+        const size_t tail = writePos.load(std::memory_order_relaxed);
+        const size_t next = (tail + 1) % slots.size();
+        if (next == readPos.load(std::memory_order_acquire))
+            return false;
+        slots[tail] = value;
+        writePos.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(size_t& value) {
+        const size_t head = readPos.load(std::memory_order_relaxed);
+        if (head == writePos.load(std::memory_order_acquire))
+            return false;
+        value = slots[head];
+        readPos.store((head + 1) % slots.size(), std::memory_order_release);
+        return true;
+    }
+
+    /// Blocking variants for the offline pipeline: spin politely until the other side catches up
+    void waitPush(size_t value) {
+        while (!push(value))
+            std::this_thread::yield();
+    }
+    size_t waitPop() {
+        size_t value;
+        while (!pop(value))
+            std::this_thread::yield();
+        return value;
+    }
+
+  private:
+    std::vector<size_t> slots;
+    alignas(64) std::atomic<size_t> writePos{0};
+    alignas(64) std::atomic<size_t> readPos{0};
+};
+
+/// Marker pushed after the last block
+constexpr size_t endOfStream = ~size_t(0);
+
+/// A block of planar audio travelling through the pipeline
+struct Block {
+    AudioBuffer<float> input, output;
+    uint64_t startFrame = 0;
+    size_t numFrames = 0;
+};
+
+/// Type-erased effect in the render chain
+class Stage {
+  public:
+    virtual ~Stage() = default;
+    virtual void process(const float* const* input, float* const* output, size_t numFrames) = 0;
+};
+
+template <typename Effect>
+class EffectStage final : public Stage {
+  public:
+    EffectStage(size_t numChannels, size_t maxBlockSize, float sampleRate) {
+        jnsc::detail::prepareProcessor<float>(effect, numChannels, maxBlockSize, sampleRate);
+    }
+
+    void process(const float* const* input, float* const* output, size_t numFrames) override {
+        if constexpr (std::is_same_v<Effect, effects::Compressor<float>>)
+            effect.processBlock(input, input, output, numFrames); // Self-keyed
+        else
+            effect.processBlock(input, output, numFrames);
+    }
+
+  private:
+    Effect effect;
+};
+
+std::unique_ptr<Stage> makeStage(const std::string& name, size_t numChannels, size_t maxBlock, float sampleRate) {
+    if (name == "chorus")
+        return std::make_unique<EffectStage<effects::Chorus<float>>>(numChannels, maxBlock, sampleRate);
+    if (name == "compressor")
+        return std::make_unique<EffectStage<effects::Compressor<float>>>(numChannels, maxBlock, sampleRate);
+    if (name == "delay")
+        return std::make_unique<EffectStage<effects::Delay<float>>>(numChannels, maxBlock, sampleRate);
+    if (name == "distortion")
+        return std::make_unique<EffectStage<effects::Distortion<float>>>(numChannels, maxBlock, sampleRate);
+    if (name == "equalizer")
+        return std::make_unique<EffectStage<effects::Equalizer<float>>>(numChannels, maxBlock, sampleRate);
+    if (name == "flanger")
+        return std::make_unique<EffectStage<effects::Flanger<float>>>(numChannels, maxBlock, sampleRate);
+    if (name == "reverb")
+        return std::make_unique<EffectStage<effects::Reverb<float>>>(numChannels, maxBlock, sampleRate);
+    throw std::runtime_error("unknown effect '" + name + "'");
+}
+
+/// Runs the chain over a block in processBlock-sized pieces, ping-ponging between two scratch buffers
+class Chain {
+  public:
+    Chain(const std::vector<std::string>& names, size_t newNumChannels, size_t newMaxBlock, float sampleRate)
+        : numChannels(newNumChannels), maxBlock(newMaxBlock), scratch{{numChannels, maxBlock}, {numChannels, maxBlock}},
+          inPtrs(numChannels), outPtrs(numChannels) {
+        for (const auto& name : names)
+            stages.push_back(makeStage(name, numChannels, maxBlock, sampleRate));
+    }
+
+    void process(Block& block) {
+        for (size_t offset = 0; offset < block.numFrames; offset += maxBlock) {
+            const size_t n = std::min(maxBlock, block.numFrames - offset);
+            if (stages.empty()) {
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    std::copy_n(block.input.readChannelPtr(ch) + offset, n, block.output.writeChannelPtr(ch) + offset);
+                continue;
+            }
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                inPtrs[ch] = block.input.readChannelPtr(ch) + offset;
+            for (size_t i = 0; i < stages.size(); ++i) {
+                const bool last = i + 1 == stages.size();
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    outPtrs[ch] = last ? block.output.writeChannelPtr(ch) + offset : scratch[i & 1].writeChannelPtr(ch);
+                stages[i]->process(inPtrs.data(), outPtrs.data(), n);
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    inPtrs[ch] = outPtrs[ch];
+            }
+        }
+    }
+
+  private:
+    size_t numChannels, maxBlock;
+    AudioBuffer<float> scratch[2];
+    std::vector<const float*> inPtrs;
+    std::vector<float*> outPtrs;
+    std::vector<std::unique_ptr<Stage>> stages;
+};
+
+void printUsage() {
+    std::fprintf(stderr,
+                 "usage: jnsc_render [options] <input.wav> <output.wav>\n"
+                 "  --chain a,b,...   effects in order: chorus, compressor, delay, distortion, equalizer,\n"
+                 "                    flanger, reverb (default: none, i.e. a format conversion)\n"
+                 "  --format f        output format: int16, int24, int32, float32 (default: input format)\n"
+                 "  --tail seconds    silence appended to the input so tails ring out (default: 0)\n"
+                 "  --block frames    frames per pipeline block (default: 65536)\n"
+                 "  --process frames  frames per effect processBlock call (default: 1024)\n");
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        const size_t end = std::min(list.find(',', begin), list.size());
+        if (end > begin)
+            items.push_back(list.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return items;
+}
+
+SampleFormat parseFormat(const std::string& name) {
+    if (name == "int16")
+        return SampleFormat::Int16;
+    if (name == "int24")
+        return SampleFormat::Int24;
+    if (name == "int32")
+        return SampleFormat::Int32;
+    if (name == "float32")
+        return SampleFormat::Float32;
+    throw std::runtime_error("unknown format '" + name + "'");
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::runtime_error(arg + " needs a value");
+            return argv[++i];
+        };
+        if (arg == "--chain") {
+            options.chain = splitList(value());
+        } else if (arg == "--format") {
+            options.outputFormat = parseFormat(value());
+            options.keepFormat = false;
+        } else if (arg == "--tail") {
+            options.tailSeconds = std::max(0.0, std::stod(value()));
+        } else if (arg == "--block") {
+            options.blockFrames = std::max<size_t>(1, std::stoul(value()));
+        } else if (arg == "--process") {
+            options.processFrames = std::max<size_t>(1, std::stoul(value()));
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            std::exit(0);
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 2)
+        throw std::runtime_error("expected an input and an output file");
+    options.inputPath = positional[0];
+    options.outputPath = positional[1];
+    options.processFrames = std::min(options.processFrames, options.blockFrames);
+    return options;
+}
+
+int renderFile(const Options& options) {
+    MappedFile inputFile = MappedFile::openRead(options.inputPath);
+    const WavFormat inFormat = parseWavHeader(inputFile.data(), inputFile.size());
+    const size_t numChannels = inFormat.numChannels;
+    if (numChannels > JONSSONIC_MAX_CHANNELS)
+        throw std::runtime_error("file has more channels than JONSSONIC_MAX_CHANNELS");
+
+    WavFormat outFormat = inFormat;
+    if (!options.keepFormat)
+        outFormat.sampleFormat = options.outputFormat;
+    outFormat.numFrames = inFormat.numFrames + uint64_t(options.tailSeconds * inFormat.sampleRate);
+    const uint64_t outHeaderSize = wavHeaderSize(needsRf64(outFormat.dataBytes()));
+    MappedFile outputFile = MappedFile::createWrite(options.outputPath, outHeaderSize + outFormat.dataBytes());
+    outFormat.dataOffset = writeWavHeader(outputFile.data(), outFormat);
+
+    Chain chain(options.chain, numChannels, options.processFrames, float(inFormat.sampleRate));
+    std::vector<Block> blocks(options.numSlots);
+    for (auto& block : blocks) {
+        block.input.resize(numChannels, options.blockFrames);
+        block.output.resize(numChannels, options.blockFrames);
+    }
+
+    // Blocks circulate reader -> processor -> writer -> reader
+    IndexQueue freeBlocks(options.numSlots), decoded(options.numSlots + 1), processed(options.numSlots + 1);
+    for (size_t i = 0; i < blocks.size(); ++i)
+        freeBlocks.waitPush(i);
+
+    double processSeconds = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread reader([&] {
+        for (uint64_t frame = 0; frame < outFormat.numFrames; frame += options.blockFrames) {
+            Block& block = blocks[freeBlocks.waitPop()];
+            block.startFrame = frame;
+            block.numFrames = size_t(std::min<uint64_t>(options.blockFrames, outFormat.numFrames - frame));
+            const size_t numInput =
+                size_t(std::min<uint64_t>(block.numFrames, inFormat.numFrames - std::min(frame, inFormat.numFrames)));
+            const uint64_t offset = inFormat.dataOffset + frame * inFormat.bytesPerFrame();
+            decodeFrames(inputFile.data() + offset, inFormat, block.input.writePtrs(), numInput);
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                std::fill_n(block.input.writeChannelPtr(ch) + numInput, block.numFrames - numInput, 0.0f);
+            inputFile.release(offset, numInput * inFormat.bytesPerFrame());
+            decoded.waitPush(size_t(&block - blocks.data()));
+        }
+        decoded.waitPush(endOfStream);
+    });
+
+    std::thread processor([&] {
+        for (size_t index; (index = decoded.waitPop()) != endOfStream;) {
+            const auto begin = std::chrono::steady_clock::now();
+            chain.process(blocks[index]);
+            processSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            processed.waitPush(index);
+        }
+        processed.waitPush(endOfStream);
+    });
+
+    std::thread writer([&] {
+        for (size_t index; (index = processed.waitPop()) != endOfStream;) {
+            Block& block = blocks[index];
+            const uint64_t offset = outFormat.dataOffset + block.startFrame * outFormat.bytesPerFrame();
+            encodeFrames(block.output.readPtrs(), outFormat, outputFile.data() + offset, block.numFrames);
+            outputFile.release(offset, block.numFrames * outFormat.bytesPerFrame());
+            freeBlocks.waitPush(index);
+        }
+    });
+
+    reader.join();
+    processor.join();
+    writer.join();
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double audioSeconds = double(outFormat.numFrames) / double(inFormat.sampleRate);
+    std::printf("%llu frames x %zu channels @ %u Hz (%.2f s of audio)\n",
+                static_cast<unsigned long long>(outFormat.numFrames),
+                numChannels,
+                inFormat.sampleRate,
+                audioSeconds);
+    std::printf("wall %.3f s -> %.1fx realtime (dsp thread busy %.3f s -> %.1fx realtime)\n",
+                wallSeconds,
+                audioSeconds / std::max(wallSeconds, 1e-9),
+                processSeconds,
+                audioSeconds / std::max(processSeconds, 1e-9));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return renderFile(parseOptions(argc, argv));
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "jnsc_render: %s\n", e.what());
+        printUsage();
+        return 1;
+    }
+}
@@ -0,0 +1,130 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Read-only and read-write file mappings for the offline render tool (POSIX)
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace jnsc::render {
+
+/**
+ * @brief RAII memory mapping of a whole file.
+ * @details Input files are mapped read-only and advised for sequential access, so the kernel reads ahead while the
+ *          reader thread decodes. Output files are created at their final size and mapped shared, so encoded
+ *          frames are written back by the page cache without explicit write calls.
+ */
+class MappedFile {
+  public:
+    /// Map an existing file for reading
+    static MappedFile openRead(const std::string& path) {
+        MappedFile file;
+        file.fd = ::open(path.c_str(), O_RDONLY);
+        if (file.fd < 0)
+            fail("cannot open " + path);
+        struct stat info {};
+        if (::fstat(file.fd, &info) != 0)
+            fail("cannot stat " + path);
+        file.length = uint64_t(info.st_size);
+        file.map(PROT_READ, MAP_PRIVATE, path);
+        ::madvise(file.base, file.length, MADV_SEQUENTIAL);
+        return file;
+    }
+
+    /// Create (or truncate) a file of the given size and map it for writing
+    static MappedFile createWrite(const std::string& path, uint64_t size) {
+        MappedFile file;
+        file.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file.fd < 0)
+            fail("cannot create " + path);
+        if (::ftruncate(file.fd, off_t(size)) != 0)
+            fail("cannot resize " + path);
+        file.length = size;
+        file.writable = true;
+        file.map(PROT_READ | PROT_WRITE, MAP_SHARED, path);
+        ::madvise(file.base, file.length, MADV_SEQUENTIAL);
+        return file;
+    }
+
+    /// Default constructor (no mapping)
+    MappedFile() = default;
+
+    /// Unmap and close
+    ~MappedFile() { close(); }
+
+    /// Move only
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            std::swap(fd, other.fd);
+            std::swap(base, other.base);
+            std::swap(length, other.length);
+            std::swap(writable, other.writable);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Drop a processed range from the working set, so long files do not grow the resident size.
+     * @note Written pages are handed to the page cache for writeback first; only whole pages are released.
+     */
+    void release(uint64_t offset, uint64_t size) {
+        const uint64_t page = uint64_t(::sysconf(_SC_PAGESIZE));
+        const uint64_t begin = offset / page * page;
+        const uint64_t end = std::min(offset + size, length) / page * page;
+        if (end <= begin)
+            return;
+        if (writable)
+            ::msync(data() + begin, end - begin, MS_ASYNC);
+        ::madvise(data() + begin, end - begin, MADV_DONTNEED);
+    }
+
+    uint8_t* data() { return static_cast<uint8_t*>(base); }
+    const uint8_t* data() const { return static_cast<const uint8_t*>(base); }
+    uint64_t size() const { return length; }
+
+  private:
+    int fd = -1;
+    void* base = nullptr;
+    uint64_t length = 0;
+    bool writable = false;
+
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    void map(int protection, int flags, const std::string& path) {
+        if (length == 0)
+            throw std::runtime_error(path + " is empty");
+        base = ::mmap(nullptr, length, protection, flags, fd, 0);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            fail("cannot map " + path);
+        }
+    }
+
+    void close() {
+        if (base)
+            ::munmap(base, length);
+        if (fd >= 0)
+            ::close(fd);
+        base = nullptr;
+        fd = -1;
+        length = 0;
+        writable = false;
+    }
+};
+
+} // namespace jnsc::render
@@ -0,0 +1,241 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// WAV/RF64 header parsing and sample conversion for the offline render tool
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace jnsc::render {
+
+/// Sample encodings supported by the render tool
+enum class SampleFormat { Int16, Int24, Int32, Float32 };
+
+/// Stream layout of a WAV/RF64 file
+struct WavFormat {
+    SampleFormat sampleFormat = SampleFormat::Float32;
+    size_t numChannels = 0;
+    uint32_t sampleRate = 0;
+    uint64_t numFrames = 0;
+    uint64_t dataOffset = 0; // Byte offset of the first sample frame
+
+    size_t bytesPerSample() const {
+        return sampleFormat == SampleFormat::Int16 ? 2 : sampleFormat == SampleFormat::Int24 ? 3 : 4;
+    }
+    size_t bytesPerFrame() const { return bytesPerSample() * numChannels; }
+    uint64_t dataBytes() const { return numFrames * bytesPerFrame(); }
+};
+
+namespace detail {
+inline uint16_t readU16(const uint8_t* p) { return uint16_t(p[0] | (p[1] << 8)); }
+inline uint32_t readU32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+inline uint64_t readU64(const uint8_t* p) { return uint64_t(readU32(p)) | (uint64_t(readU32(p + 4)) << 32); }
+inline void writeU16(uint8_t* p, uint16_t v) {
+    p[0] = uint8_t(v);
+    p[1] = uint8_t(v >> 8);
+}
+inline void writeU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i)
+        p[i] = uint8_t(v >> (8 * i));
+}
+inline void writeU64(uint8_t* p, uint64_t v) {
+    writeU32(p, uint32_t(v));
+    writeU32(p + 4, uint32_t(v >> 32));
+}
+inline bool tagIs(const uint8_t* p, const char* tag) { return std::memcmp(p, tag, 4) == 0; }
+} // namespace detail
+
+/**
+ * @brief Parse the header of a RIFF/WAVE or RF64 file held in memory.
+ * @param data Start of the file (e.g., a memory mapping)
+ * @param size File size in bytes
+ * @return Stream layout, with @ref WavFormat::dataOffset pointing into @p data
+ * @throws std::runtime_error If the file is not a supported PCM or float WAV
+ * @note WAVE_FORMAT_EXTENSIBLE is accepted when its subformat is PCM or IEEE float. An RF64 `ds64` chunk overrides
+ *       the 32-bit data size, and a data size running past the end of the file is truncated to what is present.
+ */
+inline WavFormat parseWavHeader(const uint8_t* data, uint64_t size) {
+    using namespace detail;
+    if (size < 12 || !(tagIs(data, "RIFF") || tagIs(data, "RF64")) || !tagIs(data + 8, "WAVE"))
+        throw std::runtime_error("not a RIFF/RF64 WAVE file");
+
+    WavFormat format;
+    uint64_t ds64DataSize = 0;
+    uint16_t formatTag = 0, bitsPerSample = 0;
+    bool haveFormat = false;
+    uint64_t pos = 12;
+    while (pos + 8 <= size) {
+        const uint8_t* chunk = data + pos;
+        uint64_t chunkSize = readU32(chunk + 4);
+        if (tagIs(chunk, "ds64") && chunkSize >= 16 && pos + 8 + 16 <= size) {
+            ds64DataSize = readU64(chunk + 16);
+        } else if (tagIs(chunk, "fmt ") && chunkSize >= 16 && pos + 8 + 16 <= size) {
+            formatTag = readU16(chunk + 8);
+            format.numChannels = readU16(chunk + 10);
+            format.sampleRate = readU32(chunk + 12);
+            bitsPerSample = readU16(chunk + 22);
+            if (formatTag == 0xFFFE && chunkSize >= 40 && pos + 8 + 40 <= size)
+                formatTag = readU16(chunk + 32); // First two bytes of the subformat GUID
+            haveFormat = true;
+        } else if (tagIs(chunk, "data")) {
+            if (!haveFormat)
+                throw std::runtime_error("data chunk before fmt chunk");
+            if (chunkSize == 0xFFFFFFFF && ds64DataSize > 0)
+                chunkSize = ds64DataSize;
+            format.dataOffset = pos + 8;
+            chunkSize = std::min(chunkSize, size - format.dataOffset);
+
+            if (formatTag == 1 && bitsPerSample == 16)
+                format.sampleFormat = SampleFormat::Int16;
+            else if (formatTag == 1 && bitsPerSample == 24)
+                format.sampleFormat = SampleFormat::Int24;
+            else if (formatTag == 1 && bitsPerSample == 32)
+                format.sampleFormat = SampleFormat::Int32;
+            else if (formatTag == 3 && bitsPerSample == 32)
+                format.sampleFormat = SampleFormat::Float32;
+            else
+                throw std::runtime_error("unsupported sample format (tag " + std::to_string(formatTag) + ", " +
+                                         std::to_string(bitsPerSample) + " bits)");
+            if (format.numChannels == 0)
+                throw std::runtime_error("file has no channels");
+            format.numFrames = chunkSize / format.bytesPerFrame();
+            return format;
+        }
+        pos += 8 + chunkSize + (chunkSize & 1); // Chunks are padded to even sizes
+    }
+    throw std::runtime_error("no data chunk found");
+}
+
+/**
+ * @brief Size of the header written by @ref writeWavHeader.
+ * @param rf64 Whether the file needs the RF64 layout (data larger than 4 GB)
+ */
+inline size_t wavHeaderSize(bool rf64) { return rf64 ? 80 : 44; }
+
+/// Whether a data chunk of this size needs the RF64 layout
+inline bool needsRf64(uint64_t dataBytes) { return dataBytes + 44 > 0xFFFFFFFFull; }
+
+/**
+ * @brief Write a canonical WAV header, or an RF64 header with a `ds64` chunk for data larger than 4 GB.
+ * @param dest Destination, at least @ref wavHeaderSize bytes
+ * @param format Stream layout (the data offset is ignored)
+ * @return Number of bytes written
+ */
+inline size_t writeWavHeader(uint8_t* dest, const WavFormat& format) {
+    using namespace detail;
+    const uint64_t dataBytes = format.dataBytes();
+    const bool rf64 = needsRf64(dataBytes);
+    const size_t headerSize = wavHeaderSize(rf64);
+    const uint64_t riffSize = headerSize - 8 + dataBytes;
+    uint8_t* p = dest;
+
+    std::memcpy(p, rf64 ? "RF64" : "RIFF", 4);
+    writeU32(p + 4, rf64 ? 0xFFFFFFFF : uint32_t(riffSize));
+    std::memcpy(p + 8, "WAVE", 4);
+    p += 12;
+    if (rf64) {
+        std::memcpy(p, "ds64", 4);
+        writeU32(p + 4, 28);
+        writeU64(p + 8, riffSize);
+        writeU64(p + 16, dataBytes);
+        writeU64(p + 24, format.numFrames);
+        writeU32(p + 32, 0); // No table entries
+        p += 36;
+    }
+    const bool isFloat = format.sampleFormat == SampleFormat::Float32;
+    std::memcpy(p, "fmt ", 4);
+    writeU32(p + 4, 16);
+    writeU16(p + 8, isFloat ? 3 : 1);
+    writeU16(p + 10, uint16_t(format.numChannels));
+    writeU32(p + 12, format.sampleRate);
+    writeU32(p + 16, uint32_t(format.sampleRate * format.bytesPerFrame()));
+    writeU16(p + 20, uint16_t(format.bytesPerFrame()));
+    writeU16(p + 22, uint16_t(format.bytesPerSample() * 8));
+    p += 24;
+    std::memcpy(p, "data", 4);
+    writeU32(p + 4, rf64 ? 0xFFFFFFFF : uint32_t(dataBytes));
+    return headerSize;
+}
+
+/**
+ * @brief Convert interleaved file frames to planar float channels.
+ * @param src First byte of the first frame
+ * @param format Stream layout
+ * @param dest Planar destination channels (format.numChannels pointers)
+ * @param numFrames Number of frames to convert
+ */
+inline void decodeFrames(const uint8_t* src, const WavFormat& format, float* const* dest, size_t numFrames) {
+    const size_t numChannels = format.numChannels;
+    const size_t stride = format.bytesPerSample();
+    for (size_t n = 0; n < numFrames; ++n) {
+        for (size_t ch = 0; ch < numChannels; ++ch, src += stride) {
+            float x;
+            switch (format.sampleFormat) {
+            case SampleFormat::Int16:
+                x = float(int16_t(detail::readU16(src))) * (1.0f / 32768.0f);
+                break;
+            case SampleFormat::Int24:
+                x = float(int32_t(uint32_t(src[0] << 8) | uint32_t(src[1] << 16) | uint32_t(src[2]) << 24) >> 8) *
+                    (1.0f / 8388608.0f);
+                break;
+            case SampleFormat::Int32:
+                x = float(double(int32_t(detail::readU32(src))) * (1.0 / 2147483648.0));
+                break;
+            default:
+                std::memcpy(&x, src, sizeof(float));
+                break;
+            }
+            dest[ch][n] = x;
+        }
+    }
+}
+
+/**
+ * @brief Convert planar float channels to interleaved file frames.
+ * @param src Planar source channels (format.numChannels pointers)
+ * @param format Stream layout
+ * @param dest First byte of the first destination frame
+ * @param numFrames Number of frames to convert
+ * @note Integer formats are rounded and clipped to full scale. Float samples are copied bytewise, which assumes a
+ *       little-endian host like the rest of the tool.
+ */
+inline void encodeFrames(const float* const* src, const WavFormat& format, uint8_t* dest, size_t numFrames) {
+    const size_t numChannels = format.numChannels;
+    const size_t stride = format.bytesPerSample();
+    auto quantize = [](float x, double scale) {
+        const double y = std::nearbyint(double(x) * scale);
+        return int32_t(std::clamp(y, -scale, scale - 1.0));
+    };
+    for (size_t n = 0; n < numFrames; ++n) {
+        for (size_t ch = 0; ch < numChannels; ++ch, dest += stride) {
+            const float x = src[ch][n];
+            switch (format.sampleFormat) {
+            case SampleFormat::Int16:
+                detail::writeU16(dest, uint16_t(quantize(x, 32768.0)));
+                break;
+            case SampleFormat::Int24: {
+                const uint32_t y = uint32_t(quantize(x, 8388608.0));
+                dest[0] = uint8_t(y);
+                dest[1] = uint8_t(y >> 8);
+                dest[2] = uint8_t(y >> 16);
+                break;
+            }
+            case SampleFormat::Int32:
+                detail::writeU32(dest, uint32_t(quantize(x, 2147483648.0)));
+                break;
+            default:
+                std::memcpy(dest, &x, sizeof(float));
+                break;
+            }
+        }
+    }
+}
+
+} // namespace jnsc::render
@@ -10,6 +10,7 @@
 #include "dynamics/_dynamics.h"
 #include "filters/_filters.h"
 #include "generators/_generators.h"
+#include "graph/_graph.h"
 #include "mixing/_mixing.h"
 #include "nonlinear/_nonlinear.h"
 #include "oversampling/_oversampling.h"
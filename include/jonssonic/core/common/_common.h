@@ -5,7 +5,20 @@
 #pragma once
 
 #include "audio_buffer.h"
+#include "audio_fifo.h"
+#include "channel_groups.h"
 #include "circular_audio_buffer.h"
+#include "dsp_load.h"
 #include "dsp_param.h"
+#include "interleaved_frames.h"
 #include "interpolators.h"
-#include "modulation.h"
\ No newline at end of file
+#include "modulation.h"
+#include "modulation_matrix.h"
+#include "output_mode.h"
+#include "param_event.h"
+#include "probe_point.h"
+#include "simd_channel_adapter.h"
+#include "simd_dispatch.h"
+#include "simd_pack.h"
+#include "state_blob.h"
+#include "trace_recorder.h"
\ No newline at end of file
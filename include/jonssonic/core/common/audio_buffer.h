@@ -5,6 +5,7 @@
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cassert>
+#include <jonssonic/core/common/detail/aligned_allocator.h>
 #include <vector>
 
 namespace jnsc {
@@ -128,6 +129,14 @@ class AudioBuffer<T, BufferLayout::Planar> {
      */
     void clear() { std::fill(m_data.begin(), m_data.end(), T(0)); }
 
+    /**
+     * @brief Clear the samples of a single channel (set to zero).
+     */
+    void clearChannel(size_t channel) {
+        T* data = m_data.data() + channel * m_numSamples;
+        std::fill(data, data + m_numSamples, T(0));
+    }
+
     /**
      * @brief Get the number of channels.
      */
@@ -295,22 +304,16 @@ class AudioBuffer<T, BufferLayout::Planar> {
         return *this;
     }
 
-    /**
-     * @brief Assignment operator
-     */
-    AudioBuffer& operator=(const AudioBuffer& other) {
-        if (this != &other) {
-            m_numChannels = other.m_numChannels;
-            m_numSamples = other.m_numSamples;
-            m_data = other.m_data;
-        }
-        return *this;
-    }
+    /// Copy and move semantics (the cached pointer arrays are rebuilt by readPtrs() and writePtrs())
+    AudioBuffer(const AudioBuffer&) = default;
+    AudioBuffer& operator=(const AudioBuffer&) = default;
+    AudioBuffer(AudioBuffer&&) = default;
+    AudioBuffer& operator=(AudioBuffer&&) = default;
 
   private:
     size_t m_numSamples;
     size_t m_numChannels;
-    std::vector<T> m_data; // Flat planar storage for all channels
+    detail::AlignedVector<T> m_data; // Flat planar storage for all channels
 
     // Cached pointer arrays for readPtrs() and writePtrs()
     mutable std::vector<const T*> m_readPtrs;
@@ -413,6 +416,14 @@ class AudioBuffer<T, BufferLayout::Interleaved> {
      */
     void clear() { std::fill(m_data.begin(), m_data.end(), T(0)); }
 
+    /**
+     * @brief Clear the samples of a single channel (set to zero).
+     */
+    void clearChannel(size_t channel) {
+        for (size_t n = 0; n < m_numSamples; ++n)
+            m_data[n * m_numChannels + channel] = T(0);
+    }
+
     /**
      * @brief Get the number of channels.
      */
@@ -540,23 +551,56 @@ class AudioBuffer<T, BufferLayout::Interleaved> {
             m_data[i] *= other.m_data[i];
         return *this;
     }
-    AudioBuffer& operator=(const AudioBuffer& other) {
-        if (this != &other) {
-            m_numChannels = other.m_numChannels;
-            m_numSamples = other.m_numSamples;
-            m_data = other.m_data;
-        }
-        return *this;
-    }
+    /// Copy and move semantics (the cached pointer arrays are rebuilt by readPtrs() and writePtrs())
+    AudioBuffer(const AudioBuffer&) = default;
+    AudioBuffer& operator=(const AudioBuffer&) = default;
+    AudioBuffer(AudioBuffer&&) = default;
+    AudioBuffer& operator=(AudioBuffer&&) = default;
 
   private:
     size_t m_numSamples;
     size_t m_numChannels;
-    std::vector<T> m_data;
+    detail::AlignedVector<T> m_data;
     mutable std::vector<const T*> m_readPtrs;
     mutable std::vector<T*> m_writePtrs;
 };
 
+//==============================================================================
+// Offset channel pointers
+//==============================================================================
+/**
+ * @brief Channel pointers advanced to an offset within a block, for processing a block in sub-blocks or chunks.
+ * @details Sized once when the owner is prepared, so splitting a block neither allocates nor puts a per-channel
+ *          pointer array on the audio thread's stack.
+ * @tparam Sample Sample type (const for input pointers)
+ */
+template <typename Sample>
+class OffsetChannelPtrs {
+  public:
+    /// Allocate room for a number of channels
+    void resize(size_t numChannels) { ptrs.resize(numChannels); }
+
+    /**
+     * @brief Point at sample @p offset of each channel.
+     * @param base Channel pointers at the start of the block
+     * @param numChannels Number of channels (at most the prepared count)
+     * @param offset Sample offset
+     * @return Pointers for the first @p numChannels channels, valid until the next call
+     */
+    Sample* const* advance(Sample* const* base, size_t numChannels, size_t offset) {
+        assert(numChannels <= ptrs.size() && "More channels than prepared");
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            ptrs[ch] = base[ch] + offset;
+        return ptrs.data();
+    }
+
+    /// Get number of channels prepared for
+    size_t size() const { return ptrs.size(); }
+
+  private:
+    std::vector<Sample*> ptrs;
+};
+
 // ============================================================================
 // Friend operators for scalar on left-hand side
 // ============================================================================
@@ -0,0 +1,268 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Wait-free single-producer/single-consumer multichannel audio FIFO
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/utils/detail/config_utils.h>
+#include <jonssonic/utils/math_utils.h>
+#include <vector>
+
+namespace jnsc {
+
+/**
+ * @brief Region of an @ref AudioFifo, made of up to two spans per channel (the second one after the wrap).
+ * @details Frames [0, size1) of the region are at span1(ch), frames [size1, size()) at span2(ch).
+ * @tparam Sample Sample type, const for read regions
+ */
+template <typename Sample>
+struct AudioFifoRegion {
+    Sample* const* channels = nullptr; // Channel base pointers of the ring
+    size_t offset = 0;                 // Ring position of the first span
+    size_t size1 = 0;                  // Frames in the first span
+    size_t size2 = 0;                  // Frames in the second span (starting at ring position 0)
+
+    /// Number of frames in the region
+    size_t size() const { return size1 + size2; }
+
+    /// First span of a channel
+    Sample* span1(size_t ch) const { return channels[ch] + offset; }
+
+    /// Second span of a channel (valid if size2 > 0)
+    Sample* span2(size_t ch) const { return channels[ch]; }
+};
+
+/**
+ * @brief Wait-free single-producer/single-consumer FIFO moving multichannel audio between threads.
+ * @details Built on a power-of-two ring like @ref CircularAudioBuffer. The producer asks for a write region with
+ *          @ref beginWrite, fills it in place and publishes it with @ref finishWrite; the consumer does the same
+ *          with @ref beginRead and @ref finishRead. A region wraps into at most two spans per channel, so no frame
+ *          is copied more than once. @ref push and @ref pop are copying shortcuts.
+ *
+ *          The read and write positions are monotonic counters on separate cache lines, each side keeping a cached
+ *          copy of the other side's position, so the two threads only exchange cache lines when the cached view
+ *          runs out. Every call finishes in a bounded number of steps without locks.
+ *
+ *          Producer and consumer clocks (e.g., two sound cards, or a network stream) drift apart. An optional drift
+ *          hook set with @ref setDriftHook receives the smoothed deviation of the fill level from a target after
+ *          every read; a consumer typically turns it into a small resampling ratio correction.
+ * @tparam T Sample type (typically float or double)
+ * @note Thread roles: beginWrite/finishWrite/push on one producer thread, beginRead/finishRead/pop on one consumer
+ *       thread. @ref prepare, @ref reset and @ref setDriftHook must not run concurrently with either.
+ */
+template <typename T>
+class AudioFifo {
+  public:
+    /// Cache line size used to separate the positions of the two threads
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /// Weight of the latest fill level in the smoothed drift measure
+    static constexpr double DRIFT_SMOOTHING = 0.01;
+
+    /// Callback run on the consumer thread after each read with the smoothed (fill - target) / capacity
+    using DriftHook = std::function<void(double fillError)>;
+
+    /// Default constructor
+    AudioFifo() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumChannels Number of channels
+     * @param minCapacity Minimum capacity in frames
+     */
+    AudioFifo(size_t newNumChannels, size_t minCapacity) { prepare(newNumChannels, minCapacity); }
+
+    /// Default destructor
+    ~AudioFifo() = default;
+
+    /// No copy nor move semantics
+    AudioFifo(const AudioFifo&) = delete;
+    AudioFifo& operator=(const AudioFifo&) = delete;
+    AudioFifo(AudioFifo&&) = delete;
+    AudioFifo& operator=(AudioFifo&&) = delete;
+
+    /**
+     * @brief Allocate the ring and empty the FIFO.
+     * @param newNumChannels Number of channels
+     * @param minCapacity Minimum capacity in frames (rounded up to a power of two)
+     */
+    void prepare(size_t newNumChannels, size_t minCapacity) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        capacity = utils::nextPowerOfTwo(std::max<size_t>(minCapacity, 1));
+        buffer.resize(numChannels, capacity);
+        channelPtrs.resize(numChannels);
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            channelPtrs[ch] = buffer.writeChannelPtr(ch);
+        reset();
+    }
+
+    /// Empty the FIFO and clear the drift measure
+    void reset() {
+        buffer.clear();
+        writePos.store(0, std::memory_order_relaxed);
+        readPos.store(0, std::memory_order_relaxed);
+        cachedReadPos = 0;
+        cachedWritePos = 0;
+        smoothedFillError = 0.0;
+    }
+
+    // =========================================================================
+    // Producer
+    // =========================================================================
+
+    /**
+     * @brief Get a region to write into (producer thread).
+     * @param maxFrames Frames wanted
+     * @return Region of up to maxFrames frames, fewer if the FIFO is nearly full
+     */
+    AudioFifoRegion<T> beginWrite(size_t maxFrames) {
+        const size_t w = writePos.load(std::memory_order_relaxed);
+        if (capacity - (w - cachedReadPos) < maxFrames)
+            cachedReadPos = readPos.load(std::memory_order_acquire);
+        return makeRegion<T>(channelPtrs.data(), w, std::min(maxFrames, capacity - (w - cachedReadPos)));
+    }
+
+    /**
+     * @brief Publish frames written into the region from @ref beginWrite (producer thread).
+     * @param numFrames Frames written (at most the region size)
+     */
+    void finishWrite(size_t numFrames) {
+        const size_t w = writePos.load(std::memory_order_relaxed);
+        assert(numFrames <= capacity - (w - cachedReadPos) && "Writing past the region");
+        writePos.store(w + numFrames, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy frames into the FIFO (producer thread).
+     * @param input Input sample pointers (one per channel)
+     * @param numFrames Frames to write
+     * @return Frames written (fewer than numFrames if the FIFO is full)
+     */
+    size_t push(const T* const* input, size_t numFrames) {
+        const auto region = beginWrite(numFrames);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            std::copy(input[ch], input[ch] + region.size1, region.span1(ch));
+            std::copy(input[ch] + region.size1, input[ch] + region.size(), region.span2(ch));
+        }
+        finishWrite(region.size());
+        return region.size();
+    }
+
+    // =========================================================================
+    // Consumer
+    // =========================================================================
+
+    /**
+     * @brief Get a region to read from (consumer thread).
+     * @param maxFrames Frames wanted
+     * @return Region of up to maxFrames frames, fewer if the FIFO is nearly empty
+     */
+    AudioFifoRegion<const T> beginRead(size_t maxFrames) {
+        const size_t r = readPos.load(std::memory_order_relaxed);
+        if (cachedWritePos - r < maxFrames)
+            cachedWritePos = writePos.load(std::memory_order_acquire);
+        return makeRegion<const T>(channelPtrs.data(), r, std::min(maxFrames, cachedWritePos - r));
+    }
+
+    /**
+     * @brief Release frames read from the region from @ref beginRead and run the drift hook (consumer thread).
+     * @param numFrames Frames consumed (at most the region size)
+     */
+    void finishRead(size_t numFrames) {
+        const size_t r = readPos.load(std::memory_order_relaxed);
+        assert(numFrames <= cachedWritePos - r && "Reading past the region");
+        readPos.store(r + numFrames, std::memory_order_release);
+        if (driftHook) {
+            const size_t fill = writePos.load(std::memory_order_acquire) - (r + numFrames);
+            const double fillError = (static_cast<double>(fill) - driftTarget) / static_cast<double>(capacity);
+            smoothedFillError += DRIFT_SMOOTHING * (fillError - smoothedFillError);
+            driftHook(smoothedFillError);
+        }
+    }
+
+    /**
+     * @brief Copy frames out of the FIFO (consumer thread).
+     * @param output Output sample pointers (one per channel)
+     * @param numFrames Frames to read
+     * @return Frames read (fewer than numFrames if the FIFO runs empty; the rest of the output is untouched)
+     */
+    size_t pop(T* const* output, size_t numFrames) {
+        const auto region = beginRead(numFrames);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            std::copy(region.span1(ch), region.span1(ch) + region.size1, output[ch]);
+            std::copy(region.span2(ch), region.span2(ch) + region.size2, output[ch] + region.size1);
+        }
+        finishRead(region.size());
+        return region.size();
+    }
+
+    /**
+     * @brief Set the drift-correction hook.
+     * @param hook Callback run by the consumer after each read (must be realtime safe if the consumer is an audio
+     *        thread), or an empty function to remove it
+     * @param targetFill Desired fill level as a fraction of the capacity
+     */
+    void setDriftHook(DriftHook hook, double targetFill = 0.5) {
+        driftHook = std::move(hook);
+        driftTarget = std::clamp(targetFill, 0.0, 1.0) * static_cast<double>(capacity);
+        smoothedFillError = 0.0;
+    }
+
+    // =========================================================================
+    // Fill level (any thread; a snapshot that may be stale by the time it is used)
+    // =========================================================================
+
+    /// Frames ready to be read
+    size_t getNumReady() const {
+        const size_t r = readPos.load(std::memory_order_acquire);
+        return writePos.load(std::memory_order_acquire) - r;
+    }
+
+    /// Frames that can be written
+    size_t getFreeSpace() const { return capacity - getNumReady(); }
+
+    /// Fill level as a fraction of the capacity
+    double getFillLevel() const {
+        return capacity > 0 ? static_cast<double>(getNumReady()) / static_cast<double>(capacity) : 0.0;
+    }
+
+    /// Capacity in frames
+    size_t getCapacity() const { return capacity; }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
+  private:
+    size_t numChannels = 0;
+    size_t capacity = 0;
+    AudioBuffer<T> buffer;
+    std::vector<T*> channelPtrs;
+
+    // Producer-owned
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> writePos{0};
+    size_t cachedReadPos = 0;
+
+    // Consumer-owned
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> readPos{0};
+    size_t cachedWritePos = 0;
+    DriftHook driftHook;
+    double driftTarget = 0.0;
+    double smoothedFillError = 0.0;
+
+    template <typename Sample>
+    AudioFifoRegion<Sample> makeRegion(T* const* channels, size_t position, size_t numFrames) const {
+        AudioFifoRegion<Sample> region;
+        region.channels = channels;
+        region.offset = position & (capacity - 1);
+        region.size1 = std::min(numFrames, capacity - region.offset);
+        region.size2 = numFrames - region.size1;
+        return region;
+    }
+};
+
+} // namespace jnsc
@@ -0,0 +1,41 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Cache-sized channel groups for processing large channel counts
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <jonssonic/jonssonic_config.h>
+
+namespace jnsc {
+
+/**
+ * @brief Number of channels per group so that a group's working set fits the cache budget.
+ * @tparam T Sample type
+ * @param numSamples Samples per channel touched by each stage (e.g., the oversampled block length)
+ * @param numBuffers Number of channel buffers a stage streams through (e.g., 2 for input and output)
+ * @return Group size in channels (at least one, even when a single channel exceeds the budget)
+ * @details Multi-stage processors run all their stages on one channel group before moving to the next, so the
+ *          group's audio stays in cache between stages instead of being evicted by the other channels. The budget
+ *          is JONSSONIC_CHANNEL_GROUP_BYTES (set from CMake).
+ */
+template <typename T>
+constexpr size_t channelGroupSize(size_t numSamples, size_t numBuffers = 2) {
+    const size_t bytesPerChannel = std::max<size_t>(numSamples * numBuffers * sizeof(T), 1);
+    return std::max<size_t>(JONSSONIC_CHANNEL_GROUP_BYTES / bytesPerChannel, 1);
+}
+
+/**
+ * @brief Run a callable on consecutive channel groups.
+ * @param numChannels Number of channels
+ * @param groupSize Channels per group (see @ref channelGroupSize)
+ * @param function Callable invoked as `function(chBegin, chEnd)` for each group, in channel order
+ */
+template <typename Function>
+void forEachChannelGroup(size_t numChannels, size_t groupSize, Function&& function) {
+    groupSize = std::max<size_t>(groupSize, 1);
+    for (size_t chBegin = 0; chBegin < numChannels; chBegin += groupSize)
+        function(chBegin, std::min(chBegin + groupSize, numChannels));
+}
+
+} // namespace jnsc
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <cstddef>
 #include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/state_blob.h>
 #include <jonssonic/utils/math_utils.h>
 #include <vector>
 
@@ -50,6 +51,12 @@ class CircularAudioBuffer {
         writeIndex.assign(buffer.getNumChannels(), 0);
     }
 
+    /// Clear a single channel and reset its write index
+    void clearChannel(size_t channel) {
+        buffer.clearChannel(channel);
+        writeIndex[channel] = 0;
+    }
+
     /**
      * @brief Write a sample to the buffer at the current write position for a given channel and increment the write
      * index.
@@ -103,9 +110,21 @@ class CircularAudioBuffer {
         return (writeIndex[channel] + bufferSize - delay - 1) & (bufferSize - 1);
     }
 
+    /// Append the buffered samples and write positions to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(buffer);
+        blob.write(writeIndex);
+    }
+
+    /// Restore the buffered samples and write positions from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(buffer);
+        reader.read(writeIndex);
+    }
+
   private:
     AudioBuffer<T> buffer;
-    std::vector<size_t> writeIndex; // per-channel write index
+    detail::AlignedVector<size_t> writeIndex; // per-channel write index
     size_t bufferSize = 0;
 };
 
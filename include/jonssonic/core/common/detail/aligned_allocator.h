@@ -0,0 +1,52 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Cache-line aligned allocator for per-channel state storage
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace jnsc::detail {
+
+/// Alignment used for audio and per-channel state storage (one cache line)
+inline constexpr size_t STORAGE_ALIGNMENT = 64;
+
+/**
+ * @brief Minimal allocator returning storage aligned to @p Alignment bytes.
+ * @details Aligning state storage to cache lines means that channel ranges which are multiples of a cache line
+ *          never share a line, so they can be processed on different threads without false sharing.
+ * @tparam T Value type
+ * @tparam Alignment Alignment in bytes (power of two)
+ */
+template <typename T, size_t Alignment = STORAGE_ALIGNMENT>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment))); }
+    void deallocate(T* p, size_t) noexcept { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+        return false;
+    }
+};
+
+/// std::vector with cache-line aligned storage
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace jnsc::detail
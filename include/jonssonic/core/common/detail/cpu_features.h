@@ -0,0 +1,78 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Runtime CPU feature detection (cpuid)
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define JONSSONIC_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace jnsc::detail {
+
+/// CPU features relevant for kernel dispatch
+struct CpuFeatures {
+    bool avx2 = false;    // AVX2 instructions with OS support for YMM state
+    bool avx512f = false; // AVX-512 Foundation with OS support for ZMM and mask state
+};
+
+#if defined(JONSSONIC_X86)
+inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<uint32_t>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+inline uint64_t xgetbv() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+#else
+    uint32_t lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+/**
+ * @brief Query the features of the CPU we are running on.
+ * @note Checks both the instruction set bits and that the OS saves the wide register state.
+ */
+inline CpuFeatures queryCpuFeatures() {
+    CpuFeatures features;
+#if defined(JONSSONIC_X86)
+    uint32_t regs[4] = {0, 0, 0, 0};
+    cpuid(0, 0, regs);
+    const uint32_t maxLeaf = regs[0];
+    if (maxLeaf < 7)
+        return features;
+
+    cpuid(1, 0, regs);
+    const bool osxsave = (regs[2] >> 27) & 1u;
+    const bool avx = (regs[2] >> 28) & 1u;
+    if (!osxsave || !avx)
+        return features;
+
+    const uint64_t xcr0 = xgetbv();
+    const bool ymmState = (xcr0 & 0x6u) == 0x6u;   // SSE and AVX state
+    const bool zmmState = (xcr0 & 0xE6u) == 0xE6u; // plus opmask and upper ZMM state
+
+    cpuid(7, 0, regs);
+    features.avx2 = ymmState && ((regs[1] >> 5) & 1u);
+    features.avx512f = features.avx2 && zmmState && ((regs[1] >> 16) & 1u);
+#endif
+    return features;
+}
+
+} // namespace jnsc::detail
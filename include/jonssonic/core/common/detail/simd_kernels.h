@@ -0,0 +1,279 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Hot block kernels, compiled once per instruction set for runtime dispatch
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cstddef>
+#include <jonssonic/core/common/detail/cpu_features.h>
+
+// Per-function instruction set targets (GCC/Clang on x86). Elsewhere only the baseline build exists.
+#if defined(JONSSONIC_X86) && (defined(__GNUC__) || defined(__clang__))
+#define JONSSONIC_SIMD_DISPATCH 1
+#define JONSSONIC_TARGET_AVX2 __attribute__((target("avx2")))
+#if defined(__clang__)
+#define JONSSONIC_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define JONSSONIC_TARGET_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+#endif
+#endif
+
+// AVX-512F includes FMA; keep multiply-adds separate so that every build rounds like the baseline
+#if defined(__clang__)
+#define JONSSONIC_NO_FP_CONTRACT _Pragma("clang fp contract(off)")
+#else
+#define JONSSONIC_NO_FP_CONTRACT
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define JONSSONIC_ALWAYS_INLINE inline __attribute__((always_inline))
+#define JONSSONIC_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define JONSSONIC_ALWAYS_INLINE __forceinline
+#define JONSSONIC_RESTRICT __restrict
+#else
+#define JONSSONIC_ALWAYS_INLINE inline
+#define JONSSONIC_RESTRICT
+#endif
+
+namespace jnsc::detail {
+
+// =============================================================================
+// Kernel bodies
+// Written as plain loops with independent iterations so that each instruction set build vectorizes them
+// (at -O3, i.e. Release builds). Multiply-adds are never contracted into FMA, which keeps every build
+// bit-exact with the baseline.
+// =============================================================================
+
+/// Planar channels -> interleaved frames
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void interleaveKernel(const T* const* planar,
+                                              T* JONSSONIC_RESTRICT frames,
+                                              size_t numChannels,
+                                              size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    if (numChannels == 2) {
+        const T* JONSSONIC_RESTRICT left = planar[0];
+        const T* JONSSONIC_RESTRICT right = planar[1];
+        for (size_t n = 0; n < numSamples; ++n) {
+            frames[2 * n] = left[n];
+            frames[2 * n + 1] = right[n];
+        }
+        return;
+    }
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        const T* JONSSONIC_RESTRICT in = planar[ch];
+        for (size_t n = 0; n < numSamples; ++n)
+            frames[n * numChannels + ch] = in[n];
+    }
+}
+
+/// Interleaved frames -> planar channels
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void deinterleaveKernel(const T* JONSSONIC_RESTRICT frames,
+                                                T* const* planar,
+                                                size_t numChannels,
+                                                size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    if (numChannels == 2) {
+        T* JONSSONIC_RESTRICT left = planar[0];
+        T* JONSSONIC_RESTRICT right = planar[1];
+        for (size_t n = 0; n < numSamples; ++n) {
+            left[n] = frames[2 * n];
+            right[n] = frames[2 * n + 1];
+        }
+        return;
+    }
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        T* JONSSONIC_RESTRICT out = planar[ch];
+        for (size_t n = 0; n < numSamples; ++n)
+            out[n] = frames[n * numChannels + ch];
+    }
+}
+
+/**
+ * @brief Cascaded DF2T biquads over interleaved frames, vectorized across channels.
+ * @param frames Interleaved frames, processed in place
+ * @param coeffs Coefficients laid out as [section][b0, b1, b2, a1, a2][channel]
+ * @param state State laid out as [section][s1, s2][channel]
+ */
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void biquadBankKernel(T* JONSSONIC_RESTRICT frames,
+                                              size_t numChannels,
+                                              size_t numFrames,
+                                              size_t numSections,
+                                              const T* JONSSONIC_RESTRICT coeffs,
+                                              T* JONSSONIC_RESTRICT state) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t s = 0; s < numSections; ++s) {
+        const T* JONSSONIC_RESTRICT b0 = coeffs + (s * 5 + 0) * numChannels;
+        const T* JONSSONIC_RESTRICT b1 = coeffs + (s * 5 + 1) * numChannels;
+        const T* JONSSONIC_RESTRICT b2 = coeffs + (s * 5 + 2) * numChannels;
+        const T* JONSSONIC_RESTRICT a1 = coeffs + (s * 5 + 3) * numChannels;
+        const T* JONSSONIC_RESTRICT a2 = coeffs + (s * 5 + 4) * numChannels;
+        T* JONSSONIC_RESTRICT s1 = state + (s * 2 + 0) * numChannels;
+        T* JONSSONIC_RESTRICT s2 = state + (s * 2 + 1) * numChannels;
+
+        for (size_t f = 0; f < numFrames; ++f) {
+            T* JONSSONIC_RESTRICT x = frames + f * numChannels;
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                const T input = x[ch];
+                const T output = b0[ch] * input + s1[ch];
+                s1[ch] = b1[ch] * input - a1[ch] * output + s2[ch];
+                s2[ch] = b2[ch] * input - a2[ch] * output;
+                x[ch] = output;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Symmetric halfband FIR branch: y[n] = sum_k coeffs[k] * (x[n - k] + x[n - span + k]).
+ * @param x Input, preceded by @p span samples of history (x[-span] .. x[-1])
+ * @param y Output
+ * @note Accumulates in ascending k per output, the same order as a per-sample loop.
+ */
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void halfbandFirKernel(const T* JONSSONIC_RESTRICT x,
+                                               T* JONSSONIC_RESTRICT y,
+                                               size_t numSamples,
+                                               const T* JONSSONIC_RESTRICT coeffs,
+                                               size_t numCoeffs,
+                                               size_t span) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n)
+        y[n] = T(0);
+    for (size_t k = 0; k < numCoeffs; ++k) {
+        const T c = coeffs[k];
+        const T* JONSSONIC_RESTRICT newer = x - k;
+        const T* JONSSONIC_RESTRICT older = x - span + k;
+        for (size_t n = 0; n < numSamples; ++n)
+            y[n] += c * (newer[n] + older[n]);
+    }
+}
+
+/// Hard clip to [-1, 1] (same comparisons as std::max(-1, std::min(1, x))); input and output may alias
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void hardClipKernel(const T* input, T* output, size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n) {
+        const T upper = input[n] < T(1) ? input[n] : T(1);
+        output[n] = T(-1) < upper ? upper : T(-1);
+    }
+}
+
+/// Cubic soft clip: x - x^3 / 3; input and output may alias
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void cubicClipKernel(const T* input, T* output, size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n) {
+        const T x = input[n];
+        output[n] = x - (T(1) / T(3)) * x * x * x;
+    }
+}
+
+/// Scaled accumulate: output += gain * input
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void scaledAddKernel(const T* JONSSONIC_RESTRICT input,
+                                             T* JONSSONIC_RESTRICT output,
+                                             T gain,
+                                             size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n)
+        output[n] += gain * input[n];
+}
+
+/// Scaled copy: output = gain * input; input and output may alias
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void scaleKernel(const T* input, T* output, T gain, size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n)
+        output[n] = gain * input[n];
+}
+
+/// Accumulate with a linear gain ramp: output += (startGain + n * gainStep) * input
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void rampedAddKernel(const T* JONSSONIC_RESTRICT input,
+                                             T* JONSSONIC_RESTRICT output,
+                                             T startGain,
+                                             T gainStep,
+                                             size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n)
+        output[n] += (startGain + static_cast<T>(n) * gainStep) * input[n];
+}
+
+/// Weighted sum with constant gains: output = gainA * a + gainB * b; output may alias a or b
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void blendKernel(const T* a, T gainA, const T* b, T gainB, T* output, size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n)
+        output[n] = gainA * a[n] + gainB * b[n];
+}
+
+/// Weighted sum with per-sample gain curves: output = gainA * a + gainB * b; output may alias a or b
+template <typename T>
+JONSSONIC_ALWAYS_INLINE void blendCurvesKernel(const T* a,
+                                               const T* JONSSONIC_RESTRICT gainA,
+                                               const T* b,
+                                               const T* JONSSONIC_RESTRICT gainB,
+                                               T* output,
+                                               size_t numSamples) {
+    JONSSONIC_NO_FP_CONTRACT
+    for (size_t n = 0; n < numSamples; ++n)
+        output[n] = gainA[n] * a[n] + gainB[n] * b[n];
+}
+
+// =============================================================================
+// Instruction set builds
+// =============================================================================
+// Expands to a set of static wrappers that inline the kernel bodies under the given target attribute.
+#define JONSSONIC_DEFINE_KERNEL_SET(NAME, TARGET)                                                                     \
+    template <typename T>                                                                                              \
+    struct NAME {                                                                                                      \
+        TARGET static void interleave(const T* const* planar, T* frames, size_t numChannels, size_t numSamples) {      \
+            interleaveKernel(planar, frames, numChannels, numSamples);                                                 \
+        }                                                                                                              \
+        TARGET static void deinterleave(const T* frames, T* const* planar, size_t numChannels, size_t numSamples) {    \
+            deinterleaveKernel(frames, planar, numChannels, numSamples);                                               \
+        }                                                                                                              \
+        TARGET static void biquadBank(                                                                                 \
+            T* frames, size_t numChannels, size_t numFrames, size_t numSections, const T* coeffs, T* state) {          \
+            biquadBankKernel(frames, numChannels, numFrames, numSections, coeffs, state);                              \
+        }                                                                                                              \
+        TARGET static void halfbandFir(                                                                                \
+            const T* x, T* y, size_t numSamples, const T* coeffs, size_t numCoeffs, size_t span) {                     \
+            halfbandFirKernel(x, y, numSamples, coeffs, numCoeffs, span);                                              \
+        }                                                                                                              \
+        TARGET static void hardClip(const T* input, T* output, size_t numSamples) {                                    \
+            hardClipKernel(input, output, numSamples);                                                                 \
+        }                                                                                                              \
+        TARGET static void cubicClip(const T* input, T* output, size_t numSamples) {                                   \
+            cubicClipKernel(input, output, numSamples);                                                                \
+        }                                                                                                              \
+        TARGET static void scaledAdd(const T* input, T* output, T gain, size_t numSamples) {                           \
+            scaledAddKernel(input, output, gain, numSamples);                                                          \
+        }                                                                                                              \
+        TARGET static void scale(const T* input, T* output, T gain, size_t numSamples) {                               \
+            scaleKernel(input, output, gain, numSamples);                                                              \
+        }                                                                                                              \
+        TARGET static void rampedAdd(const T* input, T* output, T startGain, T gainStep, size_t numSamples) {          \
+            rampedAddKernel(input, output, startGain, gainStep, numSamples);                                           \
+        }                                                                                                              \
+        TARGET static void blend(const T* a, T gainA, const T* b, T gainB, T* output, size_t numSamples) {             \
+            blendKernel(a, gainA, b, gainB, output, numSamples);                                                       \
+        }                                                                                                              \
+        TARGET static void blendCurves(                                                                                \
+            const T* a, const T* gainA, const T* b, const T* gainB, T* output, size_t numSamples) {                    \
+            blendCurvesKernel(a, gainA, b, gainB, output, numSamples);                                                 \
+        }                                                                                                              \
+    };
+
+JONSSONIC_DEFINE_KERNEL_SET(BaselineKernels, )
+#if defined(JONSSONIC_SIMD_DISPATCH)
+JONSSONIC_DEFINE_KERNEL_SET(Avx2Kernels, JONSSONIC_TARGET_AVX2)
+JONSSONIC_DEFINE_KERNEL_SET(Avx512Kernels, JONSSONIC_TARGET_AVX512)
+#endif
+
+#undef JONSSONIC_DEFINE_KERNEL_SET
+
+} // namespace jnsc::detail
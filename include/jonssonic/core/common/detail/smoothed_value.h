@@ -7,7 +7,11 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <jonssonic/core/common/detail/aligned_allocator.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/simd_pack.h>
+#include <jonssonic/core/common/state_blob.h>
 #include <vector>
 
 namespace jnsc {
@@ -100,8 +104,17 @@ class SmoothedValue<T, SmootherType::None, Order> {
     /// Get target value for a channel (same as current for None)
     T getTargetValue(size_t ch) const { return value[ch]; }
 
+    /// Always settled (no smoothing)
+    bool settle(size_t, T) { return true; }
+
+    /// Append the per-channel values to a state snapshot
+    void saveState(StateBlob& blob) const { blob.write(value); }
+
+    /// Restore the per-channel values from a state snapshot
+    void restoreState(StateReader& reader) { reader.read(value); }
+
   private:
-    std::vector<T> value;
+    AlignedVector<T> value;
 };
 // =============================================================
 // OnePole specialization (arbitrary order)
@@ -230,22 +243,56 @@ class SmoothedValue<T, SmootherType::OnePole, Order> {
     /// Get target value for a channel
     T getTargetValue(size_t ch) const { return target[ch]; }
 
+    /**
+     * @brief Snap a channel to its target once it is within a tolerance.
+     * @param ch Channel index
+     * @param tolerance Largest distance to the target that counts as settled
+     * @return True if the channel now sits exactly on its target
+     * @note The exponential approach never reaches the target on its own: rounding stalls it once a step falls
+     *       below half an ulp, which can be farther away than the tolerance, so a stalled channel counts as settled.
+     */
+    bool settle(size_t ch, T tolerance) {
+        using std::abs;
+        if (current[ch] == target[ch])
+            return true;
+        const T stalled = std::numeric_limits<T>::epsilon() * (abs(target[ch]) + abs(current[ch])) / coeff;
+        if (abs(target[ch] - current[ch]) > std::max(tolerance, stalled))
+            return false;
+        setTarget(ch, target[ch], true);
+        return true;
+    }
+
+    /// Append the smoothing position of every channel to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(current);
+        blob.write(target);
+        blob.write(stage);
+    }
+
+    /// Restore the smoothing position of every channel from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(current);
+        reader.read(target);
+        reader.read(stage);
+    }
+
   private:
     bool togglePrepared = false;
     T sampleRate = 44100;
     size_t numChannels = 0;
-    std::vector<T> current;
-    std::vector<T> target;
+    AlignedVector<T> current;
+    AlignedVector<T> target;
     T timeSec = 0.05;
     T coeff = 0;
-    std::vector<std::array<T, Order>> stage; // stage[channel][order]
+    AlignedVector<std::array<T, Order>> stage; // stage[channel][order]
 
     void updateSmoothingParams() {
         // Early exit if not prepared
         if (!togglePrepared)
             return;
         // Calculate coeff for one-pole smoothing;
-        coeff = 1 - std::exp(-1.0 / (timeSec * sampleRate));
+        using std::exp;
+        coeff = 1 - exp(-1.0 / (timeSec * sampleRate));
     }
 };
 
@@ -386,18 +433,51 @@ class SmoothedValue<T, SmootherType::Linear, Order> {
     // Get target value for a channel
     T getTargetValue(size_t ch) const { return target[ch]; }
 
+    /**
+     * @brief Snap a channel to its target once it is within a tolerance.
+     * @param ch Channel index
+     * @param tolerance Largest distance to the target that counts as settled
+     * @return True if the channel now sits exactly on its target
+     */
+    bool settle(size_t ch, T tolerance) {
+        using std::abs;
+        if (current[ch] == target[ch])
+            return true;
+        if (abs(target[ch] - current[ch]) > tolerance)
+            return false;
+        setTarget(ch, target[ch], true);
+        return true;
+    }
+
+    /// Append the ramp position of every channel to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(current);
+        blob.write(target);
+        blob.write(rampStep);
+        blob.write(rampSamples);
+    }
+
+    /// Restore the ramp position of every channel from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(current);
+        reader.read(target);
+        reader.read(rampStep);
+        reader.read(rampSamples);
+    }
+
   private:
     bool togglePrepared = false;
     T sampleRate = 44100;
     size_t numChannels = 0;
     T timeSec = 0.01;
-    std::vector<T> current;
-    std::vector<T> target;
-    std::vector<T> rampStep;
+    AlignedVector<T> current;
+    AlignedVector<T> target;
+    AlignedVector<T> rampStep;
     size_t rampSamples = 0;
 
     void updateSmoothingParams() {
-        rampSamples = std::max<size_t>(1, static_cast<size_t>(timeSec * sampleRate));
+        // The ramp length is shared by all channels (and by all lanes of a SIMD pack)
+        rampSamples = std::max<size_t>(1, static_cast<size_t>(reduceMax(timeSec * sampleRate)));
         for (size_t ch = 0; ch < numChannels; ++ch) {
             rampStep[ch] = (target[ch] - current[ch]) / static_cast<T>(rampSamples);
         }
@@ -0,0 +1,223 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Opt-in DSP load measurement per processor and processing stage
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace jnsc {
+
+/// True if the library is built with JONSSONIC_ENABLE_DSP_LOAD (DSP load measurement compiled in)
+#if defined(JONSSONIC_ENABLE_DSP_LOAD)
+inline constexpr bool dspLoadEnabled = true;
+#else
+inline constexpr bool dspLoadEnabled = false;
+#endif
+
+#if defined(JONSSONIC_ENABLE_DSP_LOAD)
+
+/**
+ * @brief DSP load of a processor, per processing stage, as a percentage of the realtime budget.
+ * @details The audio thread accumulates the time spent in each stage with @ref addTime (usually through a
+ *          @ref ScopedDspTimer) and closes the block with @ref commitBlock, which divides by the duration of the
+ *          block (numSamples / sampleRate) and folds the result into a moving average of about
+ *          AVERAGING_TIME_S. Averages and the peak total are published through relaxed atomics, so any thread
+ *          can read them without locking.
+ * @tparam NumStages Number of stages (1 for processors reported as a whole)
+ * @note Compiled in only when JONSSONIC_ENABLE_DSP_LOAD is defined (CMake option of the same name). Otherwise the
+ *       meter and timer are empty classes, every call is a no-op and all loads read as 0.
+ */
+template <size_t NumStages = 1>
+class DspLoadMeter {
+  public:
+    /// Time constant of the moving average in seconds
+    static constexpr double AVERAGING_TIME_S = 0.5;
+
+    /**
+     * @brief Prepare the meter (sets the realtime budget per sample).
+     * @param newSampleRate Sample rate in Hz
+     */
+    void prepare(double newSampleRate) {
+        sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+        reset();
+    }
+
+    /// Clear pending times, averages and the peak
+    void reset() {
+        pending.fill(0);
+        for (auto& load : loads)
+            load.store(0.0f, std::memory_order_relaxed);
+        peak.store(0.0f, std::memory_order_relaxed);
+    }
+
+    /// Add time spent in a stage during the current block (audio thread)
+    template <typename Stage>
+    void addTime(Stage stage, uint64_t nanoseconds) {
+        pending[static_cast<size_t>(stage)] += nanoseconds;
+    }
+
+    /**
+     * @brief Convert the times of the current block to loads and publish them (audio thread).
+     * @param numSamples Number of samples processed in the block
+     */
+    void commitBlock(size_t numSamples) {
+        if (numSamples == 0)
+            return;
+        const double blockSeconds = static_cast<double>(numSamples) / sampleRate;
+        const double toPercent = 100.0e-9 / blockSeconds;
+        const double weight = std::min(1.0, blockSeconds / AVERAGING_TIME_S);
+        double total = 0.0;
+        for (size_t s = 0; s < NumStages; ++s) {
+            const double load = static_cast<double>(pending[s]) * toPercent;
+            const double average = loads[s].load(std::memory_order_relaxed);
+            loads[s].store(static_cast<float>(average + weight * (load - average)), std::memory_order_relaxed);
+            pending[s] = 0;
+            total += load;
+        }
+        if (total > peak.load(std::memory_order_relaxed))
+            peak.store(static_cast<float>(total), std::memory_order_relaxed);
+    }
+
+    /// Average load of one stage in percent of the realtime budget (any thread)
+    template <typename Stage>
+    float getLoadPercent(Stage stage) const {
+        return loads[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+    }
+
+    /// Average load of all stages together in percent of the realtime budget (any thread)
+    float getLoadPercent() const {
+        float total = 0.0f;
+        for (const auto& load : loads)
+            total += load.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /// Highest total load of a single block since the last @ref resetPeak (any thread)
+    float getPeakLoadPercent() const { return peak.load(std::memory_order_relaxed); }
+
+    /// Restart peak tracking (any thread)
+    void resetPeak() { peak.store(0.0f, std::memory_order_relaxed); }
+
+    /// Monotonic timestamp in nanoseconds
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+  private:
+    double sampleRate = 44100.0;
+    std::array<uint64_t, NumStages> pending{};       // Audio thread only
+    std::array<std::atomic<float>, NumStages> loads{}; // Published averages
+    std::atomic<float> peak{0.0f};
+};
+
+/**
+ * @brief Charges the time of a scope to the stages of a @ref DspLoadMeter.
+ * @details The time from construction goes to the first stage; @ref next closes the current stage and starts the
+ *          next one, so consecutive stages cost a single clock read each. On destruction the remaining time goes to
+ *          the current stage, and if numSamples is nonzero the block is committed.
+ * @code
+ * ScopedDspTimer timer(loadMeter, numSamples, LoadStage::PreDelay);
+ * preDelay.processBlock(input, output, numSamples);
+ * timer.next(LoadStage::FDN);
+ * fdn.processBlock(output, output, numSamples);
+ * @endcode
+ * @tparam NumStages Number of stages of the meter
+ */
+template <size_t NumStages>
+class ScopedDspTimer {
+  public:
+    /**
+     * @brief Start timing.
+     * @param meter Meter to charge, or nullptr to time nothing
+     * @param numSamples Block size committed on destruction (0 to leave the block open)
+     * @param firstStage Stage charged until the first call to @ref next
+     */
+    template <typename Stage = size_t>
+    ScopedDspTimer(DspLoadMeter<NumStages>* meter, size_t numSamples, Stage firstStage = Stage{})
+        : meter(meter), numSamples(numSamples), stage(static_cast<size_t>(firstStage)),
+          start(meter ? DspLoadMeter<NumStages>::now() : 0) {}
+
+    /// Start timing into a meter (see above)
+    template <typename Stage = size_t>
+    ScopedDspTimer(DspLoadMeter<NumStages>& meter, size_t numSamples, Stage firstStage = Stage{})
+        : ScopedDspTimer(&meter, numSamples, firstStage) {}
+
+    /// Charge the remaining time and commit the block
+    ~ScopedDspTimer() {
+        if (!meter)
+            return;
+        meter->addTime(stage, DspLoadMeter<NumStages>::now() - start);
+        if (numSamples > 0)
+            meter->commitBlock(numSamples);
+    }
+
+    /// No copy nor move semantics
+    ScopedDspTimer(const ScopedDspTimer&) = delete;
+    ScopedDspTimer& operator=(const ScopedDspTimer&) = delete;
+    ScopedDspTimer(ScopedDspTimer&&) = delete;
+    ScopedDspTimer& operator=(ScopedDspTimer&&) = delete;
+
+    /// Charge the time so far to the current stage and continue with another one
+    template <typename Stage>
+    void next(Stage nextStage) {
+        if (!meter)
+            return;
+        const uint64_t time = DspLoadMeter<NumStages>::now();
+        meter->addTime(stage, time - start);
+        start = time;
+        stage = static_cast<size_t>(nextStage);
+    }
+
+  private:
+    DspLoadMeter<NumStages>* meter;
+    size_t numSamples;
+    size_t stage;
+    uint64_t start;
+};
+
+#else
+
+// Measurement compiled out: empty types, no-op calls, all loads read as 0
+
+template <size_t NumStages = 1>
+class DspLoadMeter {
+  public:
+    static constexpr double AVERAGING_TIME_S = 0.5;
+    void prepare(double) {}
+    void reset() {}
+    template <typename Stage>
+    void addTime(Stage, uint64_t) {}
+    void commitBlock(size_t) {}
+    template <typename Stage>
+    float getLoadPercent(Stage) const {
+        return 0.0f;
+    }
+    float getLoadPercent() const { return 0.0f; }
+    float getPeakLoadPercent() const { return 0.0f; }
+    void resetPeak() {}
+    static uint64_t now() { return 0; }
+};
+
+template <size_t NumStages>
+class ScopedDspTimer {
+  public:
+    template <typename Stage = size_t>
+    ScopedDspTimer(DspLoadMeter<NumStages>*, size_t, Stage = Stage{}) {}
+    template <typename Stage = size_t>
+    ScopedDspTimer(DspLoadMeter<NumStages>&, size_t, Stage = Stage{}) {}
+    ScopedDspTimer(const ScopedDspTimer&) = delete;
+    ScopedDspTimer& operator=(const ScopedDspTimer&) = delete;
+    template <typename Stage>
+    void next(Stage) {}
+};
+
+#endif
+
+} // namespace jnsc
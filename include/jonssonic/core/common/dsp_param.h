@@ -45,6 +45,9 @@ class DspParam {
     /// Reset the parameter smoothing state.
     void reset() { smoother.reset(); }
 
+    /// Reset the smoothing of a single channel (jumps to its target value).
+    void resetChannel(size_t ch) { smoother.setTarget(ch, smoother.getTargetValue(ch), true); }
+
     /// Set smoothing time in various units via Time class (quantities.h)
     void setSmoothingTime(Time<T> newTime) { smoother.setTime(newTime); }
 
@@ -100,6 +103,30 @@ class DspParam {
         smoother.applyToBuffer(buffer, numSamples);
     }
 
+    /**
+     * @brief Apply to the first channels of a buffer (e.g., only the active channels).
+     * @param buffer Audio buffer (array of pointers to channel data)
+     * @param numSamples Number of samples per channel
+     * @param numChannels Number of channels to apply to
+     */
+    void applyToBuffer(T* const* buffer, size_t numSamples, size_t numChannels) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                buffer[ch][n] *= smoother.getNextValue(ch);
+    }
+
+    /**
+     * @brief Apply to a buffer of interleaved frames.
+     * @param frames Interleaved frames [frame][channel]
+     * @param numFrames Number of frames
+     * @param numChannels Number of channels per frame
+     */
+    void applyToInterleaved(T* frames, size_t numFrames, size_t numChannels) {
+        for (size_t f = 0; f < numFrames; ++f)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                frames[f * numChannels + ch] *= smoother.getNextValue(ch);
+    }
+
     /// Get next smoothed value for a channel.
     T getNextValue(size_t ch) { return smoother.getNextValue(ch); }
 
@@ -109,13 +136,25 @@ class DspParam {
     /// Get target value for a channel.
     T getTargetValue(size_t ch) const { return smoother.getTargetValue(ch); }
 
+    /// Snap a channel to its target once within tolerance, true if it is settled.
+    bool settle(size_t ch, T tolerance) { return smoother.settle(ch, tolerance); }
+
+    /// Append the smoothing state to a snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const { smoother.saveState(blob); }
+
+    /// Restore the smoothing state from a snapshot (see @ref StateBlob)
+    void restoreState(StateReader& reader) { smoother.restoreState(reader); }
+
   private:
     detail::SmoothedValue<T, Type, Order> smoother;
     T min = std::numeric_limits<T>::lowest();
     T max = std::numeric_limits<T>::max();
 
     // Clamp helper
-    T clamp(T value) const { return std::clamp(value, min, max); }
+    T clamp(T value) const {
+        using std::clamp;
+        return clamp(value, min, max);
+    }
 };
 
 } // namespace jnsc
\ No newline at end of file
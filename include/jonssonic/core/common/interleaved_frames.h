@@ -0,0 +1,35 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Frame-by-frame processing of interleaved host buffers
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cstddef>
+
+namespace jnsc {
+
+/**
+ * @brief Process interleaved frames with a channel-parallel processor, without deinterleaving.
+ * @param processor Processor providing `processSample(ch, x)`
+ * @param input Interleaved input frames: input[frame * frameSize + ch]
+ * @param output Interleaved output frames (may alias @p input)
+ * @param frameSize Number of channels per frame (the buffer's channel count)
+ * @param numChannels Number of channels to process (the rest of each frame is untouched)
+ * @param numFrames Number of frames to process
+ * @note Each channel sees its samples in order, so results match planar processing of the same channels.
+ */
+template <typename Processor, typename T>
+void processInterleavedFrames(Processor& processor,
+                              const T* input,
+                              T* output,
+                              size_t frameSize,
+                              size_t numChannels,
+                              size_t numFrames) {
+    for (size_t f = 0; f < numFrames; ++f) {
+        const T* in = input + f * frameSize;
+        T* out = output + f * frameSize;
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            out[ch] = processor.processSample(ch, in[ch]);
+    }
+}
+
+} // namespace jnsc
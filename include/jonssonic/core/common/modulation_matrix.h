@@ -0,0 +1,311 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Block-based modulation matrix with shared source buffers
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include "jonssonic/utils/detail/config_utils.h"
+#include <algorithm>
+#include <cassert>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/modulation.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/common/state_blob.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jnsc {
+
+namespace detail {
+/// Detects generator sources: `processBlock(T* const* output, size_t numSamples)` (oscillators, noise)
+template <typename S, typename T, typename = void>
+struct IsModulationGenerator : std::false_type {};
+template <typename S, typename T>
+struct IsModulationGenerator<
+    S,
+    T,
+    std::void_t<decltype(std::declval<S&>().processBlock(std::declval<T* const*>(), size_t{}))>>
+    : std::true_type {};
+
+/// Detects analyzer sources: `processBlock(const T* const* input, T* const* output, size_t)` (envelope followers)
+template <typename S, typename T, typename = void>
+struct IsModulationAnalyzer : std::false_type {};
+template <typename S, typename T>
+struct IsModulationAnalyzer<S,
+                            T,
+                            std::void_t<decltype(std::declval<S&>().processBlock(
+                                std::declval<const T* const*>(), std::declval<T* const*>(), size_t{}))>>
+    : std::true_type {};
+} // namespace detail
+
+/**
+ * @brief Block-based modulation matrix.
+ * @details Sources render once per block into shared buffers, however many destinations they drive. Each
+ *          destination buffer is then computed as
+ *              destination[ch][n] = base + sum over routes (depth * source[ch][n])
+ *          with the runtime-dispatched scaled-add kernel. Destination buffers plug straight into block modulation
+ *          interfaces such as `CombMod::Block` and `AllpassMod::Block`, or any processor taking per-channel
+ *          modulation pointers.
+ *
+ *          Supported sources:
+ *          - Generators with `processBlock(output, numSamples)` (e.g., Oscillator, Noise)
+ *          - Analyzers with `processBlock(input, output, numSamples)` fed by the audio passed to @ref process
+ *            (e.g., EnvelopeFollower)
+ *          - External buffers set by the host every block (@ref addExternalSource, @ref setExternalSource)
+ *
+ * @tparam T Sample data type (float, double)
+ * @note Adding sources, destinations and routes allocates and must happen outside the audio thread. Sources are
+ *       referenced, not owned, and must outlive the matrix (or the next @ref prepare). Depth and base changes
+ *       take effect at the next block.
+ */
+template <typename T>
+class ModulationMatrix {
+  public:
+    /// Default constructor
+    ModulationMatrix() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumChannels Number of channels of every source and destination
+     * @param newMaxBlockSize Maximum block size in samples
+     */
+    ModulationMatrix(size_t newNumChannels, size_t newMaxBlockSize) { prepare(newNumChannels, newMaxBlockSize); }
+
+    /// Default destructor
+    ~ModulationMatrix() = default;
+
+    /// No copy nor move semantics
+    ModulationMatrix(const ModulationMatrix&) = delete;
+    ModulationMatrix& operator=(const ModulationMatrix&) = delete;
+    ModulationMatrix(ModulationMatrix&&) = delete;
+    ModulationMatrix& operator=(ModulationMatrix&&) = delete;
+
+    /**
+     * @brief Prepare the matrix for processing. Removes all sources, destinations and routes.
+     * @param newNumChannels Number of channels of every source and destination
+     * @param newMaxBlockSize Maximum block size in samples
+     */
+    void prepare(size_t newNumChannels, size_t newMaxBlockSize) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        maxBlockSize = std::max<size_t>(newMaxBlockSize, 1);
+        sources.clear();
+        destinations.clear();
+        routes.clear();
+        sourceBuffer.resize(0, 0);
+        destinationBuffer.resize(0, 0);
+        togglePrepared = true;
+    }
+
+    /// Clear the source and destination buffers
+    void reset() {
+        sourceBuffer.clear();
+        destinationBuffer.clear();
+    }
+
+    /**
+     * @brief Add a generator or analyzer source.
+     * @param source Source object (referenced, must outlive the matrix), prepared with the matrix channel count
+     * @return Source index
+     */
+    template <typename Source>
+    size_t addSource(Source& source) {
+        static_assert(detail::IsModulationGenerator<Source, T>::value || detail::IsModulationAnalyzer<Source, T>::value,
+                      "Source must provide processBlock(output, numSamples) or processBlock(input, output, numSamples)");
+        SourceSlot slot;
+        slot.object = &source;
+        slot.render = [](void* object, const T* const* audio, T* const* output, size_t numSamples) {
+            if constexpr (detail::IsModulationGenerator<Source, T>::value) {
+                (void)audio;
+                static_cast<Source*>(object)->processBlock(output, numSamples);
+            } else {
+                static_cast<Source*>(object)->processBlock(audio, output, numSamples);
+            }
+        };
+        slot.isAnalyzer = !detail::IsModulationGenerator<Source, T>::value;
+        return appendSource(slot);
+    }
+
+    /**
+     * @brief Add a source whose buffers the host provides every block (see @ref setExternalSource).
+     * @return Source index
+     */
+    size_t addExternalSource() { return appendSource(SourceSlot{}); }
+
+    /**
+     * @brief Set the buffers of an external source for the next @ref process call.
+     * @param source Source index returned by @ref addExternalSource
+     * @param buffers Per-channel buffers holding at least the processed number of samples
+     */
+    void setExternalSource(size_t source, const T* const* buffers) {
+        assert(source < sources.size() && sources[source].object == nullptr && "Not an external source");
+        sources[source].external = buffers;
+    }
+
+    /**
+     * @brief Add a destination.
+     * @param baseValue Value of the destination without modulation
+     * @return Destination index
+     */
+    size_t addDestination(T baseValue = T(0)) {
+        destinations.push_back(baseValue);
+        destinationBuffer.resize(destinations.size() * numChannels, maxBlockSize);
+        destinationReadPtrs = destinationBuffer.readPtrs();
+        destinationWritePtrs = destinationBuffer.writePtrs();
+        return destinations.size() - 1;
+    }
+
+    /// Set the unmodulated value of a destination
+    void setDestinationBase(size_t destination, T baseValue) {
+        assert(destination < destinations.size() && "Destination index out of bounds");
+        destinations[destination] = baseValue;
+    }
+
+    /**
+     * @brief Route a source to a destination.
+     * @param source Source index
+     * @param destination Destination index
+     * @param depth Scale applied to the source
+     * @note Connecting an existing route only updates its depth.
+     */
+    void connect(size_t source, size_t destination, T depth) {
+        assert(source < sources.size() && "Source index out of bounds");
+        assert(destination < destinations.size() && "Destination index out of bounds");
+        if (findRoute(source, destination) < routes.size()) {
+            setDepth(source, destination, depth);
+            return;
+        }
+        routes.push_back(Route{source, destination, depth});
+        // Keep routes grouped by destination so that each destination buffer is finished before the next
+        std::stable_sort(
+            routes.begin(), routes.end(), [](const Route& a, const Route& b) { return a.destination < b.destination; });
+    }
+
+    /**
+     * @brief Set the depth of the route between a source and a destination.
+     * @note Realtime safe. Routes that do not exist are ignored.
+     */
+    void setDepth(size_t source, size_t destination, T depth) {
+        const size_t route = findRoute(source, destination);
+        if (route < routes.size())
+            routes[route].depth = depth;
+    }
+
+    /**
+     * @brief Render all sources and destinations for one block.
+     * @param audioInput Audio fed to analyzer sources (may be nullptr if there are none)
+     * @param numSamples Number of samples (at most the prepared maximum block size)
+     */
+    void process(const T* const* audioInput, size_t numSamples) {
+        assert(numSamples <= maxBlockSize && "Block larger than the prepared maximum block size");
+        numSamples = std::min(numSamples, maxBlockSize);
+        const auto& kernels = getSimdKernels<T>();
+
+        // Render every source once
+        for (size_t s = 0; s < sources.size(); ++s) {
+            if (sources[s].object == nullptr)
+                continue;
+            assert((!sources[s].isAnalyzer || audioInput != nullptr) && "Analyzer sources need audio input");
+            sources[s].render(sources[s].object, audioInput, sourceWritePtrs + s * numChannels, numSamples);
+        }
+
+        // Destinations: base value plus depth-scaled sources
+        for (size_t d = 0; d < destinations.size(); ++d) {
+            T* const* dest = destinationWritePtrs + d * numChannels;
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                std::fill(dest[ch], dest[ch] + numSamples, destinations[d]);
+        }
+        for (const Route& route : routes) {
+            const T* const* src = getSource(route.source);
+            T* const* dest = destinationWritePtrs + route.destination * numChannels;
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                kernels.scaledAdd(src[ch], dest[ch], route.depth, numSamples);
+        }
+    }
+
+    /// Render a block without analyzer sources
+    void process(size_t numSamples) { process(nullptr, numSamples); }
+
+    /// Get the per-channel buffers of a destination (valid after @ref process)
+    const T* const* getDestination(size_t destination) const {
+        assert(destination < destinations.size() && "Destination index out of bounds");
+        return destinationReadPtrs + destination * numChannels;
+    }
+
+    /// Get the per-channel buffers of a source (valid after @ref process)
+    const T* const* getSource(size_t source) const {
+        assert(source < sources.size() && "Source index out of bounds");
+        return sources[source].object == nullptr ? sources[source].external : sourceReadPtrs + source * numChannels;
+    }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+    /// Get maximum block size
+    size_t getMaxBlockSize() const { return maxBlockSize; }
+    /// Get number of sources
+    size_t getNumSources() const { return sources.size(); }
+    /// Get number of destinations
+    size_t getNumDestinations() const { return destinations.size(); }
+    /// Get number of routes
+    size_t getNumRoutes() const { return routes.size(); }
+    /// Check if prepared
+    bool isPrepared() const { return togglePrepared; }
+
+    /// Append the destination base values and route depths to a state snapshot (sources save their own state)
+    void saveState(StateBlob& blob) const {
+        blob.write(destinations);
+        blob.write(routes);
+    }
+
+    /// Restore the destination base values and route depths from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(destinations);
+        reader.read(routes);
+    }
+
+  private:
+    struct SourceSlot {
+        void* object = nullptr; // nullptr for external sources
+        void (*render)(void*, const T* const*, T* const*, size_t) = nullptr;
+        const T* const* external = nullptr;
+        bool isAnalyzer = false;
+    };
+
+    struct Route {
+        size_t source;
+        size_t destination;
+        T depth;
+    };
+
+    bool togglePrepared = false;
+    size_t numChannels = 0;
+    size_t maxBlockSize = 0;
+
+    std::vector<SourceSlot> sources;
+    std::vector<T> destinations; // Base value per destination
+    std::vector<Route> routes;
+
+    // Rendered sources and destinations, one row per [index * numChannels + ch]
+    AudioBuffer<T> sourceBuffer;
+    AudioBuffer<T> destinationBuffer;
+    const T* const* sourceReadPtrs = nullptr;
+    T* const* sourceWritePtrs = nullptr;
+    const T* const* destinationReadPtrs = nullptr;
+    T* const* destinationWritePtrs = nullptr;
+
+    size_t appendSource(const SourceSlot& slot) {
+        sources.push_back(slot);
+        sourceBuffer.resize(sources.size() * numChannels, maxBlockSize);
+        sourceReadPtrs = sourceBuffer.readPtrs();
+        sourceWritePtrs = sourceBuffer.writePtrs();
+        return sources.size() - 1;
+    }
+
+    size_t findRoute(size_t source, size_t destination) const {
+        for (size_t r = 0; r < routes.size(); ++r)
+            if (routes[r].source == source && routes[r].destination == destination)
+                return r;
+        return routes.size();
+    }
+};
+
+} // namespace jnsc
@@ -0,0 +1,30 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Output store policy for replacing or accumulating block processing
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace jnsc {
+
+/**
+ * @brief How a block processor stores its result.
+ * @details `Replace` writes `output = y` (processBlock). `Add` accumulates `output += gain * y` into an existing
+ *          bus (processBlockAdding), so that send/return topologies skip rendering into a scratch buffer and
+ *          summing it afterwards.
+ */
+enum class OutputMode { Replace, Add };
+
+namespace detail {
+/// Store one processed sample according to the output mode (the gain only applies when adding)
+template <OutputMode Mode, typename T>
+inline void storeOutput(T& output, T value, T gain) {
+    if constexpr (Mode == OutputMode::Add) {
+        output += gain * value;
+    } else {
+        (void)gain;
+        output = value;
+    }
+}
+} // namespace detail
+
+} // namespace jnsc
@@ -0,0 +1,152 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Timestamped parameter events for sample-accurate automation within a block
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <type_traits>
+#include <utility>
+
+namespace jnsc {
+
+/**
+ * @brief Parameter change scheduled at a sample offset within the next processed block.
+ * @note Events passed to a processor must be sorted by @ref sampleOffset.
+ */
+struct ParamEvent {
+    size_t sampleOffset = 0;    // Offset within the block where the change takes effect
+    uint32_t paramId = 0;       // Processor-specific id (the processor's `Param` enum value)
+    double value = 0.0;         // New value, in the units of the matching setter
+    bool skipSmoothing = false; // Jump to the value instead of smoothing towards it
+};
+
+/// Default minimum sub-block length when splitting a block at event offsets (bounds per-split overhead)
+constexpr size_t PARAM_EVENT_MIN_SUB_BLOCK_SIZE = 16;
+
+namespace detail {
+/// Detects `beginParamUpdate()` / `endParamUpdate()` (coalesced coefficient recomputation)
+template <typename P, typename = void>
+struct HasParamUpdateScope : std::false_type {};
+template <typename P>
+struct HasParamUpdateScope<P,
+                           std::void_t<decltype(std::declval<P&>().beginParamUpdate()),
+                                       decltype(std::declval<P&>().endParamUpdate())>> : std::true_type {};
+
+/**
+ * @brief Apply a group of events that take effect at the same sample.
+ * @details Only the last event per parameter is applied, and processors with an update scope recompute
+ *          derived state (e.g., filter coefficients) once for the whole group.
+ */
+template <typename T, typename P>
+void applyParamEventGroup(P& processor, const ParamEvent* events, size_t numEvents) {
+    if constexpr (HasParamUpdateScope<P>::value)
+        processor.beginParamUpdate();
+    for (size_t i = 0; i < numEvents; ++i) {
+        const auto superseded = std::any_of(
+            events + i + 1, events + numEvents, [&](const ParamEvent& e) { return e.paramId == events[i].paramId; });
+        if (!superseded)
+            processor.setParam(static_cast<typename P::Param>(events[i].paramId),
+                               static_cast<T>(events[i].value),
+                               events[i].skipSmoothing);
+    }
+    if constexpr (HasParamUpdateScope<P>::value)
+        processor.endParamUpdate();
+}
+} // namespace detail
+
+/**
+ * @brief Split a block at event offsets and apply the events between sub-blocks.
+ * @details Events closer than @p minSubBlockSize to the previous split are deferred to the next split and
+ *          applied together with any other events due by then. Events at or beyond @p numSamples are applied
+ *          after the last sub-block.
+ * @tparam T Sample type
+ * @param processor Processor with `setParam(P::Param, T, bool)` and optionally `beginParamUpdate()`/`endParamUpdate()`
+ * @param numSamples Number of samples in the block
+ * @param events Events sorted by sample offset
+ * @param numEvents Number of events
+ * @param processSubBlock Callback `void(size_t offset, size_t numSamples)` processing one sub-block
+ * @param minSubBlockSize Minimum sub-block length (except for the last sub-block)
+ */
+template <typename T, typename P, typename ProcessSubBlock>
+void splitAtParamEvents(P& processor,
+                        size_t numSamples,
+                        const ParamEvent* events,
+                        size_t numEvents,
+                        ProcessSubBlock&& processSubBlock,
+                        size_t minSubBlockSize = PARAM_EVENT_MIN_SUB_BLOCK_SIZE) {
+    assert(std::is_sorted(events,
+                          events + numEvents,
+                          [](const ParamEvent& a, const ParamEvent& b) { return a.sampleOffset < b.sampleOffset; }) &&
+           "Events must be sorted by sample offset");
+    minSubBlockSize = std::max<size_t>(minSubBlockSize, 1);
+
+    size_t offset = 0;
+    while (offset < numSamples) {
+        // Apply every event due by now as one group
+        size_t due = 0;
+        while (due < numEvents && events[due].sampleOffset <= offset)
+            ++due;
+        if (due > 0) {
+            detail::applyParamEventGroup<T>(processor, events, due);
+            events += due;
+            numEvents -= due;
+        }
+
+        // Run up to the next event, but at least minSubBlockSize samples
+        size_t end = numEvents > 0 ? std::max(events[0].sampleOffset, offset + minSubBlockSize) : numSamples;
+        end = std::min(end, numSamples);
+        processSubBlock(offset, end - offset);
+        offset = end;
+    }
+
+    // Events scheduled past the block take effect from the next block on
+    if (numEvents > 0)
+        detail::applyParamEventGroup<T>(processor, events, numEvents);
+}
+
+/**
+ * @brief Process a block with sample-accurate parameter events (see @ref splitAtParamEvents).
+ * @param processor Processor with `processBlock(input, output, numSamples)` and `setParam`
+ * @param input Input sample pointers (one per channel)
+ * @param output Output sample pointers (one per channel)
+ * @param numChannels Number of channels
+ * @param numSamples Number of samples
+ * @param events Events sorted by sample offset
+ * @param numEvents Number of events
+ * @param inPtrs Sub-block input pointers owned by the processor (sized for @p numChannels in its prepare)
+ * @param outPtrs Sub-block output pointers owned by the processor (sized for @p numChannels in its prepare)
+ * @param minSubBlockSize Minimum sub-block length
+ */
+template <typename T, typename P>
+void processBlockWithParamEvents(P& processor,
+                                 const T* const* input,
+                                 T* const* output,
+                                 size_t numChannels,
+                                 size_t numSamples,
+                                 const ParamEvent* events,
+                                 size_t numEvents,
+                                 OffsetChannelPtrs<const T>& inPtrs,
+                                 OffsetChannelPtrs<T>& outPtrs,
+                                 size_t minSubBlockSize = PARAM_EVENT_MIN_SUB_BLOCK_SIZE) {
+    // Without events this is a plain processBlock call
+    if (numEvents == 0) {
+        processor.processBlock(input, output, numSamples);
+        return;
+    }
+    splitAtParamEvents<T>(
+        processor,
+        numSamples,
+        events,
+        numEvents,
+        [&](size_t offset, size_t len) {
+            processor.processBlock(
+                inPtrs.advance(input, numChannels, offset), outPtrs.advance(output, numChannels, offset), len);
+        },
+        minSubBlockSize);
+}
+
+} // namespace jnsc
@@ -0,0 +1,300 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Runtime-armed probe taps on intermediate signals with lock-free snapshot frames
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <jonssonic/utils/detail/config_utils.h>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace jnsc {
+
+/// How an armed probe fills its frames
+enum class ProbeMode {
+    Decimated, /**< Continuous: every decimation-th sample, frame after frame */
+    Triggered  /**< Each frame starts where the trigger channel crosses the trigger level upwards */
+};
+
+/// Capture settings of a @ref ProbePoint
+template <typename T>
+struct ProbeSettings {
+    ProbeMode mode = ProbeMode::Decimated;
+    size_t frameSize = 512;    // Samples per frame and channel (clamped to the prepared maximum)
+    size_t decimation = 1;     // Keep one sample out of this many
+    size_t firstChannel = 0;   // First captured channel
+    size_t numChannels = 1;    // Captured channels (clamped to MAX_CHANNELS)
+    T triggerLevel = T(0);     // Level crossed upwards to start a triggered frame
+    size_t triggerChannel = 0; // Channel watched by the trigger
+};
+
+/// A snapshot read from a @ref ProbePoint
+template <typename T>
+struct ProbeFrame {
+    std::vector<std::vector<T>> samples; // [channel][sample]
+    uint64_t number = 0;                 // Frame number (1 for the first frame after arming, 0 if none read yet)
+    uint64_t startSample = 0;            // Position of the first sample in the probed stream since arming
+    size_t decimation = 1;               // Spacing of the samples in the probed stream
+};
+
+/**
+ * @brief Tap on an intermediate signal that copies snapshots for visualization and debugging when armed.
+ * @details Processors call @ref tap on their intermediate buffers at every block. While disarmed, that costs one
+ *          atomic load and a predictable branch. While armed, the tap copies decimated or triggered frames into a
+ *          small ring of slots. Each slot is guarded by a sequence counter (odd while being written), so
+ *          @ref readLatest on another thread gets the newest complete frame without locking and detects the rare
+ *          case of the audio thread overwriting the slot while it is being copied.
+ * @tparam T Sample type
+ * @note Thread roles: @ref tap on the audio thread; @ref arm, @ref disarm and @ref readLatest on one other thread.
+ *       @ref prepare allocates and must not run concurrently with either.
+ */
+template <typename T>
+class ProbePoint {
+  public:
+    /// Frames kept (the reader gets the newest complete one)
+    static constexpr size_t NUM_SLOTS = 4;
+
+    /// Maximum channels captured at once
+    static constexpr size_t MAX_CHANNELS = 8;
+
+    /// Maximum frame size used by processors that do not choose one
+    static constexpr size_t DEFAULT_MAX_FRAME_SIZE = 512;
+
+    /// Default constructor
+    ProbePoint() = default;
+
+    /// Default destructor
+    ~ProbePoint() = default;
+
+    /// No copy nor move semantics
+    ProbePoint(const ProbePoint&) = delete;
+    ProbePoint& operator=(const ProbePoint&) = delete;
+    ProbePoint(ProbePoint&&) = delete;
+    ProbePoint& operator=(ProbePoint&&) = delete;
+
+    /**
+     * @brief Allocate the frame slots (disarms the probe).
+     * @param newNumChannels Channels of the probed signal
+     * @param newMaxFrameSize Largest frame size that can be armed
+     */
+    void prepare(size_t newNumChannels, size_t newMaxFrameSize = DEFAULT_MAX_FRAME_SIZE) {
+        armed.store(false, std::memory_order_relaxed);
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        storedChannels = std::min(numChannels, MAX_CHANNELS);
+        maxFrameSize = std::max<size_t>(newMaxFrameSize, 1);
+        data = std::make_unique<std::atomic<T>[]>(NUM_SLOTS * storedChannels * maxFrameSize);
+        for (auto& slot : slots)
+            slot.sequence.store(0, std::memory_order_relaxed);
+        published.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Start capturing (control thread). Frame numbering restarts at 1.
+     * @param newSettings Capture settings
+     */
+    void arm(const ProbeSettings<T>& newSettings) {
+        if (!data)
+            return;
+        ProbeSettings<T> s = newSettings;
+        s.numChannels = std::clamp<size_t>(s.numChannels, 1, storedChannels);
+        s.firstChannel = std::min(s.firstChannel, numChannels - s.numChannels);
+        s.frameSize = std::clamp<size_t>(s.frameSize, 1, maxFrameSize);
+        s.decimation = std::max<size_t>(s.decimation, 1);
+        s.triggerChannel = std::min(s.triggerChannel, numChannels - 1);
+
+        // The audio thread only picks up the new settings after this store and stops reading them before arming
+        armed.store(false, std::memory_order_seq_cst);
+        while (tapping.load(std::memory_order_seq_cst))
+            ; // A block being captured finishes in bounded time
+        settings = s;
+        published.store(0, std::memory_order_relaxed);
+        restart.store(true, std::memory_order_relaxed);
+        armed.store(true, std::memory_order_release);
+    }
+
+    /// Stop capturing (any thread); frames already published stay readable
+    void disarm() { armed.store(false, std::memory_order_relaxed); }
+
+    /// True while the probe captures
+    bool isArmed() const { return armed.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Offer a block of the probed signal (audio thread).
+     * @param signal Channel pointers of the probed signal (channels chBegin to chEnd - 1 are read)
+     * @param numSamples Number of samples
+     * @param chBegin First channel present in @p signal (for processors working on channel ranges)
+     * @param chEnd One past the last channel present in @p signal
+     * @note A range that does not hold every captured channel (and the trigger channel when triggered) is ignored
+     *       and does not advance the stream position, so a processor can offer each channel group of a block in turn.
+     */
+    void tap(const T* const* signal,
+             size_t numSamples,
+             size_t chBegin = 0,
+             size_t chEnd = std::numeric_limits<size_t>::max()) {
+        if (!armed.load(std::memory_order_acquire))
+            return;
+        tapping.store(true, std::memory_order_seq_cst);
+        if (armed.load(std::memory_order_seq_cst))
+            capture(signal, numSamples, chBegin, chEnd);
+        tapping.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the newest complete frame if it is newer than @p frame (reader thread).
+     * @param frame Destination; its number tells which frame was read last
+     * @return True if a newer frame was copied
+     */
+    bool readLatest(ProbeFrame<T>& frame) const {
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            const uint64_t number = published.load(std::memory_order_acquire);
+            if (number == 0 || number == frame.number)
+                return false;
+            const Slot& slot = slots[(number - 1) % NUM_SLOTS];
+            const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before % 2 != 0 || slot.number.load(std::memory_order_relaxed) != number)
+                continue; // Being rewritten already, try the newer frame
+
+            const size_t channels = slot.numChannels.load(std::memory_order_relaxed);
+            const size_t size = slot.frameSize.load(std::memory_order_relaxed);
+            frame.samples.resize(channels);
+            for (size_t ch = 0; ch < channels; ++ch) {
+                frame.samples[ch].resize(size);
+                const std::atomic<T>* src = slotData((number - 1) % NUM_SLOTS, ch);
+                for (size_t n = 0; n < size; ++n)
+                    frame.samples[ch][n] = src[n].load(std::memory_order_relaxed);
+            }
+            const uint64_t startSample = slot.startSample.load(std::memory_order_relaxed);
+            const size_t decimation = slot.decimation.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != before)
+                continue; // Overwritten while copying
+            frame.number = number;
+            frame.startSample = startSample;
+            frame.decimation = decimation;
+            return true;
+        }
+        return false;
+    }
+
+    /// Number of frames published since arming (any thread)
+    uint64_t getNumFrames() const { return published.load(std::memory_order_acquire); }
+
+    /// Channels of the probed signal
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Largest frame size that can be armed
+    size_t getMaxFrameSize() const { return maxFrameSize; }
+
+  private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0}; // Odd while the audio thread writes the slot
+        std::atomic<uint64_t> number{0};
+        std::atomic<uint64_t> startSample{0};
+        std::atomic<size_t> numChannels{0};
+        std::atomic<size_t> frameSize{0};
+        std::atomic<size_t> decimation{1};
+    };
+
+    size_t numChannels = 0;
+    size_t storedChannels = 0;
+    size_t maxFrameSize = 0;
+    std::unique_ptr<std::atomic<T>[]> data; // [slot][channel][sample]
+    std::array<Slot, NUM_SLOTS> slots;
+    std::atomic<uint64_t> published{0};
+    std::atomic<bool> armed{false};
+    std::atomic<bool> tapping{false};
+    std::atomic<bool> restart{false};
+    ProbeSettings<T> settings; // Written by arm while the audio thread is not capturing
+
+    // Capture state (audio thread)
+    uint64_t streamPos = 0;     // Samples offered since arming
+    uint64_t frameNumber = 0;   // Number of the frame being written (0 if none)
+    size_t fill = 0;            // Samples written into the current frame
+    size_t decimationPhase = 0; // Samples to skip before the next kept one
+    T lastTrigger = T(0);
+    bool triggerPrimed = false; // True once the trigger channel was below the level
+
+    std::atomic<T>* slotData(size_t slot, size_t ch) const {
+        return data.get() + (slot * storedChannels + ch) * maxFrameSize;
+    }
+
+    void capture(const T* const* signal, size_t numSamples, size_t chBegin, size_t chEnd) {
+        const ProbeSettings<T>& s = settings;
+        if (restart.exchange(false, std::memory_order_acquire)) {
+            abandonFrame();
+            streamPos = 0;
+            frameNumber = 0;
+            decimationPhase = 0;
+            triggerPrimed = false;
+        }
+        const bool triggered = s.mode == ProbeMode::Triggered;
+        const size_t firstChannel = triggered ? std::min(s.firstChannel, s.triggerChannel) : s.firstChannel;
+        const size_t lastChannel =
+            triggered ? std::max(s.firstChannel + s.numChannels, s.triggerChannel + 1) : s.firstChannel + s.numChannels;
+        if (chBegin > firstChannel || chEnd < lastChannel)
+            return;
+
+        for (size_t n = 0; n < numSamples; ++n, ++streamPos) {
+            if (fill == 0 && s.mode == ProbeMode::Triggered) {
+                const T x = signal[s.triggerChannel][n];
+                const bool crossed = triggerPrimed && lastTrigger < s.triggerLevel && x >= s.triggerLevel;
+                triggerPrimed = triggerPrimed || x < s.triggerLevel;
+                lastTrigger = x;
+                if (!crossed)
+                    continue;
+                decimationPhase = 0;
+            }
+            if (decimationPhase > 0) {
+                --decimationPhase;
+                continue;
+            }
+            decimationPhase = s.decimation - 1;
+
+            if (fill == 0)
+                beginFrame(s);
+            const size_t slot = (frameNumber - 1) % NUM_SLOTS;
+            for (size_t c = 0; c < s.numChannels; ++c)
+                slotData(slot, c)[fill].store(signal[s.firstChannel + c][n], std::memory_order_relaxed);
+            if (++fill == s.frameSize)
+                endFrame();
+        }
+    }
+
+    void beginFrame(const ProbeSettings<T>& s) {
+        ++frameNumber;
+        Slot& slot = slots[(frameNumber - 1) % NUM_SLOTS];
+        slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.number.store(frameNumber, std::memory_order_relaxed);
+        slot.startSample.store(streamPos, std::memory_order_relaxed);
+        slot.numChannels.store(s.numChannels, std::memory_order_relaxed);
+        slot.frameSize.store(s.frameSize, std::memory_order_relaxed);
+        slot.decimation.store(s.decimation, std::memory_order_relaxed);
+    }
+
+    void endFrame() {
+        Slot& slot = slots[(frameNumber - 1) % NUM_SLOTS];
+        slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        published.store(frameNumber, std::memory_order_release);
+        fill = 0;
+        if (settings.mode == ProbeMode::Triggered)
+            triggerPrimed = false; // Wait for the signal to fall below the level again
+    }
+
+    // Close a partly written frame without publishing it
+    void abandonFrame() {
+        if (fill == 0)
+            return;
+        Slot& slot = slots[(frameNumber - 1) % NUM_SLOTS];
+        slot.number.store(0, std::memory_order_relaxed);
+        slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        fill = 0;
+    }
+};
+
+} // namespace jnsc
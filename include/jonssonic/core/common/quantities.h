@@ -4,6 +4,7 @@
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cassert>
+#include <jonssonic/core/common/simd_pack.h>
 #include <jonssonic/utils/math_utils.h>
 #include <limits>
 
@@ -30,9 +31,18 @@ struct Time {
     TimeUnit unit;
 
     /// Factory methods for creating Time instances with specific units
-    static Time Samples(T v) { return Time(std::max(v, T(0)), TimeUnit::Samples); }
-    static Time Milliseconds(T v) { return Time(std::max(v, T(0)), TimeUnit::Milliseconds); }
-    static Time Seconds(T v) { return Time(std::max(v, T(0)), TimeUnit::Seconds); }
+    static Time Samples(T v) {
+        using std::max;
+        return Time(max(v, T(0)), TimeUnit::Samples);
+    }
+    static Time Milliseconds(T v) {
+        using std::max;
+        return Time(max(v, T(0)), TimeUnit::Milliseconds);
+    }
+    static Time Seconds(T v) {
+        using std::max;
+        return Time(max(v, T(0)), TimeUnit::Seconds);
+    }
 
     /// Convert time to samples given a sample rate
     T toSamples(T sampleRate) const {
@@ -50,7 +60,7 @@ struct Time {
     }
     /// Convert time to seconds given a sample rate
     T toSeconds(T sampleRate) const {
-        assert(sampleRate > T(0) && "Sample rate must be positive");
+        assert(allOf(sampleRate > T(0)) && "Sample rate must be positive");
         switch (unit) {
         case TimeUnit::Samples:
             return value * T(1) / sampleRate;
@@ -66,7 +76,7 @@ struct Time {
 
     /// Convert time to milliseconds given a sample rate
     T toMilliseconds(T sampleRate) const {
-        assert(sampleRate > T(0) && "Sample rate must be positive");
+        assert(allOf(sampleRate > T(0)) && "Sample rate must be positive");
         switch (unit) {
         case TimeUnit::Samples:
             return value * T(1000) * T(1) / sampleRate;
@@ -117,7 +127,7 @@ struct Frequency {
     }
     /// Convert frequency to normalized (0..0.5) given a sample rate
     T toNormalized(T sampleRate) const {
-        assert(sampleRate > T(0) && "Sample rate must be positive");
+        assert(allOf(sampleRate > T(0)) && "Sample rate must be positive");
         switch (unit) {
         case FrequencyUnit::Hertz:
             return value * T(1) / sampleRate;
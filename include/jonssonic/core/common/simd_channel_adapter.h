@@ -0,0 +1,148 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Adapter transposing planar channel buffers into SIMD packs and back
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include "jonssonic/utils/detail/config_utils.h"
+#include <cassert>
+#include <cstddef>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/simd_pack.h>
+
+namespace jnsc {
+
+/**
+ * @brief Transposes planar channel buffers into @ref SimdPack buffers and back.
+ * @details Channels are grouped N at a time: lane `l` of pack `p` holds channel `p * N + l`. A processor
+ *          instantiated with `SimdPack<T, N>` and prepared for @ref getNumPacks channels then processes all
+ *          channels of a group in one call. Lanes past the last channel are zero-filled and dropped on unpack.
+ * @tparam T Lane type (float, double)
+ * @tparam N Number of lanes per pack
+ */
+template <typename T, size_t N>
+class SimdChannelAdapter {
+  public:
+    /// Pack type processors should be instantiated with
+    using Pack = SimdPack<T, N>;
+
+    /// Default constructor
+    SimdChannelAdapter() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumChannels Number of planar channels
+     * @param newMaxBlockSize Maximum block size in samples
+     */
+    SimdChannelAdapter(size_t newNumChannels, size_t newMaxBlockSize) { prepare(newNumChannels, newMaxBlockSize); }
+
+    /// Default destructor
+    ~SimdChannelAdapter() = default;
+
+    /// No copy nor move semantics
+    SimdChannelAdapter(const SimdChannelAdapter&) = delete;
+    SimdChannelAdapter& operator=(const SimdChannelAdapter&) = delete;
+    SimdChannelAdapter(SimdChannelAdapter&&) = delete;
+    SimdChannelAdapter& operator=(SimdChannelAdapter&&) = delete;
+
+    /**
+     * @brief Prepare the adapter (allocates the pack buffer).
+     * @param newNumChannels Number of planar channels
+     * @param newMaxBlockSize Maximum block size in samples
+     */
+    void prepare(size_t newNumChannels, size_t newMaxBlockSize) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        maxBlockSize = newMaxBlockSize;
+        packs.resize(getNumPacksFor(numChannels), maxBlockSize);
+        packs.readPtrs();
+        packs.writePtrs();
+        togglePrepared = true;
+    }
+
+    /// Clear the pack buffer
+    void reset() { packs.clear(); }
+
+    /**
+     * @brief Transpose planar input into the pack buffer.
+     * @param input Input sample pointers (one per channel)
+     * @param numSamples Number of samples (at most the prepared maximum block size)
+     */
+    void pack(const T* const* input, size_t numSamples) {
+        assert(numSamples <= maxBlockSize && "Block size exceeds prepared maximum");
+        for (size_t p = 0; p < packs.getNumChannels(); ++p) {
+            Pack* packed = packs.writeChannelPtr(p);
+            for (size_t lane = 0; lane < N; ++lane) {
+                size_t ch = p * N + lane;
+                if (ch < numChannels)
+                    for (size_t n = 0; n < numSamples; ++n)
+                        packed[n][lane] = input[ch][n];
+                else
+                    for (size_t n = 0; n < numSamples; ++n)
+                        packed[n][lane] = T(0);
+            }
+        }
+    }
+
+    /**
+     * @brief Transpose the pack buffer back into planar output.
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples (at most the prepared maximum block size)
+     */
+    void unpack(T* const* output, size_t numSamples) const {
+        assert(numSamples <= maxBlockSize && "Block size exceeds prepared maximum");
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const Pack* packed = packs.readChannelPtr(ch / N);
+            const size_t lane = ch % N;
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] = packed[n][lane];
+        }
+    }
+
+    /**
+     * @brief Process planar buffers with a pack-instantiated processor.
+     * @param processor Processor providing `processSample(ch, x)` for `Pack` samples, prepared for
+     *        @ref getNumPacks channels (e.g., EnvelopeFollower<Pack, EnvelopeType::Peak>)
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples (at most the prepared maximum block size)
+     * @note Input and output may alias.
+     */
+    template <typename Processor>
+    void processBlock(Processor& processor, const T* const* input, T* const* output, size_t numSamples) {
+        pack(input, numSamples);
+        for (size_t p = 0; p < packs.getNumChannels(); ++p) {
+            Pack* packed = packs.writeChannelPtr(p);
+            for (size_t n = 0; n < numSamples; ++n)
+                packed[n] = processor.processSample(p, packed[n]);
+        }
+        unpack(output, numSamples);
+    }
+
+    /// Get read pointers to the pack buffer (one per pack)
+    const Pack* const* readPackPtrs() const { return packs.readPtrs(); }
+
+    /// Get write pointers to the pack buffer (one per pack)
+    Pack* const* writePackPtrs() { return packs.writePtrs(); }
+
+    /// Number of packs needed to hold a number of channels
+    static constexpr size_t getNumPacksFor(size_t channels) { return (channels + N - 1) / N; }
+
+    /// Get number of planar channels
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Get number of packs (channels of the pack-instantiated processor)
+    size_t getNumPacks() const { return packs.getNumChannels(); }
+
+    /// Get maximum block size
+    size_t getMaxBlockSize() const { return maxBlockSize; }
+
+    /// Check if prepared
+    bool isPrepared() const { return togglePrepared; }
+
+  private:
+    bool togglePrepared = false;
+    size_t numChannels = 0;
+    size_t maxBlockSize = 0;
+    AudioBuffer<Pack> packs;
+};
+
+} // namespace jnsc
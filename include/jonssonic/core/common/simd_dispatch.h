@@ -0,0 +1,180 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Runtime instruction set dispatch for hot block kernels
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <jonssonic/core/common/detail/cpu_features.h>
+#include <jonssonic/core/common/detail/simd_kernels.h>
+
+namespace jnsc {
+
+/// Instruction set levels with a dedicated kernel build
+enum class SimdIsa {
+    Baseline, /**< Whatever the library is compiled for (SSE2 on x86-64, NEON on AArch64); reference path */
+    AVX2,     /**< x86 AVX2 */
+    AVX512    /**< x86 AVX-512F */
+};
+
+/**
+ * @brief Table of block kernels built for one instruction set.
+ * @tparam T Sample type (float, double)
+ * @note All builds produce bit-identical results; only the instructions differ.
+ */
+template <typename T>
+struct SimdKernelTable {
+    /// Planar channels -> interleaved frames
+    void (*interleave)(const T* const* planar, T* frames, size_t numChannels, size_t numSamples);
+    /// Interleaved frames -> planar channels
+    void (*deinterleave)(const T* frames, T* const* planar, size_t numChannels, size_t numSamples);
+    /// Cascaded DF2T biquads over interleaved frames (coeffs: [section][b0 b1 b2 a1 a2][ch], state: [section][s1 s2][ch])
+    void (*biquadBank)(
+        T* frames, size_t numChannels, size_t numFrames, size_t numSections, const T* coeffs, T* state);
+    /// Symmetric halfband FIR branch (x is preceded by span samples of history)
+    void (*halfbandFir)(const T* x, T* y, size_t numSamples, const T* coeffs, size_t numCoeffs, size_t span);
+    /// Hard clip to [-1, 1]
+    void (*hardClip)(const T* input, T* output, size_t numSamples);
+    /// Cubic soft clip
+    void (*cubicClip)(const T* input, T* output, size_t numSamples);
+    /// Scaled accumulate: output += gain * input (input and output must not overlap)
+    void (*scaledAdd)(const T* input, T* output, T gain, size_t numSamples);
+    /// Scaled copy: output = gain * input (output may alias input)
+    void (*scale)(const T* input, T* output, T gain, size_t numSamples);
+    /// Ramped accumulate: output += (startGain + n * gainStep) * input (input and output must not overlap)
+    void (*rampedAdd)(const T* input, T* output, T startGain, T gainStep, size_t numSamples);
+    /// Weighted sum: output = gainA * a + gainB * b (output may alias a or b)
+    void (*blend)(const T* a, T gainA, const T* b, T gainB, T* output, size_t numSamples);
+    /// Weighted sum with per-sample gains: output = gainA[n] * a + gainB[n] * b (output may alias a or b)
+    void (*blendCurves)(const T* a, const T* gainA, const T* b, const T* gainB, T* output, size_t numSamples);
+};
+
+namespace detail {
+template <typename T, template <typename> class Kernels>
+constexpr SimdKernelTable<T> makeKernelTable() {
+    return {&Kernels<T>::interleave,
+            &Kernels<T>::deinterleave,
+            &Kernels<T>::biquadBank,
+            &Kernels<T>::halfbandFir,
+            &Kernels<T>::hardClip,
+            &Kernels<T>::cubicClip,
+            &Kernels<T>::scaledAdd,
+            &Kernels<T>::scale,
+            &Kernels<T>::rampedAdd,
+            &Kernels<T>::blend,
+            &Kernels<T>::blendCurves};
+}
+
+/// Best instruction set with a kernel build that this CPU can run
+inline SimdIsa detectSimdIsa() {
+#if defined(JONSSONIC_SIMD_DISPATCH)
+    const CpuFeatures features = queryCpuFeatures();
+    if (features.avx512f)
+        return SimdIsa::AVX512;
+    if (features.avx2)
+        return SimdIsa::AVX2;
+#endif
+    return SimdIsa::Baseline;
+}
+
+/// Parse an instruction set name ("baseline", "avx2", "avx512"); returns false if unknown
+inline bool parseSimdIsa(const char* name, SimdIsa& isa) {
+    if (name == nullptr)
+        return false;
+    if (std::strcmp(name, "baseline") == 0)
+        isa = SimdIsa::Baseline;
+    else if (std::strcmp(name, "avx2") == 0)
+        isa = SimdIsa::AVX2;
+    else if (std::strcmp(name, "avx512") == 0)
+        isa = SimdIsa::AVX512;
+    else
+        return false;
+    return true;
+}
+
+/// Forced instruction set (-1 if none). Initialized from the JONSSONIC_FORCE_ISA environment variable.
+inline std::atomic<int>& forcedSimdIsa() {
+    static std::atomic<int> forced{[] {
+        SimdIsa isa;
+        return parseSimdIsa(std::getenv("JONSSONIC_FORCE_ISA"), isa) ? static_cast<int>(isa) : -1;
+    }()};
+    return forced;
+}
+} // namespace detail
+
+/// Instruction set detected on this CPU (queried once with cpuid)
+inline SimdIsa getDetectedSimdIsa() {
+    static const SimdIsa detected = detail::detectSimdIsa();
+    return detected;
+}
+
+/**
+ * @brief Instruction set the kernels currently dispatch to.
+ * @return The forced instruction set if one is set (capped at what the CPU supports), otherwise the detected one.
+ */
+inline SimdIsa getSimdIsa() {
+    const int forced = detail::forcedSimdIsa().load(std::memory_order_relaxed);
+    const SimdIsa detected = getDetectedSimdIsa();
+    if (forced >= 0 && forced < static_cast<int>(detected))
+        return static_cast<SimdIsa>(forced);
+    return detected;
+}
+
+/**
+ * @brief Force the kernels to a specific instruction set (for testing and A/B comparisons).
+ * @param isa Instruction set. Levels above what the CPU supports fall back to the detected level.
+ * @note Can also be set with the environment variable JONSSONIC_FORCE_ISA=baseline|avx2|avx512.
+ */
+inline void setForcedSimdIsa(SimdIsa isa) {
+    detail::forcedSimdIsa().store(static_cast<int>(isa), std::memory_order_relaxed);
+}
+
+/// Remove a forced instruction set and dispatch to the detected one again
+inline void clearForcedSimdIsa() { detail::forcedSimdIsa().store(-1, std::memory_order_relaxed); }
+
+/// Get the name of an instruction set
+inline const char* getSimdIsaName(SimdIsa isa) {
+    switch (isa) {
+    case SimdIsa::AVX2:
+        return "avx2";
+    case SimdIsa::AVX512:
+        return "avx512";
+    default:
+        return "baseline";
+    }
+}
+
+/**
+ * @brief Get the kernel table of a specific instruction set.
+ * @param isa Instruction set (the caller must make sure the CPU supports it)
+ * @note Instruction sets without a build on this compiler/architecture return the baseline table.
+ */
+template <typename T>
+const SimdKernelTable<T>& getSimdKernels(SimdIsa isa) {
+    static constexpr SimdKernelTable<T> baseline = detail::makeKernelTable<T, detail::BaselineKernels>();
+#if defined(JONSSONIC_SIMD_DISPATCH)
+    static constexpr SimdKernelTable<T> avx2 = detail::makeKernelTable<T, detail::Avx2Kernels>();
+    static constexpr SimdKernelTable<T> avx512 = detail::makeKernelTable<T, detail::Avx512Kernels>();
+    switch (isa) {
+    case SimdIsa::AVX2:
+        return avx2;
+    case SimdIsa::AVX512:
+        return avx512;
+    default:
+        return baseline;
+    }
+#else
+    (void)isa;
+    return baseline;
+#endif
+}
+
+/// Get the kernel table for the current instruction set (see @ref getSimdIsa)
+template <typename T>
+const SimdKernelTable<T>& getSimdKernels() {
+    return getSimdKernels<T>(getSimdIsa());
+}
+
+} // namespace jnsc
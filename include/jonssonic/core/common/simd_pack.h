@@ -0,0 +1,257 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Portable SIMD pack type for running scalar-written processors on several channels at once
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace jnsc {
+
+/**
+ * @brief Fixed-size pack of samples processed in lockstep, usable as the sample type `T` of processors.
+ * @details Each lane holds one channel. Arithmetic, comparisons and the math functions used in the library
+ *          operate lane-wise, so scalar-written processors (e.g., DF2TBiquadTopology, TPTSVFTopology,
+ *          EnvelopeFollower, WaveShaper, SmoothedValue) can be instantiated with `SimdPack<float, 4>` to process
+ *          four channels per call. The storage is aligned to the pack size and the lane loops have a fixed trip
+ *          count, which compilers turn into vector instructions (SSE/AVX/NEON) without intrinsics.
+ *
+ *          Comparisons return numeric masks (1 or 0 per lane) rather than bool, so branch-free code like
+ *          `static_cast<T>(a > b)` works on packs. Code that branches on a comparison does not compile for packs;
+ *          use @ref select instead. Math functions are found through argument-dependent lookup, so generic code
+ *          should call them unqualified after `using std::exp;` etc.
+ * @tparam T Lane type (float, double)
+ * @tparam N Number of lanes (power of two)
+ * @note Use @ref SimdChannelAdapter to transpose planar channel buffers into packs and back.
+ */
+template <typename T, size_t N>
+struct SimdPack {
+    static_assert(std::is_floating_point<T>::value, "T must be a floating-point type");
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+    /// Lane type
+    using value_type = T;
+
+    /// Number of lanes
+    static constexpr size_t SIZE = N;
+
+    /// Zero-initialized pack
+    constexpr SimdPack() = default;
+
+    /**
+     * @brief Broadcast a scalar to all lanes.
+     * @param value Scalar value (implicit, so scalar constants mix with packs in expressions)
+     */
+    template <typename S, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+    constexpr SimdPack(S value) {
+        for (size_t i = 0; i < N; ++i)
+            lanes[i] = static_cast<T>(value);
+    }
+
+    /// Load N consecutive values
+    static SimdPack load(const T* source) {
+        SimdPack r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = source[i];
+        return r;
+    }
+
+    /// Store N consecutive values
+    void store(T* destination) const {
+        for (size_t i = 0; i < N; ++i)
+            destination[i] = lanes[i];
+    }
+
+    /// Lane access
+    constexpr T& operator[](size_t i) { return lanes[i]; }
+    constexpr const T& operator[](size_t i) const { return lanes[i]; }
+
+    // =========================================================================
+    // Arithmetic
+    // =========================================================================
+    friend constexpr SimdPack operator+(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return x + y; });
+    }
+    friend constexpr SimdPack operator-(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return x - y; });
+    }
+    friend constexpr SimdPack operator*(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return x * y; });
+    }
+    friend constexpr SimdPack operator/(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return x / y; });
+    }
+    friend constexpr SimdPack operator-(const SimdPack& a) {
+        return apply(a, [](T x) { return -x; });
+    }
+    friend constexpr SimdPack operator+(const SimdPack& a) { return a; }
+
+    constexpr SimdPack& operator+=(const SimdPack& other) { return *this = *this + other; }
+    constexpr SimdPack& operator-=(const SimdPack& other) { return *this = *this - other; }
+    constexpr SimdPack& operator*=(const SimdPack& other) { return *this = *this * other; }
+    constexpr SimdPack& operator/=(const SimdPack& other) { return *this = *this / other; }
+
+    // =========================================================================
+    // Comparisons (numeric masks: 1 where true, 0 where false)
+    // =========================================================================
+    friend constexpr SimdPack operator<(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return T(x < y); });
+    }
+    friend constexpr SimdPack operator<=(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return T(x <= y); });
+    }
+    friend constexpr SimdPack operator>(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return T(x > y); });
+    }
+    friend constexpr SimdPack operator>=(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return T(x >= y); });
+    }
+    friend constexpr SimdPack operator==(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return T(x == y); });
+    }
+    friend constexpr SimdPack operator!=(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return T(x != y); });
+    }
+
+    // =========================================================================
+    // Lane-wise functions (found through argument-dependent lookup)
+    // =========================================================================
+    friend constexpr SimdPack min(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return y < x ? y : x; });
+    }
+    friend constexpr SimdPack max(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return x < y ? y : x; });
+    }
+    friend constexpr SimdPack clamp(const SimdPack& x, const SimdPack& lo, const SimdPack& hi) {
+        return min(max(x, lo), hi);
+    }
+    /// Lane-wise `mask ? a : b` (mask lanes are nonzero for true)
+    friend constexpr SimdPack select(const SimdPack& mask, const SimdPack& a, const SimdPack& b) {
+        SimdPack r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = mask.lanes[i] != T(0) ? a.lanes[i] : b.lanes[i];
+        return r;
+    }
+    friend SimdPack abs(const SimdPack& a) {
+        return apply(a, [](T x) { return std::abs(x); });
+    }
+    friend SimdPack sqrt(const SimdPack& a) {
+        return apply(a, [](T x) { return std::sqrt(x); });
+    }
+    friend SimdPack exp(const SimdPack& a) {
+        return apply(a, [](T x) { return std::exp(x); });
+    }
+    friend SimdPack log(const SimdPack& a) {
+        return apply(a, [](T x) { return std::log(x); });
+    }
+    friend SimdPack pow(const SimdPack& a, const SimdPack& b) {
+        return apply(a, b, [](T x, T y) { return std::pow(x, y); });
+    }
+    friend SimdPack sin(const SimdPack& a) {
+        return apply(a, [](T x) { return std::sin(x); });
+    }
+    friend SimdPack cos(const SimdPack& a) {
+        return apply(a, [](T x) { return std::cos(x); });
+    }
+    friend SimdPack tan(const SimdPack& a) {
+        return apply(a, [](T x) { return std::tan(x); });
+    }
+    friend SimdPack tanh(const SimdPack& a) {
+        return apply(a, [](T x) { return std::tanh(x); });
+    }
+    friend SimdPack atan(const SimdPack& a) {
+        return apply(a, [](T x) { return std::atan(x); });
+    }
+    friend SimdPack floor(const SimdPack& a) {
+        return apply(a, [](T x) { return std::floor(x); });
+    }
+
+    // =========================================================================
+    // Reductions
+    // =========================================================================
+    /// True if every lane is nonzero
+    friend constexpr bool allOf(const SimdPack& a) {
+        for (size_t i = 0; i < N; ++i)
+            if (a.lanes[i] == T(0))
+                return false;
+        return true;
+    }
+    /// True if any lane is nonzero
+    friend constexpr bool anyOf(const SimdPack& a) {
+        for (size_t i = 0; i < N; ++i)
+            if (a.lanes[i] != T(0))
+                return true;
+        return false;
+    }
+    /// Largest lane value
+    friend constexpr T reduceMax(const SimdPack& a) {
+        T r = a.lanes[0];
+        for (size_t i = 1; i < N; ++i)
+            r = r < a.lanes[i] ? a.lanes[i] : r;
+        return r;
+    }
+
+  private:
+    alignas(sizeof(T) * N) T lanes[N]{};
+
+    template <typename Function>
+    static constexpr SimdPack apply(const SimdPack& a, Function function) {
+        SimdPack r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = function(a.lanes[i]);
+        return r;
+    }
+
+    template <typename Function>
+    static constexpr SimdPack apply(const SimdPack& a, const SimdPack& b, Function function) {
+        SimdPack r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = function(a.lanes[i], b.lanes[i]);
+        return r;
+    }
+};
+
+/// Trait detecting @ref SimdPack types
+template <typename T>
+struct IsSimdPack : std::false_type {};
+
+template <typename T, size_t N>
+struct IsSimdPack<SimdPack<T, N>> : std::true_type {};
+
+// =============================================================================
+// Scalar counterparts of the pack reductions, so generic code can use them for any T
+// =============================================================================
+/// True if the (comparison) result is nonzero
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+constexpr bool allOf(T x) {
+    return x != T(0);
+}
+
+/// True if the (comparison) result is nonzero
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+constexpr bool anyOf(T x) {
+    return x != T(0);
+}
+
+/// Identity for scalars
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+constexpr T reduceMax(T x) {
+    return x;
+}
+
+} // namespace jnsc
+
+namespace std {
+/// Numeric limits of a pack are the limits of its lane type, broadcast to all lanes
+template <typename T, size_t N>
+struct numeric_limits<jnsc::SimdPack<T, N>> : numeric_limits<T> {
+    static constexpr jnsc::SimdPack<T, N> min() noexcept { return std::numeric_limits<T>::min(); }
+    static constexpr jnsc::SimdPack<T, N> max() noexcept { return std::numeric_limits<T>::max(); }
+    static constexpr jnsc::SimdPack<T, N> lowest() noexcept { return std::numeric_limits<T>::lowest(); }
+    static constexpr jnsc::SimdPack<T, N> epsilon() noexcept { return std::numeric_limits<T>::epsilon(); }
+    static constexpr jnsc::SimdPack<T, N> infinity() noexcept { return std::numeric_limits<T>::infinity(); }
+};
+} // namespace std
@@ -0,0 +1,188 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Fixed-size byte blob for processor state snapshots
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <type_traits>
+#include <vector>
+
+namespace jnsc {
+
+/**
+ * @brief Byte blob holding a snapshot of processor state (delay lines, filter memories, smoother positions, ...).
+ * @details Processors provide `saveState(StateBlob&) const`, which appends their state, and
+ *          `restoreState(StateReader&)`, which consumes it in the same order through a @ref StateReader. Composite
+ *          processors save and restore their members in turn, so one blob holds a whole effect:
+ * @code
+ * StateBlob blob;
+ * reverb.saveState(blob.clear()); // allocates on the first save only
+ * ...
+ * StateReader reader(blob);
+ * reverb.restoreState(reader);    // never allocates
+ * if (!reader.ok())
+ *     reverb.reset();             // prepared differently from the snapshot
+ * @endcode
+ *          Arrays are stored with their element count and restored only if the count matches, so restoring into a
+ *          processor prepared with a different layout fails instead of reading garbage.
+ *          The byte size of a snapshot only depends on how the processor was prepared, so a blob sized by one save
+ *          (or by @ref reserve) is reused without allocation by later saves of the same processor.
+ * @note Only trivially copyable values are stored. Snapshots are raw host memory and are not portable across
+ *       builds or platforms.
+ */
+class StateBlob {
+  public:
+    /// Default constructor (empty blob)
+    StateBlob() = default;
+
+    /**
+     * @brief Construct with preallocated storage.
+     * @param numBytes Capacity in bytes
+     */
+    explicit StateBlob(size_t numBytes) { reserve(numBytes); }
+
+    /// Preallocate storage so that saves up to this size do not allocate.
+    void reserve(size_t numBytes) {
+        if (numBytes > bytes.size())
+            bytes.resize(numBytes);
+    }
+
+    /// Discard the contents before a save (keeps the storage).
+    StateBlob& clear() {
+        used = 0;
+        return *this;
+    }
+
+    /// Number of bytes written
+    size_t size() const { return used; }
+
+    /// Preallocated capacity in bytes
+    size_t capacity() const { return bytes.size(); }
+
+    // =========================================================================
+    // Writing (used by saveState)
+    // =========================================================================
+
+    /// Append a single value
+    template <typename V>
+    void write(const V& value) {
+        static_assert(std::is_trivially_copyable_v<V>, "State values must be trivially copyable");
+        append(&value, sizeof(V));
+    }
+
+    /// Append an array, preceded by its element count
+    template <typename V>
+    void write(const V* data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<V>, "State values must be trivially copyable");
+        write(count);
+        append(data, count * sizeof(V));
+    }
+
+    /// Append the contents of a vector
+    template <typename V, typename Alloc>
+    void write(const std::vector<V, Alloc>& values) {
+        write(values.data(), values.size());
+    }
+
+    /// Append the contents of an audio buffer
+    template <typename V>
+    void write(const AudioBuffer<V>& buffer) {
+        write(buffer.getNumChannels());
+        for (size_t ch = 0; ch < buffer.getNumChannels(); ++ch)
+            write(buffer.readChannelPtr(ch), buffer.getNumSamples());
+    }
+
+  private:
+    friend class StateReader;
+
+    std::vector<unsigned char> bytes;
+    size_t used = 0;
+
+    void append(const void* data, size_t numBytes) {
+        if (used + numBytes > bytes.size())
+            bytes.resize(used + numBytes); // First save of a larger layout only
+        if (numBytes > 0)
+            std::memcpy(bytes.data() + used, data, numBytes);
+        used += numBytes;
+    }
+};
+
+/**
+ * @brief Read position in a @ref StateBlob, created for each restore.
+ * @details The blob itself is never modified by reading, so one snapshot can be restored into several processors
+ *          at once (e.g., a warmed-up state into several segment renderers), each with its own reader. After the
+ *          first failed read, all further reads are skipped and @ref ok returns false.
+ * @note The blob must outlive the reader and must not be saved into while it is read.
+ */
+class StateReader {
+  public:
+    /// Start reading a blob from its beginning
+    explicit StateReader(const StateBlob& newBlob) : blob(&newBlob) {}
+
+    /// False after a read that did not match the stored layout or ran past the end
+    bool ok() const { return valid; }
+
+    /// True if a restore consumed exactly the saved bytes
+    bool fullyRead() const { return valid && readPos == blob->used; }
+
+    /// Read a single value (left untouched if the blob is exhausted or invalid)
+    template <typename V>
+    void read(V& value) {
+        static_assert(std::is_trivially_copyable_v<V>, "State values must be trivially copyable");
+        consume(&value, sizeof(V));
+    }
+
+    /// Read an array saved with the same element count
+    template <typename V>
+    void read(V* data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<V>, "State values must be trivially copyable");
+        expect(count);
+        consume(data, count * sizeof(V));
+    }
+
+    /// Read into a vector of the saved size (never resizes)
+    template <typename V, typename Alloc>
+    void read(std::vector<V, Alloc>& values) {
+        read(values.data(), values.size());
+    }
+
+    /// Read into an audio buffer of the saved size (never resizes)
+    template <typename V>
+    void read(AudioBuffer<V>& buffer) {
+        expect(buffer.getNumChannels());
+        for (size_t ch = 0; ch < buffer.getNumChannels(); ++ch)
+            read(buffer.writeChannelPtr(ch), buffer.getNumSamples());
+    }
+
+    /**
+     * @brief Read a value and check it against the current one (e.g., a prepared channel count).
+     * @return True if the saved value matches; otherwise the reader is marked invalid.
+     */
+    template <typename V>
+    bool expect(const V& value) {
+        V saved{};
+        read(saved);
+        if (valid && !(saved == value))
+            valid = false;
+        return valid;
+    }
+
+  private:
+    const StateBlob* blob;
+    size_t readPos = 0;
+    bool valid = true;
+
+    void consume(void* data, size_t numBytes) {
+        if (!valid || readPos + numBytes > blob->used) {
+            valid = false;
+            return;
+        }
+        if (numBytes > 0)
+            std::memcpy(data, blob->bytes.data() + readPos, numBytes);
+        readPos += numBytes;
+    }
+};
+
+} // namespace jnsc
@@ -0,0 +1,355 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Opt-in lock-free trace of processing scopes with Chrome trace_event export
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace jnsc {
+
+/// True if the library is built with JONSSONIC_ENABLE_TRACE (trace scopes compiled in)
+#if defined(JONSSONIC_ENABLE_TRACE)
+inline constexpr bool traceEnabled = true;
+#else
+inline constexpr bool traceEnabled = false;
+#endif
+
+/// What a traced scope does (exported as the Chrome trace category)
+enum class TraceCategory : uint8_t {
+    Process,   /**< Block processing */
+    Parameter, /**< Coefficient and parameter recomputation */
+    Prepare    /**< Preparation (allocation, setup) */
+};
+
+namespace detail {
+inline const char* traceCategoryName(TraceCategory category) {
+    switch (category) {
+    case TraceCategory::Process:
+        return "process";
+    case TraceCategory::Parameter:
+        return "parameter";
+    default:
+        return "prepare";
+    }
+}
+
+// Write a string as a JSON string literal
+inline void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\')
+            out << '\\' << *c;
+        else if (static_cast<unsigned char>(*c) >= 0x20)
+            out << *c;
+    }
+    out << '"';
+}
+
+/**
+ * @brief Ring of completed scopes written by one thread and read by the exporting thread.
+ * @details The owner thread stores the fields of a slot and then publishes it by advancing the write index. When
+ *          the ring is full the oldest events are overwritten. The write index works as the sequence counter of a
+ *          seqlock: the reader copies a slot and then re-checks the write index, dropping the copy if the writer
+ *          may have started reusing the slot meanwhile, so neither side locks.
+ * @note Always compiled; only the recorder and the scopes depend on JONSSONIC_ENABLE_TRACE.
+ */
+class TraceRing {
+  public:
+    /// Slots per thread (power of two); the newest CAPACITY - 1 events are readable, the oldest slot is reused next
+    static constexpr uint64_t CAPACITY = uint64_t(1) << 15;
+
+    /// A completed scope
+    struct Event {
+        const char* name;
+        const void* id;
+        uint64_t start;
+        uint64_t end;
+        TraceCategory category;
+    };
+
+    explicit TraceRing(std::string newThreadName) : threadName(std::move(newThreadName)), slots(CAPACITY) {}
+
+    /// Append an event (owner thread only)
+    void push(const Event& event) {
+        const uint64_t w = writeIndex.load(std::memory_order_relaxed);
+        Slot& slot = slots[w & (CAPACITY - 1)];
+        // Orders the field stores after the index published for the previous event, so a reader that sees any of
+        // them also sees an index that marks the slot as being reused
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(event.name, std::memory_order_relaxed);
+        slot.id.store(event.id, std::memory_order_relaxed);
+        slot.start.store(event.start, std::memory_order_relaxed);
+        slot.end.store(event.end, std::memory_order_relaxed);
+        slot.category.store(event.category, std::memory_order_relaxed);
+        writeIndex.store(w + 1, std::memory_order_release);
+    }
+
+    /// Visit the retained events, oldest first (reader thread)
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        const uint64_t end = writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = end >= CAPACITY ? end - (CAPACITY - 1) : 0;
+        begin = std::max(begin, discardIndex.load(std::memory_order_relaxed));
+        for (uint64_t i = begin; i < end; ++i) {
+            const Slot& slot = slots[i & (CAPACITY - 1)];
+            Event event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.id = slot.id.load(std::memory_order_relaxed);
+            event.start = slot.start.load(std::memory_order_relaxed);
+            event.end = slot.end.load(std::memory_order_relaxed);
+            event.category = slot.category.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (writeIndex.load(std::memory_order_relaxed) - i >= CAPACITY)
+                continue; // Being overwritten while reading (the writer fills index i + CAPACITY before publishing)
+            visit(event);
+        }
+    }
+
+    /// Drop the events recorded so far (reader thread)
+    void clear() { discardIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_relaxed); }
+
+    /// Name shown for the thread in the trace viewer
+    const std::string& getThreadName() const { return threadName; }
+
+  private:
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<const void*> id{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> end{0};
+        std::atomic<TraceCategory> category{TraceCategory::Process};
+    };
+
+    std::string threadName;
+    std::vector<Slot> slots;
+    std::atomic<uint64_t> writeIndex{0};
+    std::atomic<uint64_t> discardIndex{0};
+};
+} // namespace detail
+
+#if defined(JONSSONIC_ENABLE_TRACE)
+
+/**
+ * @brief Process-wide recorder of traced scopes, one lock-free ring per thread.
+ * @details Instrumented code opens a @ref TraceScope; while the recorder is armed, each scope records its begin
+ *          and end time, name, category and processor id (the address of the instance) into the ring of the
+ *          calling thread. @ref writeChromeTrace exports all rings as Chrome `trace_event` JSON, which Perfetto
+ *          and chrome://tracing display as one timeline per thread, so parameter recomputation shows up next to the
+ *          block processing it delays.
+ * @code
+ * TraceRecorder::instance().registerThread("audio"); // from the audio thread, before processing
+ * TraceRecorder::instance().setArmed(true);
+ * ...
+ * TraceRecorder::instance().writeChromeTrace("session.json");
+ * @endcode
+ * @note Compiled in only when JONSSONIC_ENABLE_TRACE is defined (CMake option of the same name); otherwise scopes
+ *       are empty and the export contains no events. A thread's ring is allocated on its first recorded scope
+ *       unless @ref registerThread was called from it beforehand, so call that outside the audio callback.
+ */
+class TraceRecorder {
+  public:
+    /// The recorder shared by all threads
+    static TraceRecorder& instance() {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    /// Start or stop recording (any thread)
+    void setArmed(bool shouldRecord) { armed.store(shouldRecord, std::memory_order_relaxed); }
+
+    /// True while scopes are recorded
+    bool isArmed() const { return armed.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Allocate the ring of the calling thread ahead of time (not realtime safe).
+     * @param threadName Name shown in the trace viewer (empty keeps the default "thread N")
+     */
+    void registerThread(const std::string& threadName = {}) {
+        detail::TraceRing*& ring = threadRing();
+        if (!ring)
+            ring = addRing(threadName);
+    }
+
+    /// Record a completed scope into the ring of the calling thread (realtime safe once the thread is registered)
+    void record(const char* name, TraceCategory category, const void* id, uint64_t start, uint64_t end) {
+        detail::TraceRing*& ring = threadRing();
+        if (!ring)
+            ring = addRing({});
+        ring->push({name, id, start, end, category});
+    }
+
+    /// Drop all events recorded so far (the rings stay allocated)
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& ring : rings)
+            ring->clear();
+    }
+
+    /**
+     * @brief Write all retained events as Chrome trace_event JSON.
+     * @param out Destination stream
+     * @return Number of events written
+     * @note Safe while other threads keep recording; events overwritten during the export are skipped.
+     */
+    size_t writeChromeTrace(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t numEvents = 0;
+        bool first = true;
+        char buffer[64];
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        for (size_t t = 0; t < rings.size(); ++t) {
+            const detail::TraceRing& ring = *rings[t];
+            out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << (t + 1)
+                << ",\"args\":{\"name\":";
+            detail::writeJsonString(out, ring.getThreadName().c_str());
+            out << "}}";
+            first = false;
+            ring.forEach([&](const detail::TraceRing::Event& event) {
+                out << ",\n{\"name\":";
+                detail::writeJsonString(out, event.name);
+                std::snprintf(buffer,
+                              sizeof(buffer),
+                              "%.3f,\"dur\":%.3f",
+                              static_cast<double>(event.start - origin) * 1.0e-3,
+                              static_cast<double>(event.end - event.start) * 1.0e-3);
+                out << ",\"cat\":\"" << detail::traceCategoryName(event.category)
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << (t + 1) << ",\"ts\":" << buffer;
+                std::snprintf(buffer, sizeof(buffer), "%p", event.id);
+                out << ",\"args\":{\"processor\":\"" << buffer << "\"}}";
+                ++numEvents;
+            });
+        }
+        out << "\n]}\n";
+        return numEvents;
+    }
+
+    /**
+     * @brief Write all retained events as Chrome trace_event JSON to a file.
+     * @param path Output file path
+     * @return False if the file could not be written
+     */
+    bool writeChromeTrace(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file)
+            return false;
+        writeChromeTrace(file);
+        return static_cast<bool>(file);
+    }
+
+    /// Monotonic timestamp in nanoseconds
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+  private:
+    TraceRecorder() : origin(now()) {}
+
+    mutable std::mutex mutex; // Guards the ring list (registration and export), never taken by recording
+    std::vector<std::unique_ptr<detail::TraceRing>> rings;
+    std::atomic<bool> armed{false};
+    const uint64_t origin; // Exported timestamps are relative to the creation of the recorder
+
+    static detail::TraceRing*& threadRing() {
+        thread_local detail::TraceRing* ring = nullptr;
+        return ring;
+    }
+
+    detail::TraceRing* addRing(const std::string& threadName) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::string name = threadName.empty() ? "thread " + std::to_string(rings.size() + 1) : threadName;
+        rings.push_back(std::make_unique<detail::TraceRing>(name));
+        return rings.back().get();
+    }
+};
+
+/**
+ * @brief Records the enclosing scope into the @ref TraceRecorder while it is armed.
+ * @code
+ * void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+ *     TraceScope trace("Reverb::processBlock", TraceCategory::Process, this);
+ *     ...
+ * }
+ * @endcode
+ */
+class TraceScope {
+  public:
+    /**
+     * @brief Open a traced scope.
+     * @param name Scope name (must outlive the export, e.g., a string literal)
+     * @param category What the scope does
+     * @param id Processor id (usually `this`)
+     */
+    TraceScope(const char* name, TraceCategory category, const void* id)
+        : name(name), id(id), category(category),
+          start(TraceRecorder::instance().isArmed() ? TraceRecorder::now() : 0) {}
+
+    /// Record the scope
+    ~TraceScope() {
+        if (start != 0)
+            TraceRecorder::instance().record(name, category, id, start, TraceRecorder::now());
+    }
+
+    /// No copy nor move semantics
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+
+  private:
+    const char* name;
+    const void* id;
+    TraceCategory category;
+    uint64_t start; // 0 if the recorder was not armed on entry
+};
+
+#else
+
+// Tracing compiled out: scopes are empty and the export contains no events
+
+class TraceRecorder {
+  public:
+    static TraceRecorder& instance() {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+    void setArmed(bool) {}
+    bool isArmed() const { return false; }
+    void registerThread(const std::string& = {}) {}
+    void record(const char*, TraceCategory, const void*, uint64_t, uint64_t) {}
+    void clear() {}
+    size_t writeChromeTrace(std::ostream& out) const {
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n";
+        return 0;
+    }
+    bool writeChromeTrace(const std::string& path) const {
+        std::ofstream file(path);
+        writeChromeTrace(file);
+        return static_cast<bool>(file);
+    }
+    static uint64_t now() { return 0; }
+};
+
+class TraceScope {
+  public:
+    TraceScope(const char*, TraceCategory, const void*) {}
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#endif
+
+} // namespace jnsc
@@ -6,4 +6,5 @@
 
 #include "allpass_filter.h"
 #include "comb_filter.h"
-#include "delay_line.h"
\ No newline at end of file
+#include "delay_line.h"
+#include "latency_compensator.h"
\ No newline at end of file
@@ -4,8 +4,10 @@
 
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
+#include <algorithm>
 #include <jonssonic/core/common/dsp_param.h>
 #include <jonssonic/core/common/modulation.h>
+#include <jonssonic/core/common/output_mode.h>
 #include <jonssonic/core/common/quantities.h>
 #include <jonssonic/core/delays/delay_line.h>
 
@@ -79,6 +81,7 @@ class AllpassFilter {
         gain.setBounds(T(-1), T(1));
         gain.setTarget(T(0), true);
 
+        numActiveChannels = numChannels;
         togglePrepared = true;
     }
 
@@ -88,6 +91,28 @@ class AllpassFilter {
         gain.reset();
     }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) {
+        delayLine.resetChannel(ch);
+        gain.resetChannel(ch);
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
     /**
      * @brief Process a single sample for a specific channel.
      * @param ch Channel index
@@ -143,22 +168,18 @@ class AllpassFilter {
      * @note Input and output must have the same number of channels as prepared.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t i = 0; i < numSamples; ++i) {
-                // Get smoothed gain value
-                T gainValue = gain.getNextValue(ch);
-
-                // Read delayed feedback state
-                T delayed = delayLine.readSample(ch);
-
-                // Compute output
-                output[ch][i] = gainValue * input[ch][i] + delayed;
+        processBlockImpl<OutputMode::Replace>(input, output, numSamples, T(1));
+    }
 
-                // Compute and write new feedback state
-                T newFeedback = input[ch][i] - gainValue * output[ch][i];
-                delayLine.writeSample(ch, newFeedback);
-            }
-        }
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y (no modulation).
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param sendGain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T sendGain = T(1)) {
+        processBlockImpl<OutputMode::Add>(input, output, numSamples, sendGain);
     }
 
     /**
@@ -170,7 +191,7 @@ class AllpassFilter {
      * @note Input and output must have the same number of channels as prepared.
      */
     void processBlock(const T* const* input, T* const* output, AllpassMod::Block<T>& modStruct, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
             for (size_t i = 0; i < numSamples; ++i) {
                 // Apply modulation to feedback and feedforward gains
                 T modulatedGain = gain.applyMultiplicativeMod(ch, modStruct.gainMod[ch][i]);
@@ -240,9 +261,44 @@ class AllpassFilter {
         gain.setTarget(ch, newGain.toLinear(), skipSmoothing);
     }
 
+    /// Append the delay line and gain smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        delayLine.saveState(blob);
+        gain.saveState(blob);
+    }
+
+    /// Restore the delay line and gain smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        delayLine.restoreState(reader);
+        gain.restoreState(reader);
+    }
+
   private:
+    // Block loop shared by processBlock and processBlockAdding
+    template <OutputMode Mode>
+    void processBlockImpl(const T* const* input, T* const* output, size_t numSamples, T addGain) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
+            for (size_t i = 0; i < numSamples; ++i) {
+                // Get smoothed gain value
+                T gainValue = gain.getNextValue(ch);
+
+                // Read delayed feedback state
+                T delayed = delayLine.readSample(ch);
+
+                // Compute output
+                T y = gainValue * input[ch][i] + delayed;
+                detail::storeOutput<Mode>(output[ch][i], y, addGain);
+
+                // Compute and write new feedback state
+                T newFeedback = input[ch][i] - gainValue * y;
+                delayLine.writeSample(ch, newFeedback);
+            }
+        }
+    }
+
     // Config variables
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     T sampleRate = T(44100);
     bool togglePrepared = false;
 
@@ -4,8 +4,10 @@
 
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
+#include <algorithm>
 #include <jonssonic/core/common/dsp_param.h>
 #include <jonssonic/core/common/modulation.h>
+#include <jonssonic/core/common/output_mode.h>
 #include <jonssonic/core/common/quantities.h>
 #include <jonssonic/core/delays/delay_line.h>
 
@@ -80,6 +82,7 @@ class CombFilter {
         feedbackGain.setTarget(T(0), true);
         feedforwardGain.setTarget(T(0), true);
 
+        numActiveChannels = numChannels;
         togglePrepared = true;
     }
 
@@ -90,6 +93,29 @@ class CombFilter {
         feedforwardGain.reset();
     }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) {
+        delayLine.resetChannel(ch);
+        feedbackGain.resetChannel(ch);
+        feedforwardGain.resetChannel(ch);
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
     /**
      * @brief Process a single sample for a specific channel.
      * @param ch Channel index
@@ -147,23 +173,18 @@ class CombFilter {
      * @note Input and output must have the same number of channels as prepared.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t i = 0; i < numSamples; ++i) {
-                // Get smoothed gain values
-                T ffGain = feedforwardGain.getNextValue(ch);
-                T fbGain = feedbackGain.getNextValue(ch);
-
-                // Read delayed signal
-                T delayed = delayLine.readSample(ch);
-
-                // Compute what to write back (input + delayed feedback)
-                T toWrite = input[ch][i] + delayed * fbGain;
-                delayLine.writeSample(ch, toWrite);
+        processBlockImpl<OutputMode::Replace>(input, output, numSamples, T(1));
+    }
 
-                // Compute output (input + delayed feedforward)
-                output[ch][i] = input[ch][i] + delayed * ffGain;
-            }
-        }
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y (no modulation).
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        processBlockImpl<OutputMode::Add>(input, output, numSamples, gain);
     }
 
     /**
@@ -176,7 +197,7 @@ class CombFilter {
      * @note Input and output must have the same number of channels as prepared.
      */
     void processBlock(const T* const* input, T* const* output, CombMod::Block<T>& modStruct, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
             for (size_t i = 0; i < numSamples; ++i) {
                 // Apply modulation to feedback and feedforward gains
                 T modulatedFbGain = feedbackGain.applyMultiplicativeMod(ch, modStruct.feedbackMod[ch][i]);
@@ -271,9 +292,46 @@ class CombFilter {
         feedforwardGain.setTarget(ch, gain.toLinear(), skipSmoothing);
     }
 
+    /// Append the delay line and gain smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        delayLine.saveState(blob);
+        feedbackGain.saveState(blob);
+        feedforwardGain.saveState(blob);
+    }
+
+    /// Restore the delay line and gain smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        delayLine.restoreState(reader);
+        feedbackGain.restoreState(reader);
+        feedforwardGain.restoreState(reader);
+    }
+
   private:
+    // Block loop shared by processBlock and processBlockAdding
+    template <OutputMode Mode>
+    void processBlockImpl(const T* const* input, T* const* output, size_t numSamples, T addGain) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
+            for (size_t i = 0; i < numSamples; ++i) {
+                // Get smoothed gain values
+                T ffGain = feedforwardGain.getNextValue(ch);
+                T fbGain = feedbackGain.getNextValue(ch);
+
+                // Read delayed signal
+                T delayed = delayLine.readSample(ch);
+
+                // Compute what to write back (input + delayed feedback)
+                T toWrite = input[ch][i] + delayed * fbGain;
+                delayLine.writeSample(ch, toWrite);
+
+                // Compute output (input + delayed feedforward)
+                detail::storeOutput<Mode>(output[ch][i], input[ch][i] + delayed * ffGain, addGain);
+            }
+        }
+    }
+
     // Config variables
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     T sampleRate = T(44100);
     bool togglePrepared = false;
 
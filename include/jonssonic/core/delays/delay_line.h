@@ -5,6 +5,7 @@
 #pragma once
 #include "jonssonic/core/delays/detail/interpolators.h"
 #include "jonssonic/utils/detail/config_utils.h"
+#include <algorithm>
 #include <jonssonic/core/common/circular_audio_buffer.h>
 #include <jonssonic/core/common/dsp_param.h>
 #include <jonssonic/core/common/quantities.h>
@@ -63,6 +64,7 @@ class DelayLine {
         delaySamples.setBounds(T(0), static_cast<T>(maxDelaySamples));
 
         // Mark as prepared
+        numActiveChannels = numChannels;
         togglePrepared = true;
     }
 
@@ -72,6 +74,25 @@ class DelayLine {
         delaySamples.reset();
     }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) {
+        circularBuffer.clearChannel(ch);
+        delaySamples.resetChannel(ch);
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * @brief Process a single sample for a specific channel.
      * @param ch Channel index
@@ -118,11 +139,24 @@ class DelayLine {
      * @note Input and output must have the same number of channels as prepared.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
             for (size_t n = 0; n < numSamples; ++n)
                 output[ch][n] = processSample(ch, input[ch][n]);
     }
 
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the delayed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] += gain * processSample(ch, input[ch][n]);
+    }
+
     /**
      * @brief Process a block of samples for all channels with modulated delay.
      * @param input Input sample pointers (one per channel)
@@ -134,7 +168,7 @@ class DelayLine {
      * @note Input, output, and modulation must all have the same number of channels as prepared.
      */
     void processBlock(const T* const* input, T* const* output, const T* const* modulation, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
             for (size_t n = 0; n < numSamples; ++n)
                 output[ch][n] = processSample(ch, input[ch][n], modulation[ch][n]);
     }
@@ -207,11 +241,26 @@ class DelayLine {
 
     /// Get number of channels
     size_t getNumChannels() const { return numChannels; }
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
+    /// Append the delay buffer and delay-time smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        circularBuffer.saveState(blob);
+        delaySamples.saveState(blob);
+    }
+
+    /// Restore the delay buffer and delay-time smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        circularBuffer.restoreState(reader);
+        delaySamples.restoreState(reader);
+    }
 
   private:
     // Config variables
-    T sampleRate = T(44100); // Sample rate in Hz
-    size_t numChannels;      // Number of audio channels
+    T sampleRate = T(44100);      // Sample rate in Hz
+    size_t numChannels;           // Number of audio channels
+    size_t numActiveChannels = 0; // Number of processed channels
     bool togglePrepared = false;
 
     // DSP Components
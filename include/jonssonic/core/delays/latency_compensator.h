@@ -0,0 +1,193 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Integer block-copy delay for aligning parallel signal paths
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/state_blob.h>
+#include <jonssonic/utils/detail/config_utils.h>
+#include <jonssonic/utils/math_utils.h>
+#include <vector>
+
+namespace jnsc {
+
+/**
+ * @brief Multichannel integer delay used to compensate latency between parallel paths (e.g., dry vs. oversampled wet).
+ * @details Blocks are moved through a power-of-two ring with at most four memcpy calls per chunk instead of a
+ *          per-sample write/read pair. Chunks are written before they are read, so processing in place is safe.
+ *          Fractional latencies are rounded to the nearest sample with @ref latencyToSamples.
+ * @tparam T Sample data type (e.g., float, double)
+ */
+template <typename T>
+class LatencyCompensator {
+    /// Ring headroom beyond the maximum delay, i.e. the minimum chunk length copied at once
+    static constexpr size_t MIN_CHUNK_SIZE = 64;
+
+  public:
+    /// Default constructor
+    LatencyCompensator() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumChannels Number of channels
+     * @param newMaxDelaySamples Maximum delay in samples
+     */
+    LatencyCompensator(size_t newNumChannels, size_t newMaxDelaySamples) {
+        prepare(newNumChannels, newMaxDelaySamples);
+    }
+
+    /// Default destructor
+    ~LatencyCompensator() = default;
+
+    /// No copy nor move semantics
+    LatencyCompensator(const LatencyCompensator&) = delete;
+    LatencyCompensator& operator=(const LatencyCompensator&) = delete;
+    LatencyCompensator(LatencyCompensator&&) = delete;
+    LatencyCompensator& operator=(LatencyCompensator&&) = delete;
+
+    /**
+     * @brief Prepare the compensator for processing. The delay is set to the maximum delay.
+     * @param newNumChannels Number of channels
+     * @param newMaxDelaySamples Maximum delay in samples
+     */
+    void prepare(size_t newNumChannels, size_t newMaxDelaySamples) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        maxDelaySamples = newMaxDelaySamples;
+        bufferSize = utils::nextPowerOfTwo(maxDelaySamples + MIN_CHUNK_SIZE);
+        buffer.resize(numChannels, bufferSize);
+        writeIndex.assign(numChannels, 0);
+        delaySamples = maxDelaySamples;
+        togglePrepared = true;
+    }
+
+    /// Clear the delayed samples
+    void reset() {
+        buffer.clear();
+        std::fill(writeIndex.begin(), writeIndex.end(), 0);
+    }
+
+    /// Clear the delayed samples of a single channel
+    void resetChannel(size_t ch) {
+        buffer.clearChannel(ch);
+        writeIndex[ch] = 0;
+    }
+
+    /**
+     * @brief Set the delay.
+     * @param newDelaySamples Delay in samples (clamped to the prepared maximum)
+     * @note Changing the delay jumps the read position without crossfading.
+     */
+    void setDelay(size_t newDelaySamples) {
+        assert(newDelaySamples <= maxDelaySamples && "Delay exceeds the prepared maximum");
+        delaySamples = std::min(newDelaySamples, maxDelaySamples);
+    }
+
+    /**
+     * @brief Process a single sample of a channel.
+     * @param ch Channel index
+     * @param input Input sample
+     * @return Input delayed by the current delay
+     */
+    T processSample(size_t ch, T input) {
+        T* data = buffer.writeChannelPtr(ch);
+        const size_t mask = bufferSize - 1;
+        data[writeIndex[ch]] = input;
+        T output = data[(writeIndex[ch] + bufferSize - delaySamples) & mask];
+        writeIndex[ch] = (writeIndex[ch] + 1) & mask;
+        return output;
+    }
+
+    /**
+     * @brief Process a block of one channel.
+     * @param ch Channel index
+     * @param input Input samples
+     * @param output Output samples (may alias @p input)
+     * @param numSamples Number of samples
+     */
+    void processChannel(size_t ch, const T* input, T* output, size_t numSamples) {
+        T* data = buffer.writeChannelPtr(ch);
+        const size_t mask = bufferSize - 1;
+        const size_t maxChunk = bufferSize - delaySamples; // never overwrite samples that are still to be read
+        size_t w = writeIndex[ch];
+        for (size_t offset = 0; offset < numSamples;) {
+            const size_t len = std::min(numSamples - offset, maxChunk);
+            const size_t r = (w + bufferSize - delaySamples) & mask;
+            copyIntoRing(data, w, input + offset, len);
+            copyFromRing(data, r, output + offset, len);
+            w = (w + len) & mask;
+            offset += len;
+        }
+        writeIndex[ch] = w;
+    }
+
+    /**
+     * @brief Process a block of samples for all channels.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel, may alias @p input)
+     * @param numSamples Number of samples to process
+     */
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            processChannel(ch, input[ch], output[ch], numSamples);
+    }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+    /// Get the current delay in samples
+    size_t getDelaySamples() const { return delaySamples; }
+    /// Get the maximum delay in samples
+    size_t getMaxDelaySamples() const { return maxDelaySamples; }
+    /// Get latency in samples (the current delay)
+    T getLatencySamples() const { return static_cast<T>(delaySamples); }
+    /// Check if prepared
+    bool isPrepared() const { return togglePrepared; }
+
+    /**
+     * @brief Round a (possibly fractional) latency to the integer delay that best compensates it.
+     * @param latencySamples Latency in samples
+     * @return Delay in samples
+     */
+    static size_t latencyToSamples(T latencySamples) {
+        return latencySamples > T(0) ? static_cast<size_t>(std::lround(latencySamples)) : 0;
+    }
+
+    /// Append the ring contents and write positions to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(buffer);
+        blob.write(writeIndex);
+    }
+
+    /// Restore the ring contents and write positions from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(buffer);
+        reader.read(writeIndex);
+    }
+
+  private:
+    bool togglePrepared = false;
+    size_t numChannels = 0;
+    size_t maxDelaySamples = 0;
+    size_t delaySamples = 0;
+    size_t bufferSize = 1;
+
+    AudioBuffer<T> buffer;          // Ring per channel, power-of-two length
+    std::vector<size_t> writeIndex; // Per-channel write position
+
+    void copyIntoRing(T* data, size_t start, const T* src, size_t len) const {
+        const size_t first = std::min(len, bufferSize - start);
+        std::memcpy(data + start, src, first * sizeof(T));
+        std::memcpy(data, src + first, (len - first) * sizeof(T));
+    }
+
+    void copyFromRing(const T* data, size_t start, T* dst, size_t len) const {
+        const size_t first = std::min(len, bufferSize - start);
+        std::memcpy(dst, data + start, first * sizeof(T));
+        std::memcpy(dst + first, data, (len - first) * sizeof(T));
+    }
+};
+
+} // namespace jnsc
@@ -5,6 +5,7 @@
 #pragma once
 #include "jonssonic/core/delays/detail/interpolators.h"
 #include "jonssonic/utils/detail/config_utils.h"
+#include <algorithm>
 #include <jonssonic/core/common/circular_audio_buffer.h>
 #include <jonssonic/core/common/dsp_param.h>
 #include <jonssonic/core/common/quantities.h>
@@ -66,6 +67,7 @@ class MultiTapDelayLine {
         tapGain.setBounds(T(-1), T(1));
 
         // Mark as prepared
+        numActiveChannels = numChannels;
         togglePrepared = true;
     }
 
@@ -76,6 +78,31 @@ class MultiTapDelayLine {
         tapGain.reset();
     }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) {
+        circularBuffer.clearChannel(ch);
+        for (size_t tap = 0; tap < NumTaps; ++tap) {
+            tapDelay.resetChannel(index(ch, tap));
+            tapGain.resetChannel(index(ch, tap));
+        }
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
     /**
      * @brief Process a single sample for a specific channel.
      * @param ch Channel index
@@ -131,7 +158,7 @@ class MultiTapDelayLine {
      * @note Input and output must have the same number of channels as prepared.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
             for (size_t n = 0; n < numSamples; ++n)
                 output[ch][n] = processSample(ch, input[ch][n]);
     }
@@ -277,11 +304,26 @@ class MultiTapDelayLine {
         return Gain<T>::Linear(tapGain.getCurrentValue(index(ch, tap)));
     }
 
+    /// Append the delay buffer and tap smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        circularBuffer.saveState(blob);
+        tapDelay.saveState(blob);
+        tapGain.saveState(blob);
+    }
+
+    /// Restore the delay buffer and tap smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        circularBuffer.restoreState(reader);
+        tapDelay.restoreState(reader);
+        tapGain.restoreState(reader);
+    }
+
   private:
     // Config variables
-    T sampleRate = T(44100); // Sample rate in Hz
-    size_t numChannels;      // Number of audio channels
-    size_t bufferSize;       // Maximum delay in samples (always power of two)
+    T sampleRate = T(44100);      // Sample rate in Hz
+    size_t numChannels;           // Number of audio channels
+    size_t numActiveChannels = 0; // Number of processed channels
+    size_t bufferSize;            // Maximum delay in samples (always power of two)
     bool togglePrepared = false;
 
     // DSP Components
@@ -82,6 +82,20 @@ class CompressorPolicy {
     bool hasKneeParam() const { return true; }
     bool hasRatioParam() const { return true; }
 
+    /// Append the parameter smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        threshold.saveState(blob);
+        ratio.saveState(blob);
+        knee.saveState(blob);
+    }
+
+    /// Restore the parameter smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        threshold.restoreState(reader);
+        ratio.restoreState(reader);
+        knee.restoreState(reader);
+    }
+
   private:
     DspParam<T> threshold; // threshold in dB
     DspParam<T> ratio;     // Compression ratio (ratio:1)
@@ -161,6 +175,20 @@ class ExpanderDownPolicy {
     bool hasKneeParam() const { return true; }
     bool hasRatioParam() const { return true; }
 
+    /// Append the parameter smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        threshold.saveState(blob);
+        ratio.saveState(blob);
+        knee.saveState(blob);
+    }
+
+    /// Restore the parameter smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        threshold.restoreState(reader);
+        ratio.restoreState(reader);
+        knee.restoreState(reader);
+    }
+
   private:
     DspParam<T> threshold; // threshold in dB
     DspParam<T> ratio;     // Expansion ratio (1:ratio)
@@ -240,6 +268,20 @@ class ExpanderUpPolicy {
     bool hasKneeParam() const { return true; }
     bool hasRatioParam() const { return true; }
 
+    /// Append the parameter smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        threshold.saveState(blob);
+        ratio.saveState(blob);
+        knee.saveState(blob);
+    }
+
+    /// Restore the parameter smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        threshold.restoreState(reader);
+        ratio.restoreState(reader);
+        knee.restoreState(reader);
+    }
+
   private:
     DspParam<T> threshold; // threshold in dB
     DspParam<T> ratio;     // Expansion ratio (1:ratio)
@@ -282,6 +324,16 @@ class LimiterPolicy {
     bool hasKneeParam() const { return false; }
     bool hasRatioParam() const { return false; }
 
+    /// Append the threshold smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        threshold.saveState(blob);
+    }
+
+    /// Restore the threshold smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        threshold.restoreState(reader);
+    }
+
   private:
     DspParam<T> threshold; // threshold in dB
 };
@@ -322,6 +374,16 @@ class GatePolicy {
     bool hasKneeParam() const { return false; }
     bool hasRatioParam() const { return false; }
 
+    /// Append the threshold smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        threshold.saveState(blob);
+    }
+
+    /// Restore the threshold smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        threshold.restoreState(reader);
+    }
+
   private:
     DspParam<T> threshold; // threshold in dB
 };
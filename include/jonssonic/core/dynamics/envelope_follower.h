@@ -7,8 +7,11 @@
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cassert>
 #include <cmath>
+#include <jonssonic/core/common/detail/aligned_allocator.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/interleaved_frames.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <vector>
 
 namespace jnsc {
@@ -79,6 +82,13 @@ class EnvelopeFollower<T, EnvelopeType::Peak> {
      */
     void reset(T value = T(0)) { std::fill(envelope.begin(), envelope.end(), value); }
 
+    /**
+     * @brief Reset the envelope follower state of a single channel.
+     * @param ch Channel index
+     * @param value Initial envelope value after reset
+     */
+    void resetChannel(size_t ch, T value = T(0)) { envelope[ch] = value; }
+
     /**
      * @brief Process a single sample for a given channel.
      * @param ch Channel index
@@ -87,7 +97,8 @@ class EnvelopeFollower<T, EnvelopeType::Peak> {
      */
     T processSample(size_t ch, T input) {
         // Rectify input (i.e. find peak level)
-        T rectified = std::abs(input);
+        using std::abs;
+        T rectified = abs(input);
 
         // What stage are we in?
         T inAttack = static_cast<T>(rectified > envelope[ch]);
@@ -118,6 +129,16 @@ class EnvelopeFollower<T, EnvelopeType::Peak> {
                 }
             }
     }
+
+    /**
+     * @brief Process a block of interleaved frames for all channels.
+     * @param input Interleaved input (signal) frames [frame][channel]
+     * @param output Interleaved output (envelope) frames [frame][channel], may alias the input
+     * @param numFrames Number of frames to process
+     */
+    void processBlock(const T* input, T* output, size_t numFrames) {
+        processInterleavedFrames(*this, input, output, numChannels, numChannels, numFrames);
+    }
     /**
      * @brief Set control smoothing time in various units.
      * @param time Smoothing time struct.
@@ -165,12 +186,12 @@ class EnvelopeFollower<T, EnvelopeType::Peak> {
     bool isPrepared() const { return togglePrepared; }
 
     /// Get the envelope state
-    std::vector<T> getState() const { return envelope; }
+    std::vector<T> getState() const { return std::vector<T>(envelope.begin(), envelope.end()); }
 
     /// Set the envelope state
     void setState(const std::vector<T>& newState) {
         assert(newState.size() == numChannels && "State size must match number of channels");
-        envelope = newState;
+        envelope.assign(newState.begin(), newState.end());
     }
 
     /// Get parameters
@@ -182,6 +203,22 @@ class EnvelopeFollower<T, EnvelopeType::Peak> {
         updateCoefficients(skipSmoothing);
     }
 
+    /// Append the envelopes, times and coefficient smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(envelope);
+        blob.write(params);
+        attackCoeff.saveState(blob);
+        releaseCoeff.saveState(blob);
+    }
+
+    /// Restore the envelopes, times and coefficient smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(envelope);
+        reader.read(params);
+        attackCoeff.restoreState(reader);
+        releaseCoeff.restoreState(reader);
+    }
+
   private:
     // Global parameters
     bool togglePrepared = false;
@@ -189,7 +226,7 @@ class EnvelopeFollower<T, EnvelopeType::Peak> {
     T sampleRate = T(44100);
 
     // State variables
-    std::vector<T> envelope;
+    detail::AlignedVector<T> envelope;
 
     // User Parameters
     EnvelopeParams params;
@@ -199,11 +236,13 @@ class EnvelopeFollower<T, EnvelopeType::Peak> {
     DspParam<T> releaseCoeff;
 
     void updateCoefficients(bool skipSmoothing) {
+        TraceScope trace("EnvelopeFollower::updateCoefficients", TraceCategory::Parameter, this);
+        using std::exp;
 
         // Set target coefficients based on current attack and release times
-        attackCoeff.setTarget(1.0 - std::exp(-1.0 / (params.attackTimeSec * sampleRate)),
+        attackCoeff.setTarget(1.0 - exp(-1.0 / (params.attackTimeSec * sampleRate)),
                               skipSmoothing);
-        releaseCoeff.setTarget(1.0 - std::exp(-1.0 / (params.releaseTimeSec * sampleRate)),
+        releaseCoeff.setTarget(1.0 - exp(-1.0 / (params.releaseTimeSec * sampleRate)),
                                skipSmoothing);
     }
 };
@@ -247,6 +286,13 @@ class EnvelopeFollower<T, EnvelopeType::RMS> {
      */
     void reset(T value = T(0)) { std::fill(envelope.begin(), envelope.end(), value); }
 
+    /**
+     * @brief Reset the envelope follower state of a single channel.
+     * @param ch Channel index
+     * @param value Initial envelope value after reset
+     */
+    void resetChannel(size_t ch, T value = T(0)) { envelope[ch] = value; }
+
     /**
      * @brief Process a single sample for a given channel.
      * @param ch Channel index
@@ -269,7 +315,8 @@ class EnvelopeFollower<T, EnvelopeType::RMS> {
         envelope[ch] += coeff * (squared - envelope[ch]);
 
         // Return the square root of the envelope for RMS
-        return std::sqrt(envelope[ch]);
+        using std::sqrt;
+        return sqrt(envelope[ch]);
     }
 
     /**
@@ -286,6 +333,16 @@ class EnvelopeFollower<T, EnvelopeType::RMS> {
                 }
             }
     }
+
+    /**
+     * @brief Process a block of interleaved frames for all channels.
+     * @param input Interleaved input (signal) frames [frame][channel]
+     * @param output Interleaved output (envelope) frames [frame][channel], may alias the input
+     * @param numFrames Number of frames to process
+     */
+    void processBlock(const T* input, T* output, size_t numFrames) {
+        processInterleavedFrames(*this, input, output, numChannels, numChannels, numFrames);
+    }
     /**
      * @brief Set control smoothing time in various units.
      * @param time Smoothing time struct.
@@ -326,6 +383,24 @@ class EnvelopeFollower<T, EnvelopeType::RMS> {
     size_t getNumChannels() const { return numChannels; }
     T getSampleRate() const { return sampleRate; }
 
+    /// Append the envelopes, times and coefficient smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(envelope);
+        blob.write(attackTimeSec);
+        blob.write(releaseTimeSec);
+        attackCoeff.saveState(blob);
+        releaseCoeff.saveState(blob);
+    }
+
+    /// Restore the envelopes, times and coefficient smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(envelope);
+        reader.read(attackTimeSec);
+        reader.read(releaseTimeSec);
+        attackCoeff.restoreState(reader);
+        releaseCoeff.restoreState(reader);
+    }
+
   private:
     // Global parameters
     bool togglePrepared = false;
@@ -333,7 +408,7 @@ class EnvelopeFollower<T, EnvelopeType::RMS> {
     T sampleRate = T(44100);
 
     // State variables
-    std::vector<T> envelope;
+    detail::AlignedVector<T> envelope;
 
     // User Parameters
     T attackTimeSec;
@@ -342,9 +417,11 @@ class EnvelopeFollower<T, EnvelopeType::RMS> {
     DspParam<T> releaseCoeff;
 
     void updateCoefficients(bool skipSmoothing) {
+        TraceScope trace("EnvelopeFollower::updateCoefficients", TraceCategory::Parameter, this);
+        using std::exp;
         // Set target coefficients based on current attack and release times
-        attackCoeff.setTarget(1.0 - std::exp(-1.0 / (attackTimeSec * sampleRate)), skipSmoothing);
-        releaseCoeff.setTarget(1.0 - std::exp(-1.0 / (releaseTimeSec * sampleRate)), skipSmoothing);
+        attackCoeff.setTarget(1.0 - exp(-1.0 / (attackTimeSec * sampleRate)), skipSmoothing);
+        releaseCoeff.setTarget(1.0 - exp(-1.0 / (releaseTimeSec * sampleRate)), skipSmoothing);
     }
 };
 
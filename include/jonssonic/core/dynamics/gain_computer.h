@@ -121,6 +121,16 @@ class GainComputer {
     /// Get the sample rate.
     T getSampleRate() const { return sampleRate; }
 
+    /// Append the policy parameter smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        policy.saveState(blob);
+    }
+
+    /// Restore the policy parameter smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        policy.restoreState(reader);
+    }
+
   private:
     size_t numChannels = 0;
     T sampleRate = T(44100);
@@ -5,8 +5,10 @@
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cmath>
+#include <jonssonic/core/common/detail/aligned_allocator.h>
 #include <jonssonic/core/common/dsp_param.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/utils/math_utils.h>
 
 namespace jnsc {
@@ -75,6 +77,13 @@ class GainSmoother<T, GainSmootherType::AttackRelease> {
      */
     void reset(T gainValueDb = T(0.0)) { std::fill(gainDb.begin(), gainDb.end(), gainValueDb); }
 
+    /**
+     * @brief Reset the gain smoother state of a single channel.
+     * @param ch Channel index
+     * @param gainValueDb Initial gain value after reset
+     */
+    void resetChannel(size_t ch, T gainValueDb = T(0.0)) { gainDb[ch] = gainValueDb; }
+
     /**
      * @brief Process a single sample for a given channel.
      * @param ch Channel index
@@ -151,6 +160,20 @@ class GainSmoother<T, GainSmootherType::AttackRelease> {
     /// @brief  Get the sample rate.
     T getSampleRate() const { return sampleRate; }
 
+    /// Append the smoothed gains and coefficient smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(gainDb);
+        attackCoeff.saveState(blob);
+        releaseCoeff.saveState(blob);
+    }
+
+    /// Restore the smoothed gains and coefficient smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(gainDb);
+        attackCoeff.restoreState(reader);
+        releaseCoeff.restoreState(reader);
+    }
+
   private:
     // Global parameters
     bool togglePrepared = false;
@@ -158,7 +181,7 @@ class GainSmoother<T, GainSmootherType::AttackRelease> {
     T sampleRate = T(44100);
 
     // State variables
-    std::vector<T> gainDb;
+    detail::AlignedVector<T> gainDb;
 
     // User Parameters
     T attackTimeSec;
@@ -169,6 +192,7 @@ class GainSmoother<T, GainSmootherType::AttackRelease> {
     DspParam<T> releaseCoeff;
 
     void updateCoefficients(bool skipSmoothing = false) {
+        TraceScope trace("GainSmoother::updateCoefficients", TraceCategory::Parameter, this);
         // Set target coefficients based on current attack and release times
         attackCoeff.setTarget(1.0 - std::exp(-1.0 / (attackTimeSec * sampleRate)), skipSmoothing);
         releaseCoeff.setTarget(1.0 - std::exp(-1.0 / (releaseTimeSec * sampleRate)), skipSmoothing);
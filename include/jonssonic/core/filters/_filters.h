@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <jonssonic/core/filters/biquad_bank.h>
 #include <jonssonic/core/filters/biquad_filter.h>
 #include <jonssonic/core/filters/one_pole_filter.h>
 #include <jonssonic/core/filters/routing.h>
\ No newline at end of file
@@ -0,0 +1,173 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Bank of per-channel biquad cascades vectorized across channels
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include "jonssonic/utils/detail/config_utils.h"
+#include <algorithm>
+#include <cassert>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/detail/aligned_allocator.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/common/state_blob.h>
+#include <jonssonic/core/filters/detail/filter_limits.h>
+
+namespace jnsc {
+
+/**
+ * @brief Bank of cascaded DF2T biquads, one cascade per channel, processed across channels at once.
+ * @details Blocks are interleaved into frames so that each sample of all channels is contiguous, filtered by
+ *          a runtime-dispatched kernel (AVX-512/AVX2/baseline, see @ref getSimdIsa) that vectorizes over
+ *          channels, and deinterleaved again. Results are bit-exact with DF2TBiquadTopology.
+ *          Best suited to many channels with independent coefficients (e.g., filter banks, multichannel EQ).
+ * @tparam T Sample data type (float, double)
+ */
+template <typename T>
+class BiquadBank {
+  public:
+    /// Coefficients per section (b0, b1, b2, a1, a2) and state variables per section (s1, s2)
+    static constexpr size_t COEFFS_PER_SECTION = 5;
+    static constexpr size_t STATE_VARS_PER_SECTION = 2;
+
+    /// Default constructor
+    BiquadBank() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumChannels Number of channels
+     * @param newMaxBlockSize Maximum block size in samples
+     * @param newNumSections Number of second-order sections per channel
+     */
+    BiquadBank(size_t newNumChannels, size_t newMaxBlockSize, size_t newNumSections = 1) {
+        prepare(newNumChannels, newMaxBlockSize, newNumSections);
+    }
+
+    /// Default destructor
+    ~BiquadBank() = default;
+
+    /// No copy nor move semantics
+    BiquadBank(const BiquadBank&) = delete;
+    BiquadBank& operator=(const BiquadBank&) = delete;
+    BiquadBank(BiquadBank&&) = delete;
+    BiquadBank& operator=(BiquadBank&&) = delete;
+
+    /**
+     * @brief Prepare the bank for processing (allocates). All sections start as passthrough.
+     * @param newNumChannels Number of channels
+     * @param newMaxBlockSize Maximum block size in samples (larger blocks are processed in chunks)
+     * @param newNumSections Number of second-order sections per channel
+     */
+    void prepare(size_t newNumChannels, size_t newMaxBlockSize, size_t newNumSections = 1) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        numSections = detail::FilterLimits<T>::clampSections(newNumSections);
+        maxBlockSize = std::max<size_t>(newMaxBlockSize, 1);
+
+        coeffs.assign(numSections * COEFFS_PER_SECTION * numChannels, T(0));
+        state.assign(numSections * STATE_VARS_PER_SECTION * numChannels, T(0));
+        frames.assign(maxBlockSize * numChannels, T(0));
+        chunkIn.resize(numChannels);
+        chunkOut.resize(numChannels);
+        for (size_t s = 0; s < numSections; ++s)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                coeffs[(s * COEFFS_PER_SECTION) * numChannels + ch] = T(1);
+
+        togglePrepared = true;
+    }
+
+    /// Reset the filter state
+    void reset() { std::fill(state.begin(), state.end(), T(0)); }
+
+    /**
+     * @brief Set coefficients for a specific channel and section.
+     * @param ch Channel index
+     * @param section Section index
+     * @param b0 Feedforward coefficient 0
+     * @param b1 Feedforward coefficient 1
+     * @param b2 Feedforward coefficient 2
+     * @param a1 Feedback coefficient 1
+     * @param a2 Feedback coefficient 2
+     */
+    void setCoeffs(size_t ch, size_t section, T b0, T b1, T b2, T a1, T a2) {
+        // Early exit if not prepared
+        if (!togglePrepared)
+            return;
+        assert(section < numSections && "Section index out of bounds");
+        assert(ch < numChannels && "Channel index out of bounds");
+
+        T* c = coeffs.data() + section * COEFFS_PER_SECTION * numChannels + ch;
+        c[0 * numChannels] = b0;
+        c[1 * numChannels] = b1;
+        c[2 * numChannels] = b2;
+        c[3 * numChannels] = a1;
+        c[4 * numChannels] = a2;
+    }
+
+    /**
+     * @brief Process a block of samples for all channels.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @note Input and output may alias.
+     */
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        const auto& kernels = getSimdKernels<T>();
+        for (size_t offset = 0; offset < numSamples; offset += maxBlockSize) {
+            const size_t len = std::min(maxBlockSize, numSamples - offset);
+            kernels.interleave(chunkIn.advance(input, numChannels, offset), frames.data(), numChannels, len);
+            kernels.biquadBank(frames.data(), numChannels, len, numSections, coeffs.data(), state.data());
+            kernels.deinterleave(frames.data(), chunkOut.advance(output, numChannels, offset), numChannels, len);
+        }
+    }
+
+    /**
+     * @brief Process a block of interleaved frames for all channels.
+     * @param input Interleaved input frames [frame][channel]
+     * @param output Interleaved output frames [frame][channel]
+     * @param numFrames Number of frames to process
+     * @note Input and output may alias. Frames are filtered in place in the output, without the interleave and
+     *       deinterleave passes of the planar path.
+     */
+    void processBlock(const T* input, T* output, size_t numFrames) {
+        if (input != output)
+            std::copy(input, input + numFrames * numChannels, output);
+        getSimdKernels<T>().biquadBank(output, numChannels, numFrames, numSections, coeffs.data(), state.data());
+    }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+    /// Get number of sections per channel
+    size_t getNumSections() const { return numSections; }
+    /// Get maximum block size processed in one pass
+    size_t getMaxBlockSize() const { return maxBlockSize; }
+    /// Check if prepared
+    bool isPrepared() const { return togglePrepared; }
+
+    /// Append the coefficients and filter memories to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(coeffs);
+        blob.write(state);
+    }
+
+    /// Restore the coefficients and filter memories from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(coeffs);
+        reader.read(state);
+    }
+
+  private:
+    bool togglePrepared = false;
+    size_t numChannels = 0;
+    size_t numSections = 0;
+    size_t maxBlockSize = 0;
+
+    // Structure-of-arrays layouts, contiguous over channels:
+    //   coeffs[(section * 5 + coeff) * numChannels + ch]
+    //   state[(section * 2 + stateVar) * numChannels + ch]
+    detail::AlignedVector<T> coeffs;
+    detail::AlignedVector<T> state;
+    detail::AlignedVector<T> frames;    // Interleaved scratch: frames[n * numChannels + ch]
+    OffsetChannelPtrs<const T> chunkIn; // Channel pointers of the chunk being processed
+    OffsetChannelPtrs<T> chunkOut;
+};
+
+} // namespace jnsc
@@ -7,6 +7,10 @@
 #include "jonssonic/core/filters/detail/df1_biquad_topology.h"
 #include "jonssonic/core/filters/detail/df2t_biquad_topology.h"
 #include "jonssonic/core/filters/routing.h"
+#include <jonssonic/core/common/interleaved_frames.h>
+#include <jonssonic/core/common/trace_recorder.h>
+#include <algorithm>
+#include <vector>
 
 namespace jnsc {
 /**
@@ -51,6 +55,22 @@ class BiquadFilter {
     /// Reset the filter state
     void reset() { topology.reset(); }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) { topology.resetChannel(ch); }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, topology.getNumChannels());
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * Prepare the filter engine for processing.
      * @param newNumChannels Number of channels
@@ -61,6 +81,27 @@ class BiquadFilter {
     void prepare(size_t newNumChannels, T newSampleRate, size_t newNumSections = 1) {
         topology.prepare(newNumChannels, newNumSections);
         design.prepare(newNumChannels, newSampleRate, newNumSections);
+        pendingCoeffs.assign(topology.getNumChannels() * topology.getNumSections(), false);
+        deferCoeffUpdates = false;
+        numActiveChannels = topology.getNumChannels();
+    }
+
+    /**
+     * @brief Defer coefficient recomputation until @ref endCoeffUpdate.
+     * @note Use around several setter calls (e.g., frequency and gain of the same section) so that each
+     *       affected channel/section is recomputed once instead of once per setter.
+     */
+    void beginCoeffUpdate() { deferCoeffUpdates = isPrepared(); }
+
+    /// Recompute the coefficients of every channel/section changed since @ref beginCoeffUpdate
+    void endCoeffUpdate() {
+        deferCoeffUpdates = false;
+        for (size_t ch = 0; ch < topology.getNumChannels(); ++ch) {
+            for (size_t section = 0; section < topology.getNumSections(); ++section) {
+                if (pendingCoeffs[ch * topology.getNumSections() + section])
+                    applyDesignToTopology(ch, section);
+            }
+        }
     }
 
     /**
@@ -70,7 +111,7 @@ class BiquadFilter {
      * @return Output sample.
      * @note Must call @ref prepare before processing.
      */
-    float processSample(size_t ch, T input) {
+    T processSample(size_t ch, T input) {
         // SERIES ROUTING
         if constexpr (RoutingType == Routing::Series) {
             T output = input;
@@ -97,11 +138,48 @@ class BiquadFilter {
      * @note Must call @ref prepare before processing.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < topology.getNumChannels(); ++ch)
+        processChannelRange(input, output, numSamples, 0, numActiveChannels);
+    }
+
+    /**
+     * @brief Process a block for a range of channels (channels outside the range are untouched).
+     * @param input input pointers for each channel [channel][sample].
+     * @param output output pointers for each channel [channel][sample].
+     * @param numSamples Number of samples in the block.
+     * @param chBegin First channel to process.
+     * @param chEnd One past the last channel to process.
+     * @note Lets multi-stage processors run all stages on a cache-sized channel group (see channel_groups.h).
+     */
+    void processChannelRange(const T* const* input, T* const* output, size_t numSamples, size_t chBegin, size_t chEnd) {
+        for (size_t ch = chBegin; ch < chEnd; ++ch)
             for (size_t n = 0; n < numSamples; ++n)
                 output[ch][n] = processSample(ch, input[ch][n]);
     }
 
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input input pointers for each channel [channel][sample].
+     * @param output output (bus) pointers for each channel [channel][sample].
+     * @param numSamples Number of samples in the block.
+     * @param gain Gain applied to the processed signal (e.g., send level).
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] += gain * processSample(ch, input[ch][n]);
+    }
+
+    /**
+     * @brief Process a block of interleaved frames for all channels.
+     * @param input interleaved input frames [frame][channel] (frame size is the prepared channel count).
+     * @param output interleaved output frames [frame][channel], may alias the input.
+     * @param numFrames Number of frames in the block.
+     * @note Avoids deinterleaving host buffers; results match planar processing.
+     */
+    void processBlock(const T* input, T* output, size_t numFrames) {
+        processInterleavedFrames(*this, input, output, getNumChannels(), numActiveChannels, numFrames);
+    }
+
     /**
      * @brief Set the filter response type for all channels and sections.
      * @param newResponse Desired filter response type.
@@ -162,6 +240,8 @@ class BiquadFilter {
     bool isPrepared() const { return topology.isPrepared(); }
     /// Get the number of channels
     size_t getNumChannels() const { return topology.getNumChannels(); }
+    /// Get the number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
     /// Get the sample rate from the design
     T getSampleRate() const { return design.getSampleRate(); }
     /// Get the number of sections
@@ -302,13 +382,37 @@ class BiquadFilter {
      */
     SectionProxy section(size_t section) { return SectionProxy(*this, section); }
 
+    /// Append the filter state and design parameters to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        topology.saveState(blob);
+        design.saveState(blob);
+    }
+
+    /// Restore the filter state and design parameters from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        topology.restoreState(reader);
+        design.restoreState(reader);
+    }
+
   private:
     // Topology and design instances
     Topology topology;
     Design design;
+    size_t numActiveChannels = 0;
+
+    // Deferred coefficient updates (see beginCoeffUpdate), flagged per [ch * numSections + section]
+    bool deferCoeffUpdates = false;
+    std::vector<bool> pendingCoeffs;
 
     // Function to apply design coefficients to the topology for a specific channel and section
     void applyDesignToTopology(size_t ch, size_t section) {
+        if (deferCoeffUpdates) {
+            pendingCoeffs[ch * topology.getNumSections() + section] = true;
+            return;
+        }
+        TraceScope trace("BiquadFilter::applyDesignToTopology", TraceCategory::Parameter, this);
+        if (!pendingCoeffs.empty())
+            pendingCoeffs[ch * topology.getNumSections() + section] = false;
         T b0, b1, b2, a1, a2;
         design.computeCoeffs(ch, section, b0, b1, b2, a1, a2);
         topology.setCoeffs(ch, section, b0, b1, b2, a1, a2);
@@ -6,6 +6,7 @@
 
 #include "jonssonic/core/common/audio_buffer.h"
 #include "jonssonic/core/common/quantities.h"
+#include "jonssonic/core/common/state_blob.h"
 #include "jonssonic/core/filters/detail/filter_limits.h"
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cmath>
@@ -163,6 +164,22 @@ class BilinearBiquadDesign {
     /// Get current Q factor (for testing purposes)
     T getQ(size_t ch = 0, size_t section = 0) const { return Q[ch][section]; }
 
+    /// Append the design parameters to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(response);
+        blob.write(w0);
+        blob.write(g);
+        blob.write(Q);
+    }
+
+    /// Restore the design parameters from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(response);
+        reader.read(w0);
+        reader.read(g);
+        reader.read(Q);
+    }
+
   private:
     // Parameters
     bool togglePrepared = false;
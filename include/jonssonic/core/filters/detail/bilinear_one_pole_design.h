@@ -7,6 +7,7 @@
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cmath>
 #include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/state_blob.h>
 #include <jonssonic/core/common/quantities.h>
 #include <jonssonic/utils/math_utils.h>
 
@@ -129,6 +130,20 @@ class BilinearOnePoleDesign {
     /// Check if the design is prepared
     bool isPrepared() const { return togglePrepared; }
 
+    /// Append the design parameters to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(response);
+        blob.write(w0);
+        blob.write(g);
+    }
+
+    /// Restore the design parameters from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(response);
+        reader.read(w0);
+        reader.read(g);
+    }
+
   private:
     // Parameters
     bool togglePrepared = false;
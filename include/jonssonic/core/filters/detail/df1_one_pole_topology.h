@@ -6,6 +6,7 @@
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cassert>
 #include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/state_blob.h>
 #include <vector>
 
 namespace jnsc::detail {
@@ -61,6 +62,9 @@ class DF1OnePoleTopology {
     /// Reset the filter state
     void reset() { state.clear(); }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) { state.clearChannel(ch); }
+
     /**
      * @brief Process a single sample for a given channel and section.
      * @param ch Channel index.
@@ -125,6 +129,18 @@ class DF1OnePoleTopology {
     /// Get coefficient buffer (for testing purposes)
     const AudioBuffer<T>& getCoeffs() const { return coeffs; }
 
+    /// Append the coefficients and filter memories to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(coeffs);
+        blob.write(state);
+    }
+
+    /// Restore the coefficients and filter memories from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(coeffs);
+        reader.read(state);
+    }
+
   private:
     bool togglePrepared = false;
     size_t numChannels = 0;
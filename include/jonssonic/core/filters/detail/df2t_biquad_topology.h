@@ -5,6 +5,7 @@
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
 #include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/state_blob.h>
 #include <jonssonic/core/filters/detail/filter_limits.h>
 
 namespace jnsc::detail {
@@ -60,6 +61,9 @@ class DF2TBiquadTopology {
     /// Reset the filter state
     void reset() { state.clear(); }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) { state.clearChannel(ch); }
+
     /**
      * @brief Process a single sample for a specific channel and section.
      * @param ch Channel index.
@@ -131,6 +135,18 @@ class DF2TBiquadTopology {
     /// Get coefficient buffer (for testing purposes)
     const AudioBuffer<T>& getCoeffs() const { return coeffs; }
 
+    /// Append the coefficients and filter memories to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(coeffs);
+        blob.write(state);
+    }
+
+    /// Restore the coefficients and filter memories from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(coeffs);
+        reader.read(state);
+    }
+
   private:
     size_t numChannels = 0;
     size_t numSections = 0;
@@ -168,6 +168,20 @@ class SVFDesign {
     /// Get current Q factor (for testing purposes)
     T getQ(size_t ch = 0, size_t section = 0) const { return T(1) / twoR.getTargetValue(index(ch, section)); }
 
+    /// Append the response selection and coefficient smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(responseOneHot);
+        twoR.saveState(blob);
+        g.saveState(blob);
+    }
+
+    /// Restore the response selection and coefficient smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(responseOneHot);
+        twoR.restoreState(reader);
+        g.restoreState(reader);
+    }
+
   private:
     // Parameters
     bool togglePrepared = false;
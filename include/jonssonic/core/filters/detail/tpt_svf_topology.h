@@ -5,6 +5,7 @@
 
 #include "jonssonic/utils/detail/config_utils.h"
 #include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/state_blob.h>
 #include <jonssonic/core/filters/detail/filter_limits.h>
 
 namespace jnsc::detail {
@@ -58,6 +59,9 @@ class TPTSVFTopology {
     /// Reset the filter state
     void reset() { state.clear(); }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) { state.clearChannel(ch); }
+
     /**
      * @brief Process a single sample for a specific channel and section.
      * @param ch Channel index.
@@ -107,6 +111,16 @@ class TPTSVFTopology {
     /// Check if the topology is prepared
     bool isPrepared() const { return togglePrepared; }
 
+    /// Append the integrator states to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(state);
+    }
+
+    /// Restore the integrator states from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(state);
+    }
+
   private:
     bool togglePrepared = false;
     size_t numChannels = 0;
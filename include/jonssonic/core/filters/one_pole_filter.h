@@ -5,6 +5,9 @@
 #pragma once
 #include "jonssonic/core/filters/detail/filter_limits.h"
 #include "jonssonic/utils/detail/config_utils.h"
+#include <algorithm>
+#include <jonssonic/core/common/interleaved_frames.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/filters/detail/bilinear_one_pole_design.h>
 #include <jonssonic/core/filters/detail/df1_one_pole_topology.h>
 #include <jonssonic/core/filters/routing.h>
@@ -52,6 +55,22 @@ class OnePoleFilter {
     /// Reset the filter state
     void reset() { topology.reset(); }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) { topology.resetChannel(ch); }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * Prepare the filter engine for processing.
      * @param newNumChannels Number of channels
@@ -68,6 +87,7 @@ class OnePoleFilter {
         // Prepare topology and design with the new configuration
         topology.prepare(numChannels, numSections);
         design.prepare(numChannels, sampleRate, numSections);
+        numActiveChannels = numChannels;
     }
 
     /**
@@ -77,7 +97,7 @@ class OnePoleFilter {
      * @return Output sample.
      * @note Must call @ref prepare before processing.
      */
-    float processSample(size_t ch, T input) {
+    T processSample(size_t ch, T input) {
         // SERIES ROUTING
         if constexpr (RoutingType == Routing::Series) {
             T output = input;
@@ -104,11 +124,35 @@ class OnePoleFilter {
      * @note Must call @ref prepare before processing.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < topology.getNumChannels(); ++ch)
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
             for (size_t n = 0; n < numSamples; ++n)
                 output[ch][n] = processSample(ch, input[ch][n]);
     }
 
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input input pointers for each channel [channel][sample].
+     * @param output output (bus) pointers for each channel [channel][sample].
+     * @param numSamples Number of samples in the block.
+     * @param gain Gain applied to the processed signal (e.g., send level).
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] += gain * processSample(ch, input[ch][n]);
+    }
+
+    /**
+     * @brief Process a block of interleaved frames for all channels.
+     * @param input Interleaved input frames [frame][channel] (frame size is the prepared channel count)
+     * @param output Interleaved output frames [frame][channel], may alias the input
+     * @param numFrames Number of frames in the block
+     * @note Avoids deinterleaving host buffers; results match planar processing.
+     */
+    void processBlock(const T* input, T* output, size_t numFrames) {
+        processInterleavedFrames(*this, input, output, numChannels, numActiveChannels, numFrames);
+    }
+
     /**
      * @brief Set the filter response type for all channels and sections.
      * @param newResponse Desired filter response type.
@@ -156,6 +200,8 @@ class OnePoleFilter {
     bool isPrepared() const { return topology.isPrepared() && design.isPrepared(); }
     /// Get the number of channels
     size_t getNumChannels() const { return numChannels; }
+    /// Get the number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
     /// Get the sample rate from the design
     T getSampleRate() const { return sampleRate; }
     /// Get the number of sections
@@ -286,10 +332,23 @@ class OnePoleFilter {
      */
     SectionProxy section(size_t section) { return SectionProxy(*this, section); }
 
+    /// Append the filter state and design parameters to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        topology.saveState(blob);
+        design.saveState(blob);
+    }
+
+    /// Restore the filter state and design parameters from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        topology.restoreState(reader);
+        design.restoreState(reader);
+    }
+
   private:
     // Config variables
     T sampleRate = T(44100);
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     size_t numSections = 0;
 
     // Topology and design instances
@@ -300,6 +359,7 @@ class OnePoleFilter {
     void applyDesignToTopology(size_t ch, size_t section) {
         assert(ch < numChannels && "Channel index out of bounds");
         assert(section < numSections && "Section index out of bounds");
+        TraceScope trace("OnePoleFilter::applyDesignToTopology", TraceCategory::Parameter, this);
         T b0, b1, a1;
         design.computeCoeffs(ch, section, b0, b1, a1);
         topology.setCoeffs(ch, section, b0, b1, a1);
@@ -6,6 +6,8 @@
 #include "jonssonic/core/filters/detail/svf_design.h"
 #include "jonssonic/core/filters/detail/tpt_svf_topology.h"
 #include "jonssonic/core/filters/routing.h"
+#include <jonssonic/core/common/interleaved_frames.h>
+#include <algorithm>
 
 namespace jnsc {
 /**
@@ -49,6 +51,22 @@ class StateVariableFilter {
     /// Reset the filter state
     void reset() { topology.reset(); }
 
+    /// Reset the state of a single channel
+    void resetChannel(size_t ch) { topology.resetChannel(ch); }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, topology.getNumChannels());
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * Prepare the filter engine for processing.
      * @param newNumChannels Number of channels
@@ -59,6 +77,7 @@ class StateVariableFilter {
     void prepare(size_t newNumChannels, T newSampleRate, size_t newNumSections = 1) {
         topology.prepare(newNumChannels, newNumSections);
         design.prepare(newNumChannels, newSampleRate, newNumSections);
+        numActiveChannels = topology.getNumChannels();
     }
 
     /**
@@ -119,11 +138,35 @@ class StateVariableFilter {
      * @note Must call @ref prepare before processing.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < topology.getNumChannels(); ++ch)
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
             for (size_t n = 0; n < numSamples; ++n)
                 output[ch][n] = processSample(ch, input[ch][n]);
     }
 
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input input pointers for each channel [channel][sample].
+     * @param output output (bus) pointers for each channel [channel][sample].
+     * @param numSamples Number of samples in the block.
+     * @param gain Gain applied to the processed signal (e.g., send level).
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] += gain * processSample(ch, input[ch][n]);
+    }
+
+    /**
+     * @brief Process a block of interleaved frames for all channels.
+     * @param input interleaved input frames [frame][channel] (frame size is the prepared channel count).
+     * @param output interleaved output frames [frame][channel], may alias the input.
+     * @param numFrames Number of frames in the block.
+     * @note Avoids deinterleaving host buffers; results match planar processing.
+     */
+    void processBlock(const T* input, T* output, size_t numFrames) {
+        processInterleavedFrames(*this, input, output, getNumChannels(), numActiveChannels, numFrames);
+    }
+
     /**
      * @brief Set the filter response type for all channels and sections.
      * @param newResponse Desired filter response type.
@@ -180,6 +223,8 @@ class StateVariableFilter {
     bool isPrepared() const { return topology.isPrepared(); }
     /// Get the number of channels
     size_t getNumChannels() const { return topology.getNumChannels(); }
+    /// Get the number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
     /// Get the sample rate from the design
     T getSampleRate() const { return design.getSampleRate(); }
     /// Get the number of sections
@@ -286,10 +331,23 @@ class StateVariableFilter {
      */
     SectionProxy section(size_t section) { return SectionProxy(*this, section); }
 
+    /// Append the filter state and design parameters to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        topology.saveState(blob);
+        design.saveState(blob);
+    }
+
+    /// Restore the filter state and design parameters from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        topology.restoreState(reader);
+        design.restoreState(reader);
+    }
+
   private:
     // Topology and design instances
     Topology topology;
     Design design;
+    size_t numActiveChannels = 0;
 };
 
 } // namespace jnsc
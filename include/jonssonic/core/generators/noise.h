@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <jonssonic/core/common/state_blob.h>
 #include <jonssonic/utils/math_utils.h>
 #include <vector>
 
@@ -102,6 +103,25 @@ class Noise<T, NoiseType::Gaussian> {
         }
     }
 
+    /// Append the generator states to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(rngs);
+        for (bool spareReady : hasSpare) // std::vector<bool> is bit-packed, store one flag at a time
+            blob.write(spareReady);
+        blob.write(spare);
+    }
+
+    /// Restore the generator states from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(rngs);
+        for (size_t ch = 0; ch < hasSpare.size(); ++ch) {
+            bool spareReady = hasSpare[ch];
+            reader.read(spareReady);
+            hasSpare[ch] = spareReady;
+        }
+        reader.read(spare);
+    }
+
   private:
     size_t numChannels = 0;
     std::vector<utils::Xorshift32> rngs;
@@ -166,6 +186,16 @@ class Noise<T, NoiseType::Uniform> {
         }
     }
 
+    /// Append the generator states to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(rngs);
+    }
+
+    /// Restore the generator states from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(rngs);
+    }
+
   private:
     size_t numChannels = 0;
     std::vector<utils::Xorshift32> rngs;
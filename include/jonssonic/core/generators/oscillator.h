@@ -5,7 +5,9 @@
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <jonssonic/core/common/detail/aligned_allocator.h>
 #include <jonssonic/core/common/dsp_param.h>
 #include <jonssonic/core/common/quantities.h>
 #include <vector>
@@ -51,6 +53,7 @@ class Oscillator {
         // Resize and initialize to zero
         phase.assign(numChannels, T(0));
         phaseIncrement.prepare(numChannels, sampleRate);
+        numActiveChannels = numChannels;
 
         togglePrepared = true;
     }
@@ -61,6 +64,21 @@ class Oscillator {
     /// Reset phase for specific channel
     void reset(size_t channel) { phase[channel] = T(0); }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again restart
+     *       from zero phase.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch) {
+            reset(ch);
+            phaseIncrement.resetChannel(ch);
+        }
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * @brief Process single sample for a specific channel (no phase modulation)
      * @param ch Channel index
@@ -102,7 +120,7 @@ class Oscillator {
      * @param numSamples Number of samples to process
      */
     void processBlock(T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
             for (size_t i = 0; i < numSamples; ++i) {
                 // Generate waveform at current phase
                 output[ch][i] = generateWaveform(phase[ch]);
@@ -121,7 +139,7 @@ class Oscillator {
      * @param numSamples Number of samples to process
      */
     void processBlock(T* const* output, const T* const* phaseMod, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
             for (size_t i = 0; i < numSamples; ++i) {
 
                 // Calculate and wrap modulated phase using floor
@@ -180,6 +198,27 @@ class Oscillator {
      */
     void setAntiAliasing(bool enable) { useAntiAliasing = enable; }
 
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
+    /// Get sample rate
+    T getSampleRate() const { return sampleRate; }
+
+    /// Append the phases and increment smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(phase);
+        phaseIncrement.saveState(blob);
+    }
+
+    /// Restore the phases and increment smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(phase);
+        phaseIncrement.restoreState(reader);
+    }
+
   private:
     // Generate waveform sample at given phase (0.0 to 1.0)
     inline T generateWaveform(T phase) const {
@@ -207,11 +246,12 @@ class Oscillator {
 
     T sampleRate = 44100.0;
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     bool togglePrepared = false;
     Waveform waveform = Waveform::Sine;
     bool useAntiAliasing = false;
 
-    std::vector<T> phase;       // Phase per channel
-    DspParam<T> phaseIncrement; // Phase increment per channel
+    detail::AlignedVector<T> phase; // Phase per channel
+    DspParam<T> phaseIncrement;     // Phase increment per channel
 };
 } // namespace jnsc
\ No newline at end of file
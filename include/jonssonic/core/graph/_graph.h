@@ -0,0 +1,13 @@
+// Jonssonic - A C++ audio DSP library
+// Umbrella header for graph module
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "fused_chain.h"
+#include "hot_swap.h"
+#include "parallel_process.h"
+#include "processing_graph.h"
+#include "processor_chain.h"
+#include "quality_governor.h"
+#include "thread_pool.h"
@@ -0,0 +1,41 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Graph module limits and tunable constants
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cstddef>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace jnsc::detail {
+/**
+ * @brief Limits and tunable constants for the graph module.
+ */
+struct GraphLimits {
+    // Assumed cache line size in bytes (used to keep per-thread state on separate lines)
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    // Maximum number of worker threads in a thread pool
+    static constexpr size_t MAX_WORKERS = 256;
+
+    // Busy-wait iterations before an idle worker goes to sleep
+    static constexpr size_t SPIN_ITERATIONS = 20000;
+
+    // Weight of the newest measurement in the per-node cost estimate
+    static constexpr double COST_SMOOTHING = 0.1;
+};
+
+/// Hint to the CPU that the calling thread is busy-waiting.
+inline void cpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace jnsc::detail
@@ -0,0 +1,66 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Compile-time detection of processor capabilities used by the graph module
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace jnsc::detail {
+
+/// Detects `prepare(numChannels, sampleRate)`.
+template <typename P, typename T, typename = void>
+struct HasPrepareChannelsRate : std::false_type {};
+template <typename P, typename T>
+struct HasPrepareChannelsRate<P, T, std::void_t<decltype(std::declval<P&>().prepare(size_t{}, T{}))>>
+    : std::true_type {};
+
+/// Detects `prepare(numChannels, maxBlockSize, sampleRate)`.
+template <typename P, typename T, typename = void>
+struct HasPrepareChannelsBlockRate : std::false_type {};
+template <typename P, typename T>
+struct HasPrepareChannelsBlockRate<P,
+                                   T,
+                                   std::void_t<decltype(std::declval<P&>().prepare(size_t{}, size_t{}, T{}))>>
+    : std::true_type {};
+
+/// Detects `getLatencySamples() const`.
+template <typename P, typename = void>
+struct HasLatency : std::false_type {};
+template <typename P>
+struct HasLatency<P, std::void_t<decltype(std::declval<const P&>().getLatencySamples())>> : std::true_type {};
+
+/// Detects `reset()`.
+template <typename P, typename = void>
+struct HasReset : std::false_type {};
+template <typename P>
+struct HasReset<P, std::void_t<decltype(std::declval<P&>().reset())>> : std::true_type {};
+
+/**
+ * @brief Prepare a processor with whichever of the two standard prepare signatures it provides.
+ * @note The two-argument form is tried first, since filters expose `prepare(numChannels, sampleRate, numSections = 1)`
+ *       which would otherwise silently accept the three-argument call with swapped meaning.
+ */
+template <typename T, typename P>
+void prepareProcessor(P& processor, size_t numChannels, size_t maxBlockSize, T sampleRate) {
+    if constexpr (HasPrepareChannelsRate<P, T>::value)
+        processor.prepare(numChannels, sampleRate);
+    else if constexpr (HasPrepareChannelsBlockRate<P, T>::value)
+        processor.prepare(numChannels, maxBlockSize, sampleRate);
+    else
+        static_assert(HasPrepareChannelsRate<P, T>::value,
+                      "Processor must provide prepare(numChannels, sampleRate) or "
+                      "prepare(numChannels, maxBlockSize, sampleRate)");
+}
+
+/// Latency of a processor in samples (possibly fractional), or zero if it does not report any.
+template <typename T, typename P>
+T processorLatency(const P& processor) {
+    if constexpr (HasLatency<P>::value)
+        return static_cast<T>(processor.getLatencySamples());
+    else
+        return T(0);
+}
+
+} // namespace jnsc::detail
@@ -0,0 +1,78 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Counting semaphore for waking sleeping worker threads
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#if defined(JONSSONIC_LINUX) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace jnsc::detail {
+/**
+ * @brief Counting semaphore used by one sleeping thread and the threads that wake it.
+ * @details On Linux, @ref post is an atomic increment and a futex wake, so the waking (audio) thread never takes a
+ *          lock. Elsewhere it falls back to a mutex and condition variable.
+ */
+class WakeSemaphore {
+  public:
+    /// Default constructor (count 0)
+    WakeSemaphore() = default;
+
+    /// No copy nor move semantics
+    WakeSemaphore(const WakeSemaphore&) = delete;
+    WakeSemaphore& operator=(const WakeSemaphore&) = delete;
+    WakeSemaphore(WakeSemaphore&&) = delete;
+    WakeSemaphore& operator=(WakeSemaphore&&) = delete;
+
+    /// Increment the count and wake the waiting thread, if any
+    void post() {
+#if defined(JONSSONIC_LINUX) || defined(__linux__)
+        count.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&count), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count.fetch_add(1, std::memory_order_release);
+        }
+        condition.notify_one();
+#endif
+    }
+
+    /// Block until the count is positive, then decrement it
+    void wait() {
+#if defined(JONSSONIC_LINUX) || defined(__linux__)
+        while (true) {
+            uint32_t current = count.load(std::memory_order_acquire);
+            if (current > 0) {
+                if (count.compare_exchange_weak(current, current - 1, std::memory_order_acquire))
+                    return;
+                continue;
+            }
+            // Sleeps only if the count is still 0, so a post between the load and this call is not lost
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&count), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+        }
+#else
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return count.load(std::memory_order_acquire) > 0; });
+        count.fetch_sub(1, std::memory_order_acq_rel);
+#endif
+    }
+
+  private:
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word must be a plain 32-bit integer");
+    std::atomic<uint32_t> count{0};
+#if !(defined(JONSSONIC_LINUX) || defined(__linux__))
+    std::mutex mutex;
+    std::condition_variable condition;
+#endif
+};
+
+} // namespace jnsc::detail
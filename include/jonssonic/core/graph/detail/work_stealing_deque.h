@@ -0,0 +1,107 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Fixed-capacity Chase-Lev work-stealing deque of task indices
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <jonssonic/core/graph/detail/graph_limits.h>
+#include <jonssonic/utils/math_utils.h>
+#include <memory>
+
+namespace jnsc::detail {
+/**
+ * @brief Lock-free work-stealing deque (Chase-Lev) holding task indices.
+ * @details The owning thread pushes and pops at the bottom, other threads steal from the top.
+ *          Storage is allocated once in @ref prepare and never grows, so push/pop/steal never allocate.
+ */
+class WorkStealingDeque {
+  public:
+    WorkStealingDeque() = default;
+    ~WorkStealingDeque() = default;
+
+    /// No copy nor move semantics
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+    /**
+     * @brief Allocate storage for at least the given number of items and clear the deque.
+     * @param minCapacity Minimum capacity (rounded up to a power of two)
+     * @note Not thread-safe, call while no other thread accesses the deque.
+     */
+    void prepare(size_t minCapacity) {
+        size_t capacity = utils::nextPowerOfTwo(minCapacity < 2 ? 2 : minCapacity);
+        items = std::make_unique<std::atomic<size_t>[]>(capacity);
+        mask = capacity - 1;
+        top.store(0, std::memory_order_relaxed);
+        bottom.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Push an item at the bottom (owner thread only).
+     * @return False if the deque is full.
+     */
+    bool push(size_t item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        if (b - t > static_cast<int64_t>(mask))
+            return false;
+        items[static_cast<size_t>(b) & mask].store(item, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop an item from the bottom (owner thread only).
+     * @return False if the deque is empty.
+     */
+    bool pop(size_t& item) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = items[static_cast<size_t>(b) & mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last item, race against thieves
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Steal an item from the top (any thread).
+     * @return False if the deque was empty or the steal lost a race.
+     */
+    bool steal(size_t& item) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return false;
+
+        item = items[static_cast<size_t>(t) & mask].load(std::memory_order_relaxed);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /// Get capacity in items
+    size_t getCapacity() const { return items ? mask + 1 : 0; }
+
+  private:
+    alignas(GraphLimits::CACHE_LINE_SIZE) std::atomic<int64_t> top{0};
+    alignas(GraphLimits::CACHE_LINE_SIZE) std::atomic<int64_t> bottom{0};
+    alignas(GraphLimits::CACHE_LINE_SIZE) std::unique_ptr<std::atomic<size_t>[]> items;
+    size_t mask = 0;
+};
+
+} // namespace jnsc::detail
@@ -0,0 +1,153 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Expression-template fusion of per-sample processors into a single processing loop
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/core/filters/one_pole_filter.h>
+#include <jonssonic/core/mixing/dry_wet_mixer.h>
+#include <jonssonic/core/nonlinear/wave_shaper_processor.h>
+#include <tuple>
+#include <type_traits>
+
+namespace jnsc {
+
+/**
+ * @brief Trait marking processors that can be composed with `operator>>` into a @ref FusedChain.
+ * @tparam P Processor type
+ * @note Fusable processors provide `processSample(ch, x)` and `getNumChannels()`.
+ *       Specialize to std::true_type to opt other processors in.
+ */
+template <typename P>
+struct IsFusable : std::false_type {};
+
+template <typename T, WaveShaperType ShaperType>
+struct IsFusable<WaveShaperProcessor<T, ShaperType>> : std::true_type {};
+
+template <typename T, typename Topology, typename Design, Routing RoutingType>
+struct IsFusable<BiquadFilter<T, Topology, Design, RoutingType>> : std::true_type {};
+
+template <typename T, typename Topology, typename Design, Routing RoutingType>
+struct IsFusable<OnePoleFilter<T, Topology, Design, RoutingType>> : std::true_type {};
+
+template <typename T>
+struct IsFusable<DryWetMixer<T>> : std::true_type {};
+
+namespace detail {
+/// Run one fused stage on a sample (single-input processors ignore the dry sample).
+template <typename P, typename T>
+T fusedProcessSample(P& processor, size_t ch, T x, T /*dry*/) {
+    return processor.processSample(ch, x);
+}
+
+/// Dry/wet mixers take the chain input as dry signal and the running sample as wet signal.
+template <typename T>
+T fusedProcessSample(DryWetMixer<T>& mixer, size_t ch, T x, T dry) {
+    return mixer.processSample(ch, dry, x);
+}
+} // namespace detail
+
+/**
+ * @brief Chain of per-sample processors executed in a single loop over the buffer.
+ * @details Built with `operator>>`, e.g. `auto fx = shaper >> filter >> mixer;`. Each sample is loaded once,
+ *          passed through every stage while held in a local, and stored once, instead of every stage making
+ *          its own pass over memory. A @ref DryWetMixer stage mixes the chain input (dry) with the running
+ *          sample (wet).
+ * @tparam Stages Processor types, held by reference. The processors must outlive the chain.
+ */
+template <typename... Stages>
+class FusedChain {
+  public:
+    /**
+     * @brief Construct a chain from processor references.
+     * @param newStages Processors in processing order
+     */
+    explicit FusedChain(Stages&... newStages) : stages(newStages...) {}
+
+    /**
+     * @brief Process a single sample of a specific channel through all stages.
+     * @param ch Channel index
+     * @param x Input sample
+     * @return Output sample
+     */
+    template <typename T>
+    T processSample(size_t ch, T x) {
+        return processSampleImpl(ch, x, std::index_sequence_for<Stages...>{});
+    }
+
+    /**
+     * @brief Process a block of samples for all channels in one fused pass.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @note Input and output may alias.
+     */
+    template <typename T>
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        const size_t numChannels = getNumChannels();
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const T* in = input[ch];
+            T* out = output[ch];
+            for (size_t n = 0; n < numSamples; ++n)
+                out[n] = processSampleImpl(ch, in[n], std::index_sequence_for<Stages...>{});
+        }
+    }
+
+    /// Get number of channels (taken from the first stage)
+    size_t getNumChannels() const { return std::get<0>(stages).getNumChannels(); }
+
+    /// Get number of fused stages
+    static constexpr size_t getNumStages() { return sizeof...(Stages); }
+
+    /**
+     * @brief Access a stage of the chain.
+     * @tparam I Stage index
+     */
+    template <size_t I>
+    auto& get() {
+        return std::get<I>(stages);
+    }
+
+  private:
+    template <typename... Others>
+    friend class FusedChain;
+
+    // Construct from an already built tuple of references (used when appending stages)
+    explicit FusedChain(std::tuple<Stages&...> newStages) : stages(newStages) {}
+
+    std::tuple<Stages&...> stages;
+
+    template <typename T, size_t... I>
+    T processSampleImpl(size_t ch, T x, std::index_sequence<I...>) {
+        const T dry = x;
+        ((x = detail::fusedProcessSample(std::get<I>(stages), ch, x, dry)), ...);
+        return x;
+    }
+
+  public:
+    /**
+     * @brief Append a processor to the chain.
+     * @param next Processor to run after the current stages
+     * @return New chain referencing all stages
+     */
+    template <typename P, typename = std::enable_if_t<IsFusable<P>::value>>
+    FusedChain<Stages..., P> operator>>(P& next) const {
+        return FusedChain<Stages..., P>(std::tuple_cat(stages, std::tie(next)));
+    }
+};
+
+/**
+ * @brief Fuse two processors into a @ref FusedChain.
+ * @param first Processor running first
+ * @param second Processor running second
+ */
+template <typename A,
+          typename B,
+          typename = std::enable_if_t<IsFusable<A>::value && IsFusable<B>::value>>
+FusedChain<A, B> operator>>(A& first, B& second) {
+    return FusedChain<A, B>(first, second);
+}
+
+} // namespace jnsc
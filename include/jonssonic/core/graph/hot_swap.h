@@ -0,0 +1,268 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Background re-preparation of a processor with a lock-free swap at a block boundary
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/delays/latency_compensator.h>
+#include <jonssonic/core/graph/detail/processor_traits.h>
+#include <jonssonic/core/mixing/crossfader.h>
+#include <memory>
+#include <thread>
+
+namespace jnsc {
+/**
+ * @brief Owns a processor and replaces it with a freshly prepared instance without stopping audio.
+ * @details @ref prepare allocates, so a change of sample rate, channel count or maximum block/delay size normally
+ *          means stopping the audio thread. With a hot swap, @ref requestPrepare builds and prepares a new instance
+ *          on a background thread, and the audio thread picks it up at the start of its next block by exchanging
+ *          an atomic pointer. When the old and new instance run at the same channel count and sample rate, and the
+ *          new maximum block size does not exceed the old one, the switch can be crossfaded (equal power, with whichever instance is ahead delayed to match the other).
+ *          A new instance with less latency than the current one keeps that alignment delay after the fade, so the
+ *          output never jumps back in time; a synchronous @ref prepare drops it. The replaced instance is handed back
+ *          to the background thread, which destroys it, so the audio thread never allocates or frees.
+ * @tparam T Sample data type (e.g., float, double)
+ * @tparam Processor Processor type providing `processBlock(const T* const*, T* const*, size_t)` and either of the
+ *         standard prepare signatures
+ * @note Thread roles: @ref processBlock and @ref get belong to the audio thread; @ref prepare, @ref requestPrepare
+ *       and @ref collectRetired to a single control thread. Only one reconfiguration is in flight at a time.
+ */
+template <typename T, typename Processor>
+class HotSwap {
+  public:
+    /// Callback run on the background thread to configure a new instance (e.g., set parameters) before the swap
+    using Configure = std::function<void(Processor&)>;
+
+    /// Default constructor (no instance until @ref prepare or @ref requestPrepare)
+    HotSwap() = default;
+
+    /// Destructor stops the background thread and destroys all instances
+    ~HotSwap() {
+        stopRequested.store(true, std::memory_order_release);
+        if (builder.joinable())
+            builder.join();
+        delete current;
+        delete fadingOut;
+        delete pending.exchange(nullptr);
+        delete retired.exchange(nullptr);
+    }
+
+    /// No copy nor move semantics
+    HotSwap(const HotSwap&) = delete;
+    HotSwap& operator=(const HotSwap&) = delete;
+    HotSwap(HotSwap&&) = delete;
+    HotSwap& operator=(HotSwap&&) = delete;
+
+    /**
+     * @brief Prepare synchronously (not realtime safe, the audio thread must not be running).
+     * @param numChannels Number of channels
+     * @param maxBlockSize Maximum block size
+     * @param sampleRate Sample rate in Hz
+     * @param configure Optional configuration applied to the new instance
+     */
+    void prepare(size_t numChannels, size_t maxBlockSize, T sampleRate, const Configure& configure = {}) {
+        // A requested instance may never be taken since audio is stopped, so the background thread must not wait
+        stopRequested.store(true, std::memory_order_release);
+        if (builder.joinable())
+            builder.join();
+        stopRequested.store(false, std::memory_order_relaxed);
+        building.store(false, std::memory_order_relaxed);
+        delete current;
+        delete fadingOut;
+        delete pending.exchange(nullptr);
+        delete retired.exchange(nullptr);
+        fadingOut = nullptr;
+        fadeActive.store(false, std::memory_order_relaxed);
+        current = makeInstance(numChannels, maxBlockSize, sampleRate, 0, T(0), configure).release();
+    }
+
+    /**
+     * @brief Build a newly prepared instance on a background thread and swap it in at a block boundary.
+     * @param numChannels Number of channels
+     * @param maxBlockSize Maximum block size
+     * @param sampleRate Sample rate in Hz
+     * @param crossfadeSamples Crossfade length (0 switches instantly, also used when the layout changes or the
+     *        maximum block size grows)
+     * @param configure Optional configuration applied to the new instance on the background thread
+     * @return False if a previous reconfiguration has not completed yet
+     */
+    bool requestPrepare(size_t numChannels,
+                        size_t maxBlockSize,
+                        T sampleRate,
+                        size_t crossfadeSamples = 0,
+                        Configure configure = {}) {
+        if (isSwapPending())
+            return false;
+        if (builder.joinable())
+            builder.join();
+        collectRetired();
+
+        // No swap is in flight, so the current instance is stable here. Only fade between matching layouts, and only
+        // when the outgoing instance can take every block the new maximum allows.
+        const bool canFade = current && crossfadeSamples > 0 && current->numChannels == numChannels &&
+                             current->sampleRate == sampleRate && maxBlockSize <= current->maxBlockSize;
+        const size_t fadeSamples = canFade ? crossfadeSamples : 0;
+        const T currentLatency = canFade ? current->latencySamples : T(0);
+
+        building.store(true, std::memory_order_release);
+        builder = std::thread([this, numChannels, maxBlockSize, sampleRate, fadeSamples, currentLatency, configure] {
+            auto instance = makeInstance(numChannels, maxBlockSize, sampleRate, fadeSamples, currentLatency, configure);
+            pending.store(instance.release(), std::memory_order_release);
+
+            // Wait for the audio thread to take the instance and finish fading out its predecessor, then free it
+            while (!stopRequested.load(std::memory_order_acquire)) {
+                const bool taken = pending.load(std::memory_order_acquire) == nullptr;
+                if (taken && !fadeActive.load(std::memory_order_acquire))
+                    break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            collectRetired();
+            building.store(false, std::memory_order_release);
+        });
+        return true;
+    }
+
+    /// True while a requested instance is being built, waiting for the swap or fading in
+    bool isSwapPending() const { return building.load(std::memory_order_acquire); }
+
+    /// Destroy an instance retired by the audio thread (control thread; also done by the background thread)
+    void collectRetired() { delete retired.exchange(nullptr, std::memory_order_acq_rel); }
+
+    /**
+     * @brief Process a block with the current instance, switching to a pending instance first if there is one.
+     * @param input Input buffer (array of pointers to channel data)
+     * @param output Output buffer (array of pointers to channel data)
+     * @param numSamples Number of samples (at most the maximum block size of the current instance)
+     * @note The output is left untouched until an instance has been prepared. When a requested layout has more
+     *       channels or a larger block size, the caller's buffers must already be sized for it.
+     */
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        if (!fadingOut && retired.load(std::memory_order_acquire) == nullptr) {
+            // Clear pending only after swap has published retired/fadeActive, which the background thread checks next
+            if (Instance* next = pending.load(std::memory_order_acquire)) {
+                swap(next);
+                pending.store(nullptr, std::memory_order_release);
+            }
+        }
+
+        if (!current)
+            return;
+        if (!fadingOut) {
+            processCurrent(input, output, numSamples);
+            return;
+        }
+
+        // Old instance into the fade buffer first, so in-place processing still sees the input
+        T* const* fadePtrs = current->fadeBuffer.writePtrs();
+        fadingOut->processor.processBlock(input, fadePtrs, numSamples);
+        processCurrent(input, output, numSamples);
+        current->crossfader.processBlock(fadePtrs, output, output, numSamples, fadeDelaySamples);
+
+        fadeRemaining -= std::min(fadeRemaining, numSamples);
+        if (fadeRemaining == 0) {
+            retired.store(fadingOut, std::memory_order_release);
+            fadingOut = nullptr;
+            fadeActive.store(false, std::memory_order_release);
+        }
+    }
+
+    /// Current instance (audio thread only, e.g., to set parameters), or nullptr before the first prepare
+    Processor* get() { return current ? &current->processor : nullptr; }
+
+    /// Channel count of the current instance
+    size_t getNumChannels() const { return current ? current->numChannels : 0; }
+
+    /// Maximum block size of the current instance
+    size_t getMaxBlockSize() const { return current ? current->maxBlockSize : 0; }
+
+    /// Sample rate of the current instance
+    T getSampleRate() const { return current ? current->sampleRate : T(0); }
+
+    /// Latency of the current instance in samples (including its alignment delay)
+    T getLatencySamples() const { return current ? current->latencySamples : T(0); }
+
+  private:
+    /// A prepared processor together with what the audio thread needs to fade it in
+    struct Instance {
+        Processor processor;
+        size_t numChannels = 0;
+        size_t maxBlockSize = 0;
+        T sampleRate = T(0);
+        T latencySamples = T(0); // Processor latency plus alignment delay
+        size_t crossfadeSamples = 0;
+        size_t alignDelaySamples = 0;     // Delay matching the latency of the instance faded out
+        LatencyCompensator<T> alignDelay; // Applied to the output of this instance
+        AudioBuffer<T> fadeBuffer;        // Output of the instance fading out
+        Crossfader<T> crossfader;
+    };
+
+    Instance* current = nullptr;   // Audio thread
+    Instance* fadingOut = nullptr; // Audio thread
+    size_t fadeRemaining = 0;
+    size_t fadeDelaySamples = 0;
+
+    std::atomic<Instance*> pending{nullptr}; // Background -> audio
+    std::atomic<Instance*> retired{nullptr}; // Audio -> background/control
+    std::atomic<bool> fadeActive{false};
+    std::atomic<bool> building{false};
+    std::atomic<bool> stopRequested{false};
+    std::thread builder;
+
+    static std::unique_ptr<Instance> makeInstance(size_t numChannels,
+                                                  size_t maxBlockSize,
+                                                  T sampleRate,
+                                                  size_t crossfadeSamples,
+                                                  T fadeFromLatency,
+                                                  const Configure& configure) {
+        auto instance = std::make_unique<Instance>();
+        detail::prepareProcessor<T>(instance->processor, numChannels, maxBlockSize, sampleRate);
+        if (configure)
+            configure(instance->processor);
+        instance->numChannels = numChannels;
+        instance->maxBlockSize = maxBlockSize;
+        instance->sampleRate = sampleRate;
+        instance->latencySamples = detail::processorLatency<T>(instance->processor);
+        instance->crossfadeSamples = crossfadeSamples;
+        if (crossfadeSamples > 0) {
+            // Delay this instance when it is ahead of the one it replaces; the crossfader delays the other one
+            instance->alignDelaySamples =
+                LatencyCompensator<T>::latencyToSamples(fadeFromLatency - instance->latencySamples);
+            instance->alignDelay.prepare(numChannels, instance->alignDelaySamples);
+            instance->latencySamples += static_cast<T>(instance->alignDelaySamples);
+            instance->fadeBuffer.resize(numChannels, maxBlockSize);
+            instance->crossfader.prepare(numChannels,
+                                         LatencyCompensator<T>::latencyToSamples(instance->latencySamples));
+        }
+        return instance;
+    }
+
+    // Audio thread: process with the current instance and its alignment delay
+    void processCurrent(const T* const* input, T* const* output, size_t numSamples) {
+        current->processor.processBlock(input, output, numSamples);
+        if (current->alignDelaySamples > 0)
+            current->alignDelay.processBlock(output, output, numSamples);
+    }
+
+    // Audio thread: make the new instance current, fading out the old one if the new one was built to fade
+    void swap(Instance* next) {
+        Instance* previous = current;
+        current = next;
+        if (!previous || next->crossfadeSamples == 0) {
+            retired.store(previous, std::memory_order_release);
+            return;
+        }
+        fadingOut = previous;
+        fadeRemaining = next->crossfadeSamples;
+        const T extraLatency = next->latencySamples - previous->latencySamples;
+        fadeDelaySamples = LatencyCompensator<T>::latencyToSamples(extraLatency);
+        next->crossfader.startCrossfade(next->crossfadeSamples);
+        fadeActive.store(true, std::memory_order_release);
+    }
+};
+
+} // namespace jnsc
@@ -0,0 +1,115 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Channel-sharded parallel processing for channel-independent processors
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <jonssonic/core/common/detail/aligned_allocator.h>
+#include <jonssonic/core/graph/thread_pool.h>
+#include <type_traits>
+#include <utility>
+
+namespace jnsc {
+
+/**
+ * @brief Smallest channel shard for sample type T.
+ * @details Per-channel state is stored in cache-line aligned arrays with one or more values of T per channel,
+ *          so shards spanning a multiple of this many channels never share a cache line with their neighbours.
+ */
+template <typename T>
+constexpr size_t channelShardGranularity() {
+    return detail::STORAGE_ALIGNMENT / sizeof(T) > 0 ? detail::STORAGE_ALIGNMENT / sizeof(T) : 1;
+}
+
+namespace detail {
+template <typename Function>
+struct ChannelShardTask {
+    Function& function;
+    size_t numChannels;
+    size_t shardSize;
+
+    static void run(void* context, size_t shard, size_t /*worker*/) {
+        auto* task = static_cast<ChannelShardTask*>(context);
+        size_t chBegin = shard * task->shardSize;
+        size_t chEnd = std::min(chBegin + task->shardSize, task->numChannels);
+        task->function(chBegin, chEnd);
+    }
+};
+} // namespace detail
+
+/**
+ * @brief Split a channel range into shards and run them on the thread pool.
+ * @param pool Thread pool
+ * @param numChannels Number of channels
+ * @param granularity Shard sizes are multiples of this many channels
+ * @param function Callable invoked as `function(chBegin, chEnd)` for each shard
+ * @note Does not allocate. Blocks until all shards are done.
+ */
+template <typename Function>
+void parallelForChannels(ThreadPool& pool, size_t numChannels, size_t granularity, Function&& function) {
+    if (numChannels == 0)
+        return;
+    granularity = std::max<size_t>(granularity, 1);
+
+    size_t numGroups = (numChannels + granularity - 1) / granularity;
+    size_t numShards = std::min(numGroups, pool.getNumThreads());
+    size_t shardSize = ((numGroups + numShards - 1) / numShards) * granularity;
+    numShards = (numChannels + shardSize - 1) / shardSize;
+
+    if (numShards == 1) {
+        function(size_t(0), numChannels);
+        return;
+    }
+
+    detail::ChannelShardTask<std::remove_reference_t<Function>> task{function, numChannels, shardSize};
+    pool.parallelFor(numShards, &decltype(task)::run, &task);
+}
+
+/**
+ * @brief Process a block with a channel-independent processor, sharding channels across the thread pool.
+ * @param pool Thread pool
+ * @param processor Processor providing `processSample(ch, x)` and `getNumChannels()`
+ *        (e.g., BiquadFilter, StateVariableFilter, OnePoleFilter, DelayLine, EnvelopeFollower)
+ * @param input Input sample pointers (one per channel)
+ * @param output Output sample pointers (one per channel)
+ * @param numSamples Number of samples to process
+ * @param granularity Shard sizes are multiples of this many channels (default avoids false sharing)
+ * @note Only valid for processors whose channels do not interact.
+ */
+template <typename Processor, typename T>
+void parallelProcessBlock(ThreadPool& pool,
+                          Processor& processor,
+                          const T* const* input,
+                          T* const* output,
+                          size_t numSamples,
+                          size_t granularity = channelShardGranularity<T>()) {
+    parallelForChannels(pool, processor.getNumChannels(), granularity, [&](size_t chBegin, size_t chEnd) {
+        for (size_t ch = chBegin; ch < chEnd; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] = processor.processSample(ch, input[ch][n]);
+    });
+}
+
+/**
+ * @brief Generate a block with a channel-independent generator, sharding channels across the thread pool.
+ * @param pool Thread pool
+ * @param generator Generator providing `processSample(ch)` and `getNumChannels()` (e.g., Oscillator)
+ * @param output Output sample pointers (one per channel)
+ * @param numSamples Number of samples to generate
+ * @param granularity Shard sizes are multiples of this many channels (default avoids false sharing)
+ */
+template <typename Generator, typename T>
+void parallelProcessBlock(ThreadPool& pool,
+                          Generator& generator,
+                          T* const* output,
+                          size_t numSamples,
+                          size_t granularity = channelShardGranularity<T>()) {
+    parallelForChannels(pool, generator.getNumChannels(), granularity, [&](size_t chBegin, size_t chEnd) {
+        for (size_t ch = chBegin; ch < chEnd; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] = generator.processSample(ch);
+    });
+}
+
+} // namespace jnsc
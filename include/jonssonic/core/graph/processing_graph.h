@@ -0,0 +1,452 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// DAG of processors scheduled per block across a work-stealing thread pool
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/delays/latency_compensator.h>
+#include <jonssonic/core/graph/detail/graph_limits.h>
+#include <jonssonic/core/graph/detail/processor_traits.h>
+#include <jonssonic/core/graph/thread_pool.h>
+#include <jonssonic/utils/detail/config_utils.h>
+#include <memory>
+#include <vector>
+
+namespace jnsc {
+/**
+ * @brief Directed acyclic graph of processors executed block by block.
+ * @details Nodes without inputs read the graph input, nodes without outputs are summed into the graph output.
+ *          A node with several incoming edges (e.g., a send/return bus) receives the gain-weighted sum of its inputs.
+ *          Parallel branches are latency compensated: inputs of a summing node and sinks that arrive earlier than
+ *          the slowest path are delayed by @ref LatencyCompensator instances sized in @ref prepare.
+ *          With a @ref ThreadPool attached, ready nodes are scheduled across cores: a node is released as soon as
+ *          all of its inputs are done, and among ready nodes the one with the longest remaining path
+ *          (estimated from measured per-node costs) runs first.
+ *          An optional deadline bounds the block: nodes that have not started when it expires are skipped
+ *          and output silence.
+ * @tparam T Sample data type (e.g., float, double)
+ * @note Topology changes (@ref addNode, @ref connect) and @ref prepare allocate and are not realtime safe.
+ *       Branch alignment uses the node latencies at @ref prepare time; prepare again if a latency changes.
+ */
+template <typename T>
+class ProcessingGraph {
+  public:
+    /// Node handle
+    using NodeId = size_t;
+
+    /// Default constructor
+    ProcessingGraph() = default;
+
+    /// Default destructor
+    ~ProcessingGraph() = default;
+
+    /// No copy nor move semantics
+    ProcessingGraph(const ProcessingGraph&) = delete;
+    ProcessingGraph& operator=(const ProcessingGraph&) = delete;
+    ProcessingGraph(ProcessingGraph&&) = delete;
+    ProcessingGraph& operator=(ProcessingGraph&&) = delete;
+
+    /**
+     * @brief Add a processor as a node.
+     * @param processor Processor providing `processBlock(const T* const*, T* const*, size_t)`. Must outlive the graph.
+     * @return Node handle
+     */
+    template <typename P>
+    NodeId addNode(P& processor) {
+        Node node;
+        node.processor = &processor;
+        node.process = [](void* p, const T* const* in, T* const* out, size_t n) {
+            static_cast<P*>(p)->processBlock(in, out, n);
+        };
+        node.prepare = [](void* p, size_t numCh, size_t maxBlock, T sr) {
+            detail::prepareProcessor<T>(*static_cast<P*>(p), numCh, maxBlock, sr);
+        };
+        node.reset = [](void* p) { static_cast<P*>(p)->reset(); };
+        node.latency = [](const void* p) { return detail::processorLatency<T>(*static_cast<const P*>(p)); };
+        nodes.push_back(std::move(node));
+        togglePrepared = false;
+        return nodes.size() - 1;
+    }
+
+    /**
+     * @brief Connect the output of one node to the input of another.
+     * @param from Source node
+     * @param to Destination node
+     * @param gain Gain applied to this connection (e.g., send level)
+     */
+    void connect(NodeId from, NodeId to, T gain = T(1)) {
+        assert(from < nodes.size() && to < nodes.size() && from != to && "Invalid connection");
+        nodes[to].inputs.push_back({from, gain});
+        nodes[from].successors.push_back(to);
+        togglePrepared = false;
+    }
+
+    /**
+     * @brief Attach a thread pool for parallel execution (nullptr runs everything on the calling thread).
+     * @param newPool Thread pool, must outlive the graph
+     * @note Allocates queue capacity in the pool, call from a non-realtime thread.
+     */
+    void setThreadPool(ThreadPool* newPool) {
+        pool = newPool;
+        if (pool)
+            pool->reserve(nodes.size());
+    }
+
+    /**
+     * @brief Prepare the graph and all node processors.
+     * @param newNumChannels Number of channels
+     * @param newMaxBlockSize Maximum block size for processing
+     * @param newSampleRate Sample rate in Hz
+     * @param prepareNodes If false, node processors are assumed to be prepared already
+     */
+    void prepare(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate, bool prepareNodes = true) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        maxBlockSize = newMaxBlockSize;
+        sampleRate = utils::detail::clampSampleRate(newSampleRate);
+
+        for (auto& node : nodes) {
+            if (prepareNodes)
+                node.prepare(node.processor, numChannels, maxBlockSize, sampleRate);
+            node.inputBuffer.resize(numChannels, maxBlockSize);
+            node.outputBuffer.resize(numChannels, maxBlockSize);
+            node.inputPtrs.resize(numChannels);
+            node.outputPtrs.resize(numChannels);
+            node.sourcePtrs.resize(numChannels);
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                node.inputPtrs[ch] = node.inputBuffer.writeChannelPtr(ch);
+                node.outputPtrs[ch] = node.outputBuffer.writeChannelPtr(ch);
+            }
+        }
+
+        pendingInputs = std::make_unique<std::atomic<size_t>[]>(nodes.size());
+        computeTopologicalOrder();
+        updateLatencyCompensation();
+        updatePriorities();
+        if (pool)
+            pool->reserve(nodes.size());
+        togglePrepared = true;
+    }
+
+    /// Reset the state of all node processors
+    void reset() {
+        for (auto& node : nodes) {
+            node.reset(node.processor);
+            for (auto& delay : node.inputDelays)
+                if (delay)
+                    delay->reset();
+        }
+        for (auto& delay : sinkDelays)
+            if (delay)
+                delay->reset();
+    }
+
+    /**
+     * @brief Process one block through the graph.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     */
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        assert(togglePrepared && "ProcessingGraph must be prepared before processing");
+        assert(numSamples <= maxBlockSize && "Block exceeds prepared size");
+
+        graphInput = input;
+        blockSize = numSamples;
+        blockStart = Clock::now();
+        updatePriorities();
+
+        if (pool && pool->getNumThreads() > 1) {
+            for (size_t i = 0; i < nodes.size(); ++i)
+                pendingInputs[i].store(nodes[i].inputs.size(), std::memory_order_relaxed);
+            pool->run(&ProcessingGraph::runTask, this, sources.data(), sources.size(), nodes.size());
+        } else {
+            for (NodeId id : topologicalOrder)
+                runNode(id);
+        }
+
+        // Sum sink nodes into the graph output, delaying the ones on shorter paths
+        bool first = true;
+        for (size_t s = 0; s < sinks.size(); ++s) {
+            const auto& node = nodes[sinks[s]];
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                const T* src = node.outputPtrs[ch];
+                if (sinkDelays[s]) {
+                    T* delayed = sinkDelayBuffer.writeChannelPtr(ch);
+                    sinkDelays[s]->processChannel(ch, src, delayed, numSamples);
+                    src = delayed;
+                }
+                T* dst = output[ch];
+                if (first)
+                    std::copy(src, src + numSamples, dst);
+                else
+                    for (size_t n = 0; n < numSamples; ++n)
+                        dst[n] += src[n];
+            }
+            first = false;
+        }
+        if (first)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                std::fill(output[ch], output[ch] + numSamples, T(0));
+    }
+
+    /**
+     * @brief Set the processing deadline per block, measured from the start of @ref processBlock.
+     * @param newDeadline Deadline time (zero disables the deadline)
+     */
+    void setDeadline(Time<T> newDeadline) {
+        T seconds = newDeadline.toSeconds(sampleRate);
+        deadline = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    /**
+     * @brief Provide an initial cost estimate for a node, before any measurement exists.
+     * @param id Node handle
+     * @param costNs Estimated processing time per block in nanoseconds
+     */
+    void setNodeCostHint(NodeId id, double costNs) { nodes[id].costNs = costNs; }
+
+    /// Get the current cost estimate of a node in nanoseconds per block
+    double getNodeCost(NodeId id) const { return nodes[id].costNs; }
+
+    /// Get the number of node executions skipped because the deadline expired
+    size_t getNumDeadlineMisses() const { return deadlineMisses.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the output of a node from the last processed block.
+     * @param id Node handle
+     * @return Read pointers (one per channel)
+     */
+    const T* const* getNodeOutput(NodeId id) const { return nodes[id].outputPtrs.data(); }
+
+    /// Longest path latency through the graph, in samples (possibly fractional)
+    T getLatencySamples() const {
+        std::vector<T> pathLatency;
+        computePathLatencies(pathLatency);
+        T maxLatency = T(0);
+        for (NodeId id : sinks)
+            maxLatency = std::max(maxLatency, pathLatency[id]);
+        return maxLatency;
+    }
+
+    /// Get number of nodes
+    size_t getNumNodes() const { return nodes.size(); }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Get sample rate
+    T getSampleRate() const { return sampleRate; }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Edge {
+        NodeId from;
+        T gain;
+    };
+
+    struct Node {
+        Node() = default;
+        Node(Node&&) = default;
+        Node& operator=(Node&&) = default;
+
+        // Type-erased processor
+        void* processor = nullptr;
+        void (*process)(void*, const T* const*, T* const*, size_t) = nullptr;
+        void (*prepare)(void*, size_t, size_t, T) = nullptr;
+        void (*reset)(void*) = nullptr;
+        T (*latency)(const void*) = nullptr;
+
+        // Connectivity
+        std::vector<Edge> inputs;
+        std::vector<NodeId> successors;
+
+        // Buffers
+        AudioBuffer<T> inputBuffer;
+        AudioBuffer<T> outputBuffer;
+        std::vector<T*> inputPtrs;
+        std::vector<T*> outputPtrs;
+        std::vector<const T*> sourcePtrs;
+
+        // Latency compensation per input edge (nullptr when aligned)
+        std::vector<std::unique_ptr<LatencyCompensator<T>>> inputDelays;
+        AudioBuffer<T> delayBuffer;
+
+        // Cost model
+        double costNs = 0.0;
+        double priority = 0.0;
+    };
+
+    // Config variables
+    size_t numChannels = 0;
+    size_t maxBlockSize = 0;
+    T sampleRate = T(44100);
+    bool togglePrepared = false;
+
+    // Graph
+    std::vector<Node> nodes;
+    std::vector<NodeId> topologicalOrder;
+    std::vector<NodeId> sources;
+    std::vector<NodeId> sinks;
+    std::unique_ptr<std::atomic<size_t>[]> pendingInputs;
+    std::vector<std::unique_ptr<LatencyCompensator<T>>> sinkDelays; // Per sink (nullptr when aligned)
+    AudioBuffer<T> sinkDelayBuffer;
+    ThreadPool* pool = nullptr;
+
+    // Per-block state
+    const T* const* graphInput = nullptr;
+    size_t blockSize = 0;
+    Clock::time_point blockStart;
+    Clock::duration deadline = Clock::duration::zero();
+    std::atomic<size_t> deadlineMisses{0};
+
+    static void runTask(void* context, size_t task, size_t worker) {
+        auto* graph = static_cast<ProcessingGraph*>(context);
+        graph->runNode(task);
+
+        // Release successors, highest priority last so the owner pops it first
+        for (NodeId next : graph->nodes[task].successors)
+            if (graph->pendingInputs[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                graph->pool->spawn(worker, next);
+    }
+
+    void runNode(NodeId id) {
+        Node& node = nodes[id];
+
+        if (deadline != Clock::duration::zero() && Clock::now() - blockStart > deadline) {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                std::fill(node.outputPtrs[ch], node.outputPtrs[ch] + blockSize, T(0));
+            deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const T* const* in = gatherInputs(node);
+        auto start = Clock::now();
+        node.process(node.processor, in, node.outputPtrs.data(), blockSize);
+        double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        node.costNs += detail::GraphLimits::COST_SMOOTHING * (elapsedNs - node.costNs);
+    }
+
+    // Resolve the input of a node, summing only when several inputs or a gain are involved
+    const T* const* gatherInputs(Node& node) {
+        if (node.inputs.empty())
+            return graphInput;
+
+        if (node.inputs.size() == 1 && node.inputs[0].gain == T(1)) {
+            const Node& src = nodes[node.inputs[0].from];
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                node.sourcePtrs[ch] = src.outputPtrs[ch];
+            return node.sourcePtrs.data();
+        }
+
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            T* dst = node.inputPtrs[ch];
+            std::fill(dst, dst + blockSize, T(0));
+            for (size_t e = 0; e < node.inputs.size(); ++e) {
+                const Edge& edge = node.inputs[e];
+                const T* src = nodes[edge.from].outputPtrs[ch];
+                if (node.inputDelays[e]) {
+                    T* delayed = node.delayBuffer.writeChannelPtr(ch);
+                    node.inputDelays[e]->processChannel(ch, src, delayed, blockSize);
+                    src = delayed;
+                }
+                for (size_t n = 0; n < blockSize; ++n)
+                    dst[n] += edge.gain * src[n];
+            }
+        }
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            node.sourcePtrs[ch] = node.inputPtrs[ch];
+        return node.sourcePtrs.data();
+    }
+
+    // Kahn's algorithm, also collects sources and sinks
+    void computeTopologicalOrder() {
+        topologicalOrder.clear();
+        sources.clear();
+        sinks.clear();
+        std::vector<size_t> inDegree(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            inDegree[i] = nodes[i].inputs.size();
+            if (inDegree[i] == 0) {
+                sources.push_back(i);
+                topologicalOrder.push_back(i);
+            }
+            if (nodes[i].successors.empty())
+                sinks.push_back(i);
+        }
+        for (size_t head = 0; head < topologicalOrder.size(); ++head)
+            for (NodeId next : nodes[topologicalOrder[head]].successors)
+                if (--inDegree[next] == 0)
+                    topologicalOrder.push_back(next);
+        assert(topologicalOrder.size() == nodes.size() && "ProcessingGraph contains a cycle");
+    }
+
+    // Latency from the graph input to the output of every node, in samples
+    void computePathLatencies(std::vector<T>& pathLatency) const {
+        pathLatency.assign(nodes.size(), T(0));
+        for (NodeId id : topologicalOrder) {
+            T inputLatency = T(0);
+            for (const auto& edge : nodes[id].inputs)
+                inputLatency = std::max(inputLatency, pathLatency[edge.from]);
+            pathLatency[id] = inputLatency + nodes[id].latency(nodes[id].processor);
+        }
+    }
+
+    // Delay edges into summing nodes and sinks that lag behind the slowest parallel path
+    void updateLatencyCompensation() {
+        std::vector<T> pathLatency;
+        computePathLatencies(pathLatency);
+        auto makeDelay = [this](T lag) -> std::unique_ptr<LatencyCompensator<T>> {
+            const size_t delaySamples = LatencyCompensator<T>::latencyToSamples(lag);
+            if (delaySamples == 0)
+                return nullptr;
+            return std::make_unique<LatencyCompensator<T>>(numChannels, delaySamples);
+        };
+
+        for (auto& node : nodes) {
+            T inputLatency = T(0);
+            for (const auto& edge : node.inputs)
+                inputLatency = std::max(inputLatency, pathLatency[edge.from]);
+            node.inputDelays.clear();
+            bool anyDelay = false;
+            for (const auto& edge : node.inputs) {
+                node.inputDelays.push_back(makeDelay(inputLatency - pathLatency[edge.from]));
+                anyDelay = anyDelay || node.inputDelays.back() != nullptr;
+            }
+            node.delayBuffer.resize(anyDelay ? numChannels : 0, anyDelay ? maxBlockSize : 0);
+        }
+
+        T outputLatency = T(0);
+        for (NodeId id : sinks)
+            outputLatency = std::max(outputLatency, pathLatency[id]);
+        sinkDelays.clear();
+        bool anyDelay = false;
+        for (NodeId id : sinks) {
+            sinkDelays.push_back(makeDelay(outputLatency - pathLatency[id]));
+            anyDelay = anyDelay || sinkDelays.back() != nullptr;
+        }
+        sinkDelayBuffer.resize(anyDelay ? numChannels : 0, anyDelay ? maxBlockSize : 0);
+    }
+
+    // Priority = own cost + most expensive remaining path, then order ready lists by it (allocation free)
+    void updatePriorities() {
+        for (auto it = topologicalOrder.rbegin(); it != topologicalOrder.rend(); ++it) {
+            Node& node = nodes[*it];
+            double downstream = 0.0;
+            for (NodeId next : node.successors)
+                downstream = std::max(downstream, nodes[next].priority);
+            node.priority = node.costNs + downstream;
+        }
+        auto lowerPriority = [this](NodeId a, NodeId b) { return nodes[a].priority < nodes[b].priority; };
+        std::sort(sources.begin(), sources.end(), lowerPriority);
+        for (auto& node : nodes)
+            std::sort(node.successors.begin(), node.successors.end(), lowerPriority);
+    }
+};
+
+} // namespace jnsc
@@ -0,0 +1,237 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Compile-time serial chain of processors sharing a single in-place working buffer
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <array>
+#include <cassert>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/probe_point.h>
+#include <jonssonic/core/graph/detail/processor_traits.h>
+#include <jonssonic/utils/detail/config_utils.h>
+#include <tuple>
+#include <vector>
+
+namespace jnsc {
+
+/**
+ * @brief Trait telling the chain whether a processor may be called with aliased input and output.
+ * @tparam P Processor type
+ * @note All processors in this library read a sample before writing it and are therefore in-place safe.
+ *       Specialize to std::false_type for user processors that are not.
+ */
+template <typename P>
+struct SupportsInPlace : std::true_type {};
+
+namespace detail {
+/**
+ * @brief Compute the buffer slot each chain stage writes to.
+ * @details Slot 0 is the chain output buffer, slots >= 1 are shared scratch buffers.
+ *          The intermediate written by stage i is live until stage i + 1 has read it, so an in-place
+ *          stage can reuse its input slot while an out-of-place stage needs its input and output live at once.
+ *          Walking backwards from the output, at most two intermediates are ever live, hence one scratch buffer.
+ * @param inPlace In-place capability of each stage.
+ * @return Slot index per stage.
+ */
+template <size_t N>
+constexpr std::array<size_t, N> planChainBuffers(const std::array<bool, N>& inPlace) {
+    std::array<size_t, N> slots{};
+    if constexpr (N > 0) {
+        slots[N - 1] = 0;
+        for (size_t i = N - 1; i > 0; --i)
+            slots[i - 1] = inPlace[i] ? slots[i] : (slots[i] == 0 ? 1 : 0);
+    }
+    return slots;
+}
+
+/// Number of scratch buffers required by a buffer plan.
+template <size_t N>
+constexpr size_t countScratchBuffers(const std::array<size_t, N>& slots) {
+    size_t maxSlot = 0;
+    for (size_t i = 0; i < N; ++i)
+        maxSlot = slots[i] > maxSlot ? slots[i] : maxSlot;
+    return maxSlot;
+}
+} // namespace detail
+
+/**
+ * @brief Serial chain of processors known at compile time.
+ * @details All stages run through the caller's output buffer whenever they support in-place processing.
+ *          Scratch memory is only allocated for stages that cannot run in place, and intermediates whose
+ *          lifetimes do not overlap share the same scratch buffer.
+ * @tparam T Sample data type (e.g., float, double)
+ * @tparam Processors Processor types, each providing `processBlock(const T* const*, T* const*, size_t)`
+ *         and `prepare(numChannels, sampleRate)` or `prepare(numChannels, maxBlockSize, sampleRate)`.
+ */
+template <typename T, typename... Processors>
+class ProcessorChain {
+    static_assert(sizeof...(Processors) > 0, "ProcessorChain requires at least one processor");
+
+  public:
+    /// Number of stages in the chain
+    static constexpr size_t NUM_STAGES = sizeof...(Processors);
+
+    /// Buffer slot written by each stage (0 = chain output, >= 1 = scratch)
+    static constexpr std::array<size_t, NUM_STAGES> BUFFER_PLAN =
+        detail::planChainBuffers<NUM_STAGES>({SupportsInPlace<Processors>::value...});
+
+    /// Number of scratch buffers required by the plan
+    static constexpr size_t NUM_SCRATCH_BUFFERS = detail::countScratchBuffers(BUFFER_PLAN);
+
+    /// Default constructor
+    ProcessorChain() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumChannels Number of channels
+     * @param newMaxBlockSize Maximum block size for processing
+     * @param newSampleRate Sample rate in Hz
+     */
+    ProcessorChain(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        prepare(newNumChannels, newMaxBlockSize, newSampleRate);
+    }
+
+    /// Default destructor
+    ~ProcessorChain() = default;
+
+    /// No copy nor move semantics
+    ProcessorChain(const ProcessorChain&) = delete;
+    ProcessorChain& operator=(const ProcessorChain&) = delete;
+    ProcessorChain(ProcessorChain&&) = delete;
+    ProcessorChain& operator=(ProcessorChain&&) = delete;
+
+    /**
+     * @brief Prepare all processors and allocate the shared scratch memory.
+     * @param newNumChannels Number of channels
+     * @param newMaxBlockSize Maximum block size for processing
+     * @param newSampleRate Sample rate in Hz
+     * @note Processors needing extra configuration (e.g., delay lines) can be re-prepared through @ref get.
+     */
+    void prepare(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        maxBlockSize = newMaxBlockSize;
+        sampleRate = utils::detail::clampSampleRate(newSampleRate);
+
+        std::apply([this](auto&... p) { (detail::prepareProcessor<T>(p, numChannels, maxBlockSize, sampleRate), ...); },
+                   processors);
+
+        // One contiguous allocation holds every scratch slot
+        scratch.resize(NUM_SCRATCH_BUFFERS * numChannels, maxBlockSize);
+        scratchPtrs.resize(NUM_SCRATCH_BUFFERS * numChannels);
+        for (size_t i = 0; i < scratchPtrs.size(); ++i)
+            scratchPtrs[i] = scratch.writeChannelPtr(i);
+        for (auto& probe : probes)
+            probe.prepare(numChannels);
+
+        togglePrepared = true;
+    }
+
+    /// Reset the state of all processors
+    void reset() {
+        std::apply([](auto&... p) { (p.reset(), ...); }, processors);
+    }
+
+    /**
+     * @brief Process a block of samples through all stages.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @note Input and output may alias if the first stage supports in-place processing.
+     */
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        assert(togglePrepared && "ProcessorChain must be prepared before processing");
+        assert((NUM_SCRATCH_BUFFERS == 0 || numSamples <= maxBlockSize) && "Block exceeds prepared size");
+        processStages(input, output, numSamples, std::index_sequence_for<Processors...>{});
+    }
+
+    /**
+     * @brief Access a stage of the chain.
+     * @tparam I Stage index
+     */
+    template <size_t I>
+    auto& get() {
+        return std::get<I>(processors);
+    }
+
+    /// Const access to a stage of the chain
+    template <size_t I>
+    const auto& get() const {
+        return std::get<I>(processors);
+    }
+
+    /**
+     * @brief Probe on the output of a stage (arm it to capture snapshots, see @ref ProbePoint).
+     * @param stage Stage index
+     */
+    ProbePoint<T>& getProbe(size_t stage) {
+        assert(stage < NUM_STAGES && "Stage index out of range");
+        return probes[stage];
+    }
+
+    /// Summed latency of all stages reporting @c getLatencySamples(), in samples
+    T getLatencySamples() const {
+        return std::apply([](const auto&... p) { return (T(0) + ... + detail::processorLatency<T>(p)); },
+                          processors);
+    }
+
+    /// Bytes of scratch audio memory owned by the chain
+    size_t getScratchMemoryBytes() const { return scratch.getTotalSize() * sizeof(T); }
+
+    /// Bytes a naive chain with one buffer per intermediate would allocate
+    size_t getUnsharedMemoryBytes() const { return (NUM_STAGES - 1) * numChannels * maxBlockSize * sizeof(T); }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Get maximum block size
+    size_t getMaxBlockSize() const { return maxBlockSize; }
+
+    /// Get sample rate
+    T getSampleRate() const { return sampleRate; }
+
+    /// Append the state of every processor, in chain order, to a state snapshot
+    void saveState(StateBlob& blob) const {
+        std::apply([&](const auto&... processor) { (processor.saveState(blob), ...); }, processors);
+    }
+
+    /// Restore the state of every processor, in chain order, from a state snapshot
+    void restoreState(StateReader& reader) {
+        std::apply([&](auto&... processor) { (processor.restoreState(reader), ...); }, processors);
+    }
+
+  private:
+    // Config variables
+    size_t numChannels = 0;
+    size_t maxBlockSize = 0;
+    T sampleRate = T(44100);
+    bool togglePrepared = false;
+
+    // Processing stages and the probes on their outputs
+    std::tuple<Processors...> processors;
+    std::array<ProbePoint<T>, NUM_STAGES> probes;
+
+    // Scratch buffers and their channel pointers (slot s, channel ch at (s - 1) * numChannels + ch)
+    AudioBuffer<T> scratch;
+    std::vector<T*> scratchPtrs;
+
+    // Resolve a slot index to channel pointers
+    T* const* slotPtrs(size_t slot, T* const* output) {
+        return slot == 0 ? output : scratchPtrs.data() + (slot - 1) * numChannels;
+    }
+
+    template <size_t... I>
+    void processStages(const T* const* input, T* const* output, size_t numSamples, std::index_sequence<I...>) {
+        const T* const* stageInput = input;
+        (processStage<I>(stageInput, output, numSamples), ...);
+    }
+
+    template <size_t I>
+    void processStage(const T* const*& stageInput, T* const* output, size_t numSamples) {
+        T* const* stageOutput = slotPtrs(BUFFER_PLAN[I], output);
+        std::get<I>(processors).processBlock(stageInput, stageOutput, numSamples);
+        probes[I].tap(stageOutput, numSamples);
+        stageInput = stageOutput;
+    }
+};
+
+} // namespace jnsc
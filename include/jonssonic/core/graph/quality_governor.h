@@ -0,0 +1,355 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// CPU-adaptive switching between quality tiers of a processor
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_load.h>
+#include <jonssonic/core/delays/latency_compensator.h>
+#include <jonssonic/core/graph/detail/processor_traits.h>
+#include <jonssonic/core/mixing/crossfader.h>
+#include <jonssonic/utils/detail/config_utils.h>
+#include <tuple>
+#include <utility>
+
+namespace jnsc {
+
+/**
+ * @brief Runs one of several quality tiers of a processor and steps down when the DSP load exceeds its budget.
+ * @details Tiers are declared as processor types, best quality first, e.g. oversampling factors 8, 4 and 2,
+ *          `Reverb<T, 16>`, `Reverb<T, 8>` and `Reverb<T, 4>`, or a Lagrange and a linear interpolating delay. All
+ *          tiers are prepared up front, so switching never allocates.
+ *
+ *          At every block the governor compares the load of the active tier (its own @ref DspLoadMeter, or a load
+ *          reported by the host through @ref reportLoad, whichever is higher) with two thresholds. Above the
+ *          step-down threshold for the step-down hold time, it moves to the next cheaper tier; below the step-up
+ *          threshold for the (longer) step-up hold time, it moves back to the next better one. After a switch,
+ *          decisions wait until the moving average reflects the new tier.
+ *
+ *          Switches are crossfaded (equal power), with both tiers running for the length of the fade. Every tier is
+ *          delayed to the latency of the slowest one, so the output stays aligned across tiers and the reported
+ *          latency never changes. A tier that becomes active is reset first when it provides `reset()`.
+ * @tparam T Sample data type (e.g., float, double)
+ * @tparam Tiers Processor types, best quality first, each providing `processBlock(const T* const*, T* const*, size_t)`
+ *         and `prepare(numChannels, sampleRate)` or `prepare(numChannels, maxBlockSize, sampleRate)`
+ * @note Load measurement needs JONSSONIC_ENABLE_DSP_LOAD; without it the governor only acts on @ref reportLoad and
+ *       @ref setTier. Parameters should be set on every tier (see @ref forEachTier) so switching keeps the sound.
+ */
+template <typename T, typename... Tiers>
+class QualityGovernor {
+    static_assert(sizeof...(Tiers) > 0, "QualityGovernor requires at least one tier");
+
+  public:
+    /// Number of quality tiers
+    static constexpr size_t NUM_TIERS = sizeof...(Tiers);
+
+    /// Default constructor
+    QualityGovernor() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumChannels Number of channels
+     * @param newMaxBlockSize Maximum block size for processing
+     * @param newSampleRate Sample rate in Hz
+     */
+    QualityGovernor(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        prepare(newNumChannels, newMaxBlockSize, newSampleRate);
+    }
+
+    /// Default destructor
+    ~QualityGovernor() = default;
+
+    /// No copy nor move semantics
+    QualityGovernor(const QualityGovernor&) = delete;
+    QualityGovernor& operator=(const QualityGovernor&) = delete;
+    QualityGovernor(QualityGovernor&&) = delete;
+    QualityGovernor& operator=(QualityGovernor&&) = delete;
+
+    /**
+     * @brief Prepare all tiers, the latency compensation and the crossfade, and start at the best tier.
+     * @param newNumChannels Number of channels
+     * @param newMaxBlockSize Maximum block size for processing
+     * @param newSampleRate Sample rate in Hz
+     */
+    void prepare(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        numChannels = utils::detail::clampChannels(newNumChannels);
+        maxBlockSize = newMaxBlockSize;
+        sampleRate = utils::detail::clampSampleRate(newSampleRate);
+
+        std::apply([this](auto&... t) { (detail::prepareProcessor<T>(t, numChannels, maxBlockSize, sampleRate), ...); },
+                   tiers);
+
+        // Delay every tier to the latency of the slowest one
+        std::array<T, NUM_TIERS> latencies{};
+        forEachTierIndexed([&](auto& tier, size_t i) { latencies[i] = detail::processorLatency<T>(tier); });
+        latencySamples = *std::max_element(latencies.begin(), latencies.end());
+        for (size_t i = 0; i < NUM_TIERS; ++i) {
+            const T compensation = latencySamples - latencies[i];
+            compensators[i].prepare(numChannels, LatencyCompensator<T>::latencyToSamples(compensation));
+        }
+
+        fadeBuffer.resize(numChannels, maxBlockSize);
+        crossfader.prepare(numChannels);
+        loadMeter.prepare(sampleRate);
+        setCrossfadeTimeMs(crossfadeTimeMs);
+        setHoldTimesMs(stepDownHoldMs, stepUpHoldMs);
+
+        activeTier = 0;
+        fadingTier = NUM_TIERS;
+        fadeRemaining = 0;
+        overSamples = underSamples = settleSamples = 0;
+        requestedTier.store(NUM_TIERS, std::memory_order_relaxed);
+        publishedTier.store(0, std::memory_order_relaxed);
+        togglePrepared = true;
+    }
+
+    /// Reset all tiers, the latency compensation and the load history (the active tier is kept)
+    void reset() {
+        forEachTier([](auto& tier) {
+            if constexpr (detail::HasReset<std::decay_t<decltype(tier)>>::value)
+                tier.reset();
+        });
+        for (auto& compensator : compensators)
+            compensator.reset();
+        fadingTier = NUM_TIERS;
+        fadeRemaining = 0;
+        overSamples = underSamples = settleSamples = 0;
+        loadMeter.reset();
+    }
+
+    /**
+     * @brief Process a block with the active tier, switching tiers first if the load calls for it.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel, may alias @p input)
+     * @param numSamples Number of samples to process (at most the maximum block size)
+     */
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        assert(togglePrepared && "QualityGovernor must be prepared before processing");
+        assert(numSamples <= maxBlockSize && "Block exceeds prepared size");
+        govern(numSamples);
+
+        ScopedDspTimer timer(loadMeter, numSamples);
+        if (fadingTier == NUM_TIERS) {
+            processTier(activeTier, input, output, numSamples);
+            return;
+        }
+
+        // Outgoing tier into the fade buffer first, so in-place processing still sees the input
+        T* const* fadePtrs = fadeBuffer.writePtrs();
+        processTier(fadingTier, input, fadePtrs, numSamples);
+        processTier(activeTier, input, output, numSamples);
+        crossfader.processBlock(fadePtrs, output, output, numSamples);
+
+        fadeRemaining -= std::min(fadeRemaining, numSamples);
+        if (fadeRemaining == 0)
+            fadingTier = NUM_TIERS;
+    }
+
+    /**
+     * @brief Set the load thresholds in percent of the realtime budget.
+     * @param newStepDownLoad Step down to a cheaper tier above this load
+     * @param newStepUpLoad Step back up below this load (should leave room for the better tier's extra cost)
+     */
+    void setLoadThresholds(float newStepDownLoad, float newStepUpLoad) {
+        stepDownLoad.store(newStepDownLoad, std::memory_order_relaxed);
+        stepUpLoad.store(std::min(newStepUpLoad, newStepDownLoad), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set how long the load must stay beyond a threshold before switching.
+     * @param newStepDownHoldMs Time above the step-down threshold
+     * @param newStepUpHoldMs Time below the step-up threshold
+     * @note Call from the audio thread or before processing.
+     */
+    void setHoldTimesMs(T newStepDownHoldMs, T newStepUpHoldMs) {
+        stepDownHoldMs = std::max(newStepDownHoldMs, T(0));
+        stepUpHoldMs = std::max(newStepUpHoldMs, T(0));
+        stepDownHoldSamples = msToSamples(stepDownHoldMs);
+        stepUpHoldSamples = msToSamples(stepUpHoldMs);
+        settleTimeSamples = msToSamples(T(1000) * static_cast<T>(DspLoadMeter<>::AVERAGING_TIME_S));
+    }
+
+    /**
+     * @brief Set the crossfade time of tier switches.
+     * @param newCrossfadeTimeMs Crossfade time in milliseconds (0 switches instantly)
+     * @note Call from the audio thread or before processing.
+     */
+    void setCrossfadeTimeMs(T newCrossfadeTimeMs) {
+        crossfadeTimeMs = std::max(newCrossfadeTimeMs, T(0));
+        crossfadeSamples = msToSamples(crossfadeTimeMs);
+    }
+
+    /// Enable or disable load-driven switching (any thread); manual @ref setTier requests still apply
+    void setAutomatic(bool shouldGovern) { automatic.store(shouldGovern, std::memory_order_relaxed); }
+
+    /**
+     * @brief Report a load measured elsewhere, e.g. the host's callback load (any thread).
+     * @param loadPercent Load in percent of the realtime budget; the governor acts on the larger of this and the
+     *        load of its own meter
+     */
+    void reportLoad(float loadPercent) { reportedLoad.store(loadPercent, std::memory_order_relaxed); }
+
+    /// Switch to a tier at the next block boundary (any thread); in automatic mode governing continues from there
+    void setTier(size_t tier) { requestedTier.store(std::min(tier, NUM_TIERS - 1), std::memory_order_relaxed); }
+
+    /// Active tier (0 = best quality; any thread)
+    size_t getTier() const { return publishedTier.load(std::memory_order_relaxed); }
+
+    /// True while a tier switch is being crossfaded (audio thread)
+    bool isSwitching() const { return fadingTier != NUM_TIERS; }
+
+    /// Average load of the active tier(s) in percent of the realtime budget (any thread)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Latency of the slowest tier, reported for all tiers, in samples
+    T getLatencySamples() const { return latencySamples; }
+
+    /**
+     * @brief Access a tier.
+     * @tparam I Tier index
+     */
+    template <size_t I>
+    auto& get() {
+        return std::get<I>(tiers);
+    }
+
+    /// Const access to a tier
+    template <size_t I>
+    const auto& get() const {
+        return std::get<I>(tiers);
+    }
+
+    /// Call a function on every tier (e.g., to set a parameter on all of them)
+    template <typename Function>
+    void forEachTier(Function&& function) {
+        std::apply([&](auto&... tier) { (function(tier), ...); }, tiers);
+    }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Get maximum block size
+    size_t getMaxBlockSize() const { return maxBlockSize; }
+
+    /// Get sample rate
+    T getSampleRate() const { return sampleRate; }
+
+  private:
+    // Config variables
+    size_t numChannels = 0;
+    size_t maxBlockSize = 0;
+    T sampleRate = T(44100);
+    bool togglePrepared = false;
+    T latencySamples = T(0);
+
+    // Tiers and switching
+    std::tuple<Tiers...> tiers;
+    std::array<LatencyCompensator<T>, NUM_TIERS> compensators;
+    AudioBuffer<T> fadeBuffer; // Output of the tier fading out
+    Crossfader<T> crossfader;
+    size_t activeTier = 0;
+    size_t fadingTier = NUM_TIERS; // NUM_TIERS while no switch is in progress
+    size_t fadeRemaining = 0;
+
+    // Governing (audio thread)
+    DspLoadMeter<> loadMeter;
+    T crossfadeTimeMs = T(20);
+    T stepDownHoldMs = T(50);
+    T stepUpHoldMs = T(2000);
+    size_t crossfadeSamples = 0;
+    size_t stepDownHoldSamples = 0;
+    size_t stepUpHoldSamples = 0;
+    size_t settleTimeSamples = 0;
+    size_t overSamples = 0;
+    size_t underSamples = 0;
+    size_t settleSamples = 0;
+
+    // Control
+    std::atomic<float> stepDownLoad{70.0f};
+    std::atomic<float> stepUpLoad{35.0f};
+    std::atomic<float> reportedLoad{0.0f};
+    std::atomic<bool> automatic{true};
+    std::atomic<size_t> requestedTier{NUM_TIERS}; // NUM_TIERS while nothing is requested
+    std::atomic<size_t> publishedTier{0};
+
+    size_t msToSamples(T timeMs) const { return static_cast<size_t>(timeMs * sampleRate / T(1000)); }
+
+    template <typename Function, size_t... I>
+    void forEachTierIndexed(Function&& function, std::index_sequence<I...>) {
+        (function(std::get<I>(tiers), I), ...);
+    }
+
+    template <typename Function>
+    void forEachTierIndexed(Function&& function) {
+        forEachTierIndexed(std::forward<Function>(function), std::index_sequence_for<Tiers...>{});
+    }
+
+    // Process one tier and delay it to the common latency
+    void processTier(size_t index, const T* const* input, T* const* output, size_t numSamples) {
+        forEachTierIndexed([&](auto& tier, size_t i) {
+            if (i == index)
+                tier.processBlock(input, output, numSamples);
+        });
+        if (compensators[index].getLatencySamples() > T(0))
+            compensators[index].processBlock(output, output, numSamples);
+    }
+
+    // Decide on a switch at the start of a block (no decisions while a switch is in progress)
+    void govern(size_t numSamples) {
+        if (fadingTier != NUM_TIERS)
+            return;
+        const size_t requested = requestedTier.exchange(NUM_TIERS, std::memory_order_relaxed);
+        if (requested != NUM_TIERS) {
+            if (requested != activeTier)
+                switchTo(requested);
+            return;
+        }
+        if (!automatic.load(std::memory_order_relaxed))
+            return;
+        if (settleSamples > 0) {
+            settleSamples -= std::min(settleSamples, numSamples);
+            return;
+        }
+
+        const float load = std::max(loadMeter.getLoadPercent(), reportedLoad.load(std::memory_order_relaxed));
+        if (load > stepDownLoad.load(std::memory_order_relaxed) && activeTier + 1 < NUM_TIERS) {
+            underSamples = 0;
+            overSamples += numSamples;
+            if (overSamples >= stepDownHoldSamples)
+                switchTo(activeTier + 1);
+        } else if (load < stepUpLoad.load(std::memory_order_relaxed) && activeTier > 0) {
+            overSamples = 0;
+            underSamples += numSamples;
+            if (underSamples >= stepUpHoldSamples)
+                switchTo(activeTier - 1);
+        } else {
+            overSamples = underSamples = 0;
+        }
+    }
+
+    // Make a tier active, fading out the previous one
+    void switchTo(size_t tier) {
+        forEachTierIndexed([&](auto& t, size_t i) {
+            if constexpr (detail::HasReset<std::decay_t<decltype(t)>>::value)
+                if (i == tier)
+                    t.reset();
+        });
+        compensators[tier].reset();
+
+        if (crossfadeSamples > 0) {
+            fadingTier = activeTier;
+            fadeRemaining = crossfadeSamples;
+            crossfader.startCrossfade(crossfadeSamples);
+        }
+        activeTier = tier;
+        publishedTier.store(tier, std::memory_order_relaxed);
+        overSamples = underSamples = 0;
+        settleSamples = settleTimeSamples;
+    }
+};
+
+} // namespace jnsc
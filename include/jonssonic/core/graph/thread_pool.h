@@ -0,0 +1,277 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Realtime-oriented work-stealing thread pool
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <jonssonic/core/graph/detail/graph_limits.h>
+#include <jonssonic/core/graph/detail/wake_semaphore.h>
+#include <jonssonic/core/graph/detail/work_stealing_deque.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(JONSSONIC_LINUX) || defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace jnsc {
+/**
+ * @brief Work-stealing thread pool for running audio tasks across cores.
+ * @details Workers are optionally pinned to cores and wait for work by spinning for a while before going to sleep
+ *          on their own semaphore, which a dispatch posts without taking a lock. A dispatch pushes task indices into preallocated Chase-Lev deques and never allocates. The calling
+ *          (audio) thread takes part in the work and returns once every task has finished.
+ *          Tasks can spawn follow-up tasks with @ref spawn, which is how @ref ProcessingGraph releases successors.
+ * @note One dispatch at a time: @ref run and @ref parallelFor must not be called concurrently.
+ */
+class ThreadPool {
+  public:
+    /**
+     * @brief Task callback.
+     * @param context User context pointer passed to the dispatch
+     * @param task Task index
+     * @param worker Index of the executing thread (0 is the dispatching thread)
+     */
+    using TaskFunction = void (*)(void* context, size_t task, size_t worker);
+
+    /// Default constructor (no worker threads, all work runs on the calling thread)
+    ThreadPool() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref start.
+     * @param numWorkers Number of worker threads besides the calling thread
+     * @param pinThreads If true, pin each worker to its own core
+     */
+    explicit ThreadPool(size_t numWorkers, bool pinThreads = true) { start(numWorkers, pinThreads); }
+
+    /// Destructor stops all workers
+    ~ThreadPool() { stop(); }
+
+    /// No copy nor move semantics
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /// Default number of workers: one less than the number of hardware threads
+    static size_t getDefaultNumWorkers() {
+        size_t hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+    /**
+     * @brief Start the worker threads (allocates).
+     * @param numWorkers Number of worker threads besides the calling thread
+     * @param pinThreads If true, pin each worker to its own core (Linux only, ignored elsewhere)
+     */
+    void start(size_t numWorkers, bool pinThreads = true) {
+        stop();
+        numWorkers = std::min(numWorkers, detail::GraphLimits::MAX_WORKERS);
+
+        deques = std::make_unique<detail::WorkStealingDeque[]>(numWorkers + 1);
+        wakes = std::make_unique<WorkerWake[]>(numWorkers + 1);
+        numThreads = numWorkers + 1;
+        for (size_t i = 0; i < numThreads; ++i)
+            deques[i].prepare(taskCapacity);
+
+        running.store(true);
+        threads.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i) {
+            threads.emplace_back([this, i] { workerLoop(i + 1); });
+            if (pinThreads)
+                pinToCore(threads.back(), i + 1);
+        }
+    }
+
+    /// Stop and join all worker threads
+    void stop() {
+        if (threads.empty())
+            return;
+        running.store(false, std::memory_order_seq_cst);
+        wakeSleepingWorkers();
+        for (auto& t : threads)
+            t.join();
+        threads.clear();
+    }
+
+    /**
+     * @brief Reserve queue capacity for the largest expected dispatch (allocates).
+     * @param maxTasks Maximum number of tasks queued at once
+     * @note Call while no dispatch is running. Tasks beyond the capacity are executed inline.
+     */
+    void reserve(size_t maxTasks) {
+        taskCapacity = std::max(taskCapacity, maxTasks);
+        if (!deques) {
+            deques = std::make_unique<detail::WorkStealingDeque[]>(1);
+            numThreads = 1;
+        }
+        for (size_t i = 0; i < numThreads; ++i)
+            if (deques[i].getCapacity() < taskCapacity)
+                deques[i].prepare(taskCapacity);
+    }
+
+    /**
+     * @brief Run a set of tasks and wait for completion.
+     * @param function Task callback
+     * @param context Context pointer forwarded to the callback
+     * @param seeds Initial task indices, or nullptr for 0..numSeeds-1
+     * @param numSeeds Number of initial tasks
+     * @param totalTasks Total number of tasks including those spawned while running
+     */
+    void run(TaskFunction function, void* context, const size_t* seeds, size_t numSeeds, size_t totalTasks) {
+        if (totalTasks == 0)
+            return;
+        if (!deques)
+            reserve(numSeeds);
+
+        taskFunction = function;
+        taskContext = context;
+        pendingTasks.store(totalTasks, std::memory_order_release);
+
+        for (size_t i = 0; i < numSeeds; ++i)
+            spawn(0, seeds ? seeds[i] : i);
+
+        // Wake workers, only visiting their semaphores if someone actually sleeps
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+            wakeSleepingWorkers();
+
+        participate(0);
+
+        // Do not return (and let the next dispatch overwrite the task) while workers are still inside this one
+        while (activeWorkers.load(std::memory_order_acquire) > 0)
+            detail::cpuRelax();
+    }
+
+    /**
+     * @brief Run tasks 0..count-1 and wait for completion.
+     * @param count Number of tasks
+     * @param function Task callback
+     * @param context Context pointer forwarded to the callback
+     */
+    void parallelFor(size_t count, TaskFunction function, void* context) {
+        run(function, context, nullptr, count, count);
+    }
+
+    /**
+     * @brief Queue a task from inside a running task.
+     * @param worker Index of the calling thread, as passed to the task callback
+     * @param task Task index
+     * @note If the queue is full the task is executed inline.
+     */
+    void spawn(size_t worker, size_t task) {
+        if (!deques[worker].push(task))
+            execute(task, worker);
+    }
+
+    /// Get number of threads taking part in a dispatch (workers + calling thread)
+    size_t getNumThreads() const { return numThreads; }
+
+    /// Get number of worker threads
+    size_t getNumWorkers() const { return threads.size(); }
+
+  private:
+    // Threads and their queues (index 0 belongs to the dispatching thread)
+    std::vector<std::thread> threads;
+    std::unique_ptr<detail::WorkStealingDeque[]> deques;
+    size_t numThreads = 1;
+    size_t taskCapacity = 64;
+
+    // Current dispatch
+    TaskFunction taskFunction = nullptr;
+    void* taskContext = nullptr;
+    alignas(detail::GraphLimits::CACHE_LINE_SIZE) std::atomic<size_t> pendingTasks{0};
+    alignas(detail::GraphLimits::CACHE_LINE_SIZE) std::atomic<size_t> activeWorkers{0};
+
+    // Wake-up signalling (one semaphore per thread, so waking never blocks the dispatching thread)
+    struct alignas(detail::GraphLimits::CACHE_LINE_SIZE) WorkerWake {
+        std::atomic<bool> sleeping{false}; // Set by the worker before it waits, cleared by whoever posts
+        detail::WakeSemaphore semaphore;
+    };
+    std::unique_ptr<WorkerWake[]> wakes;
+    alignas(detail::GraphLimits::CACHE_LINE_SIZE) std::atomic<size_t> epoch{0};
+    std::atomic<size_t> sleepingWorkers{0};
+    std::atomic<bool> running{false};
+
+    // Post the semaphore of every worker that announced it sleeps
+    void wakeSleepingWorkers() {
+        for (size_t i = 1; i < numThreads; ++i)
+            if (wakes[i].sleeping.exchange(false, std::memory_order_seq_cst))
+                wakes[i].semaphore.post();
+    }
+
+    void execute(size_t task, size_t worker) {
+        taskFunction(taskContext, task, worker);
+        pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    // Pop own work first, then try to steal from the other threads
+    bool findTask(size_t worker, size_t& task) {
+        if (deques[worker].pop(task))
+            return true;
+        for (size_t i = 1; i < numThreads; ++i)
+            if (deques[(worker + i) % numThreads].steal(task))
+                return true;
+        return false;
+    }
+
+    void participate(size_t worker) {
+        size_t task;
+        while (pendingTasks.load(std::memory_order_acquire) > 0) {
+            if (findTask(worker, task))
+                execute(task, worker);
+            else
+                detail::cpuRelax();
+        }
+    }
+
+    void workerLoop(size_t worker) {
+        size_t lastEpoch = 0;
+        while (true) {
+            // Spin for a while, then sleep until the next dispatch
+            size_t spins = 0;
+            while (epoch.load(std::memory_order_acquire) == lastEpoch && running.load(std::memory_order_relaxed)) {
+                if (++spins < detail::GraphLimits::SPIN_ITERATIONS) {
+                    detail::cpuRelax();
+                    continue;
+                }
+                // Announce the sleep before the last check, so a dispatch either sees it or is seen here
+                WorkerWake& wake = wakes[worker];
+                sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+                wake.sleeping.store(true, std::memory_order_seq_cst);
+                if (epoch.load(std::memory_order_seq_cst) == lastEpoch && running.load(std::memory_order_seq_cst))
+                    wake.semaphore.wait();
+                else if (!wake.sleeping.exchange(false, std::memory_order_seq_cst))
+                    wake.semaphore.wait(); // Claimed by a dispatch that posts (or has posted) anyway
+                sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+                spins = 0;
+            }
+            if (!running.load(std::memory_order_relaxed))
+                return;
+            lastEpoch = epoch.load(std::memory_order_acquire);
+
+            activeWorkers.fetch_add(1, std::memory_order_acq_rel);
+            participate(worker);
+            activeWorkers.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    static void pinToCore(std::thread& thread, size_t core) {
+#if defined(JONSSONIC_LINUX) || defined(__linux__)
+        size_t numCores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<int>(core % numCores), &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#else
+        (void)thread;
+        (void)core;
+#endif
+    }
+};
+
+} // namespace jnsc
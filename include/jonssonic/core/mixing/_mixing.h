@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "channel_mapper.h"
 #include "crossfader.h"
 #include "dry_wet_mixer.h"
 #include "mixing_matrix.h"
\ No newline at end of file
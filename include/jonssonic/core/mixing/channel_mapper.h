@@ -0,0 +1,368 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Sparse gain-matrix channel mapper for up/downmixing and custom routing
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/common/state_blob.h>
+#include <jonssonic/utils/detail/config_utils.h>
+#include <jonssonic/utils/math_utils.h>
+#include <vector>
+
+namespace jnsc {
+
+/**
+ * @brief Speaker layouts with a built-in downmix.
+ * @details Channel orders: Stereo L R; Surround51 L R C LFE Ls Rs; Surround71 L R C LFE Ls Rs Lb Rb;
+ *          Surround714 L R C LFE Ls Rs Lb Rb Ltf Rtf Ltb Rtb.
+ */
+enum class ChannelLayout { Mono, Stereo, Surround51, Surround71, Surround714 };
+
+/// Number of channels of a layout
+constexpr size_t getNumChannels(ChannelLayout layout) {
+    switch (layout) {
+    case ChannelLayout::Mono:
+        return 1;
+    case ChannelLayout::Stereo:
+        return 2;
+    case ChannelLayout::Surround51:
+        return 6;
+    case ChannelLayout::Surround71:
+        return 8;
+    case ChannelLayout::Surround714:
+        return 12;
+    }
+    return 0;
+}
+
+/**
+ * @brief Maps input channels to output channels through a gain matrix: out[o] = sum_i gain[o][i] * in[i].
+ * @details The matrix is stored densely but applied as a list of non-zero routes, so sparse routings (downmixes,
+ *          channel selection) cost one kernel pass per route. The first unity route of an output channel is a
+ *          plain copy, so pure routing matrices (all gains 0 or 1) reduce to memcpy. Matrix changes can be ramped
+ *          linearly over a number of samples to avoid zipper noise.
+ * @tparam T Sample data type (e.g., float, double)
+ */
+template <typename T>
+class ChannelMapper {
+    /// Maximum channels of the built-in layouts (size of the downmix scratch matrices)
+    static constexpr size_t MAX_LAYOUT_CHANNELS = 12;
+    using LayoutMatrix = std::array<T, MAX_LAYOUT_CHANNELS * MAX_LAYOUT_CHANNELS>;
+
+  public:
+    /// Single matrix entry: output channel += gain * input channel
+    struct Route {
+        size_t input = 0;  // Input channel index
+        size_t output = 0; // Output channel index
+        T gain = T(0);     // Linear gain
+    };
+
+    /// Default constructor
+    ChannelMapper() = default;
+
+    /**
+     * @brief Parameterized constructor that calls @ref prepare.
+     * @param newNumInputChannels Number of input channels
+     * @param newNumOutputChannels Number of output channels
+     */
+    ChannelMapper(size_t newNumInputChannels, size_t newNumOutputChannels) {
+        prepare(newNumInputChannels, newNumOutputChannels);
+    }
+
+    /// Default destructor
+    ~ChannelMapper() = default;
+
+    /// No copy nor move semantics
+    ChannelMapper(const ChannelMapper&) = delete;
+    ChannelMapper& operator=(const ChannelMapper&) = delete;
+    ChannelMapper(ChannelMapper&&) = delete;
+    ChannelMapper& operator=(ChannelMapper&&) = delete;
+
+    /**
+     * @brief Prepare the mapper for processing. The matrix is set to identity (input i -> output i).
+     * @param newNumInputChannels Number of input channels
+     * @param newNumOutputChannels Number of output channels
+     */
+    void prepare(size_t newNumInputChannels, size_t newNumOutputChannels) {
+        numInputChannels = utils::detail::clampChannels(newNumInputChannels);
+        numOutputChannels = utils::detail::clampChannels(newNumOutputChannels);
+        const size_t matrixSize = numInputChannels * numOutputChannels;
+        currentGains.assign(matrixSize, T(0));
+        targetGains.assign(matrixSize, T(0));
+        routes.clear();
+        routes.reserve(matrixSize);
+        for (size_t ch = 0; ch < std::min(numInputChannels, numOutputChannels); ++ch)
+            targetGains[index(ch, ch)] = T(1);
+        currentGains = targetGains;
+        rampLength = rampPosition = 0;
+        buildRoutes();
+        togglePrepared = true;
+    }
+
+    /// Finish a running ramp (jump to the target matrix)
+    void reset() {
+        currentGains = targetGains;
+        rampLength = rampPosition = 0;
+        buildRoutes();
+    }
+
+    /**
+     * @brief Set the full gain matrix (e.g., an ambisonic decode table).
+     * @param gains Row-major gains, gains[outCh * numInputChannels + inCh]
+     * @param rampSamples Length of the linear ramp from the current matrix (0 = immediate)
+     */
+    void setMatrix(const T* gains, size_t rampSamples = 0) {
+        std::copy(gains, gains + targetGains.size(), newGains().begin());
+        commit(rampSamples);
+    }
+
+    /**
+     * @brief Set a sparse gain matrix; all other entries are zero.
+     * @param newRoutes Routes (entries for the same pair are summed)
+     * @param numRoutes Number of routes
+     * @param rampSamples Length of the linear ramp from the current matrix (0 = immediate)
+     */
+    void setRoutes(const Route* newRoutes, size_t numRoutes, size_t rampSamples = 0) {
+        auto& gains = newGains();
+        std::fill(gains.begin(), gains.end(), T(0));
+        for (size_t r = 0; r < numRoutes; ++r) {
+            assert(newRoutes[r].input < numInputChannels && newRoutes[r].output < numOutputChannels);
+            gains[index(newRoutes[r].output, newRoutes[r].input)] += newRoutes[r].gain;
+        }
+        commit(rampSamples);
+    }
+
+    /**
+     * @brief Set a single matrix entry, keeping the others.
+     * @param outCh Output channel index
+     * @param inCh Input channel index
+     * @param gain Linear gain
+     * @param rampSamples Length of the linear ramp from the current matrix (0 = immediate)
+     */
+    void setGain(size_t outCh, size_t inCh, T gain, size_t rampSamples = 0) {
+        assert(inCh < numInputChannels && outCh < numOutputChannels);
+        newGains()[index(outCh, inCh)] = gain;
+        commit(rampSamples);
+    }
+
+    /**
+     * @brief Set the standard downmix between two layouts (fold-downs are chained, e.g. 7.1.4 -> 7.1 -> 5.1).
+     * @param from Input layout (must match the number of input channels)
+     * @param to Output layout (must match the number of output channels, with at most as many channels as @p from)
+     * @param rampSamples Length of the linear ramp from the current matrix (0 = immediate)
+     * @note Folded channels are attenuated by 3 dB (ITU-R BS.775 style), the LFE is dropped below 5.1 and stereo
+     *       is folded to mono at -6 dB per side.
+     */
+    void setDownmix(ChannelLayout from, ChannelLayout to, size_t rampSamples = 0) {
+        assert(getNumChannels(from) == numInputChannels && getNumChannels(to) == numOutputChannels);
+        assert(static_cast<int>(to) <= static_cast<int>(from) && "Only downmixes are built in");
+
+        // Chain single fold-down steps: matrix = step * matrix
+        LayoutMatrix matrix{}, step{}, product{};
+        for (size_t ch = 0; ch < MAX_LAYOUT_CHANNELS; ++ch)
+            matrix[ch * MAX_LAYOUT_CHANNELS + ch] = T(1);
+        for (ChannelLayout layout = from; layout != to && layout != ChannelLayout::Mono;) {
+            layout = foldDownStep(layout, step);
+            product.fill(T(0));
+            for (size_t o = 0; o < MAX_LAYOUT_CHANNELS; ++o)
+                for (size_t k = 0; k < MAX_LAYOUT_CHANNELS; ++k)
+                    if (step[o * MAX_LAYOUT_CHANNELS + k] != T(0))
+                        for (size_t i = 0; i < MAX_LAYOUT_CHANNELS; ++i)
+                            product[o * MAX_LAYOUT_CHANNELS + i] +=
+                                step[o * MAX_LAYOUT_CHANNELS + k] * matrix[k * MAX_LAYOUT_CHANNELS + i];
+            matrix = product;
+        }
+
+        auto& gains = newGains();
+        for (size_t o = 0; o < numOutputChannels; ++o)
+            for (size_t i = 0; i < numInputChannels; ++i)
+                gains[index(o, i)] = matrix[o * MAX_LAYOUT_CHANNELS + i];
+        commit(rampSamples);
+    }
+
+    /**
+     * @brief Map a block of samples.
+     * @param input Input sample pointers (numInputChannels)
+     * @param output Output sample pointers (numOutputChannels, must not alias the input)
+     * @param numSamples Number of samples to process
+     */
+    void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        size_t offset = 0;
+        if (rampPosition < rampLength) {
+            const size_t len = std::min(numSamples, rampLength - rampPosition);
+            processRamp(input, output, len);
+            offset = len;
+            if (rampPosition == rampLength)
+                reset();
+        }
+        if (offset < numSamples)
+            processSettled(input, output, offset, numSamples - offset);
+    }
+
+    /// Get number of input channels
+    size_t getNumInputChannels() const { return numInputChannels; }
+    /// Get number of output channels
+    size_t getNumOutputChannels() const { return numOutputChannels; }
+    /// Get the target gain of a matrix entry
+    T getGain(size_t outCh, size_t inCh) const { return targetGains[index(outCh, inCh)]; }
+    /// Get number of non-zero routes currently applied
+    size_t getNumActiveRoutes() const { return routes.size(); }
+    /// Check if a matrix change is being ramped
+    bool isRamping() const { return rampPosition < rampLength; }
+    /// Check if prepared
+    bool isPrepared() const { return togglePrepared; }
+
+    /// Append the gain matrices and ramp position to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(currentGains);
+        blob.write(targetGains);
+        blob.write(rampLength);
+        blob.write(rampPosition);
+    }
+
+    /// Restore the gain matrices and ramp position from a state snapshot (routes are rebuilt in place)
+    void restoreState(StateReader& reader) {
+        reader.read(currentGains);
+        reader.read(targetGains);
+        reader.read(rampLength);
+        reader.read(rampPosition);
+        buildRoutes();
+    }
+
+  private:
+    /// Applied route: gain at the start of the ramp and per-sample increment (zero when settled)
+    struct ActiveRoute {
+        size_t input;
+        size_t output;
+        T startGain;
+        T gainStep;
+    };
+
+    bool togglePrepared = false;
+    size_t numInputChannels = 0;
+    size_t numOutputChannels = 0;
+    std::vector<T> currentGains;     // Matrix at the start of the ramp (or the settled matrix)
+    std::vector<T> targetGains;      // Matrix at the end of the ramp
+    std::vector<ActiveRoute> routes; // Non-zero entries sorted by output channel
+    size_t rampLength = 0;
+    size_t rampPosition = 0;
+
+    size_t index(size_t outCh, size_t inCh) const { return outCh * numInputChannels + inCh; }
+
+    // Freeze a running ramp at its current position and return the target matrix for editing
+    std::vector<T>& newGains() {
+        if (rampPosition < rampLength) {
+            const T progress = static_cast<T>(rampPosition) / static_cast<T>(rampLength);
+            for (size_t i = 0; i < currentGains.size(); ++i)
+                currentGains[i] += (targetGains[i] - currentGains[i]) * progress;
+        } else {
+            currentGains = targetGains;
+        }
+        return targetGains;
+    }
+
+    // Start the ramp towards the edited target (or jump to it)
+    void commit(size_t rampSamples) {
+        rampLength = rampSamples;
+        rampPosition = 0;
+        if (rampSamples == 0)
+            currentGains = targetGains;
+        buildRoutes();
+    }
+
+    void buildRoutes() {
+        routes.clear();
+        const bool ramping = rampPosition < rampLength;
+        for (size_t o = 0; o < numOutputChannels; ++o) {
+            for (size_t i = 0; i < numInputChannels; ++i) {
+                const T start = currentGains[index(o, i)];
+                const T end = targetGains[index(o, i)];
+                if (start == T(0) && end == T(0))
+                    continue;
+                const T step = ramping ? (end - start) / static_cast<T>(rampLength) : T(0);
+                routes.push_back({i, o, start, step});
+            }
+        }
+    }
+
+    void processSettled(const T* const* input, T* const* output, size_t offset, size_t numSamples) {
+        const auto& kernels = getSimdKernels<T>();
+        size_t r = 0;
+        for (size_t o = 0; o < numOutputChannels; ++o) {
+            T* out = output[o] + offset;
+            if (r == routes.size() || routes[r].output != o) {
+                std::fill(out, out + numSamples, T(0));
+                continue;
+            }
+
+            // First route initializes the output, the rest accumulate
+            const ActiveRoute& first = routes[r++];
+            if (first.startGain == T(1))
+                std::memcpy(out, input[first.input] + offset, numSamples * sizeof(T));
+            else
+                kernels.scale(input[first.input] + offset, out, first.startGain, numSamples);
+            for (; r < routes.size() && routes[r].output == o; ++r)
+                kernels.scaledAdd(input[routes[r].input] + offset, out, routes[r].startGain, numSamples);
+        }
+    }
+
+    void processRamp(const T* const* input, T* const* output, size_t numSamples) {
+        const auto& kernels = getSimdKernels<T>();
+        const T position = static_cast<T>(rampPosition);
+        for (size_t o = 0; o < numOutputChannels; ++o)
+            std::fill(output[o], output[o] + numSamples, T(0));
+        for (const ActiveRoute& route : routes) {
+            const T gain = route.startGain + position * route.gainStep;
+            kernels.rampedAdd(input[route.input], output[route.output], gain, route.gainStep, numSamples);
+        }
+        rampPosition += numSamples;
+    }
+
+    // Write the single fold-down step below a layout into step (row-major, MAX_LAYOUT_CHANNELS stride)
+    static ChannelLayout foldDownStep(ChannelLayout layout, LayoutMatrix& step) {
+        constexpr size_t S = MAX_LAYOUT_CHANNELS;
+        constexpr size_t L = 0, R = 1, C = 2, Ls = 4, Rs = 5, Lb = 6, Rb = 7, Ltf = 8, Rtf = 9, Ltb = 10, Rtb = 11;
+        const T g = utils::inv_sqrt2<T>; // -3 dB
+        step.fill(T(0));
+        auto keep = [&](size_t numChannels) {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                step[ch * S + ch] = T(1);
+        };
+        switch (layout) {
+        case ChannelLayout::Surround714: // Heights into the ear-level pairs below them
+            keep(8);
+            step[L * S + Ltf] = g;
+            step[R * S + Rtf] = g;
+            step[Ls * S + Ltb] = g;
+            step[Rs * S + Rtb] = g;
+            return ChannelLayout::Surround71;
+        case ChannelLayout::Surround71: // Back surrounds into the side surrounds
+            keep(6);
+            step[Ls * S + Lb] = g;
+            step[Rs * S + Rb] = g;
+            return ChannelLayout::Surround51;
+        case ChannelLayout::Surround51: // ITU-R BS.775: centre and surrounds at -3 dB, LFE dropped
+            keep(2);
+            step[L * S + C] = g;
+            step[R * S + C] = g;
+            step[L * S + Ls] = g;
+            step[R * S + Rs] = g;
+            return ChannelLayout::Stereo;
+        case ChannelLayout::Stereo:
+            step[0] = T(0.5);
+            step[1] = T(0.5);
+            return ChannelLayout::Mono;
+        case ChannelLayout::Mono:
+            break;
+        }
+        keep(1);
+        return ChannelLayout::Mono;
+    }
+};
+
+} // namespace jnsc
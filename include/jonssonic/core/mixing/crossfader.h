@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
-#include <jonssonic/core/common/circular_audio_buffer.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/delays/latency_compensator.h>
 #include <jonssonic/utils/math_utils.h>
 
 namespace jnsc {
@@ -13,12 +15,16 @@ namespace jnsc {
  * @brief Crossfader for audio signals.
  *
  * Crossfades audio signals using equal-power law for smooth perceptual transitions.
- * Addionally supports latency compensation for the dry signal via a circular delay buffer.
+ * The gain curves are computed once per block for all channels with a sine/cosine recurrence.
+ * Addionally supports latency compensation for the first input via a block-copy delay.
  * @param T Sample data type (e.g., float, double)
  */
 
 template <typename T>
 class Crossfader {
+    /// Samples of gains and delayed input staged on the stack per pass
+    static constexpr size_t CHUNK_SIZE = 256;
+
   public:
     Crossfader() = default;
     ~Crossfader() = default;
@@ -36,14 +42,14 @@ class Crossfader {
      */
     void prepare(size_t newNumChannels, size_t maxLatencySamples = 0) {
         numChannels = newNumChannels;
-        latencyBuffer.resize(newNumChannels, maxLatencySamples);
+        latencyCompensator.prepare(newNumChannels, maxLatencySamples);
         crossfadeSamplePos = 0;
     }
 
     /**
      * @brief Reset crossfader state
      */
-    void reset() { latencyBuffer.clear(); }
+    void reset() { latencyCompensator.reset(); }
 
     /**
      * @brief Start a new crossfade transition.
@@ -68,31 +74,51 @@ class Crossfader {
                       T* const* output,
                       size_t numSamples,
                       size_t input1DelaySamples = 0) {
-        for (size_t n = 0; n < numSamples; ++n) {
-            T crossFadeOn = static_cast<T>(crossfadeSamplePos < crossFadeTimeSamples);
-            T fadeFactor = static_cast<T>(crossfadeSamplePos) /
-                               static_cast<T>(crossFadeTimeSamples - 1) * crossFadeOn +
-                           (T(1) - crossFadeOn);
+        const auto& kernels = getSimdKernels<T>();
+        latencyCompensator.setDelay(input1DelaySamples);
+        const T step = crossFadeTimeSamples > 1 ? T(1) / static_cast<T>(crossFadeTimeSamples - 1) : T(1);
+        T g1[CHUNK_SIZE], g2[CHUNK_SIZE], delayed[CHUNK_SIZE];
 
-            T g1 = std::cos(fadeFactor * pi_over_2<T>);
-            T g2 = std::sin(fadeFactor * pi_over_2<T>);
+        for (size_t offset = 0; offset < numSamples; offset += CHUNK_SIZE) {
+            const size_t len = std::min(CHUNK_SIZE, numSamples - offset);
 
-            for (size_t ch = 0; ch < numChannels; ++ch) {
-                T input1sample = input1[ch][n];
-                latencyBuffer.write(ch, input1sample);
-                input1sample = latencyBuffer.read(ch, input1DelaySamples);
+            // Gain curves are shared by all channels: a ramp while fading, then input 2 only
+            const size_t remaining = crossFadeTimeSamples - std::min(crossfadeSamplePos, crossFadeTimeSamples);
+            const size_t rampLen = std::min(len, remaining);
+            if (rampLen > 0) {
+                utils::equalPowerRamp(static_cast<T>(crossfadeSamplePos) * step, step, g1, g2, rampLen);
+                std::fill(g1 + rampLen, g1 + len, T(0));
+                std::fill(g2 + rampLen, g2 + len, T(1));
+                crossfadeSamplePos += rampLen;
+            }
 
-                output[ch][n] = input1sample * g1 + input2[ch][n] * g2;
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                latencyCompensator.processChannel(ch, input1[ch] + offset, delayed, len);
+                if (rampLen > 0)
+                    kernels.blendCurves(delayed, g1, input2[ch] + offset, g2, output[ch] + offset, len);
+                else
+                    kernels.blend(delayed, T(0), input2[ch] + offset, T(1), output[ch] + offset, len);
             }
-            crossfadeSamplePos += static_cast<size_t>(crossFadeOn);
         }
     }
 
+    /// Append the crossfade position and delay compensation to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(crossfadeSamplePos);
+        latencyCompensator.saveState(blob);
+    }
+
+    /// Restore the crossfade position and delay compensation from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(crossfadeSamplePos);
+        latencyCompensator.restoreState(reader);
+    }
+
   private:
     size_t numChannels = 0;
-    size_t crossFadeTimeSamples = 2048;   // Crossfade time in samples
-    size_t crossfadeSamplePos = 0;        // Current position in crossfade
-    CircularAudioBuffer<T> latencyBuffer; // Circular buffer for dry signal delay compensation
+    size_t crossFadeTimeSamples = 2048;       // Crossfade time in samples
+    size_t crossfadeSamplePos = 0;            // Current position in crossfade
+    LatencyCompensator<T> latencyCompensator; // Delay compensation for the first input
 };
 
 } // namespace jnsc
\ No newline at end of file
@@ -0,0 +1,64 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Lookup table for equal-power gains of arbitrary mix positions
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <jonssonic/utils/math_utils.h>
+
+namespace jnsc::detail {
+
+/**
+ * @brief Quarter sine table with linear interpolation for equal-power mixing.
+ * @details gainB = sin(p * pi/2) and gainA = cos(p * pi/2) = sin((1 - p) * pi/2), so the end points are exact
+ *          (full wet leaves no dry residue). The interpolation error stays below 2e-6.
+ * @tparam T Sample data type (float, double)
+ */
+template <typename T>
+class EqualPowerTable {
+  public:
+    /// Number of table segments
+    static constexpr size_t SIZE = 512;
+
+    /// Shared table, built on first use (call once from a non-realtime thread, e.g. in prepare)
+    static const EqualPowerTable& get() {
+        static const EqualPowerTable table;
+        return table;
+    }
+
+    /// sin(p * pi/2) for a position p in [0, 1]
+    T sine(T position) const {
+        const T x = std::min(std::max(position, T(0)), T(1)) * static_cast<T>(SIZE);
+        const size_t i = std::min(static_cast<size_t>(x), SIZE - 1);
+        const T frac = x - static_cast<T>(i);
+        return values[i] + frac * (values[i + 1] - values[i]);
+    }
+
+    /**
+     * @brief Gains for a block of mix positions.
+     * @param position Mix positions in [0, 1] (0 = all A, 1 = all B)
+     * @param gainA Output gains for signal A, cos(p * pi/2)
+     * @param gainB Output gains for signal B, sin(p * pi/2)
+     * @param numSamples Number of samples
+     */
+    void gains(const T* position, T* gainA, T* gainB, size_t numSamples) const {
+        for (size_t n = 0; n < numSamples; ++n) {
+            gainA[n] = sine(T(1) - position[n]);
+            gainB[n] = sine(position[n]);
+        }
+    }
+
+  private:
+    std::array<T, SIZE + 1> values;
+
+    EqualPowerTable() {
+        for (size_t i = 0; i <= SIZE; ++i)
+            values[i] = static_cast<T>(std::sin(static_cast<double>(i) / SIZE * utils::pi_over_2<double>));
+        values[SIZE] = T(1);
+    }
+};
+
+} // namespace jnsc::detail
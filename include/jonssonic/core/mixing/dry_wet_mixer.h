@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
-#include <jonssonic/core/common/circular_audio_buffer.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/delays/latency_compensator.h>
+#include <jonssonic/core/mixing/detail/equal_power_table.h>
 #include <jonssonic/utils/math_utils.h>
 
 namespace jnsc {
@@ -14,10 +17,16 @@ namespace jnsc {
  * @brief Dry/Wet mixer for audio signals.
  *
  * Mixes dry and wet signals based on a mix parameter (0.0 = full dry, 1.0 = full wet).
+ * Equal-power gains come from a shared lookup table, and only once per block while the mix is settled.
  */
 
 template <typename T>
 class DryWetMixer {
+    /// Samples of delayed dry signal and gains staged on the stack per pass
+    static constexpr size_t DRY_CHUNK_SIZE = 256;
+    /// Distance from the target mix at which smoothing snaps to it (gain error around -100 dB)
+    static constexpr T SETTLE_TOLERANCE = T(1e-5);
+
   public:
     DryWetMixer() = default;
     ~DryWetMixer() = default;
@@ -32,20 +41,47 @@ class DryWetMixer {
      * @brief Prepare the mixer for processing.
      * @param newNumChannels Number of channels to process
      * @param newSampleRate Sample rate in Hz
-     * @param smoothingTimeMs Smoothing time for mix parameter changes (default: 15ms)
+     * @param maxDryDelaySamples Maximum delay applied to the dry signal (latency compensation)
      */
     void prepare(size_t newNumChannels, T newSampleRate, size_t maxDryDelaySamples = 0) {
         numChannels = newNumChannels;
+        numActiveChannels = numChannels;
         mix.prepare(newNumChannels, newSampleRate);
         mix.setBounds(T(0), T(1)); // Clamp between 0 and 1
         mix.setTarget(T(1), true); // Default to full wet
-        dryDelayBuffer.resize(newNumChannels, maxDryDelaySamples);
+        dryDelay.prepare(newNumChannels, maxDryDelaySamples);
+        detail::EqualPowerTable<T>::get(); // build the shared gain table outside the audio thread
     }
 
     /**
      * @brief Clear the mixer state (same as reset).
      */
-    void reset() { mix.reset(); }
+    void reset() {
+        mix.reset();
+        dryDelay.reset();
+    }
+
+    /**
+     * @brief Reset the state of a single channel.
+     * @param ch Channel index
+     */
+    void resetChannel(size_t ch) {
+        mix.resetChannel(ch);
+        dryDelay.resetChannel(ch);
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
 
     /**
      * @brief Set control smoothing time for the mix parameter.
@@ -70,6 +106,29 @@ class DryWetMixer {
         mix.setTarget(ch, newMix, skipSmoothing);
     }
 
+    /**
+     * @brief Process a single sample of a specific channel with equal-power crossfading.
+     * @param ch Channel index
+     * @param drySample Dry input sample
+     * @param wetSample Wet input sample
+     * @param dryDelaySamples Delay applied to the dry signal in samples
+     * @return Mixed output sample
+     */
+    T processSample(size_t ch, T drySample, T wetSample, size_t dryDelaySamples = 0) {
+        T mixValue = mix.getNextValue(ch);
+
+        // Equal-power crossfade: cos(x) for dry, sin(x) for wet
+        const auto& table = detail::EqualPowerTable<T>::get();
+        T dryGain = table.sine(T(1) - mixValue);
+        T wetGain = table.sine(mixValue);
+
+        // Apply dry delay if needed
+        dryDelay.setDelay(dryDelaySamples);
+        drySample = dryDelay.processSample(ch, drySample);
+
+        return drySample * dryGain + wetSample * wetGain;
+    }
+
     /**
      * @brief Process a block of samples with equal-power crossfading.
      * @param dryInput Dry signal input pointers (one per channel)
@@ -85,29 +144,82 @@ class DryWetMixer {
                       T* const* output,
                       size_t numSamples,
                       size_t dryDelaySamples = 0) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t n = 0; n < numSamples; ++n) {
-                T mixValue = mix.getNextValue(ch);
+        const auto& kernels = getSimdKernels<T>();
+        const auto& table = detail::EqualPowerTable<T>::get();
+        dryDelay.setDelay(dryDelaySamples);
+        T delayedDry[DRY_CHUNK_SIZE], mixValues[DRY_CHUNK_SIZE], dryGains[DRY_CHUNK_SIZE], wetGains[DRY_CHUNK_SIZE];
 
-                // Equal-power crossfade: cos(x) for dry, sin(x) for wet
-                T dryGain = std::cos(mixValue * utils::pi_over_2<T>);
-                T wetGain = std::sin(mixValue * utils::pi_over_2<T>);
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
+            // A settled mix needs its gains only once per block
+            const bool settled = mix.settle(ch, SETTLE_TOLERANCE);
+            const T currentMix = mix.getCurrentValue(ch);
+            const T dryGain = table.sine(T(1) - currentMix);
+            const T wetGain = table.sine(currentMix);
 
-                // Apply dry delay if needed
-                T drySample = dryInput[ch][n];
-                dryDelayBuffer.write(ch, drySample);
-                drySample = dryDelayBuffer.read(ch, dryDelaySamples);
+            for (size_t offset = 0; offset < numSamples; offset += DRY_CHUNK_SIZE) {
+                const size_t len = std::min(DRY_CHUNK_SIZE, numSamples - offset);
 
-                // Mix dry and wet signals
-                output[ch][n] = drySample * dryGain + wetInput[ch][n] * wetGain;
+                // Delay the dry signal by whole chunks
+                dryDelay.processChannel(ch, dryInput[ch] + offset, delayedDry, len);
+
+                // Equal-power crossfade: cos(x) for dry, sin(x) for wet
+                if (settled) {
+                    kernels.blend(delayedDry, dryGain, wetInput[ch] + offset, wetGain, output[ch] + offset, len);
+                } else {
+                    for (size_t n = 0; n < len; ++n)
+                        mixValues[n] = mix.getNextValue(ch);
+                    table.gains(mixValues, dryGains, wetGains, len);
+                    kernels.blendCurves(
+                        delayedDry, dryGains, wetInput[ch] + offset, wetGains, output[ch] + offset, len);
+                }
             }
         }
     }
 
+    /**
+     * @brief Process a block of interleaved frames with equal-power crossfading.
+     * @param dryInput Interleaved dry frames [frame][channel] (frame size is the prepared channel count)
+     * @param wetInput Interleaved wet frames [frame][channel]
+     * @param output Interleaved output frames [frame][channel], may alias either input
+     * @param numFrames Number of frames to process
+     * @param dryDelaySamples Delay applied to the dry signal in samples
+     */
+    void processBlock(
+        const T* dryInput, const T* wetInput, T* output, size_t numFrames, size_t dryDelaySamples = 0) {
+        for (size_t f = 0; f < numFrames; ++f) {
+            const size_t frame = f * numChannels;
+            for (size_t ch = 0; ch < numActiveChannels; ++ch)
+                output[frame + ch] =
+                    processSample(ch, dryInput[frame + ch], wetInput[frame + ch], dryDelaySamples);
+        }
+    }
+
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
+    /// True once the mix of a channel sits on its target, so block processing uses constant gains
+    bool isMixSettled(size_t ch) const { return mix.getCurrentValue(ch) == mix.getTargetValue(ch); }
+
+    /// Append the mix smoothing and dry delay to a state snapshot
+    void saveState(StateBlob& blob) const {
+        mix.saveState(blob);
+        dryDelay.saveState(blob);
+    }
+
+    /// Restore the mix smoothing and dry delay from a state snapshot
+    void restoreState(StateReader& reader) {
+        mix.restoreState(reader);
+        dryDelay.restoreState(reader);
+    }
+
   private:
     size_t numChannels = 0;
-    DspParam<T> mix;                       // Mix parameter with smoothing
-    CircularAudioBuffer<T> dryDelayBuffer; // Circular buffer for dry signal delay compensation
+    size_t numActiveChannels = 0;
+    DspParam<T> mix;                // Mix parameter with smoothing
+    LatencyCompensator<T> dryDelay; // Dry signal delay compensation
 };
 
 } // namespace jnsc
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #pragma once
 #include <cstddef>
+#include <cstring>
 #include <jonssonic/utils/math_utils.h>
 #include <random>
 #include <vector>
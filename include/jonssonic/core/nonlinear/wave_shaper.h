@@ -5,8 +5,11 @@
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
 #include <cmath>
+#include <cstring>
 #include <functional>
+#include <jonssonic/core/common/simd_dispatch.h>
 #include <jonssonic/utils/math_utils.h>
+#include <type_traits>
 
 namespace jnsc {
 
@@ -50,12 +53,23 @@ class WaveShaper<T, WaveShaperType::None> {
 template <typename T>
 class WaveShaper<T, WaveShaperType::HardClip> {
   public:
-    T processSample(T x, T shape = T(0)) const { return std::max<T>(-1, std::min<T>(1, x)); }
+    T processSample(T x, T shape = T(0)) const {
+        using std::max;
+        using std::min;
+        return max(T(-1), min(T(1), x));
+    }
 
     void processBlock(const T* const* input, T* const* output, size_t numChannels, size_t numSamples) const {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t n = 0; n < numSamples; ++n) {
-                output[ch][n] = processSample(input[ch][n]);
+        if constexpr (std::is_floating_point<T>::value) {
+            // Runtime-dispatched block kernel (bit-exact with processSample)
+            const auto& kernels = getSimdKernels<T>();
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                kernels.hardClip(input[ch], output[ch], numSamples);
+        } else {
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                for (size_t n = 0; n < numSamples; ++n) {
+                    output[ch][n] = processSample(input[ch][n]);
+                }
             }
         }
     }
@@ -70,7 +84,10 @@ class WaveShaper<T, WaveShaperType::HardClip> {
 template <typename T>
 class WaveShaper<T, WaveShaperType::Atan> {
   public:
-    T processSample(T x, T shape = T(0)) const { return std::atan(x) * utils::inv_atan_1<T>; }
+    T processSample(T x, T shape = T(0)) const {
+        using std::atan;
+        return atan(x) * utils::inv_atan_1<T>;
+    }
 
     void processBlock(const T* const* input, T* const* output, size_t numChannels, size_t numSamples) const {
         for (size_t ch = 0; ch < numChannels; ++ch) {
@@ -86,12 +103,15 @@ class WaveShaper<T, WaveShaperType::Atan> {
 // =====================================================================
 /**
  * @brief Tanh shaper specialization.
- *        Applies std::tanh(x) for smooth saturation.
+ *        Applies tanh(x) for smooth saturation.
  */
 template <typename T>
 class WaveShaper<T, WaveShaperType::Tanh> {
   public:
-    T processSample(T x, T shape = T(0)) const { return std::tanh(x); }
+    T processSample(T x, T shape = T(0)) const {
+        using std::tanh;
+        return tanh(x);
+    }
 
     void processBlock(const T* const* input, T* const* output, size_t numChannels, size_t numSamples) const {
         for (size_t ch = 0; ch < numChannels; ++ch) {
@@ -112,7 +132,10 @@ class WaveShaper<T, WaveShaperType::Tanh> {
 template <typename T>
 class WaveShaper<T, WaveShaperType::FullWaveRectifier> {
   public:
-    T processSample(T x, T shape = T(0)) const { return std::abs(x); }
+    T processSample(T x, T shape = T(0)) const {
+        using std::abs;
+        return abs(x);
+    }
 
     void processBlock(const T* const* input, T* const* output, size_t numChannels, size_t numSamples) const {
         for (size_t ch = 0; ch < numChannels; ++ch) {
@@ -133,7 +156,10 @@ class WaveShaper<T, WaveShaperType::FullWaveRectifier> {
 template <typename T>
 class WaveShaper<T, WaveShaperType::HalfWaveRectifier> {
   public:
-    T processSample(T x, T shape = T(0)) const { return x < 0 ? 0 : x; }
+    T processSample(T x, T shape = T(0)) const {
+        using std::max;
+        return max(x, T(0));
+    }
 
     void processBlock(const T* const* input, T* const* output, size_t numChannels, size_t numSamples) const {
         for (size_t ch = 0; ch < numChannels; ++ch) {
@@ -158,9 +184,16 @@ class WaveShaper<T, WaveShaperType::Cubic> {
     T processSample(T x, T shape = T(0)) const { return x - (T(1) / T(3)) * x * x * x; }
 
     void processBlock(const T* const* input, T* const* output, size_t numChannels, size_t numSamples) const {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t n = 0; n < numSamples; ++n) {
-                output[ch][n] = processSample(input[ch][n]);
+        if constexpr (std::is_floating_point<T>::value) {
+            // Runtime-dispatched block kernel (bit-exact with processSample)
+            const auto& kernels = getSimdKernels<T>();
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                kernels.cubicClip(input[ch], output[ch], numSamples);
+        } else {
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                for (size_t n = 0; n < numSamples; ++n) {
+                    output[ch][n] = processSample(input[ch][n]);
+                }
             }
         }
     }
@@ -182,7 +215,9 @@ class WaveShaper<T, WaveShaperType::Dynamic> {
      * @param shape Raw shape parameter (usable range ~ [2, 20])
      */
     T processSample(T x, T shape = T(0)) const {
-        return x * T(1) / std::pow(T(1) + std::pow(std::abs(x), shape), T(1) / shape);
+        using std::abs;
+        using std::pow;
+        return x * T(1) / pow(T(1) + pow(abs(x), shape), T(1) / shape);
     }
 
     void processBlock(
@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/interleaved_frames.h>
+#include <jonssonic/core/common/output_mode.h>
 #include <jonssonic/core/nonlinear/wave_shaper.h>
 #include <vector>
 
@@ -72,11 +74,34 @@ class WaveShaperProcessor {
         bias.setTarget(T(0), true);
         asymmetry.setTarget(T(0), true);
         shape.setTarget(T(1), true); // Only functional with Dynamic shaper
+        numActiveChannels = numChannels;
     }
 
     /// Reset the wave shaper processor state
     void reset() { /* Nothing to reset internally for now.*/ }
 
+    /// Reset the parameter smoothing of a single channel
+    void resetChannel(size_t ch) {
+        inputGain.resetChannel(ch);
+        outputGain.resetChannel(ch);
+        bias.resetChannel(ch);
+        asymmetry.resetChannel(ch);
+        shape.resetChannel(ch);
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * @brief Process a single sample of specified channel.
      * @param ch Channel index
@@ -93,7 +118,7 @@ class WaveShaperProcessor {
         T sign = (T(0) < input) - (input < T(0)); // 1 if input>0, -1 if input<0, 0 if input==0
         input *= (T(1) + asym * sign);
         // Apply waveshaping
-        input = shaper.processSample(input);
+        input = shaper.processSample(input, shape.getNextValue(ch));
         // Apply output gain
         input *= outputGain.getNextValue(ch);
         return input;
@@ -106,25 +131,41 @@ class WaveShaperProcessor {
      * @param numSamples Number of samples to process
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t n = 0; n < numSamples; ++n) {
-                // Get input sample
-                T sample = input[ch][n];
-                // Apply input gain
-                sample *= inputGain.getNextValue(ch);
-                // Apply bias
-                sample += bias.getNextValue(ch);
-                // Apply asymmetry (branchless)
-                T asym = asymmetry.getNextValue(ch);
-                T sign =
-                    (T(0) < sample) - (sample < T(0)); // 1 if input>0, -1 if input<0, 0 if input==0
-                sample *= (T(1) + asym * sign);
-                // Apply waveshaping
-                output[ch][n] = shaper.processSample(sample, shape.getNextValue(ch));
-                // Apply output gain
-                output[ch][n] *= outputGain.getNextValue(ch);
-            }
-        }
+        processBlockImpl<OutputMode::Replace>(input, output, numSamples, T(1), 0, numActiveChannels);
+    }
+
+    /**
+     * @brief Process a block for a range of channels (channels outside the range are untouched).
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param chBegin First channel to process
+     * @param chEnd One past the last channel to process
+     */
+    void processChannelRange(const T* const* input, T* const* output, size_t numSamples, size_t chBegin, size_t chEnd) {
+        processBlockImpl<OutputMode::Replace>(input, output, numSamples, T(1), chBegin, chEnd);
+    }
+
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        processBlockImpl<OutputMode::Add>(input, output, numSamples, gain, 0, numActiveChannels);
+    }
+
+    /**
+     * @brief Process a block of interleaved frames for all channels.
+     * @param input Interleaved input frames [frame][channel] (frame size is the prepared channel count)
+     * @param output Interleaved output frames [frame][channel], may alias the input
+     * @param numFrames Number of frames to process
+     * @note Avoids deinterleaving host buffers; results match planar processing.
+     */
+    void processBlock(const T* input, T* output, size_t numFrames) {
+        processInterleavedFrames(*this, input, output, numChannels, numActiveChannels, numFrames);
     }
 
     /**
@@ -234,8 +275,61 @@ class WaveShaperProcessor {
         shape.setTarget(shapeValue, skipSmoothing);
     }
 
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
+    /// Get sample rate
+    T getSampleRate() const { return sampleRate; }
+
+    /// Append the parameter smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        inputGain.saveState(blob);
+        outputGain.saveState(blob);
+        bias.saveState(blob);
+        asymmetry.saveState(blob);
+        shape.saveState(blob);
+    }
+
+    /// Restore the parameter smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        inputGain.restoreState(reader);
+        outputGain.restoreState(reader);
+        bias.restoreState(reader);
+        asymmetry.restoreState(reader);
+        shape.restoreState(reader);
+    }
+
   private:
+    // Block loop shared by processBlock and processBlockAdding
+    template <OutputMode Mode>
+    void processBlockImpl(
+        const T* const* input, T* const* output, size_t numSamples, T addGain, size_t chBegin, size_t chEnd) {
+        for (size_t ch = chBegin; ch < chEnd; ++ch) {
+            for (size_t n = 0; n < numSamples; ++n) {
+                // Get input sample
+                T sample = input[ch][n];
+                // Apply input gain
+                sample *= inputGain.getNextValue(ch);
+                // Apply bias
+                sample += bias.getNextValue(ch);
+                // Apply asymmetry (branchless)
+                T asym = asymmetry.getNextValue(ch);
+                T sign =
+                    (T(0) < sample) - (sample < T(0)); // 1 if input>0, -1 if input<0, 0 if input==0
+                sample *= (T(1) + asym * sign);
+                // Apply waveshaping
+                T shaped = shaper.processSample(sample, shape.getNextValue(ch));
+                // Apply output gain
+                detail::storeOutput<Mode>(output[ch][n], shaped * outputGain.getNextValue(ch), addGain);
+            }
+        }
+    }
+
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     T sampleRate = T(44100);
     DspParam<T> inputGain;
     DspParam<T> outputGain;
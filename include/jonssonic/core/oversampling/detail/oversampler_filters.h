@@ -3,7 +3,13 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
-#include <jonssonic/core/common/circular_audio_buffer.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/common/state_blob.h>
 #include <jonssonic/utils/math_utils.h>
 #include <numeric>
 #include <vector>
@@ -35,19 +41,37 @@ class FIRHalfbandStage {
     void prepare(size_t newNumChannels) {
         numChannels = newNumChannels;
 
-        // Allocate buffers
-        upsamplerBuffer.resize(newNumChannels, FIRTaps);
-        // Downsampler uses interleaved polyphase branch channels: even indices for even branch, odd
-        // for odd branch
-        downsamplerBuffer.resize(newNumChannels * 2, FIRTaps / 2 + 1);
+        // Allocate linear history buffers: HISTORY samples of past input followed by one chunk of new input.
+        // The downsampler keeps its even and odd polyphase branches in separate buffers.
+        upsamplerHistory.resize(newNumChannels, HISTORY + CHUNK_SIZE);
+        downsamplerEven.resize(newNumChannels, HISTORY + CHUNK_SIZE);
+        downsamplerOdd.resize(newNumChannels, HISTORY + CHUNK_SIZE);
+        evenBranchOutput.resize(newNumChannels, CHUNK_SIZE);
 
         // Initialize filter coefficients
         prepareCoeffs();
+        numActiveChannels = numChannels;
     }
 
     void reset() {
-        upsamplerBuffer.clear();
-        downsamplerBuffer.clear();
+        upsamplerHistory.clear();
+        downsamplerEven.clear();
+        downsamplerOdd.clear();
+    }
+
+    /// Reset the filter history of a single channel
+    void resetChannel(size_t ch) {
+        upsamplerHistory.clearChannel(ch);
+        downsamplerEven.clearChannel(ch);
+        downsamplerOdd.clearChannel(ch);
+    }
+
+    /// Set the number of processed channels (re-enabled channels start from cleared history)
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
     }
 
     /**
@@ -58,26 +82,44 @@ class FIRHalfbandStage {
      * @note Output buffer must have space for 2 * numInputSamples samples per channel
      */
     void upsample(const T* const* input, T* const* output, size_t numInputSamples) {
+        upsample(input, output, numInputSamples, 0, numActiveChannels);
+    }
 
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t n = 0; n < numInputSamples; ++n) {
-                // Push new sample into the circular buffer
-                upsamplerBuffer.write(ch, input[ch][n]);
+    /**
+     * @brief Upsample a range of channels by 2x (channels outside the range are untouched)
+     * @param input Input audio buffer (deinterleaved)
+     * @param output Output audio buffer (deinterleaved)
+     * @param numInputSamples Number of input samples per channel
+     * @param chBegin First channel to process
+     * @param chEnd One past the last channel to process
+     */
+    void upsample(const T* const* input, T* const* output, size_t numInputSamples, size_t chBegin, size_t chEnd) {
+        const auto& kernels = getSimdKernels<T>();
+        for (size_t ch = chBegin; ch < chEnd; ++ch) {
+            T* history = upsamplerHistory.writeChannelPtr(ch);
+            T* x = history + HISTORY;
+            T* y0 = evenBranchOutput.writeChannelPtr(ch);
+
+            for (size_t offset = 0; offset < numInputSamples; offset += CHUNK_SIZE) {
+                const size_t len = std::min(CHUNK_SIZE, numInputSamples - offset);
+                std::memcpy(x, input[ch] + offset, len * sizeof(T));
 
                 // Polyphase filtering - even branch (symmetric optimization)
-                T y0 = T(0);
-                for (size_t k = 0; k < K0; ++k) {
-                    T sum = upsamplerBuffer.read(ch, k) + upsamplerBuffer.read(ch, halfFIRTaps - k);
-                    y0 += coeffs0[k] * sum;
-                }
+                kernels.halfbandFir(x, y0, len, coeffs0.data(), K0, halfFIRTaps);
+
+                T* out = output[ch] + 2 * offset;
+                for (size_t n = 0; n < len; ++n) {
+                    // Polyphase filtering - odd branch
+                    // For halfband filters, only the center tap (0.5) is non-zero
+                    T y1 = T(0.5) * x[n - centerTapIdx];
 
-                // Polyphase filtering - odd branch
-                // For halfband filters, only the center tap (0.5) is non-zero
-                T y1 = T(0.5) * upsamplerBuffer.read(ch, centerTapIdx);
+                    // Upsampled output (with 2x gain compensation)
+                    out[2 * n] = 2 * y0[n];
+                    out[2 * n + 1] = 2 * y1;
+                }
 
-                // Upsampled output (with 2x gain compensation)
-                output[ch][2 * n] = 2 * y0;
-                output[ch][2 * n + 1] = 2 * y1;
+                // Keep the most recent samples as history for the next chunk
+                std::memmove(history, history + len, HISTORY * sizeof(T));
             }
         }
     }
@@ -91,51 +133,91 @@ class FIRHalfbandStage {
      * @note This applies the full anti-aliasing filter then decimates by 2
      */
     void downsample(const T* const* input, T* const* output, size_t numOutputSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            // Polyphase branch channels: even branch at ch*2, odd branch at ch*2+1
-            const size_t evenCh = ch * 2;
-            const size_t oddCh = ch * 2 + 1;
+        downsample(input, output, numOutputSamples, 0, numActiveChannels);
+    }
+
+    /**
+     * @brief Downsample a range of channels by 2x (channels outside the range are untouched)
+     * @param input Input audio buffer (deinterleaved)
+     * @param output Output audio buffer (deinterleaved)
+     * @param numOutputSamples Number of output samples per channel
+     * @param chBegin First channel to process
+     * @param chEnd One past the last channel to process
+     */
+    void downsample(const T* const* input, T* const* output, size_t numOutputSamples, size_t chBegin, size_t chEnd) {
+        const auto& kernels = getSimdKernels<T>();
+        for (size_t ch = chBegin; ch < chEnd; ++ch) {
+            T* evenHistory = downsamplerEven.writeChannelPtr(ch);
+            T* oddHistory = downsamplerOdd.writeChannelPtr(ch);
+            T* branches[2] = {evenHistory + HISTORY, oddHistory + HISTORY};
+            T* y0 = evenBranchOutput.writeChannelPtr(ch);
+
+            for (size_t offset = 0; offset < numOutputSamples; offset += CHUNK_SIZE) {
+                const size_t len = std::min(CHUNK_SIZE, numOutputSamples - offset);
 
-            for (size_t n = 0; n < numOutputSamples; ++n) {
-                // Push even and odd samples into separate polyphase branches
-                downsamplerBuffer.write(evenCh, input[ch][2 * n]);    // even sample
-                downsamplerBuffer.write(oddCh, input[ch][2 * n + 1]); // odd sample
+                // Split even and odd samples into separate polyphase branches
+                kernels.deinterleave(input[ch] + 2 * offset, branches, 2, len);
 
                 // Filter even branch (h0 coefficients, symmetric optimization)
-                T y0 = T(0);
-                for (size_t k = 0; k < K0; ++k) {
-                    T sum = downsamplerBuffer.read(evenCh, k) + downsamplerBuffer.read(evenCh, halfFIRTaps - k);
-                    y0 += coeffs0[k] * sum;
-                }
+                kernels.halfbandFir(branches[0], y0, len, coeffs0.data(), K0, halfFIRTaps);
+
+                const T* odd = branches[1];
+                T* out = output[ch] + offset;
+                for (size_t n = 0; n < len; ++n) {
+                    // Filter odd branch - only center tap (0.5) with one-sample delay
+                    // The +1 accounts for the z^-1 delay in the downsampler odd branch
+                    T y1 = T(0.5) * odd[n - (centerTapIdx + 1)];
 
-                // Filter odd branch - only center tap (0.5) with one-sample delay
-                // The +1 accounts for the z^-1 delay in the downsampler odd branch
-                T y1 = T(0.5) * downsamplerBuffer.read(oddCh, centerTapIdx + 1);
+                    // Combine polyphase branches
+                    out[n] = y0[n] + y1;
+                }
 
-                // Combine polyphase branches
-                output[ch][n] = y0 + y1;
+                // Keep the most recent samples as history for the next chunk
+                std::memmove(evenHistory, evenHistory + len, HISTORY * sizeof(T));
+                std::memmove(oddHistory, oddHistory + len, HISTORY * sizeof(T));
             }
         }
     }
 
+    /// Get number of channels
+    size_t getNumChannels() const { return numChannels; }
+
     constexpr T getLatencySamples() const {
         // Latency is (FIRTaps - 1) / 2 samples due to linear phase FIR filter
         return (FIRTaps - 1) / 2;
     }
 
-  private:
-    size_t numChannels = 0; // number of channels
+    /// Append the filter histories to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(upsamplerHistory);
+        blob.write(downsamplerEven);
+        blob.write(downsamplerOdd);
+    }
 
-    // BUFFERS
-    CircularAudioBuffer<T> upsamplerBuffer;   // Circular audio buffer for upsampler filter state
-    CircularAudioBuffer<T> downsamplerBuffer; // Polyphase buffer: even channels for even branch,
-                                              // odd channels for odd branch
+    /// Restore the filter histories from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(upsamplerHistory);
+        reader.read(downsamplerEven);
+        reader.read(downsamplerOdd);
+    }
+
+  private:
+    size_t numChannels = 0;       // number of channels
+    size_t numActiveChannels = 0; // number of processed channels
 
     // COEFFICIENTS
     static constexpr size_t K0 =
         (FIRTaps / 2 + 1) / 2; // Number of unique symmetric even polyphase coefficients actually stored
     static constexpr size_t centerTapIdx = FIRTaps / 4; // Center tap index in odd polyphase branch
     static constexpr size_t halfFIRTaps = FIRTaps / 2;  // Half the number of FIR taps
+
+    // BUFFERS
+    static constexpr size_t HISTORY = halfFIRTaps; // Longest delay read by either branch
+    static constexpr size_t CHUNK_SIZE = 64;       // Samples filtered per kernel call
+    AudioBuffer<T> upsamplerHistory;               // Upsampler input history (linear, per channel)
+    AudioBuffer<T> downsamplerEven;                // Downsampler even branch history
+    AudioBuffer<T> downsamplerOdd;                 // Downsampler odd branch history
+    AudioBuffer<T> evenBranchOutput;               // Even branch output for the current chunk
     std::array<T, K0> coeffs0; // Even polyphase coefficients (odd branch is just 0.5 * center tap)
 
     /**
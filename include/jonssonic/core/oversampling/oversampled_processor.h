@@ -151,7 +151,7 @@ class OversampledProcessor<T, 0> {
      * @param factor Current oversampling factor
      * @return Latency in samples
      */
-    size_t getLatencySamples(int factor) const {
+    T getLatencySamples(int factor) const {
         switch (factor) {
         case 2:
             return oversampler2x.getLatencySamples();
@@ -162,10 +162,26 @@ class OversampledProcessor<T, 0> {
         case 16:
             return oversampler16x.getLatencySamples();
         default:
-            return 0;
+            return T(0);
         }
     }
 
+    /// Append the filter histories of all oversampling factors to a state snapshot
+    void saveState(StateBlob& blob) const {
+        oversampler2x.saveState(blob);
+        oversampler4x.saveState(blob);
+        oversampler8x.saveState(blob);
+        oversampler16x.saveState(blob);
+    }
+
+    /// Restore the filter histories of all oversampling factors from a state snapshot
+    void restoreState(StateReader& reader) {
+        oversampler2x.restoreState(reader);
+        oversampler4x.restoreState(reader);
+        oversampler8x.restoreState(reader);
+        oversampler16x.restoreState(reader);
+    }
+
   private:
     /**
      * @brief Internal helper: upsample → process → downsample
@@ -247,6 +263,12 @@ class OversampledProcessor {
         oversampledBuffer.clear();
     }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     */
+    void setActiveChannels(size_t newNumActiveChannels) { oversampler.setActiveChannels(newNumActiveChannels); }
+
     /**
      * @brief Process audio with the configured oversampling factor
      * @param input Input audio buffer (array of channel pointers)
@@ -272,11 +294,44 @@ class OversampledProcessor {
         oversampler.downsample(oversampledBuffer.readPtrs(), output, numSamples);
     }
 
+    /**
+     * @brief Process a range of channels with oversampling (channels outside the range are untouched).
+     * @param input Input audio buffer (array of channel pointers)
+     * @param output Output audio buffer (array of channel pointers)
+     * @param numSamples Number of samples per channel
+     * @param chBegin First channel to process
+     * @param chEnd One past the last channel to process
+     * @param processFunc Function to call for processing: (const T**, T**, size_t samples); it receives pointers
+     *        for all channels and must only process the range.
+     */
+    template <typename ProcessFunc>
+    void processChannelRange(const T* const* input,
+                             T* const* output,
+                             size_t numSamples,
+                             size_t chBegin,
+                             size_t chEnd,
+                             ProcessFunc&& processFunc) {
+        T* const* oversampled = oversampledBuffer.writePtrs();
+        size_t oversampledSamples = oversampler.upsample(input, oversampled, numSamples, chBegin, chEnd);
+        processFunc(oversampled, oversampled, oversampledSamples);
+        oversampler.downsample(oversampled, output, numSamples, chBegin, chEnd);
+    }
+
     /**
      * @brief Get total latency in samples at base sample rate
      * @return Latency in samples
      */
-    size_t getLatencySamples() const { return oversampler.getLatencySamples(); }
+    T getLatencySamples() const { return oversampler.getLatencySamples(); }
+
+    /// Append the oversampler filter histories to a state snapshot
+    void saveState(StateBlob& blob) const {
+        oversampler.saveState(blob);
+    }
+
+    /// Restore the oversampler filter histories from a state snapshot
+    void restoreState(StateReader& reader) {
+        oversampler.restoreState(reader);
+    }
 
   private:
     size_t numChannels = 0;
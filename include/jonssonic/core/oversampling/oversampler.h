@@ -49,6 +49,7 @@ class Oversampler {
      */
     void prepare(size_t newNumChannels, size_t newMaxBlockSize) {
         numChannels = newNumChannels;
+        numActiveChannels = numChannels;
 
         // Prepare all stages
         if constexpr (Factor >= 2) {
@@ -87,6 +88,28 @@ class Oversampler {
         }
     }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Up- and downsampling skip the channels from this index on. Channels that become active again start
+     *       from cleared filter history.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        numActiveChannels = std::min(newNumActiveChannels, numChannels);
+        if constexpr (Factor >= 2) {
+            stage1.setActiveChannels(numActiveChannels);
+        }
+        if constexpr (Factor >= 4) {
+            stage2.setActiveChannels(numActiveChannels);
+        }
+        if constexpr (Factor >= 8) {
+            stage3.setActiveChannels(numActiveChannels);
+        }
+        if constexpr (Factor == 16) {
+            stage4.setActiveChannels(numActiveChannels);
+        }
+    }
+
     /**
      * @brief Upsample input buffer by the oversampling factor.
      * @param input Input audio buffer (array of channel pointers)
@@ -97,45 +120,70 @@ class Oversampler {
      */
 
     size_t upsample(const T* const* input, T* const* output, size_t numInputSamples) {
+        return upsample(input, output, numInputSamples, 0, numActiveChannels);
+    }
+
+    /**
+     * @brief Upsample a range of channels (channels outside the range are untouched).
+     * @param input Input audio buffer (array of channel pointers)
+     * @param output Output audio buffer (array of channel pointers)
+     * @param numInputSamples Number of input samples per channel
+     * @param chBegin First channel to process
+     * @param chEnd One past the last channel to process
+     * @return Number of output samples per channel
+     */
+    size_t upsample(const T* const* input, T* const* output, size_t numInputSamples, size_t chBegin, size_t chEnd) {
         // Factor 1 (bypass)
         if constexpr (Factor == 1) {
-            for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t ch = chBegin; ch < chEnd; ++ch) {
                 std::copy(input[ch], input[ch] + numInputSamples, output[ch]);
             }
         }
         // Factor 2
         if constexpr (Factor == 2) {
-            stage1.upsample(input, output, numInputSamples); // stage1 1x to 2x
+            stage1.upsample(input, output, numInputSamples, chBegin, chEnd); // stage1 1x to 2x
         }
 
         // Factor 4
         if constexpr (Factor == 4) {
             // stage1 1x to 2x
-            stage1.upsample(input, intermediateBuffer1to2.writePtrs(), numInputSamples);
+            stage1.upsample(input, intermediateBuffer1to2.writePtrs(), numInputSamples, chBegin, chEnd);
             // stage2 2x to 4x
-            stage2.upsample(intermediateBuffer1to2.readPtrs(), output, 2 * numInputSamples);
+            stage2.upsample(intermediateBuffer1to2.readPtrs(), output, 2 * numInputSamples, chBegin, chEnd);
         }
 
         // Factor 8
         if constexpr (Factor == 8) {
             // stage1 1x to 2x
-            stage1.upsample(input, intermediateBuffer1to2.writePtrs(), numInputSamples);
+            stage1.upsample(input, intermediateBuffer1to2.writePtrs(), numInputSamples, chBegin, chEnd);
             // stage2 2x to 4x
-            stage2.upsample(intermediateBuffer1to2.readPtrs(), intermediateBuffer2to4.writePtrs(), 2 * numInputSamples);
+            stage2.upsample(intermediateBuffer1to2.readPtrs(),
+                            intermediateBuffer2to4.writePtrs(),
+                            2 * numInputSamples,
+                            chBegin,
+                            chEnd);
             // stage3 4x to 8x
-            stage3.upsample(intermediateBuffer2to4.readPtrs(), output, 4 * numInputSamples);
+            stage3.upsample(intermediateBuffer2to4.readPtrs(), output, 4 * numInputSamples, chBegin, chEnd);
         }
 
         // Factor 16
         if constexpr (Factor == 16) {
             // stage1 1x to 2x
-            stage1.upsample(input, intermediateBuffer1to2.writePtrs(), numInputSamples);
+            stage1.upsample(input, intermediateBuffer1to2.writePtrs(), numInputSamples, chBegin, chEnd);
             // stage2 2x to 4x
-            stage2.upsample(intermediateBuffer1to2.readPtrs(), intermediateBuffer2to4.writePtrs(), 2 * numInputSamples);
+            stage2.upsample(intermediateBuffer1to2.readPtrs(),
+                            intermediateBuffer2to4.writePtrs(),
+                            2 * numInputSamples,
+                            chBegin,
+                            chEnd);
             // stage3 4x to 8x
-            stage3.upsample(intermediateBuffer2to4.readPtrs(), intermediateBuffer4to8.writePtrs(), 4 * numInputSamples);
+            stage3.upsample(intermediateBuffer2to4.readPtrs(),
+                            intermediateBuffer4to8.writePtrs(),
+                            4 * numInputSamples,
+                            chBegin,
+                            chEnd);
             // stage4 8x to 16x
-            stage4.upsample(intermediateBuffer4to8.readPtrs(), output, 8 * numInputSamples);
+            stage4.upsample(intermediateBuffer4to8.readPtrs(), output, 8 * numInputSamples, chBegin, chEnd);
         }
         return numInputSamples * Factor;
     }
@@ -147,58 +195,77 @@ class Oversampler {
      * @note Input buffer must have numOutputSamples * Factor samples.
      */
     void downsample(const T* const* input, T* const* output, size_t numOutputSamples) {
+        downsample(input, output, numOutputSamples, 0, numActiveChannels);
+    }
+
+    /**
+     * @brief Downsample a range of channels (channels outside the range are untouched).
+     * @param input Input audio buffer (array of channel pointers)
+     * @param output Output audio buffer (array of channel pointers)
+     * @param numOutputSamples Number of output samples per channel
+     * @param chBegin First channel to process
+     * @param chEnd One past the last channel to process
+     */
+    void downsample(const T* const* input, T* const* output, size_t numOutputSamples, size_t chBegin, size_t chEnd) {
         // Factor 1 (bypass)
         if constexpr (Factor == 1) {
-            for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t ch = chBegin; ch < chEnd; ++ch) {
                 std::copy(input[ch], input[ch] + numOutputSamples, output[ch]);
             }
         }
         // Factor 2
         if constexpr (Factor == 2) {
-            stage1.downsample(input, output, numOutputSamples); // stage1 2x to 1x
+            stage1.downsample(input, output, numOutputSamples, chBegin, chEnd); // stage1 2x to 1x
         }
 
         // Factor 4
         if constexpr (Factor == 4) {
             // stage2 4x to 2x
-            stage2.downsample(input, intermediateBuffer1to2.writePtrs(), 2 * numOutputSamples);
+            stage2.downsample(input, intermediateBuffer1to2.writePtrs(), 2 * numOutputSamples, chBegin, chEnd);
             // stage1 2x to 1x
-            stage1.downsample(intermediateBuffer1to2.readPtrs(), output, numOutputSamples);
+            stage1.downsample(intermediateBuffer1to2.readPtrs(), output, numOutputSamples, chBegin, chEnd);
         }
 
         // Factor 8
         if constexpr (Factor == 8) {
             // stage3 8x to 4x
-            stage3.downsample(input, intermediateBuffer2to4.writePtrs(), 4 * numOutputSamples);
+            stage3.downsample(input, intermediateBuffer2to4.writePtrs(), 4 * numOutputSamples, chBegin, chEnd);
             // stage2 4x to 2x
             stage2.downsample(intermediateBuffer2to4.readPtrs(),
                               intermediateBuffer1to2.writePtrs(),
-                              2 * numOutputSamples);
+                              2 * numOutputSamples,
+                              chBegin,
+                              chEnd);
             // stage1 2x to 1x
-            stage1.downsample(intermediateBuffer1to2.readPtrs(), output, numOutputSamples);
+            stage1.downsample(intermediateBuffer1to2.readPtrs(), output, numOutputSamples, chBegin, chEnd);
         }
 
         // Factor 16
         if constexpr (Factor == 16) {
             // stage4 16x to 8x
-            stage4.downsample(input, intermediateBuffer4to8.writePtrs(), 8 * numOutputSamples);
+            stage4.downsample(input, intermediateBuffer4to8.writePtrs(), 8 * numOutputSamples, chBegin, chEnd);
             // stage3 8x to 4x
             stage3.downsample(intermediateBuffer4to8.readPtrs(),
                               intermediateBuffer2to4.writePtrs(),
-                              4 * numOutputSamples);
+                              4 * numOutputSamples,
+                              chBegin,
+                              chEnd);
             // stage2 4x to 2x
             stage2.downsample(intermediateBuffer2to4.readPtrs(),
                               intermediateBuffer1to2.writePtrs(),
-                              2 * numOutputSamples);
+                              2 * numOutputSamples,
+                              chBegin,
+                              chEnd);
             // stage1 2x to 1x
-            stage1.downsample(intermediateBuffer1to2.readPtrs(), output, numOutputSamples);
+            stage1.downsample(intermediateBuffer1to2.readPtrs(), output, numOutputSamples, chBegin, chEnd);
         }
     }
 
     static constexpr size_t getUpsampledLength(size_t inputLength) { return inputLength * Factor; }
     static constexpr size_t getDownsampledLength(size_t inputLength) { return inputLength / Factor; }
 
-    size_t getLatencySamples() const {
+    /// Get latency in samples at base sample rate (fractional, since later stages run at higher rates)
+    T getLatencySamples() const {
         T latency = 0; // Factor 1 (bypass)
         if constexpr (Factor >= 2) {
             latency += stage1.getLatencySamples(); // runs at 1x rate
@@ -212,12 +279,29 @@ class Oversampler {
         if constexpr (Factor == 16) {
             latency += stage4.getLatencySamples() / 8; // runs at 8x rate
         }
-        return static_cast<size_t>(latency);
+        return latency;
+    }
+
+    /// Append the halfband filter histories of every stage to a state snapshot
+    void saveState(StateBlob& blob) const {
+        stage1.saveState(blob);
+        stage2.saveState(blob);
+        stage3.saveState(blob);
+        stage4.saveState(blob);
+    }
+
+    /// Restore the halfband filter histories of every stage from a state snapshot
+    void restoreState(StateReader& reader) {
+        stage1.restoreState(reader);
+        stage2.restoreState(reader);
+        stage3.restoreState(reader);
+        stage4.restoreState(reader);
     }
 
   private:
     // Global state
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
 
     // FIR Halfband filter stages
     detail::FIRHalfbandStage<T, 31> stage1; // 2x stage
@@ -5,9 +5,14 @@
 #pragma once
 
 #include "jonssonic/utils/detail/config_utils.h"
+#include <jonssonic/core/common/dsp_load.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/output_mode.h>
+#include <jonssonic/core/common/param_event.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/delays/multi_tap_delay_line.h>
 #include <jonssonic/core/generators/oscillator.h>
+#include <algorithm>
 
 namespace jnsc::effects {
 
@@ -36,6 +41,15 @@ class Chorus {
     static constexpr T MAX_DELAY_MS = T(50.0);
 
   public:
+    /// Automatable parameters (ids for @ref setParam and ParamEvent::paramId)
+    enum class Param : uint32_t {
+        Rate,     // LFO rate in Hz
+        Depth,    // Normalized modulation depth [0, 1]
+        Feedback, // Normalized feedback [0, 1]
+        DelayMs,  // Center delay in milliseconds
+        Spread    // Channel spread [0, 1]
+    };
+
     /// Default constructor.
     Chorus() = default;
 
@@ -61,9 +75,14 @@ class Chorus {
      * @param newSampleRate Sample rate in Hz.
      */
     void prepare(size_t newNumChannels, T newSampleRate) {
+        TraceScope trace("Chorus::prepare", TraceCategory::Prepare, this);
+
         // Store global parameters
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
+        loadMeter.prepare(sampleRate);
+        subBlockIn.resize(numChannels);
+        subBlockOut.resize(numChannels);
 
         // Prepare DSP components
         multiTapDelay.prepare(numChannels, sampleRate, Time<T>::Milliseconds(MAX_DELAY_MS));
@@ -87,6 +106,7 @@ class Chorus {
         setFeedback(T(0.0), true);
         setDelayMs(T(15.0), true);
         setSpread(T(1.0), true);
+        numActiveChannels = numChannels;
     }
 
     /**
@@ -94,6 +114,30 @@ class Chorus {
      */
     void reset() { multiTapDelay.reset(); }
 
+    /// Reset the state of a single channel.
+    void resetChannel(size_t ch) {
+        multiTapDelay.resetChannel(ch);
+        modDepthSamples.resetChannel(ch);
+        feedback.resetChannel(ch);
+        for (size_t tap = 0; tap < NUM_VOICES; ++tap) {
+            lfo.reset(index(ch, tap));
+            lfoPhaseOffset.resetChannel(index(ch, tap));
+        }
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * @brief Process a block of samples for all channels.
      * @param input Input sample pointers (one per channel)
@@ -104,38 +148,34 @@ class Chorus {
      *       Processing is done sample-by-sample due to the feedback loop.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            // Calculate the base LFO index for this channel
-            size_t voiceBaseIdx = ch * NUM_VOICES;
-            for (size_t n = 0; n < numSamples; ++n) {
-                // Get current input sample
-                T inputSample = input[ch][n];
-
-                // Initialize output to zero before accumulating
-                T outputSample = T(0);
-
-                // Get the modulation depth for this channel
-                T modDepth = modDepthSamples.getNextValue(ch);
-
-                // Loop over active voices
-                for (size_t tap = 0; tap < NUM_VOICES; ++tap) {
-                    // Get the phase offset for this channel-tap combination
-                    T phaseOffset = lfoPhaseOffset.getNextValue(index(ch, tap));
-
-                    // Run LFO for this channel-tap combination to get modulation value (unipolar: 0 to +1)
-                    T lfoValue = lfo.processSample(voiceBaseIdx + tap, phaseOffset) * T(0.5) + T(0.5);
-                    T mod = modDepth * lfoValue;
+        processBlockImpl<OutputMode::Replace>(input, output, numSamples, T(1));
+    }
 
-                    // Read delayed sample with interpolation and gain for this tap and accumulate to output
-                    outputSample += multiTapDelay.readSample(ch, tap, mod);
-                }
+    /**
+     * @brief Process a block and accumulate the wet signal into the output: output += gain * wet.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the wet signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        processBlockImpl<OutputMode::Add>(input, output, numSamples, gain);
+    }
 
-                // Write the input sample plus feedback into the delay line
-                multiTapDelay.writeSample(ch, inputSample + feedback.getNextValue(ch) * outputSample * NORM_FACTOR);
-                // Store the final output sample
-                output[ch][n] = outputSample;
-            }
-        }
+    /**
+     * @brief Process a block with sample-accurate parameter automation.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param events Parameter events sorted by sample offset (ids from @ref Param)
+     * @param numEvents Number of events
+     * @note The block is split at the event offsets, with sub-blocks of at least PARAM_EVENT_MIN_SUB_BLOCK_SIZE
+     *       samples; events at the same split are applied together.
+     */
+    void processBlock(
+        const T* const* input, T* const* output, size_t numSamples, const ParamEvent* events, size_t numEvents) {
+        processBlockWithParamEvents(
+            *this, input, output, numActiveChannels, numSamples, events, numEvents, subBlockIn, subBlockOut);
     }
 
     /**
@@ -189,14 +229,104 @@ class Chorus {
         }
     }
 
+    /**
+     * @brief Set a parameter by id (used for ParamEvent automation).
+     * @param param Parameter id
+     * @param value New value, in the units of the matching setter
+     * @param skipSmoothing If true, skip smoothing and set immediately (ignored by unsmoothed parameters).
+     */
+    void setParam(Param param, T value, bool skipSmoothing = false) {
+        switch (param) {
+        case Param::Rate:
+            setRate(value, skipSmoothing);
+            break;
+        case Param::Depth:
+            setDepth(value, skipSmoothing);
+            break;
+        case Param::Feedback:
+            setFeedback(value, skipSmoothing);
+            break;
+        case Param::DelayMs:
+            setDelayMs(value, skipSmoothing);
+            break;
+        case Param::Spread:
+            setSpread(value, skipSmoothing);
+            break;
+        }
+    }
+
     /// Get number of channels
     size_t getNumChannels() const { return numChannels; }
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
     /// Get sample rate
     T getSampleRate() const { return sampleRate; }
+    /// Get latency in samples (none, the modulated delays are part of the effect)
+    T getLatencySamples() const { return T(0); }
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Append the delay buffers, LFOs and parameter smoothing to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        multiTapDelay.saveState(blob);
+        lfo.saveState(blob);
+        modDepthSamples.saveState(blob);
+        lfoPhaseOffset.saveState(blob);
+        feedback.saveState(blob);
+    }
+
+    /// Restore the delay buffers, LFOs and parameter smoothing from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        multiTapDelay.restoreState(reader);
+        lfo.restoreState(reader);
+        modDepthSamples.restoreState(reader);
+        lfoPhaseOffset.restoreState(reader);
+        feedback.restoreState(reader);
+    }
 
   private:
+    // Block loop shared by processBlock and processBlockAdding
+    template <OutputMode Mode>
+    void processBlockImpl(const T* const* input, T* const* output, size_t numSamples, T addGain) {
+        TraceScope trace("Chorus::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
+            // Calculate the base LFO index for this channel
+            size_t voiceBaseIdx = ch * NUM_VOICES;
+            for (size_t n = 0; n < numSamples; ++n) {
+                // Get current input sample
+                T inputSample = input[ch][n];
+
+                // Initialize output to zero before accumulating
+                T outputSample = T(0);
+
+                // Get the modulation depth for this channel
+                T modDepth = modDepthSamples.getNextValue(ch);
+
+                // Loop over active voices
+                for (size_t tap = 0; tap < NUM_VOICES; ++tap) {
+                    // Get the phase offset for this channel-tap combination
+                    T phaseOffset = lfoPhaseOffset.getNextValue(index(ch, tap));
+
+                    // Run LFO for this channel-tap combination to get modulation value (unipolar: 0 to +1)
+                    T lfoValue = lfo.processSample(voiceBaseIdx + tap, phaseOffset) * T(0.5) + T(0.5);
+                    T mod = modDepth * lfoValue;
+
+                    // Read delayed sample with interpolation and gain for this tap and accumulate to output
+                    outputSample += multiTapDelay.readSample(ch, tap, mod);
+                }
+
+                // Write the input sample plus feedback into the delay line
+                multiTapDelay.writeSample(ch, inputSample + feedback.getNextValue(ch) * outputSample * NORM_FACTOR);
+                // Store the final output sample
+                detail::storeOutput<Mode>(output[ch][n], outputSample, addGain);
+            }
+        }
+    }
+
     // Config variables
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     T sampleRate = T(44100);
 
     // Processors
@@ -208,6 +338,9 @@ class Chorus {
     DspParam<T> lfoPhaseOffset;
     DspParam<T> feedback;
     T normFactor;
+    DspLoadMeter<> loadMeter;
+    OffsetChannelPtrs<const T> subBlockIn; // Sub-block input pointers for parameter events
+    OffsetChannelPtrs<T> subBlockOut;      // Sub-block output pointers
 
     // Helper function for indexing
     inline size_t index(size_t ch, size_t tap) { return ch * NUM_VOICES + tap; }
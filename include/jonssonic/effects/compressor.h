@@ -4,8 +4,14 @@
 
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
+#include <atomic>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_load.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/param_event.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/models/dynamics/dynamics_stage.h>
 #include <jonssonic/utils/buffer_utils.h>
 #include <jonssonic/utils/math_utils.h>
@@ -22,12 +28,24 @@ class Compressor {
      * @param CONTROL_SMOOTH_TIME_MS Control smoothing time in milliseconds.
      * @param GAIN_SMOOTH_ATTACK_MS Gain smoother attack time in milliseconds.
      * @param GAIN_SMOOTH_RELEASE_MS Gain smoother release time in milliseconds.
+     * @param ADDING_CHUNK_SIZE Chunk length of the scratch buffer used by processBlockAdding.
      */
     static constexpr T CONTROL_SMOOTH_TIME_MS = T(50);
     static constexpr T GAIN_SMOOTH_ATTACK_MS = T(0.1);
     static constexpr T GAIN_SMOOTH_RELEASE_MS = T(5);
+    static constexpr size_t ADDING_CHUNK_SIZE = 256;
 
   public:
+    /// Automatable parameters (ids for @ref setParam and ParamEvent::paramId)
+    enum class Param : uint32_t {
+        ThresholdDb,   // Threshold in dB
+        AttackTimeMs,  // Attack time in milliseconds
+        ReleaseTimeMs, // Release time in milliseconds
+        Ratio,         // Compression ratio
+        KneeDb,        // Knee width in dB
+        OutputGainDb   // Output gain in dB
+    };
+
     /// Default constructor.
     Compressor() = default;
 
@@ -55,15 +73,21 @@ class Compressor {
      * @param newSampleRate Sample rate in Hz
      */
     void prepare(size_t newNumChannels, T newSampleRate) {
+        TraceScope trace("Compressor::prepare", TraceCategory::Prepare, this);
 
         // Store global parameters
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
+        loadMeter.prepare(sampleRate);
 
         // Prepare compressor components
         compressor.prepare(numChannels, sampleRate);
         outputGain.prepare(numChannels, sampleRate);
         gainReductionOutput.resize(numChannels, T(1));
+        addBuffer.resize(numChannels, ADDING_CHUNK_SIZE);
+        subBlockIn.resize(numChannels);
+        subBlockDetector.resize(numChannels);
+        subBlockOut.resize(numChannels);
 
         // Configure fixed parameters
         compressor.setGainSmootherAttackTime(Time<T>::Milliseconds(GAIN_SMOOTH_ATTACK_MS));
@@ -88,6 +112,21 @@ class Compressor {
         outputGain.reset();
     }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = compressor.getNumActiveChannels(); ch < newNumActiveChannels; ++ch) {
+            outputGain.resetChannel(ch);
+            gainReductionOutput[ch] = T(1);
+        }
+        compressor.setActiveChannels(newNumActiveChannels);
+    }
+
     /**
      * @brief Process a block of samples for all channels.
      * @param input Input buffer (numChannels x numSamples)
@@ -99,6 +138,8 @@ class Compressor {
                       const T* const* detectorInput,
                       T* const* output,
                       size_t numSamples) {
+        TraceScope trace("Compressor::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
 
         // Process through compressor
         compressor.processBlock(input,
@@ -108,11 +149,69 @@ class Compressor {
                                 gainReductionOutput.data());
 
         // Apply output gain
-        outputGain.applyToBuffer(output, numSamples);
+        const size_t numActiveChannels = compressor.getNumActiveChannels();
+        outputGain.applyToBuffer(output, numSamples, numActiveChannels);
+
+        // Update gain reduction metering (max reduction across active channels)
+        if (numActiveChannels > 0)
+            gainReduction.store(*std::max_element(gainReductionOutput.begin(),
+                                                  gainReductionOutput.begin() + numActiveChannels));
+    }
+
+    /**
+     * @brief Process a block with sample-accurate parameter automation.
+     * @param input Input buffer (numChannels x numSamples)
+     * @param detectorInput Detector input buffer (numChannels x numSamples)
+     * @param output Output buffer (numChannels x numSamples)
+     * @param numSamples Number of samples to process
+     * @param events Parameter events sorted by sample offset (ids from @ref Param)
+     * @param numEvents Number of events
+     * @note The block is split at the event offsets, with sub-blocks of at least PARAM_EVENT_MIN_SUB_BLOCK_SIZE
+     *       samples; events at the same split are applied together. The gain reduction meter reports the last
+     *       sub-block.
+     */
+    void processBlock(const T* const* input,
+                      const T* const* detectorInput,
+                      T* const* output,
+                      size_t numSamples,
+                      const ParamEvent* events,
+                      size_t numEvents) {
+        splitAtParamEvents<T>(*this, numSamples, events, numEvents, [&](size_t offset, size_t len) {
+            const size_t numActive = getNumActiveChannels();
+            processBlock(subBlockIn.advance(input, numActive, offset),
+                         subBlockDetector.advance(detectorInput, numActive, offset),
+                         subBlockOut.advance(output, numActive, offset),
+                         len);
+        });
+    }
 
-        // Update gain reduction metering (max reduction across channels)
-        gainReduction.store(
-            *std::max_element(gainReductionOutput.begin(), gainReductionOutput.end()));
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input buffer (numChannels x numSamples)
+     * @param detectorInput Detector input buffer (numChannels x numSamples)
+     * @param output Output (bus) buffer (numChannels x numSamples)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the compressed signal (e.g., send level)
+     * @note The block is compressed into a small scratch chunk and accumulated chunk by chunk. The gain reduction
+     *       meter reports the last chunk.
+     */
+    void processBlockAdding(const T* const* input,
+                            const T* const* detectorInput,
+                            T* const* output,
+                            size_t numSamples,
+                            T gain = T(1)) {
+        const auto& kernels = getSimdKernels<T>();
+        T* const* scratch = addBuffer.writePtrs();
+        for (size_t offset = 0; offset < numSamples;) {
+            const size_t len = std::min(numSamples - offset, ADDING_CHUNK_SIZE);
+            processBlock(subBlockIn.advance(input, getNumActiveChannels(), offset),
+                         subBlockDetector.advance(detectorInput, getNumActiveChannels(), offset),
+                         scratch,
+                         len);
+            for (size_t ch = 0; ch < getNumActiveChannels(); ++ch)
+                kernels.scaledAdd(scratch[ch], output[ch] + offset, gain, len);
+            offset += len;
+        }
     }
 
     // SETTERS FOR PARAMETERS
@@ -171,18 +270,68 @@ class Compressor {
         outputGain.setTarget(utils::dB2Mag(gainDb), skipSmoothing);
     }
 
+    /**
+     * @brief Set a parameter by id (used for ParamEvent automation).
+     * @param param Parameter id
+     * @param value New value, in the units of the matching setter
+     * @param skipSmoothing If true, skip smoothing and set immediately (ignored by unsmoothed parameters).
+     */
+    void setParam(Param param, T value, bool skipSmoothing = false) {
+        switch (param) {
+        case Param::ThresholdDb:
+            setThreshold(value, skipSmoothing);
+            break;
+        case Param::AttackTimeMs:
+            setAttackTime(value, skipSmoothing);
+            break;
+        case Param::ReleaseTimeMs:
+            setReleaseTime(value, skipSmoothing);
+            break;
+        case Param::Ratio:
+            setRatio(value, skipSmoothing);
+            break;
+        case Param::KneeDb:
+            setKnee(value, skipSmoothing);
+            break;
+        case Param::OutputGainDb:
+            setOutputGain(value, skipSmoothing);
+            break;
+        }
+    }
+
     /// Get number of channels.
     size_t getNumChannels() const { return numChannels; }
 
+    /// Get number of active (processed) channels.
+    size_t getNumActiveChannels() const { return compressor.getNumActiveChannels(); }
+
     /// Get sample rate.
     T getSampleRate() const { return sampleRate; }
 
+    /// Get latency in samples (none, the detector does not look ahead).
+    T getLatencySamples() const { return T(0); }
+
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
     /// Check if the processor is prepared.
     bool isPrepared() const { return togglePrepared; }
 
     /// Get gain reduction value.
     T getGainReduction() const { return gainReduction.load(); }
 
+    /// Append the detector, gain and output smoothing to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        compressor.saveState(blob);
+        outputGain.saveState(blob);
+    }
+
+    /// Restore the detector, gain and output smoothing from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        compressor.restoreState(reader);
+        outputGain.restoreState(reader);
+    }
+
   private:
     // Config variables
     size_t numChannels = 0;
@@ -192,6 +341,11 @@ class Compressor {
     // COMPONENTS
     models::CompressorRMSFeedforward<T> compressor;
     DspParam<T> outputGain;
+    AudioBuffer<T> addBuffer; // Scratch chunk for processBlockAdding
+    DspLoadMeter<> loadMeter;
+    OffsetChannelPtrs<const T> subBlockIn;       // Sub-block input pointers (events, processBlockAdding chunks)
+    OffsetChannelPtrs<const T> subBlockDetector; // Sub-block detector pointers
+    OffsetChannelPtrs<T> subBlockOut;            // Sub-block output pointers
 
     // Metering variables
     std::vector<T> gainReductionOutput;
@@ -4,7 +4,10 @@
 
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
-#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_load.h>
+#include <jonssonic/core/common/modulation_matrix.h>
+#include <jonssonic/core/common/param_event.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/generators/oscillator.h>
 #include <jonssonic/models/delays/modulated_delay_stage.h>
 
@@ -30,6 +33,15 @@ class Delay {
     static constexpr T DAMPING_MIN_HZ = T(2000);
 
   public:
+    /// Automatable parameters (ids for @ref setParam and ParamEvent::paramId)
+    enum class Param : uint32_t {
+        DelayMs,  // Delay time in milliseconds
+        Feedback, // Feedback amount
+        Damping,  // Damping amount
+        PingPong, // Ping-pong amount
+        ModDepth  // Wow/flutter modulation depth
+    };
+
     /// Default Constructor
     Delay() = default;
 
@@ -59,9 +71,14 @@ class Delay {
      * @param maxDelayMs Maximum delay in milliseconds
      */
     void prepare(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        TraceScope trace("Delay::prepare", TraceCategory::Prepare, this);
+
         // Store global parameters
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
+        loadMeter.prepare(sampleRate);
+        subBlockIn.resize(numChannels);
+        subBlockOut.resize(numChannels);
 
         // Prepare Modulated Delay Stage
         modulatedDelayStage.prepare(numChannels, Time<T>::Milliseconds(MAX_DELAY_MS), sampleRate);
@@ -79,8 +96,13 @@ class Delay {
         flutterLfo.setWaveform(Waveform::Sine);
         flutterLfo.setFrequency(Frequency<T>::Hertz(6.0)); // 6 Hz for flutter
 
-        // Prepare modulation buffer
-        modulationBuffer.resize(numChannels, newMaxBlockSize);
+        // Route the LFOs through the modulation matrix: unipolar wow/flutter mix in [0, 1]
+        modMatrix.prepare(numChannels, newMaxBlockSize);
+        const size_t wowSource = modMatrix.addSource(wowLfo);
+        const size_t flutterSource = modMatrix.addSource(flutterLfo);
+        delayModDestination = modMatrix.addDestination(T(0.5));
+        modMatrix.connect(wowSource, delayModDestination, T(0.5) * WOW_PORTION_OF_MODULATION);
+        modMatrix.connect(flutterSource, delayModDestination, T(0.5) * (T(1) - WOW_PORTION_OF_MODULATION));
 
         // Set default parameter values
         setFeedback(T(0), true);
@@ -94,7 +116,17 @@ class Delay {
         modulatedDelayStage.reset();
         flutterLfo.reset();
         wowLfo.reset();
-        modulationBuffer.clear();
+        modMatrix.reset();
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        modulatedDelayStage.setActiveChannels(newNumActiveChannels);
     }
 
     /**
@@ -104,18 +136,45 @@ class Delay {
      * @param numSamples Number of samples to process
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        // Process LFOs to modulation buffer (note: could implement oscillator bank to internalize additive oscillators)
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t n = 0; n < numSamples; ++n) {
-                T wowValue = wowLfo.processSample(ch) * T(0.5) + T(0.5);         // unipolar 0 to 1
-                T flutterValue = flutterLfo.processSample(ch) * T(0.5) + T(0.5); // unipolar 0 to 1
-                modulationBuffer[ch][n] =
-                    wowValue * WOW_PORTION_OF_MODULATION + flutterValue * (T(1) - WOW_PORTION_OF_MODULATION);
-            }
-        }
+        TraceScope trace("Delay::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
+
+        // Render the wow/flutter modulation for this block
+        modMatrix.process(numSamples);
 
         // Process delay stage with external modulation
-        modulatedDelayStage.processBlock(input, output, modulationBuffer.readPtrs(), numSamples);
+        modulatedDelayStage.processBlock(input, output, modMatrix.getDestination(delayModDestination), numSamples);
+    }
+
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        TraceScope trace("Delay::processBlockAdding", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
+        modMatrix.process(numSamples);
+        modulatedDelayStage.processBlockAdding(
+            input, output, modMatrix.getDestination(delayModDestination), numSamples, gain);
+    }
+
+    /**
+     * @brief Process a block with sample-accurate parameter automation.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param events Parameter events sorted by sample offset (ids from @ref Param)
+     * @param numEvents Number of events
+     * @note The block is split at the event offsets, with sub-blocks of at least PARAM_EVENT_MIN_SUB_BLOCK_SIZE
+     *       samples; events at the same split are applied together.
+     */
+    void processBlock(
+        const T* const* input, T* const* output, size_t numSamples, const ParamEvent* events, size_t numEvents) {
+        processBlockWithParamEvents(
+            *this, input, output, getNumActiveChannels(), numSamples, events, numEvents, subBlockIn, subBlockOut);
     }
 
     /**
@@ -164,12 +223,63 @@ class Delay {
         modulatedDelayStage.setModulationDepth(Time<T>::Milliseconds(MAX_MODULATION_MS * newModDepth), skipSmoothing);
     }
 
+    /**
+     * @brief Set a parameter by id (used for ParamEvent automation).
+     * @param param Parameter id
+     * @param value New value, in the units of the matching setter
+     * @param skipSmoothing If true, skip smoothing and set immediately (ignored by unsmoothed parameters).
+     */
+    void setParam(Param param, T value, bool skipSmoothing = false) {
+        switch (param) {
+        case Param::DelayMs:
+            setDelayMs(value, skipSmoothing);
+            break;
+        case Param::Feedback:
+            setFeedback(value, skipSmoothing);
+            break;
+        case Param::Damping:
+            setDamping(value, skipSmoothing);
+            break;
+        case Param::PingPong:
+            setPingPong(value, skipSmoothing);
+            break;
+        case Param::ModDepth:
+            setModDepth(value, skipSmoothing);
+            break;
+        }
+    }
+
     /// Get number of channels
     size_t getNumChannels() const { return numChannels; }
 
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return modulatedDelayStage.getNumActiveChannels(); }
+
     /// Get sample rate
     T getSampleRate() const { return sampleRate; }
 
+    /// Get latency in samples (none, the delay is part of the effect)
+    T getLatencySamples() const { return T(0); }
+
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Append the delay stage, wow/flutter LFOs and modulation routing to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        modulatedDelayStage.saveState(blob);
+        wowLfo.saveState(blob);
+        flutterLfo.saveState(blob);
+        modMatrix.saveState(blob);
+    }
+
+    /// Restore the delay stage, wow/flutter LFOs and modulation routing from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        modulatedDelayStage.restoreState(reader);
+        wowLfo.restoreState(reader);
+        flutterLfo.restoreState(reader);
+        modMatrix.restoreState(reader);
+    }
+
   private:
     // Config variables
     size_t numChannels = 0;
@@ -180,8 +290,13 @@ class Delay {
     Oscillator<T> wowLfo;
     Oscillator<T> flutterLfo;
 
-    // Buffer for modulation
-    AudioBuffer<T> modulationBuffer;
+    // Wow/flutter modulation (LFO sources summed into one delay modulation destination)
+    ModulationMatrix<T> modMatrix;
+    size_t delayModDestination = 0;
+
+    DspLoadMeter<> loadMeter;
+    OffsetChannelPtrs<const T> subBlockIn; // Sub-block input pointers for parameter events
+    OffsetChannelPtrs<T> subBlockOut;      // Sub-block output pointers
 };
 
 } // namespace jnsc::effects
\ No newline at end of file
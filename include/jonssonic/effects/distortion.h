@@ -4,7 +4,12 @@
 
 #pragma once
 #include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_load.h>
+#include <jonssonic/core/common/param_event.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/common/trace_recorder.h>
+#include <jonssonic/core/delays/latency_compensator.h>
 #include <jonssonic/core/mixing/dry_wet_mixer.h>
 #include <jonssonic/models/saturation/saturation_stage.h>
 #include <jonssonic/utils/buffer_utils.h>
@@ -34,6 +39,20 @@ class Distortion {
     static constexpr T PRE_FILTER_CUTOFF_HZ = T(80);
 
   public:
+    /// Automatable parameters (ids for @ref setParam and ParamEvent::paramId)
+    enum class Param : uint32_t {
+        DriveDb,             // Drive in dB
+        Asymmetry,           // Asymmetry [-1, 1]
+        Shape,               // Shape [0, 1]
+        ToneFrequency,       // Tone cutoff in Hz
+        Mix,                 // Dry/wet mix [0, 1]
+        OutputGainDb,        // Output gain in dB
+        OversamplingEnabled  // Oversampling on (non-zero) or off
+    };
+
+    /// Processing stages reported by @ref getLoadPercent (the first four are those of the saturation stage)
+    enum class LoadStage { PreFiltering, Oversampling, Shaping, PostFiltering, Mixing };
+
     /// Default constructor.
     Distortion() = default;
 
@@ -63,6 +82,7 @@ class Distortion {
      * @param newSampleRate Sample rate in Hz
      */
     void prepare(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        TraceScope trace("Distortion::prepare", TraceCategory::Prepare, this);
 
         // Store global parameters
         numChannels = utils::detail::clampChannels(newNumChannels);
@@ -83,7 +103,7 @@ class Distortion {
         distortionOS.setPreFilterFrequency(Frequency<T>::Hertz(T(PRE_FILTER_CUTOFF_HZ)));
 
         // Prepare dry/wet mixer with latency compensation and output gain
-        size_t oversamplerLatencySamples = distortionOS.getLatencySamples();
+        size_t oversamplerLatencySamples = LatencyCompensator<T>::latencyToSamples(distortionOS.getLatencySamples());
         dryWetMixer.prepare(newNumChannels, newSampleRate, oversamplerLatencySamples);
 
         // Prepare internal buffers and oversampler
@@ -91,6 +111,9 @@ class Distortion {
 
         // Prepare output gain
         outputGain.prepare(newNumChannels, newSampleRate);
+        loadMeter.prepare(sampleRate);
+        subBlockIn.resize(numChannels);
+        subBlockOut.resize(numChannels);
 
         // Set parameter smoothing times
         distortion.setControlSmoothingTime(Time<T>::Milliseconds(PARAM_SMOOTH_TIME_MS));
@@ -115,6 +138,21 @@ class Distortion {
         fxBuffer.clear();
     }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = dryWetMixer.getNumActiveChannels(); ch < newNumActiveChannels; ++ch)
+            outputGain.resetChannel(ch);
+        distortion.setActiveChannels(newNumActiveChannels);
+        distortionOS.setActiveChannels(newNumActiveChannels);
+        dryWetMixer.setActiveChannels(newNumActiveChannels);
+    }
+
     /**
      * @brief Process a block of samples for all channels.
      * @param input Input buffer (numChannels x numSamples)
@@ -122,24 +160,53 @@ class Distortion {
      * @param numSamples Number of samples to process
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        // Copy input to fxBuffer for processing
-        utils::copyToBuffer<T>(input, fxBuffer.writePtrs(), numChannels, numSamples);
-
-        // Process oversampled distortion if enabled
-        if (toggleOversampling) {
-            distortionOS.processBlock(fxBuffer.readPtrs(), fxBuffer.writePtrs(), numSamples);
-        }
-        // Process non-oversampled distortion otherwise
-        else {
-            distortion.processBlock(fxBuffer.readPtrs(), fxBuffer.writePtrs(), numSamples);
-        }
+        TraceScope trace("Distortion::processBlock", TraceCategory::Process, this);
+        processDistortion(input, numSamples);
+        ScopedDspTimer timer(loadMeter, numSamples);
 
         // Apply dry/wet mixing (with delay compensation if oversampling)
-        size_t dryDelaySamples = getLatencySamples();
+        size_t dryDelaySamples = LatencyCompensator<T>::latencyToSamples(getLatencySamples());
         dryWetMixer.processBlock(input, fxBuffer.readPtrs(), output, numSamples, dryDelaySamples);
 
         // Apply output gain
-        outputGain.applyToBuffer(output, numSamples);
+        outputGain.applyToBuffer(output, numSamples, getNumActiveChannels());
+    }
+
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input buffer (numChannels x numSamples)
+     * @param output Output (bus) buffer (numChannels x numSamples)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        TraceScope trace("Distortion::processBlockAdding", TraceCategory::Process, this);
+        processDistortion(input, numSamples);
+        ScopedDspTimer timer(loadMeter, numSamples);
+
+        // Mix and apply output gain in place, then accumulate into the output
+        size_t dryDelaySamples = LatencyCompensator<T>::latencyToSamples(getLatencySamples());
+        dryWetMixer.processBlock(input, fxBuffer.readPtrs(), fxBuffer.writePtrs(), numSamples, dryDelaySamples);
+        outputGain.applyToBuffer(fxBuffer.writePtrs(), numSamples, getNumActiveChannels());
+        const auto& kernels = getSimdKernels<T>();
+        for (size_t ch = 0; ch < getNumActiveChannels(); ++ch)
+            kernels.scaledAdd(fxBuffer.readChannelPtr(ch), output[ch], gain, numSamples);
+    }
+
+    /**
+     * @brief Process a block with sample-accurate parameter automation.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param events Parameter events sorted by sample offset (ids from @ref Param)
+     * @param numEvents Number of events
+     * @note The block is split at the event offsets, with sub-blocks of at least PARAM_EVENT_MIN_SUB_BLOCK_SIZE
+     *       samples; events at the same split are applied together.
+     */
+    void processBlock(
+        const T* const* input, T* const* output, size_t numSamples, const ParamEvent* events, size_t numEvents) {
+        processBlockWithParamEvents(
+            *this, input, output, getNumActiveChannels(), numSamples, events, numEvents, subBlockIn, subBlockOut);
     }
 
     // SETTERS FOR PARAMETERS
@@ -205,28 +272,117 @@ class Distortion {
      */
     void setOversamplingEnabled(bool enabled) { toggleOversampling = enabled; }
 
+    /**
+     * @brief Set a parameter by id (used for ParamEvent automation).
+     * @param param Parameter id
+     * @param value New value, in the units of the matching setter
+     * @param skipSmoothing If true, skip smoothing and set immediately (ignored by unsmoothed parameters).
+     */
+    void setParam(Param param, T value, bool skipSmoothing = false) {
+        switch (param) {
+        case Param::DriveDb:
+            setDriveDb(value, skipSmoothing);
+            break;
+        case Param::Asymmetry:
+            setAsymmetry(value, skipSmoothing);
+            break;
+        case Param::Shape:
+            setShape(value, skipSmoothing);
+            break;
+        case Param::ToneFrequency:
+            setToneFrequency(value);
+            break;
+        case Param::Mix:
+            setMix(value, skipSmoothing);
+            break;
+        case Param::OutputGainDb:
+            setOutputGainDb(value, skipSmoothing);
+            break;
+        case Param::OversamplingEnabled:
+            setOversamplingEnabled(value != T(0));
+            break;
+        }
+    }
+
     /// Get number of channels.
     size_t getNumChannels() const { return numChannels; }
 
+    /// Get number of active (processed) channels.
+    size_t getNumActiveChannels() const { return dryWetMixer.getNumActiveChannels(); }
+
     /// Get sample rate.
     T getSampleRate() const { return sampleRate; }
 
-    /// Get latency in samples at base sample rate.
-    size_t getLatencySamples() const {
+    /// Get latency in samples at base sample rate (fractional when oversampling).
+    T getLatencySamples() const {
         return toggleOversampling ? distortionOS.getLatencySamples() : distortion.getLatencySamples();
     }
 
+    /**
+     * @brief DSP load of one stage in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD).
+     * @param stage Stage; filter and shaper stages report the saturation path selected by the oversampling switch
+     */
+    float getLoadPercent(LoadStage stage) const {
+        if (stage == LoadStage::Mixing)
+            return loadMeter.getLoadPercent();
+        return toggleOversampling ? distortionOS.getLoadPercent(static_cast<typename OSStage::LoadStage>(stage))
+                                  : distortion.getLoadPercent(static_cast<typename BaseStage::LoadStage>(stage));
+    }
+
+    /// DSP load of the whole distortion in percent of the realtime budget
+    float getLoadPercent() const {
+        return loadMeter.getLoadPercent() +
+               (toggleOversampling ? distortionOS.getLoadPercent() : distortion.getLoadPercent());
+    }
+
+    /// Append both saturation paths, the mixer and the output smoothing to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        blob.write(toggleOversampling);
+        distortionOS.saveState(blob);
+        distortion.saveState(blob);
+        dryWetMixer.saveState(blob);
+        outputGain.saveState(blob);
+    }
+
+    /// Restore both saturation paths, the mixer and the output smoothing from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        reader.read(toggleOversampling);
+        distortionOS.restoreState(reader);
+        distortion.restoreState(reader);
+        dryWetMixer.restoreState(reader);
+        outputGain.restoreState(reader);
+    }
+
   private:
+    // Copy the input into fxBuffer and run the (oversampled) distortion on it
+    void processDistortion(const T* const* input, size_t numSamples) {
+        utils::copyToBuffer<T>(input, fxBuffer.writePtrs(), getNumActiveChannels(), numSamples);
+
+        // Process oversampled distortion if enabled
+        if (toggleOversampling) {
+            distortionOS.processBlock(fxBuffer.readPtrs(), fxBuffer.writePtrs(), numSamples);
+        }
+        // Process non-oversampled distortion otherwise
+        else {
+            distortion.processBlock(fxBuffer.readPtrs(), fxBuffer.writePtrs(), numSamples);
+        }
+    }
+
     // GLOBAL PARAMETERS
     size_t numChannels = 0;
     T sampleRate = T(44100);
     bool toggleOversampling = false;
 
     // PROCESSORS
-    models::SaturationStage<T, WaveShaperType::Dynamic, true, true, OVERSAMPLING_FACTOR> distortionOS;
-    models::SaturationStage<T, WaveShaperType::Dynamic, true, true, 1> distortion;
+    using OSStage = models::SaturationStage<T, WaveShaperType::Dynamic, true, true, OVERSAMPLING_FACTOR>;
+    using BaseStage = models::SaturationStage<T, WaveShaperType::Dynamic, true, true, 1>;
+    OSStage distortionOS;
+    BaseStage distortion;
     DryWetMixer<T> dryWetMixer;
     DspParam<T> outputGain;
+    DspLoadMeter<> loadMeter; // Mixer and output gain; the saturation stages meter themselves
+    OffsetChannelPtrs<const T> subBlockIn; // Sub-block input pointers for parameter events
+    OffsetChannelPtrs<T> subBlockOut;      // Sub-block output pointers
 
     // BUFFERS
     AudioBuffer<T> fxBuffer; // buffer for the effect processing
@@ -4,6 +4,9 @@
 
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
+#include <jonssonic/core/common/dsp_load.h>
+#include <jonssonic/core/common/param_event.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/filters/biquad_filter.h>
 
 namespace jnsc::effects {
@@ -24,6 +27,16 @@ class Equalizer {
     static constexpr size_t HIGH_SHELF_CUTOFF = T(5000);
 
   public:
+    /// Automatable parameters (ids for @ref setParam and ParamEvent::paramId)
+    enum class Param : uint32_t {
+        LowCutFreq,      // Low cut frequency in Hz
+        LowMidGainDb,    // Low mid gain in dB
+        HighMidGainDb,   // High mid gain in dB
+        HighShelfGainDb, // High shelf gain in dB
+        LowMidFreq,      // Low mid frequency in Hz
+        HighMidFreq      // High mid frequency in Hz
+    };
+
     /// Default constructor.
     Equalizer() = default;
 
@@ -51,6 +64,7 @@ class Equalizer {
      * @param maxDelayMs Maximum Equalizer in milliseconds
      */
     void prepare(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        TraceScope trace("Equalizer::prepare", TraceCategory::Prepare, this);
 
         // Prepare biquad chain
         eq.prepare(newNumChannels, newSampleRate, 4); // 4 sections: LowCut, LowMid, HighMid, HighShelf
@@ -61,10 +75,24 @@ class Equalizer {
 
         // Fixed parameters
         eq.section(3).setFrequency(Frequency<T>::Hertz(HIGH_SHELF_CUTOFF)); // HighShelf fixed freq
+
+        loadMeter.prepare(eq.getSampleRate());
+
+        subBlockIn.resize(eq.getNumChannels());
+
+        subBlockOut.resize(eq.getNumChannels());
     }
 
     void reset() { eq.reset(); }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) { eq.setActiveChannels(newNumActiveChannels); }
+
     /**
      * @brief Process a block of samples for all channels.
      * @param input Input buffer (numChannels x numSamples)
@@ -72,9 +100,40 @@ class Equalizer {
      * @param numSamples Number of samples to process
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        TraceScope trace("Equalizer::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
         eq.processBlock(input, output, numSamples);
     }
 
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        TraceScope trace("Equalizer::processBlockAdding", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
+        eq.processBlockAdding(input, output, numSamples, gain);
+    }
+
+    /**
+     * @brief Process a block with sample-accurate parameter automation.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param events Parameter events sorted by sample offset (ids from @ref Param)
+     * @param numEvents Number of events
+     * @note The block is split at the event offsets, with sub-blocks of at least PARAM_EVENT_MIN_SUB_BLOCK_SIZE
+     *       samples; events at the same split are applied together.
+     */
+    void processBlock(
+        const T* const* input, T* const* output, size_t numSamples, const ParamEvent* events, size_t numEvents) {
+        processBlockWithParamEvents(
+            *this, input, output, getNumActiveChannels(), numSamples, events, numEvents, subBlockIn, subBlockOut);
+    }
+
     // SETTERS FOR PARAMETERS
     /**
      * @brief Set low cut frequency in Hz.
@@ -133,14 +192,71 @@ class Equalizer {
         eq.section(2).setFrequency(Frequency<T>::Hertz(newFreqHz));
     }
 
+    /**
+     * @brief Set a parameter by id (used for ParamEvent automation).
+     * @param param Parameter id
+     * @param value New value, in the units of the matching setter
+     * @param skipSmoothing If true, skip smoothing and set immediately (ignored by unsmoothed parameters).
+     */
+    void setParam(Param param, T value, bool skipSmoothing = false) {
+        switch (param) {
+        case Param::LowCutFreq:
+            setLowCutFreq(value, skipSmoothing);
+            break;
+        case Param::LowMidGainDb:
+            setLowMidGainDb(value, skipSmoothing);
+            break;
+        case Param::HighMidGainDb:
+            setHighMidGainDb(value, skipSmoothing);
+            break;
+        case Param::HighShelfGainDb:
+            setHighShelfGainDb(value, skipSmoothing);
+            break;
+        case Param::LowMidFreq:
+            setLowMidFreq(value, skipSmoothing);
+            break;
+        case Param::HighMidFreq:
+            setHighMidFreq(value, skipSmoothing);
+            break;
+        }
+    }
+
+    /// Defer filter coefficient recomputation until @ref endParamUpdate (coalesces several parameter changes)
+    void beginParamUpdate() { eq.beginCoeffUpdate(); }
+
+    /// Recompute the coefficients of every band changed since @ref beginParamUpdate
+    void endParamUpdate() { eq.endCoeffUpdate(); }
+
     /// Get number of channels.
     size_t getNumChannels() const { return eq.getNumChannels(); }
 
+    /// Get number of active (processed) channels.
+    size_t getNumActiveChannels() const { return eq.getNumActiveChannels(); }
+
     /// Get sample rate.
     T getSampleRate() const { return eq.getSampleRate(); }
 
+    /// Get latency in samples (none, the filters are minimum phase).
+    T getLatencySamples() const { return T(0); }
+
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Append the band filter state and settings to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        eq.saveState(blob);
+    }
+
+    /// Restore the band filter state and settings from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        eq.restoreState(reader);
+    }
+
   private:
     BiquadFilter<T> eq;
+    DspLoadMeter<> loadMeter;
+    OffsetChannelPtrs<const T> subBlockIn; // Sub-block input pointers for parameter events
+    OffsetChannelPtrs<T> subBlockOut;      // Sub-block output pointers
 
     /**
      * @brief Compute variable Q factor based on gain in dB.
@@ -6,7 +6,10 @@
 
 #include "jonssonic/utils/detail/config_utils.h"
 #include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_load.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/param_event.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/generators/oscillator.h>
 #include <jonssonic/models/delays/modulated_delay_stage.h>
 #include <jonssonic/utils/buffer_utils.h>
@@ -35,6 +38,15 @@ class Flanger {
     static constexpr T MAX_FEEDBACK = T(0.9);
 
   public:
+    /// Automatable parameters (ids for @ref setParam and ParamEvent::paramId)
+    enum class Param : uint32_t {
+        Rate,     // LFO rate in Hz
+        Depth,    // Normalized modulation depth [0, 1]
+        Feedback, // Feedback amount
+        DelayMs,  // Center delay in milliseconds
+        Spread    // Channel spread [0, 1]
+    };
+
     /// Default constructor.
     Flanger() = default;
 
@@ -61,9 +73,14 @@ class Flanger {
      * @param newSampleRate Sample rate in Hz.
      */
     void prepare(size_t newNumChannels, T newSampleRate) {
+        TraceScope trace("Flanger::prepare", TraceCategory::Prepare, this);
+
         // Store global parameters
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
+        loadMeter.prepare(sampleRate);
+        subBlockIn.resize(numChannels);
+        subBlockOut.resize(numChannels);
 
         // Prepare DSP components
         delayStage.prepare(numChannels, Time<T>::Milliseconds(MAX_DELAY_MS), sampleRate);
@@ -84,6 +101,14 @@ class Flanger {
      */
     void reset() { delayStage.reset(); }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) { delayStage.setActiveChannels(newNumActiveChannels); }
+
     /**
      * @brief Process a block of samples for all channels.
      * @param input Input sample pointers (one per channel)
@@ -94,8 +119,39 @@ class Flanger {
      *       Processing is done sample-by-sample due to the feedback loop.
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        TraceScope trace("Flanger::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
         delayStage.processBlock(input, output, numSamples);
-        utils::applyGain<T>(output, numChannels, numSamples, T(0.5));
+        utils::applyGain<T>(output, getNumActiveChannels(), numSamples, T(0.5));
+    }
+
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        TraceScope trace("Flanger::processBlockAdding", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
+        delayStage.processBlockAdding(input, output, numSamples, T(0.5) * gain);
+    }
+
+    /**
+     * @brief Process a block with sample-accurate parameter automation.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param events Parameter events sorted by sample offset (ids from @ref Param)
+     * @param numEvents Number of events
+     * @note The block is split at the event offsets, with sub-blocks of at least PARAM_EVENT_MIN_SUB_BLOCK_SIZE
+     *       samples; events at the same split are applied together.
+     */
+    void processBlock(
+        const T* const* input, T* const* output, size_t numSamples, const ParamEvent* events, size_t numEvents) {
+        processBlockWithParamEvents(
+            *this, input, output, getNumActiveChannels(), numSamples, events, numEvents, subBlockIn, subBlockOut);
     }
 
     /**
@@ -146,10 +202,52 @@ class Flanger {
         }
     }
 
+    /**
+     * @brief Set a parameter by id (used for ParamEvent automation).
+     * @param param Parameter id
+     * @param value New value, in the units of the matching setter
+     * @param skipSmoothing If true, skip smoothing and set immediately (ignored by unsmoothed parameters).
+     */
+    void setParam(Param param, T value, bool skipSmoothing = false) {
+        switch (param) {
+        case Param::Rate:
+            setRate(value, skipSmoothing);
+            break;
+        case Param::Depth:
+            setDepth(value, skipSmoothing);
+            break;
+        case Param::Feedback:
+            setFeedback(value, skipSmoothing);
+            break;
+        case Param::DelayMs:
+            setDelayMs(value, skipSmoothing);
+            break;
+        case Param::Spread:
+            setSpread(value, skipSmoothing);
+            break;
+        }
+    }
+
     /// Get number of channels
     size_t getNumChannels() const { return numChannels; }
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return delayStage.getNumActiveChannels(); }
     /// Get sample rate
     T getSampleRate() const { return sampleRate; }
+    /// Get latency in samples (none, the modulated delays are part of the effect)
+    T getLatencySamples() const { return T(0); }
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Append the delay stage state to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        delayStage.saveState(blob);
+    }
+
+    /// Restore the delay stage state from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        delayStage.restoreState(reader);
+    }
 
   private:
     // Config variables
@@ -158,6 +256,9 @@ class Flanger {
 
     // Processors
     models::ModulatedDelayStage<T, jnsc::detail::LagrangeInterpolator<T>, true, false, false> delayStage;
+    DspLoadMeter<> loadMeter;
+    OffsetChannelPtrs<const T> subBlockIn; // Sub-block input pointers for parameter events
+    OffsetChannelPtrs<T> subBlockOut;      // Sub-block output pointers
 };
 
 } // namespace jnsc::effects
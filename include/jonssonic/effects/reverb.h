@@ -3,6 +3,12 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
+#include <algorithm>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_load.h>
+#include <jonssonic/core/common/param_event.h>
+#include <jonssonic/core/common/probe_point.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/filters/biquad_filter.h>
 #include <jonssonic/models/generators/filtered_noise.h>
 #include <jonssonic/models/reverb/feedback_delay_network.h>
@@ -11,9 +17,10 @@ namespace jnsc::effects {
 /**
  * @brief Reverberation effect implmented with a Feedback Delay Network (FDN)
  * @tparam T Sample data type (e.g., float, double)
+ * @tparam FDNSize Number of delay lines in the FDN (4, 8, 16 or 32); smaller networks are cheaper but less dense
  */
 
-template <typename T>
+template <typename T, size_t FDNSize = 16>
 class Reverb {
     /**
      * @brief Tunable constants
@@ -23,53 +30,73 @@ class Reverb {
      * @param MIN_DELAY_SCALE Minimum scaling factor for FDN base delays
      * @param MAX_DELAY_SCALE Maximum scaling factor for FDN base delays
      * @param MAX_RELATIVE_MODULATION_DEPTH Maximum relative modulation depth for delay lines
+     * @param ADDING_CHUNK_SIZE Chunk length of the scratch buffer used by processBlockAdding
      */
-    static constexpr size_t FDN_SIZE = 16;
+    static constexpr size_t FDN_SIZE = FDNSize;
     static constexpr int SMOOTHING_TIME_MS = 50;
     static constexpr T MAX_PRE_DELAY_MS = T(200.0);
     static constexpr T MIN_DELAY_SCALE = T(0.9);
     static constexpr T MAX_DELAY_SCALE = T(3.0);
     static constexpr T MAX_RELATIVE_MODULATION_DEPTH = T(0.01);
+    static constexpr size_t ADDING_CHUNK_SIZE = 256;
 
     /**
      * @brief Coprime base delay lengths in samples for the FDN.
      *        Actual lengths will be scaled based on diffusion parameter.
      */
-    template <size_t N>
+    template <size_t N, typename Dummy = void>
     struct FDNBaseDelays;
 
-    template <>
-    struct FDNBaseDelays<2> {
+    template <typename Dummy>
+    struct FDNBaseDelays<2, Dummy> {
         static constexpr int values[2] = {
             1, 2 // ONLY FOR TESTING PURPOSES
         };
     };
 
-    template <>
-    struct FDNBaseDelays<4> {
+    template <typename Dummy>
+    struct FDNBaseDelays<4, Dummy> {
         static constexpr int values[4] = {443, 601, 809, 1031};
     };
-    template <>
-    struct FDNBaseDelays<8> {
+    template <typename Dummy>
+    struct FDNBaseDelays<8, Dummy> {
         static constexpr int values[8] = {1493, 1789, 2131, 2467, 2927, 3253, 3697, 4211
 
         };
     };
-    template <>
-    struct FDNBaseDelays<16> {
+    template <typename Dummy>
+    struct FDNBaseDelays<16, Dummy> {
         static constexpr int values[16] = {
             1601, 547, 2371, 947, 3187, 503, 1231, 2749, 587, 2053, 3677, 829, 1423, 631, 1069, 1823
 
         };
     };
-    template <>
-    struct FDNBaseDelays<32> {
+    template <typename Dummy>
+    struct FDNBaseDelays<32, Dummy> {
         static constexpr int values[32] = {673,  809,  887,  1039, 1217, 1429, 1667, 1951, 2027, 2089, 2137,
                                            2203, 2269, 2339, 2411, 2477, 2539, 2593, 2657, 2719, 2789, 2851,
                                            2909, 2971, 3109, 3631, 4231, 4937, 5779, 6761, 7907, 9241};
     };
 
   public:
+    /// Automatable parameters (ids for @ref setParam and ParamEvent::paramId)
+    enum class Param : uint32_t {
+        ReverbTimeLowS,         // Reverb time at DC in seconds
+        DampingCrossoverFreqHz, // Damping crossover frequency in Hz
+        ReverbTimeHighS,        // Reverb time at Nyquist in seconds
+        Diffusion,              // Diffusion amount [0, 1]
+        PreDelayTimeMs,         // Pre-delay in milliseconds
+        LowCutFreqHz,           // Low cut frequency in Hz
+        ModulationRateHz,       // Modulation rate in Hz
+        ModulationDepth         // Modulation depth [0, 1]
+    };
+
+    /// Processing stages reported by @ref getLoadPercent
+    enum class LoadStage { PreDelay, FDN, LowCut };
+
+    /// Intermediate signals exposed by @ref getProbe
+    enum class Probe { PreDelay, FDN };
+
     /// Default constructor.
     Reverb() = default;
     /**
@@ -94,6 +121,8 @@ class Reverb {
      * @param newSampleRate Sample rate in Hz
      */
     void prepare(size_t newNumChannels, T newSampleRate) {
+        TraceScope trace("Reverb::prepare", TraceCategory::Prepare, this);
+
         // Store global parameters
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
@@ -109,11 +138,18 @@ class Reverb {
         fdn.prepare(numChannels, sampleRate, Time<T>::Samples(maxDelaySamples));
         lowCutFilter.prepare(numChannels, sampleRate);
         lowCutFilter.setResponse(BiquadFilter<T>::Response::Highpass);
+        addBuffer.resize(numChannels, ADDING_CHUNK_SIZE);
+        loadMeter.prepare(sampleRate);
+        subBlockIn.resize(numChannels);
+        subBlockOut.resize(numChannels);
+        for (auto& probe : probes)
+            probe.prepare(numChannels);
 
         // Set fixed parameters
         fdn.setControlSmoothingTime(Time<T>::Milliseconds(SMOOTHING_TIME_MS));
 
         // Initialize parameters to defaults
+        beginParamUpdate();
         setReverbTimeLowS(T(2.0), true);
         setReverbTimeHighS(T(1.0), true);
         setDiffusion(T(0.5), true);
@@ -121,6 +157,7 @@ class Reverb {
         setLowCutFreqHz(T(1000.0));
         setModulationRateHz(T(1.0));
         setModulationDepth(T(0.1));
+        endParamUpdate();
     }
 
     /// Reset the reverb state.
@@ -130,6 +167,18 @@ class Reverb {
         lowCutFilter.reset();
     }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Pre-delay and low cut of channels that become
+     *       active again start from reset state; the shared feedback delay network keeps its tail.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        preDelay.setActiveChannels(newNumActiveChannels);
+        fdn.setActiveChannels(newNumActiveChannels);
+        lowCutFilter.setActiveChannels(newNumActiveChannels);
+    }
+
     /**
      * @brief Process a block of audio samples.
      * @param input Input sample pointers (one per channel)
@@ -137,17 +186,67 @@ class Reverb {
      * @param numSamples Number of samples to process
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        TraceScope trace("Reverb::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples, LoadStage::PreDelay);
 
         // Process pre-delay
         preDelay.processBlock(input, output, numSamples);
+        probes[static_cast<size_t>(Probe::PreDelay)].tap(output, numSamples);
 
         // Process FDN
+        timer.next(LoadStage::FDN);
         fdn.processBlock(output, output, numSamples);
+        probes[static_cast<size_t>(Probe::FDN)].tap(output, numSamples);
 
         // Process highpass filter for low cut
+        timer.next(LoadStage::LowCut);
         lowCutFilter.processBlock(output, output, numSamples);
     }
 
+    /**
+     * @brief Process a block and accumulate the result into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the reverb signal (e.g., send level)
+     * @note Pre-delay and FDN render into a small scratch chunk; the final low cut accumulates into the output.
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        TraceScope trace("Reverb::processBlockAdding", TraceCategory::Process, this);
+        T* const* scratch = addBuffer.writePtrs();
+        ScopedDspTimer timer(loadMeter, numSamples, LoadStage::PreDelay);
+        for (size_t offset = 0; offset < numSamples;) {
+            const size_t len = std::min(numSamples - offset, ADDING_CHUNK_SIZE);
+            const T* const* inPtrs = subBlockIn.advance(input, getNumActiveChannels(), offset);
+            T* const* outPtrs = subBlockOut.advance(output, getNumActiveChannels(), offset);
+            timer.next(LoadStage::PreDelay);
+            preDelay.processBlock(inPtrs, scratch, len);
+            probes[static_cast<size_t>(Probe::PreDelay)].tap(scratch, len);
+            timer.next(LoadStage::FDN);
+            fdn.processBlock(scratch, scratch, len);
+            probes[static_cast<size_t>(Probe::FDN)].tap(scratch, len);
+            timer.next(LoadStage::LowCut);
+            lowCutFilter.processBlockAdding(scratch, outPtrs, len, gain);
+            offset += len;
+        }
+    }
+
+    /**
+     * @brief Process a block with sample-accurate parameter automation.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param events Parameter events sorted by sample offset (ids from @ref Param)
+     * @param numEvents Number of events
+     * @note The block is split at the event offsets, with sub-blocks of at least PARAM_EVENT_MIN_SUB_BLOCK_SIZE
+     *       samples; events at the same split are applied together.
+     */
+    void processBlock(
+        const T* const* input, T* const* output, size_t numSamples, const ParamEvent* events, size_t numEvents) {
+        processBlockWithParamEvents(
+            *this, input, output, getNumActiveChannels(), numSamples, events, numEvents, subBlockIn, subBlockOut);
+    }
+
     //==============================================================================
     // SETTERS
     //==============================================================================
@@ -189,11 +288,14 @@ class Reverb {
                                        MIN_DELAY_SCALE,
                                        MAX_DELAY_SCALE);
 
+        // The damping filters depend on every delay length, so recompute them once after all lines are set
+        fdn.beginParamUpdate();
         for (size_t m = 0; m < FDN_SIZE; ++m) {
             // Compute scaled delay lengths
             size_t delaySamples = static_cast<size_t>(FDNBaseDelays<FDN_SIZE>::values[m] * scaledDiffusion);
             fdn.setDelay(m, Time<T>::Samples(delaySamples), skipSmoothing);
         }
+        fdn.endParamUpdate();
     }
 
     /**
@@ -227,15 +329,91 @@ class Reverb {
         fdn.setRelativeModulationDepth(clampedDepth * MAX_RELATIVE_MODULATION_DEPTH);
     }
 
+    /**
+     * @brief Set a parameter by id (used for ParamEvent automation).
+     * @param param Parameter id
+     * @param value New value, in the units of the matching setter
+     * @param skipSmoothing If true, skip smoothing and set immediately (ignored by unsmoothed parameters).
+     */
+    void setParam(Param param, T value, bool skipSmoothing = false) {
+        switch (param) {
+        case Param::ReverbTimeLowS:
+            setReverbTimeLowS(value, skipSmoothing);
+            break;
+        case Param::DampingCrossoverFreqHz:
+            setDampingCrossoverFreqHz(value);
+            break;
+        case Param::ReverbTimeHighS:
+            setReverbTimeHighS(value, skipSmoothing);
+            break;
+        case Param::Diffusion:
+            setDiffusion(value, skipSmoothing);
+            break;
+        case Param::PreDelayTimeMs:
+            setPreDelayTimeMs(value, skipSmoothing);
+            break;
+        case Param::LowCutFreqHz:
+            setLowCutFreqHz(value);
+            break;
+        case Param::ModulationRateHz:
+            setModulationRateHz(value);
+            break;
+        case Param::ModulationDepth:
+            setModulationDepth(value);
+            break;
+        }
+    }
+
+    /// Defer damping and low cut coefficient recomputation until @ref endParamUpdate (coalesces parameter changes)
+    void beginParamUpdate() {
+        fdn.beginParamUpdate();
+        lowCutFilter.beginCoeffUpdate();
+    }
+
+    /// Recompute the damping filters and low cut coefficients changed since @ref beginParamUpdate
+    void endParamUpdate() {
+        fdn.endParamUpdate();
+        lowCutFilter.endCoeffUpdate();
+    }
+
     //==============================================================================
     // GETTERS
     //==============================================================================
     /// Get number of channels
     size_t getNumChannels() const { return numChannels; }
 
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return fdn.getNumActiveChannels(); }
+
     /// Get sample rate
     T getSampleRate() const { return sampleRate; }
 
+    /// Get latency in samples (none, the pre-delay is part of the effect)
+    T getLatencySamples() const { return T(0); }
+
+    /// DSP load of one stage in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent(LoadStage stage) const { return loadMeter.getLoadPercent(stage); }
+
+    /// DSP load of the whole reverb in percent of the realtime budget
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Probe on the pre-delay or FDN output (arm it to capture snapshots, see @ref ProbePoint)
+    ProbePoint<T>& getProbe(Probe probe) { return probes[static_cast<size_t>(probe)]; }
+
+    /// Append the pre-delay, network and low-cut state to a state snapshot (see @ref StateBlob)
+    void saveState(StateBlob& blob) const {
+        preDelay.saveState(blob);
+        fdn.saveState(blob);
+        lowCutFilter.saveState(blob);
+    }
+
+    /// Restore the pre-delay, network and low-cut state from a state snapshot (no allocation)
+    void restoreState(StateReader& reader) {
+        preDelay.restoreState(reader);
+        fdn.restoreState(reader);
+        lowCutFilter.restoreState(reader);
+    }
+
   private:
     // Global parameters
     size_t numChannels = 0;
@@ -253,6 +431,11 @@ class Reverb {
                                  jnsc::detail::LinearInterpolator<T>>
         fdn;
     BiquadFilter<T> lowCutFilter;
+    AudioBuffer<T> addBuffer; // Scratch chunk for processBlockAdding
+    DspLoadMeter<3> loadMeter;
+    OffsetChannelPtrs<const T> subBlockIn; // Sub-block input pointers (events, processBlockAdding chunks)
+    OffsetChannelPtrs<T> subBlockOut;      // Sub-block output pointers
+    std::array<ProbePoint<T>, 2> probes;
 };
 
 } // namespace jnsc::effects
\ No newline at end of file
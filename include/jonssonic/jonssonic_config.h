@@ -13,7 +13,9 @@
 namespace jnsc {
 // clang-format off
 /// Maximum number of supported channels
-constexpr size_t JONSSONIC_MAX_CHANNELS = 64;
+constexpr size_t JONSSONIC_MAX_CHANNELS = 1024;
+/// Cache budget in bytes for the working set of one channel group (see channel_groups.h)
+constexpr size_t JONSSONIC_CHANNEL_GROUP_BYTES = 131072;
 /// Supported sample rate range
 constexpr double JONSSONIC_MIN_SAMPLE_RATE = 1000;
 constexpr double JONSSONIC_MAX_SAMPLE_RATE = 192000;
@@ -3,8 +3,12 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
+#include <algorithm>
+#include <jonssonic/core/common/dsp_load.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/output_mode.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/delays/delay_line.h>
 #include <jonssonic/core/filters/one_pole_filter.h>
 #include <jonssonic/core/generators/oscillator.h>
@@ -55,9 +59,12 @@ class ModulatedDelayStage {
      * @param newSampleRate Sample rate in Hz
      */
     void prepare(size_t newNumChannels, Time<T> newMaxDelay, T newSampleRate) {
+        TraceScope trace("ModulatedDelayStage::prepare", TraceCategory::Prepare, this);
+
         // Store config variables
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
+        loadMeter.prepare(sampleRate);
 
         // Prepare delay line
         delayLine.prepare(numChannels, sampleRate, newMaxDelay);
@@ -95,6 +102,7 @@ class ModulatedDelayStage {
             crossFeedback.setBounds(T(-0.99), T(0.99));
         if constexpr (UseInternalLFO)
             lfoPhaseOffset.setBounds(T(0), T(1));
+        numActiveChannels = numChannels;
     }
 
     /// Reset the modulated delay stage state.
@@ -113,6 +121,40 @@ class ModulatedDelayStage {
             lfoPhaseOffset.reset();
     }
 
+    /// Reset the state of a single channel.
+    void resetChannel(size_t ch) {
+        delayLine.resetChannel(ch);
+        feedforward.resetChannel(ch);
+        feedback.resetChannel(ch);
+        if constexpr (UseDamping)
+            dampingFilter.resetChannel(ch);
+        if constexpr (UseCrossFeedback) {
+            crossFeedback.resetChannel(ch);
+            delayedSamples[ch] = T(0);
+        }
+        modDepthSamples.resetChannel(ch);
+        if constexpr (UseInternalLFO) {
+            lfo.reset(ch);
+            lfoPhaseOffset.resetChannel(ch);
+        }
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
     /**
      * @brief Process a block of samples with internal LFO.
      * @param input Input sample pointers (one per channel)
@@ -121,11 +163,18 @@ class ModulatedDelayStage {
      */
 
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
-        if constexpr (UseCrossFeedback) {
-            processWithCrossFeedback(input, output, numSamples);
-        } else {
-            processWithoutCrossFeedback(input, output, numSamples);
-        }
+        processBlockImpl<OutputMode::Replace>(input, output, numSamples, T(1));
+    }
+
+    /**
+     * @brief Process a block with internal LFO and accumulate into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(const T* const* input, T* const* output, size_t numSamples, T gain = T(1)) {
+        processBlockImpl<OutputMode::Add>(input, output, numSamples, gain);
     }
 
     /**
@@ -136,11 +185,20 @@ class ModulatedDelayStage {
      * @param numSamples Number of samples to process
      */
     void processBlock(const T* const* input, T* const* output, const T* const* mod, size_t numSamples) {
-        if constexpr (UseCrossFeedback) {
-            processWithCrossFeedback(input, output, mod, numSamples);
-        } else {
-            processWithoutCrossFeedback(input, output, mod, numSamples);
-        }
+        processBlockImpl<OutputMode::Replace>(input, output, mod, numSamples, T(1));
+    }
+
+    /**
+     * @brief Process a block with external modulation and accumulate into the output: output += gain * y.
+     * @param input Input sample pointers (one per channel)
+     * @param output Output (bus) sample pointers (one per channel)
+     * @param mod Delay time modulation signal pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param gain Gain applied to the processed signal (e.g., send level)
+     */
+    void processBlockAdding(
+        const T* const* input, T* const* output, const T* const* mod, size_t numSamples, T gain = T(1)) {
+        processBlockImpl<OutputMode::Add>(input, output, mod, numSamples, gain);
     }
 
     /**
@@ -264,9 +322,37 @@ class ModulatedDelayStage {
         }
     }
 
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Append the delay line, damping, LFO and parameter smoothing to a state snapshot
+    void saveState(StateBlob& blob) const {
+        delayLine.saveState(blob);
+        dampingFilter.saveState(blob);
+        lfo.saveState(blob);
+        feedforward.saveState(blob);
+        feedback.saveState(blob);
+        crossFeedback.saveState(blob);
+        modDepthSamples.saveState(blob);
+        lfoPhaseOffset.saveState(blob);
+    }
+
+    /// Restore the delay line, damping, LFO and parameter smoothing from a state snapshot
+    void restoreState(StateReader& reader) {
+        delayLine.restoreState(reader);
+        dampingFilter.restoreState(reader);
+        lfo.restoreState(reader);
+        feedforward.restoreState(reader);
+        feedback.restoreState(reader);
+        crossFeedback.restoreState(reader);
+        modDepthSamples.restoreState(reader);
+        lfoPhaseOffset.restoreState(reader);
+    }
+
   private:
     // Config variables
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     T sampleRate = T(44100);
 
     // Processing components
@@ -283,12 +369,37 @@ class ModulatedDelayStage {
 
     // State variables
     std::vector<T> delayedSamples; // needed for cross-feedback processing
+    DspLoadMeter<> loadMeter;
+
+    // Dispatch on the cross-feedback configuration
+    template <OutputMode Mode>
+    void processBlockImpl(const T* const* input, T* const* output, size_t numSamples, T addGain) {
+        TraceScope trace("ModulatedDelayStage::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
+        if constexpr (UseCrossFeedback) {
+            processWithCrossFeedback<Mode>(input, output, numSamples, addGain);
+        } else {
+            processWithoutCrossFeedback<Mode>(input, output, numSamples, addGain);
+        }
+    }
+
+    template <OutputMode Mode>
+    void processBlockImpl(const T* const* input, T* const* output, const T* const* mod, size_t numSamples, T addGain) {
+        TraceScope trace("ModulatedDelayStage::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
+        if constexpr (UseCrossFeedback) {
+            processWithCrossFeedback<Mode>(input, output, mod, numSamples, addGain);
+        } else {
+            processWithoutCrossFeedback<Mode>(input, output, mod, numSamples, addGain);
+        }
+    }
 
     // Process block with cross-feedback and internal LFO
-    void processWithCrossFeedback(const T* const* input, T* const* output, size_t numSamples) {
+    template <OutputMode Mode>
+    void processWithCrossFeedback(const T* const* input, T* const* output, size_t numSamples, T addGain) {
         for (size_t n = 0; n < numSamples; ++n) {
             // First pass: read delayed samples from all channels
-            for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t ch = 0; ch < numActiveChannels; ++ch) {
                 T lfoValue = lfo.processSample(ch, lfoPhaseOffset.getNextValue(ch)) * T(0.5) + T(0.5);
                 T modValue = lfoValue * modDepthSamples.getNextValue(ch);
                 T sample = delayLine.readSample(ch, modValue);
@@ -300,10 +411,10 @@ class ModulatedDelayStage {
             }
 
             // Second pass: compute feedback and write back to delay lines
-            for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t ch = 0; ch < numActiveChannels; ++ch) {
                 // Retrieve delayed sample for this channel and next channel
                 T sample = delayedSamples[ch];
-                size_t nextCh = (ch + 1) % numChannels;
+                size_t nextCh = (ch + 1) % numActiveChannels;
                 T nextChSample = delayedSamples[nextCh];
 
                 // Compute mixed sample with cross-feedback
@@ -321,16 +432,21 @@ class ModulatedDelayStage {
                 delayLine.writeSample(ch, input[ch][n] * inputGain + feedbackSample);
 
                 // Output the delayed sample + feedforward
-                output[ch][n] = sample + feedforward.getNextValue(ch) * input[ch][n];
+                detail::storeOutput<Mode>(output[ch][n], sample + feedforward.getNextValue(ch) * input[ch][n], addGain);
             }
         }
     }
 
     // Process block with cross-feedback and external modulation
-    void processWithCrossFeedback(const T* const* input, T* const* output, const T* const* mod, size_t numSamples) {
+    template <OutputMode Mode>
+    void processWithCrossFeedback(const T* const* input,
+                                  T* const* output,
+                                  const T* const* mod,
+                                  size_t numSamples,
+                                  T addGain) {
         for (size_t n = 0; n < numSamples; ++n) {
             // First pass: read delayed samples from all channels
-            for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t ch = 0; ch < numActiveChannels; ++ch) {
                 T modValue = mod[ch][n] * modDepthSamples.getNextValue(ch);
                 T sample = delayLine.readSample(ch, modValue);
 
@@ -341,10 +457,10 @@ class ModulatedDelayStage {
             }
 
             // Second pass: compute feedback and write back to delay lines
-            for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t ch = 0; ch < numActiveChannels; ++ch) {
                 // Retrieve delayed sample for this channel and next channel
                 T sample = delayedSamples[ch];
-                size_t nextCh = (ch + 1) % numChannels;
+                size_t nextCh = (ch + 1) % numActiveChannels;
                 T nextChSample = delayedSamples[nextCh];
 
                 // Compute mixed sample with cross-feedback
@@ -362,14 +478,15 @@ class ModulatedDelayStage {
                 delayLine.writeSample(ch, input[ch][n] * inputGain + feedbackSample);
 
                 // Output the delayed sample + feedforward
-                output[ch][n] = sample + feedforward.getNextValue(ch) * input[ch][n];
+                detail::storeOutput<Mode>(output[ch][n], sample + feedforward.getNextValue(ch) * input[ch][n], addGain);
             }
         }
     }
 
     // Proces block without cross-feedback with internal LFO
-    void processWithoutCrossFeedback(const T* const* input, T* const* output, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
+    template <OutputMode Mode>
+    void processWithoutCrossFeedback(const T* const* input, T* const* output, size_t numSamples, T addGain) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
             for (size_t n = 0; n < numSamples; ++n) {
                 // Get LFO modulation value if internal LFO is used
                 T modValue = T(0);
@@ -392,14 +509,19 @@ class ModulatedDelayStage {
                 delayLine.writeSample(ch, input[ch][n] + feedbackSample);
 
                 // Output the delayed sample + feedforward
-                output[ch][n] = sample + feedforward.getNextValue(ch) * input[ch][n];
+                detail::storeOutput<Mode>(output[ch][n], sample + feedforward.getNextValue(ch) * input[ch][n], addGain);
             }
         }
     }
 
     // Process block without cross-feedback with external modulation
-    void processWithoutCrossFeedback(const T* const* input, T* const* output, const T* const* mod, size_t numSamples) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
+    template <OutputMode Mode>
+    void processWithoutCrossFeedback(const T* const* input,
+                                     T* const* output,
+                                     const T* const* mod,
+                                     size_t numSamples,
+                                     T addGain) {
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
             for (size_t n = 0; n < numSamples; ++n) {
                 // Scale modulation signal by modulation depth
                 T modValue = mod[ch][n] * modDepthSamples.getNextValue(ch);
@@ -418,7 +540,7 @@ class ModulatedDelayStage {
                 delayLine.writeSample(ch, input[ch][n] + feedbackSample);
 
                 // Output the delayed sample + feedforward
-                output[ch][n] = sample + feedforward.getNextValue(ch) * input[ch][n];
+                detail::storeOutput<Mode>(output[ch][n], sample + feedforward.getNextValue(ch) * input[ch][n], addGain);
             }
         }
     }
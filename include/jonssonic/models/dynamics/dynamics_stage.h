@@ -4,8 +4,10 @@
 
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
+#include <jonssonic/core/common/dsp_load.h>
 #include <jonssonic/core/common/dsp_param.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/dynamics/_dynamics.h>
 #include <jonssonic/core/filters/biquad_filter.h>
 
@@ -33,7 +35,13 @@ template <typename T,
           bool SideChainFilter = false,
           bool Metering = true>
 class DynamicsStage {
+    /// Chunk length of the feedforward block path (each stage runs over a chunk before the next one)
+    static constexpr size_t STAGE_CHUNK_SIZE = 64;
+
   public:
+    /// Processing stages reported by @ref getLoadPercent (gain application is part of the smoother)
+    enum class LoadStage { Detector, Computer, Smoother };
+
     /// Default constructor.
     DynamicsStage() = default;
 
@@ -59,6 +67,8 @@ class DynamicsStage {
      * @param newSampleRate Sample rate in Hz
      */
     void prepare(size_t newNumChannels, T newSampleRate) {
+        TraceScope trace("DynamicsStage::prepare", TraceCategory::Prepare, this);
+
         // Store config
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
@@ -81,6 +91,8 @@ class DynamicsStage {
         if constexpr (DetectorType == DetectorType::Feedback) {
             previousOutput.resize(numChannels, T(1));
         }
+        numActiveChannels = numChannels;
+        loadMeter.prepare(sampleRate);
     }
 
     /**
@@ -97,6 +109,34 @@ class DynamicsStage {
         }
     }
 
+    /**
+     * @brief Reset the dynamics processor state of a single channel.
+     * @param ch Channel index
+     */
+    void resetChannel(size_t ch) {
+        envelopeFollower.resetChannel(ch);
+        gainSmoother.resetChannel(ch);
+        if constexpr (SideChainFilter) {
+            sideChainFilter.resetChannel(ch);
+        }
+        if constexpr (DetectorType == DetectorType::Feedback) {
+            previousOutput[ch] = T(0);
+        }
+    }
+
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        newNumActiveChannels = std::min(newNumActiveChannels, numChannels);
+        for (size_t ch = numActiveChannels; ch < newNumActiveChannels; ++ch)
+            resetChannel(ch);
+        numActiveChannels = newNumActiveChannels;
+    }
+
     /**
      * @brief Process a single sample for a given channel.
      * @param ch Channel index.
@@ -165,21 +205,29 @@ class DynamicsStage {
      * @param numSamples Number of samples to process
      * @param gainReductionOutput Output (max gain reduction) sample pointers (one per channel) -
      * only if metering enabled
-     * @note Must call @ref prepare before processing.
+     * @note Must call @ref prepare before processing. The feedforward detector runs the stages chunk by chunk,
+     *       with the same result as @ref processSample; the feedback detector couples the stages sample by sample,
+     *       so its whole loop is charged to the detector stage of the DSP load.
      */
     void processBlock(const T* const* input,
                       const T* const* detectorInput,
                       T* const* output,
                       size_t numSamples,
                       T* gainReductionOutput = nullptr) {
+        TraceScope trace("DynamicsStage::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples, LoadStage::Detector);
+
         // Reset metering state if enabled
         if constexpr (Metering)
             std::fill(maxGainReduction.begin(), maxGainReduction.end(), T(1));
 
         // Process loop
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            for (size_t n = 0; n < numSamples; ++n) {
-                output[ch][n] = processSample(ch, input[ch][n], detectorInput[ch][n]);
+        for (size_t ch = 0; ch < numActiveChannels; ++ch) {
+            if constexpr (DetectorType == DetectorType::Feedforward) {
+                processChannelStaged(ch, input[ch], detectorInput[ch], output[ch], numSamples, timer);
+            } else {
+                for (size_t n = 0; n < numSamples; ++n)
+                    output[ch][n] = processSample(ch, input[ch][n], detectorInput[ch][n]);
             }
             // Output max gain reduction if enabled
             if constexpr (Metering) {
@@ -270,12 +318,72 @@ class DynamicsStage {
     /// Get the number of channels.
     size_t getNumChannels() const { return numChannels; }
 
+    /// Get the number of active (processed) channels.
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
     /// Get the sample rate.
     T getSampleRate() const { return sampleRate; }
 
+    /// DSP load of one stage in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent(LoadStage stage) const { return loadMeter.getLoadPercent(stage); }
+
+    /// DSP load of the whole dynamics stage in percent of the realtime budget
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Append the detector, gain computer and smoother state to a state snapshot
+    void saveState(StateBlob& blob) const {
+        envelopeFollower.saveState(blob);
+        gainComputer.saveState(blob);
+        gainSmoother.saveState(blob);
+        sideChainFilter.saveState(blob);
+        blob.write(previousOutput);
+    }
+
+    /// Restore the detector, gain computer and smoother state from a state snapshot
+    void restoreState(StateReader& reader) {
+        envelopeFollower.restoreState(reader);
+        gainComputer.restoreState(reader);
+        gainSmoother.restoreState(reader);
+        sideChainFilter.restoreState(reader);
+        reader.read(previousOutput);
+    }
+
   private:
+    // Feedforward block path for one channel: detector, computer and smoother each run over a chunk in turn
+    void processChannelStaged(
+        size_t ch, const T* input, const T* detectorInput, T* output, size_t numSamples, ScopedDspTimer<3>& timer) {
+        T chunk[STAGE_CHUNK_SIZE];
+        for (size_t offset = 0; offset < numSamples; offset += STAGE_CHUNK_SIZE) {
+            const size_t len = std::min(STAGE_CHUNK_SIZE, numSamples - offset);
+
+            // Side chain filter and envelope
+            timer.next(LoadStage::Detector);
+            for (size_t n = 0; n < len; ++n) {
+                T x = detectorInput[offset + n];
+                if constexpr (SideChainFilter)
+                    x = sideChainFilter.processSample(ch, x);
+                chunk[n] = envelopeFollower.processSample(ch, x);
+            }
+
+            // Gain computation
+            timer.next(LoadStage::Computer);
+            for (size_t n = 0; n < len; ++n)
+                chunk[n] = gainComputer.processSample(ch, chunk[n]);
+
+            // Gain smoothing, metering and gain application
+            timer.next(LoadStage::Smoother);
+            for (size_t n = 0; n < len; ++n) {
+                const T smoothGainLin = gainSmoother.processSample(ch, chunk[n]);
+                if constexpr (Metering)
+                    maxGainReduction[ch] = std::min(maxGainReduction[ch], smoothGainLin);
+                output[offset + n] = input[offset + n] * smoothGainLin;
+            }
+        }
+    }
+
     // Config variables
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     T sampleRate = T(44100);
 
     // Components
@@ -287,6 +395,7 @@ class DynamicsStage {
     // State variables
     std::vector<T> previousOutput;   // Needed for feedback detector
     std::vector<T> maxGainReduction; // For metering
+    DspLoadMeter<3> loadMeter;
 };
 
 // =============================================================================
@@ -5,6 +5,8 @@
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
 
+#include <jonssonic/core/common/dsp_load.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/filters/one_pole_filter.h>
 #include <jonssonic/core/generators/noise.h>
 #include <vector>
@@ -43,9 +45,12 @@ class FilteredNoise<T, noiseType, FilterType::Lowpass1stOrder> {
      * @note Must be called before processing
      */
     void prepare(size_t newNumChannels, T newSampleRate) {
+        TraceScope trace("FilteredNoise::prepare", TraceCategory::Prepare, this);
+
         // Store parameters
         numChannels = newNumChannels;
         sampleRate = newSampleRate;
+        loadMeter.prepare(sampleRate);
 
         // Prepare components
         noise.prepare(newNumChannels);
@@ -75,6 +80,8 @@ class FilteredNoise<T, noiseType, FilterType::Lowpass1stOrder> {
     }
 
     void processBlock(T* const* output, size_t numSamples) {
+        TraceScope trace("FilteredNoise::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
         noise.processBlock(output, numSamples);          // Generate raw noise block
         filter.processBlock(output, output, numSamples); // Apply filter to block
     }
@@ -85,16 +92,32 @@ class FilteredNoise<T, noiseType, FilterType::Lowpass1stOrder> {
      */
     void setCutoff(Frequency<T> newFreq) { filter.setFrequency(newFreq); }
 
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
     size_t getNumChannels() const { return numChannels; }
 
     bool isPrepared() const { return togglePrepared; }
 
+    /// Append the generator and filter state to a state snapshot
+    void saveState(StateBlob& blob) const {
+        noise.saveState(blob);
+        filter.saveState(blob);
+    }
+
+    /// Restore the generator and filter state from a state snapshot
+    void restoreState(StateReader& reader) {
+        noise.restoreState(reader);
+        filter.restoreState(reader);
+    }
+
   private:
     bool togglePrepared = false;
     size_t numChannels = 0;
     T sampleRate = T(44100);
     Noise<T, noiseType> noise;
     OnePoleFilter<T> filter;
+    DspLoadMeter<> loadMeter;
 };
 
 // =============================================================================
@@ -114,9 +137,12 @@ class FilteredNoise<T, noiseType, FilterType::Lowpass2ndOrder> {
      * @note Must be called before processing
      */
     void prepare(size_t newNumChannels, T newSampleRate) {
+        TraceScope trace("FilteredNoise::prepare", TraceCategory::Prepare, this);
+
         // Store parameters
         numChannels = newNumChannels;
         sampleRate = newSampleRate;
+        loadMeter.prepare(sampleRate);
 
         // Prepare components
         noise.prepare(newNumChannels);
@@ -147,6 +173,8 @@ class FilteredNoise<T, noiseType, FilterType::Lowpass2ndOrder> {
     }
 
     void processBlock(T* const* output, size_t numSamples) {
+        TraceScope trace("FilteredNoise::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
         noise.processBlock(output, numSamples);          // Generate raw noise block
         filter.processBlock(output, output, numSamples); // Apply filter to block
     }
@@ -156,15 +184,31 @@ class FilteredNoise<T, noiseType, FilterType::Lowpass2ndOrder> {
      */
     void setCutoff(Frequency<T> newFreq) { filter.setFrequency(newFreq); }
 
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
     size_t getNumChannels() const { return numChannels; }
     bool isPrepared() const { return togglePrepared; }
 
+    /// Append the generator and filter state to a state snapshot
+    void saveState(StateBlob& blob) const {
+        noise.saveState(blob);
+        filter.saveState(blob);
+    }
+
+    /// Restore the generator and filter state from a state snapshot
+    void restoreState(StateReader& reader) {
+        noise.restoreState(reader);
+        filter.restoreState(reader);
+    }
+
   private:
     bool togglePrepared = false;
     size_t numChannels = 0;
     T sampleRate = T(44100);
     Noise<T, noiseType> noise;
     BiquadFilter<T> filter;
+    DspLoadMeter<> loadMeter;
 };
 
 } // namespace jnsc::models
@@ -83,6 +83,16 @@ class DecayFilter {
     /// Get the underlying filter object (e.g., for setting coefficients)
     DecayType& engine() { return filter; }
 
+    /// Append the decay filter state to a state snapshot
+    void saveState(StateBlob& blob) const {
+        filter.saveState(blob);
+    }
+
+    /// Restore the decay filter state from a state snapshot
+    void restoreState(StateReader& reader) {
+        filter.restoreState(reader);
+    }
+
   private:
     // Config variables
     T sampleRate = T(44100);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "jonssonic/models/reverb/detail/decay_limits.h"
+#include <jonssonic/core/common/state_blob.h>
 
 namespace jnsc::models::detail {
 
@@ -95,6 +96,20 @@ class OnePoleDecay {
     /// Check if the filter is prepared
     bool isPrepared() const { return togglePrepared; }
 
+    /// Append the decay coefficients and filter memories to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(a);
+        blob.write(b);
+        blob.write(z1);
+    }
+
+    /// Restore the decay coefficients and filter memories from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(a);
+        reader.read(b);
+        reader.read(z1);
+    }
+
   private:
     bool togglePrepared = false;
     T sampleRate = T(44100);
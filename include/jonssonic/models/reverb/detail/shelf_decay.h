@@ -113,6 +113,18 @@ class ShelfDecay {
     /// Check if the filter is prepared
     bool isPrepared() const { return togglePrepared; }
 
+    /// Append the broadband gains and shelf filter state to a state snapshot
+    void saveState(StateBlob& blob) const {
+        blob.write(gBase);
+        shelf.saveState(blob);
+    }
+
+    /// Restore the broadband gains and shelf filter state from a state snapshot
+    void restoreState(StateReader& reader) {
+        reader.read(gBase);
+        shelf.restoreState(reader);
+    }
+
   private:
     bool togglePrepared = false;
     T sampleRate = T(44100);
@@ -3,7 +3,9 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
+#include <jonssonic/core/common/dsp_load.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/delays/delay_line.h>
 #include <jonssonic/core/filters/biquad_filter.h>
 #include <jonssonic/core/mixing/mixing_matrix.h>
@@ -63,9 +65,12 @@ class FeedbackDelayNetwork {
      * @param newMaxDelay Maximum delay time struct.
      */
     void prepare(size_t newNumChannels, T newSampleRate, Time<T> newMaxDelay) {
+        TraceScope trace("FeedbackDelayNetwork::prepare", TraceCategory::Prepare, this);
+
         // Clamp and store config variables
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
+        loadMeter.prepare(sampleRate);
 
         // Prepare DSP components
         Dm.prepare(M, sampleRate, newMaxDelay);
@@ -87,6 +92,9 @@ class FeedbackDelayNetwork {
         modDepthSamples.prepare(M, sampleRate);
         modDepthSamples.setBounds(T(0), T(1));
 
+        numActiveChannels = numChannels;
+        paramUpdateDepth = 0;
+        dampingUpdatePending = false;
         togglePrepared = true;
     }
 
@@ -104,6 +112,17 @@ class FeedbackDelayNetwork {
         std::fill(s.begin(), s.end(), T(0));
     }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Inactive channels feed silence into the network and their outputs are left untouched. The delay lines
+     *       are shared by all channels, so the network keeps its state when channels are toggled.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        numActiveChannels = std::min(newNumActiveChannels, numChannels);
+        std::fill(inputFrame.begin() + numActiveChannels, inputFrame.end(), T(0));
+    }
+
     /**
      * @brief Process block of samples with the FDN without modulation.
      * @param input Input sample pointers (one per channel)
@@ -111,9 +130,11 @@ class FeedbackDelayNetwork {
      * @param numSamples Number of samples to process
      */
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        TraceScope trace("FeedbackDelayNetwork::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples);
         for (size_t n = 0; n < numSamples; ++n) {
             // Gather audio inputs for this sample
-            for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t ch = 0; ch < numActiveChannels; ++ch)
                 inputFrame[ch] = input[ch][n];
 
             // Input mixing: inputFrame (numChannels) -> x (M)
@@ -138,7 +159,7 @@ class FeedbackDelayNetwork {
             C.mix(s.data(), outputFrame.data());
 
             // Write to audio outputs
-            for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t ch = 0; ch < numActiveChannels; ++ch)
                 output[ch][n] = outputFrame[ch];
         }
     }
@@ -146,6 +167,26 @@ class FeedbackDelayNetwork {
     // SETTERS
     //==============================================================================
 
+    /**
+     * @brief Defer damping filter recomputation until the matching @ref endParamUpdate.
+     * @note Use around several delay or decay changes so that the damping filters are recomputed once instead of
+     *       once per setter. Scopes may nest; the outermost one recomputes.
+     */
+    void beginParamUpdate() {
+        if (togglePrepared)
+            ++paramUpdateDepth;
+    }
+
+    /// Recompute the damping filters once if a setter changed them since the outermost @ref beginParamUpdate
+    void endParamUpdate() {
+        if (paramUpdateDepth == 0 || --paramUpdateDepth > 0)
+            return;
+        if (dampingUpdatePending) {
+            dampingUpdatePending = false;
+            updateDampingFilter();
+        }
+    }
+
     /**
      * @brief Set control smoothing time.
      * @param time Smoothing time struct.
@@ -165,7 +206,7 @@ class FeedbackDelayNetwork {
         if (!togglePrepared)
             return;
         Dm.setDelay(m, newDelayTime, skipSmoothing);
-        updateDampingFilter();
+        requestDampingUpdate();
     }
 
     /**
@@ -176,7 +217,7 @@ class FeedbackDelayNetwork {
         if (!togglePrepared)
             return;
         RT60_LO = newDecayTime;
-        updateDampingFilter();
+        requestDampingUpdate();
     }
 
     /**
@@ -187,7 +228,7 @@ class FeedbackDelayNetwork {
         if (!togglePrepared)
             return;
         RT60_HI = newDecayTime;
-        updateDampingFilter();
+        requestDampingUpdate();
     }
 
     /**
@@ -199,7 +240,7 @@ class FeedbackDelayNetwork {
         if (!togglePrepared)
             return;
         Fc = newCrossOverFreq;
-        updateDampingFilter();
+        requestDampingUpdate();
     }
 
     /**
@@ -231,15 +272,44 @@ class FeedbackDelayNetwork {
     /// Get number of channels
     size_t getNumChannels() const { return numChannels; }
 
+    /// Get number of active (processed) channels
+    size_t getNumActiveChannels() const { return numActiveChannels; }
+
     /// Get sample rate
     T getSampleRate() const { return sampleRate; }
 
     /// Check if prepared
     bool isPrepared() const { return togglePrepared; }
 
+    /// DSP load in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /// Append the delay lines, decay filters, modulation and reverb times to a state snapshot
+    void saveState(StateBlob& blob) const {
+        Dm.saveState(blob);
+        G.saveState(blob);
+        modSource.saveState(blob);
+        modDepthSamples.saveState(blob);
+        blob.write(RT60_LO);
+        blob.write(RT60_HI);
+        blob.write(Fc);
+    }
+
+    /// Restore the delay lines, decay filters, modulation and reverb times from a state snapshot
+    void restoreState(StateReader& reader) {
+        Dm.restoreState(reader);
+        G.restoreState(reader);
+        modSource.restoreState(reader);
+        modDepthSamples.restoreState(reader);
+        reader.read(RT60_LO);
+        reader.read(RT60_HI);
+        reader.read(Fc);
+    }
+
   private:
     // Config variables
     size_t numChannels = 0;
+    size_t numActiveChannels = 0;
     T sampleRate = T(44100);
     bool togglePrepared = false;
 
@@ -265,8 +335,23 @@ class FeedbackDelayNetwork {
     Time<T> RT60_HI = Time<T>::Seconds(T(1.0));     // Reverb time at high frequencies
     Frequency<T> Fc = Frequency<T>::Hertz(T(2000)); // Crossover frequency for damping filter
 
+    // Deferred damping filter recomputation (see beginParamUpdate)
+    size_t paramUpdateDepth = 0;
+    bool dampingUpdatePending = false;
+
+    DspLoadMeter<> loadMeter;
+
+    // Recompute the damping filters now, or once at the end of the current update scope
+    void requestDampingUpdate() {
+        if (paramUpdateDepth > 0)
+            dampingUpdatePending = true;
+        else
+            updateDampingFilter();
+    }
+
     // Helper method
     void updateDampingFilter() {
+        TraceScope trace("FeedbackDelayNetwork::updateDampingFilter", TraceCategory::Parameter, this);
         constexpr bool isShelf = std::is_same_v<DecayType, Shelf1Decay<T>> || std::is_same_v<DecayType, Shelf2Decay<T>>;
         if constexpr (isShelf) {
             for (size_t m = 0; m < M; ++m)
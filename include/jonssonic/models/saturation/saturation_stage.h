@@ -4,8 +4,12 @@
 
 #pragma once
 #include "jonssonic/utils/detail/config_utils.h"
+#include <jonssonic/core/common/channel_groups.h>
+#include <jonssonic/core/common/dsp_load.h>
 #include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/common/probe_point.h>
 #include <jonssonic/core/common/quantities.h>
+#include <jonssonic/core/common/trace_recorder.h>
 #include <jonssonic/core/filters/biquad_filter.h>
 #include <jonssonic/core/nonlinear/wave_shaper_processor.h>
 #include <jonssonic/core/oversampling/oversampled_processor.h>
@@ -32,6 +36,9 @@ class SaturationStage {
                   "OversamplingFactor must be 1, 2, 4, 8, or 16.");
 
   public:
+    /// Processing stages reported by @ref getLoadPercent (oversampling covers the up- and downsampling filters)
+    enum class LoadStage { PreFiltering, Oversampling, Shaping, PostFiltering };
+
     /// Default constructor.
     SaturationStage() = default;
 
@@ -57,6 +64,8 @@ class SaturationStage {
      * @param newSampleRate Sample rate in Hz
      */
     void prepare(size_t newNumChannels, size_t newMaxBlockSize, T newSampleRate) {
+        TraceScope trace("SaturationStage::prepare", TraceCategory::Prepare, this);
+
         // Clamp and set number of channels and sample rate
         numChannels = utils::detail::clampChannels(newNumChannels);
         sampleRate = utils::detail::clampSampleRate(newSampleRate);
@@ -74,6 +83,9 @@ class SaturationStage {
 
         if constexpr (PostFilter)
             postFilter.prepare(numChannels, sampleRate);
+
+        loadMeter.prepare(sampleRate);
+        shaperProbe.prepare(numChannels);
     }
 
     /// Reset the saturation stage state.
@@ -90,55 +102,55 @@ class SaturationStage {
             postFilter.reset();
     }
 
+    /**
+     * @brief Set the number of processed channels without re-preparing.
+     * @param newNumActiveChannels Number of active channels (clamped to the prepared channel count)
+     * @note Block processing skips the channels from this index on. Channels that become active again start from
+     *       reset state.
+     */
+    void setActiveChannels(size_t newNumActiveChannels) {
+        if constexpr (OversamplingFactor > 1)
+            oversampledProcessor.setActiveChannels(newNumActiveChannels);
+
+        waveShaper.setActiveChannels(newNumActiveChannels);
+
+        if constexpr (PreFilter)
+            preFilter.setActiveChannels(newNumActiveChannels);
+
+        if constexpr (PostFilter)
+            postFilter.setActiveChannels(newNumActiveChannels);
+    }
+
     /**
      * @brief Process a block of samples for all channels.
      * @param input Input sample pointers (one per channel)
      * @param output Output sample pointers (one per channel)
      * @param numSamples Number of samples to process
-     * @note Must call @ref prepare before processing.
+     * @note Must call @ref prepare before processing. All stages run on one cache-sized channel group before the
+     *       next group starts, so large channel counts do not evict the audio between stages.
      */
-
     void processBlock(const T* const* input, T* const* output, size_t numSamples) {
+        TraceScope trace("SaturationStage::processBlock", TraceCategory::Process, this);
+        ScopedDspTimer timer(loadMeter, numSamples, LoadStage::PreFiltering);
+        const size_t groupSize = channelGroupSize<T>(numSamples * OversamplingFactor);
+        forEachChannelGroup(getNumActiveChannels(), groupSize, [&](size_t chBegin, size_t chEnd) {
+            processRange(input, output, numSamples, chBegin, chEnd, timer, &shaperProbe);
+        });
+    }
 
-        // PRE-FILTERING ENABLED SIGNAL PATH
-        if constexpr (PreFilter) {
-            preFilter.processBlock(input, output, numSamples);
-
-            // Oversampled waveshaping
-            if constexpr (OversamplingFactor > 1) {
-                oversampledProcessor.processBlock(output,
-                                                  output,
-                                                  numSamples,
-                                                  [this](const T* const* in, T* const* out, size_t oversampledSamples) {
-                                                      waveShaper.processBlock(in, out, oversampledSamples);
-                                                  });
-
-            }
-            // No oversampling
-            else
-                waveShaper.processBlock(output, output, numSamples);
-        }
-
-        // PRE-FILTERING DISABLED SIGNAL PATH
-        if constexpr (!PreFilter) {
-            // Oversampled waveshaping
-            if constexpr (OversamplingFactor > 1) {
-                oversampledProcessor.processBlock(input,
-                                                  output,
-                                                  numSamples,
-                                                  [this](const T* const* in, T* const* out, size_t oversampledSamples) {
-                                                      waveShaper.processBlock(in, out, oversampledSamples);
-                                                  });
-
-            }
-            // No oversampling
-            else
-                waveShaper.processBlock(input, output, numSamples);
-        }
-
-        // Post-filtering if enabled
-        if constexpr (PostFilter)
-            postFilter.processBlock(output, output, numSamples);
+    /**
+     * @brief Process a block for a range of channels (channels outside the range are untouched).
+     * @param input Input sample pointers (one per channel)
+     * @param output Output sample pointers (one per channel)
+     * @param numSamples Number of samples to process
+     * @param chBegin First channel to process
+     * @param chEnd One past the last channel to process
+     * @note Not included in the DSP load nor the shaper probe, since ranges may be processed on several threads at
+     *       once.
+     */
+    void processChannelRange(const T* const* input, T* const* output, size_t numSamples, size_t chBegin, size_t chEnd) {
+        ScopedDspTimer<NUM_LOAD_STAGES> untimed(nullptr, 0);
+        processRange(input, output, numSamples, chBegin, chEnd, untimed, nullptr);
     }
 
     /**
@@ -271,18 +283,100 @@ class SaturationStage {
     /// Get the number of channels.
     size_t getNumChannels() const { return numChannels; }
 
+    /// Get the number of active (processed) channels.
+    size_t getNumActiveChannels() const { return waveShaper.getNumActiveChannels(); }
+
     /// Get the sample rate in Hz.
     T getSampleRate() const { return sampleRate; }
 
     /// Get latency in samples at base sample rate.
-    size_t getLatencySamples() const {
+    T getLatencySamples() const {
         if constexpr (OversamplingFactor > 1)
             return oversampledProcessor.getLatencySamples();
         else
-            return 0;
+            return T(0);
+    }
+
+    /// DSP load of one stage in percent of the realtime budget (0 unless built with JONSSONIC_ENABLE_DSP_LOAD)
+    float getLoadPercent(LoadStage stage) const { return loadMeter.getLoadPercent(stage); }
+
+    /// DSP load of the whole saturation stage in percent of the realtime budget
+    float getLoadPercent() const { return loadMeter.getLoadPercent(); }
+
+    /**
+     * @brief Probe on the shaper output, at the oversampled rate (arm it to capture snapshots, see @ref ProbePoint).
+     * @note Each channel group is offered in turn, so the captured channels (and the trigger channel when
+     *       triggered) must fall in one group (see @ref channelGroupSize).
+     */
+    ProbePoint<T>& getShaperProbe() { return shaperProbe; }
+
+    /// Append the filters, shaper smoothing and oversampler histories to a state snapshot
+    void saveState(StateBlob& blob) const {
+        oversampledProcessor.saveState(blob);
+        waveShaper.saveState(blob);
+        preFilter.saveState(blob);
+        postFilter.saveState(blob);
+    }
+
+    /// Restore the filters, shaper smoothing and oversampler histories from a state snapshot
+    void restoreState(StateReader& reader) {
+        oversampledProcessor.restoreState(reader);
+        waveShaper.restoreState(reader);
+        preFilter.restoreState(reader);
+        postFilter.restoreState(reader);
     }
 
   private:
+    static constexpr size_t NUM_LOAD_STAGES = 4;
+
+    // Run all stages on a range of channels, charging each stage to the timer and offering the shaper output to
+    // the probe (if any)
+    void processRange(const T* const* input,
+                      T* const* output,
+                      size_t numSamples,
+                      size_t chBegin,
+                      size_t chEnd,
+                      ScopedDspTimer<NUM_LOAD_STAGES>& timer,
+                      ProbePoint<T>* probe) {
+        // Pre-filtering if enabled (then shape the filtered output in place)
+        timer.next(LoadStage::PreFiltering);
+        const T* const* shaperInput = input;
+        if constexpr (PreFilter) {
+            preFilter.processChannelRange(input, output, numSamples, chBegin, chEnd);
+            shaperInput = output;
+        }
+
+        // Oversampled waveshaping (the shaper itself is charged separately from the resampling filters)
+        if constexpr (OversamplingFactor > 1) {
+            timer.next(LoadStage::Oversampling);
+            oversampledProcessor.processChannelRange(
+                shaperInput,
+                output,
+                numSamples,
+                chBegin,
+                chEnd,
+                [this, chBegin, chEnd, &timer, probe](const T* const* in, T* const* out, size_t oversampledSamples) {
+                    timer.next(LoadStage::Shaping);
+                    waveShaper.processChannelRange(in, out, oversampledSamples, chBegin, chEnd);
+                    if (probe)
+                        probe->tap(out, oversampledSamples, chBegin, chEnd);
+                    timer.next(LoadStage::Oversampling);
+                });
+        }
+        // No oversampling
+        else {
+            timer.next(LoadStage::Shaping);
+            waveShaper.processChannelRange(shaperInput, output, numSamples, chBegin, chEnd);
+            if (probe)
+                probe->tap(output, numSamples, chBegin, chEnd);
+        }
+
+        // Post-filtering if enabled
+        timer.next(LoadStage::PostFiltering);
+        if constexpr (PostFilter)
+            postFilter.processChannelRange(output, output, numSamples, chBegin, chEnd);
+    }
+
     // Config variables
     size_t numChannels = 0;
     T sampleRate = T(44100);
@@ -292,6 +386,8 @@ class SaturationStage {
     WaveShaperProcessor<T, ShaperType> waveShaper;
     BiquadFilter<T> preFilter;
     BiquadFilter<T> postFilter;
+    DspLoadMeter<NUM_LOAD_STAGES> loadMeter;
+    ProbePoint<T> shaperProbe;
 };
 
 } // namespace jnsc::models
\ No newline at end of file
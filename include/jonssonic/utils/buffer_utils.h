@@ -2,7 +2,10 @@
 // Buffer utilities header file
 // SPDX-License-Identifier: MIT
 #pragma once
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#include <jonssonic/utils/math_utils.h>
 
 namespace jnsc::utils {
 
@@ -13,7 +16,8 @@ namespace jnsc::utils {
 /**
  * @brief Maps input channels to output channels for raw audio buffers.
  *        Supports both upmixing and downmixing.
- *        Dow
+ *        Downmixing averages groups of input channels, upmixing duplicates them.
+ *        For weighted or smoothed routing (e.g., 5.1 -> stereo), use ChannelMapper.
  * @tparam T Sample type (e.g., float, double)
  * @param input Array of pointers to input channel data (const T* const*)
  * @param output Array of pointers to output channel data (T* const*)
@@ -24,22 +28,23 @@ namespace jnsc::utils {
 template <typename T>
 inline void mapChannels(
     const T* const* input, T* const* output, size_t numInputChannels, size_t numOutputChannels, size_t numSamples) {
-    for (int outCh = 0; outCh < numOutputChannels; ++outCh) {
+    const size_t groupSize = numOutputChannels > 0 ? numInputChannels / numOutputChannels : 0;
+    const T groupGain = groupSize > 0 ? T(1) / static_cast<T>(groupSize) : T(0);
+    for (size_t outCh = 0; outCh < numOutputChannels; ++outCh) {
         if (numInputChannels == numOutputChannels) {
             // Direct copy
             std::memcpy(output[outCh], input[outCh], sizeof(T) * numSamples);
         } else if (numInputChannels > numOutputChannels) {
             // Downmix: average groups of input channels
-            int groupSize = numInputChannels / numOutputChannels;
-            for (int n = 0; n < numSamples; ++n) {
+            for (size_t n = 0; n < numSamples; ++n) {
                 T sum = 0;
-                for (int i = 0; i < groupSize; ++i)
+                for (size_t i = 0; i < groupSize; ++i)
                     sum += input[outCh * groupSize + i][n];
-                output[outCh][n] = sum / groupSize;
+                output[outCh][n] = sum * groupGain;
             }
         } else {
             // Upmix: wrap or duplicate
-            int inCh = outCh % numInputChannels;
+            size_t inCh = outCh % numInputChannels;
             std::memcpy(output[outCh], input[inCh], sizeof(T) * numSamples);
         }
     }
@@ -113,13 +118,20 @@ void copyToBuffer(const T* const* src, T* const* dest, size_t numChannels, size_
 template <typename T>
 void crossfadeBuffers(
     const T* const* bufferA, const T* const* bufferB, T* const* output, size_t numChannels, size_t numSamples) {
-    for (size_t ch = 0; ch < numChannels; ++ch) {
-        for (size_t n = 0; n < numSamples; ++n) {
-            // Equal power crossfade
-            T fadeFactor = static_cast<T>(n) / static_cast<T>(numSamples - 1);
-            T gainA = std::cos(fadeFactor * (static_cast<T>(M_PI) / static_cast<T>(2))); // cos(0 to π/2)
-            T gainB = std::sin(fadeFactor * (static_cast<T>(M_PI) / static_cast<T>(2))); // sin(0 to π/2)
-            output[ch][n] = bufferA[ch][n] * gainA + bufferB[ch][n] * gainB;
+    constexpr size_t CHUNK_SIZE = 256;
+    T gainA[CHUNK_SIZE], gainB[CHUNK_SIZE];
+    const T step = numSamples > 1 ? T(1) / static_cast<T>(numSamples - 1) : T(1);
+    for (size_t offset = 0; offset < numSamples; offset += CHUNK_SIZE) {
+        const size_t len = std::min(CHUNK_SIZE, numSamples - offset);
+
+        // Equal power crossfade, gains shared by all channels: cos(0 to π/2) for A, sin(0 to π/2) for B
+        equalPowerRamp(static_cast<T>(offset) * step, step, gainA, gainB, len);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const T* a = bufferA[ch] + offset;
+            const T* b = bufferB[ch] + offset;
+            T* out = output[ch] + offset;
+            for (size_t n = 0; n < len; ++n)
+                out[n] = a[n] * gainA[n] + b[n] * gainB[n];
         }
     }
 }
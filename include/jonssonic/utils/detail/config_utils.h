@@ -27,9 +27,8 @@ constexpr void requireSupportedType() {
  */
 template <typename T>
 constexpr T clampSampleRate(T sr) {
-    return std::clamp(sr,
-                      static_cast<T>(JONSSONIC_MIN_SAMPLE_RATE),
-                      static_cast<T>(JONSSONIC_MAX_SAMPLE_RATE));
+    using std::clamp; // unqualified so SIMD packs find their lane-wise clamp
+    return clamp(sr, static_cast<T>(JONSSONIC_MIN_SAMPLE_RATE), static_cast<T>(JONSSONIC_MAX_SAMPLE_RATE));
 }
 
 /**
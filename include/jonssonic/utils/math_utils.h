@@ -4,7 +4,9 @@
 // Update: 18.11.2025
 
 #pragma once
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <complex>
 #include <cstddef>
 #include <limits>
@@ -151,6 +153,36 @@ inline T mag2dB(T mag) {
     return T(20) * std::log10(std::max(mag, minMag));
 }
 
+/**
+ * @brief Equal-power crossfade gains along a linear fade: gainA = cos(p * pi/2), gainB = sin(p * pi/2).
+ * @details The fade positions p = start + n * step advance by a constant angle, so the gains follow a rotation
+ *          recurrence. It is re-seeded with exact values every 64 samples to keep rounding drift negligible.
+ * @param start Fade position of the first sample (0 = all A, 1 = all B)
+ * @param step Fade position increment per sample
+ * @param gainA Output gains for signal A
+ * @param gainB Output gains for signal B
+ * @param numSamples Number of samples
+ */
+template <typename T>
+void equalPowerRamp(T start, T step, T* gainA, T* gainB, size_t numSamples) {
+    constexpr size_t RESEED_INTERVAL = 64;
+    const T cosStep = std::cos(step * pi_over_2<T>);
+    const T sinStep = std::sin(step * pi_over_2<T>);
+    for (size_t offset = 0; offset < numSamples; offset += RESEED_INTERVAL) {
+        const size_t end = std::min(numSamples, offset + RESEED_INTERVAL);
+        const T angle = (start + static_cast<T>(offset) * step) * pi_over_2<T>;
+        T c = std::cos(angle);
+        T s = std::sin(angle);
+        for (size_t n = offset; n < end; ++n) {
+            gainA[n] = c;
+            gainB[n] = s;
+            const T nextC = c * cosStep - s * sinStep;
+            s = s * cosStep + c * sinStep;
+            c = nextC;
+        }
+    }
+}
+
 /**
  * @brief Compute crosscorrelation between two signals.
  * @param x First input signal
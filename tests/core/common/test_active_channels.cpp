@@ -0,0 +1,159 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for changing the active channel count without re-preparing
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/delays/comb_filter.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/effects/chorus.h>
+#include <jonssonic/effects/compressor.h>
+#include <jonssonic/effects/delay.h>
+#include <jonssonic/effects/distortion.h>
+#include <jonssonic/effects/reverb.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 4;
+constexpr size_t numActive = 2;
+constexpr size_t numSamples = 300;
+constexpr float sampleRate = 48000.0f;
+constexpr float untouched = 7.0f; // Marker left in the outputs of inactive channels
+
+struct Buffers {
+    std::vector<std::vector<float>> input, output;
+    std::vector<const float*> in;
+    std::vector<float*> out;
+
+    Buffers() : input(numChannels, std::vector<float>(numSamples)), output(numChannels) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                input[ch][n] = 0.5f * std::sin(0.03f * float(n) * float(ch + 1));
+        for (auto& ch : input)
+            in.push_back(ch.data());
+        clearOutput();
+        for (auto& ch : output)
+            out.push_back(ch.data());
+    }
+
+    void clearOutput() {
+        for (auto& ch : output)
+            ch.assign(numSamples, untouched);
+    }
+};
+
+/**
+ * Process two blocks with a processor prepared for numChannels but running numActive channels, and with a twin
+ * prepared for numActive channels only. Active channels must match the twin, inactive outputs must stay untouched.
+ */
+template <typename ActiveFn, typename TwinFn>
+void expectInactiveChannelsSkipped(ActiveFn processActive, TwinFn processTwin, bool compareActive = true) {
+    Buffers active, twin;
+    for (size_t block = 0; block < 2; ++block) {
+        active.clearOutput();
+        processActive(active.in.data(), active.out.data());
+        processTwin(twin.in.data(), twin.out.data());
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t n = 0; n < numSamples; ++n) {
+                if (ch >= numActive) {
+                    ASSERT_EQ(active.output[ch][n], untouched) << block << " " << ch << " " << n;
+                } else if (compareActive) {
+                    ASSERT_EQ(active.output[ch][n], twin.output[ch][n]) << block << " " << ch << " " << n;
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(ActiveChannelsTest, CoreProcessorsSkipInactiveChannels) {
+    BiquadFilter<float> filter(numChannels, sampleRate), filterTwin(numActive, sampleRate);
+    filter.setActiveChannels(numActive);
+    EXPECT_EQ(filter.getNumActiveChannels(), numActive);
+    EXPECT_EQ(filter.getNumChannels(), numChannels);
+    expectInactiveChannelsSkipped([&](auto in, auto out) { filter.processBlock(in, out, numSamples); },
+                                  [&](auto in, auto out) { filterTwin.processBlock(in, out, numSamples); });
+
+    CombFilter<float> comb(numChannels, sampleRate, Time<float>::Milliseconds(10.0f));
+    CombFilter<float> combTwin(numActive, sampleRate, Time<float>::Milliseconds(10.0f));
+    for (auto* f : {&comb, &combTwin}) {
+        f->setDelay(Time<float>::Samples(37.0f), true);
+        f->setFeedbackGain(Gain<float>::Linear(0.6f), true);
+        f->setFeedforwardGain(Gain<float>::Linear(1.0f), true);
+    }
+    comb.setActiveChannels(numActive);
+    expectInactiveChannelsSkipped([&](auto in, auto out) { comb.processBlock(in, out, numSamples); },
+                                  [&](auto in, auto out) { combTwin.processBlock(in, out, numSamples); });
+
+    // The count is clamped to the prepared channels
+    comb.setActiveChannels(numChannels + 8);
+    EXPECT_EQ(comb.getNumActiveChannels(), numChannels);
+}
+
+TEST(ActiveChannelsTest, ReenabledChannelsStartFromResetState) {
+    CombFilter<float> comb(numChannels, sampleRate, Time<float>::Milliseconds(10.0f));
+    CombFilter<float> fresh(numChannels, sampleRate, Time<float>::Milliseconds(10.0f));
+    for (auto* f : {&comb, &fresh}) {
+        f->setDelay(Time<float>::Samples(37.0f), true);
+        f->setFeedbackGain(Gain<float>::Linear(0.6f), true);
+        f->setFeedforwardGain(Gain<float>::Linear(1.0f), true);
+    }
+
+    // Fill all delay lines, then disable and re-enable the upper channels
+    Buffers buffers, freshBuffers;
+    comb.processBlock(buffers.in.data(), buffers.out.data(), numSamples);
+    comb.setActiveChannels(1);
+    comb.processBlock(buffers.in.data(), buffers.out.data(), numSamples);
+    comb.setActiveChannels(numChannels);
+
+    comb.processBlock(buffers.in.data(), buffers.out.data(), numSamples);
+    fresh.processBlock(freshBuffers.in.data(), freshBuffers.out.data(), numSamples);
+    for (size_t ch = 1; ch < numChannels; ++ch)
+        EXPECT_EQ(buffers.output[ch], freshBuffers.output[ch]) << ch;
+    EXPECT_NE(buffers.output[0], freshBuffers.output[0]); // Channel 0 kept its state
+}
+
+TEST(ActiveChannelsTest, EffectsSkipInactiveChannels) {
+    {
+        effects::Chorus<float> a(numChannels, sampleRate), b(numActive, sampleRate);
+        a.setActiveChannels(numActive);
+        expectInactiveChannelsSkipped([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                      [&](auto in, auto out) { b.processBlock(in, out, numSamples); });
+    }
+    {
+        effects::Delay<float> a(numChannels, numSamples, sampleRate), b(numActive, numSamples, sampleRate);
+        a.setActiveChannels(numActive);
+        EXPECT_EQ(a.getNumActiveChannels(), numActive);
+        expectInactiveChannelsSkipped([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                      [&](auto in, auto out) { b.processBlock(in, out, numSamples); });
+    }
+    {
+        // The network mixes all channels, so only the skipped outputs are checked
+        effects::Reverb<float> a(numChannels, sampleRate), b(numActive, sampleRate);
+        a.setActiveChannels(numActive);
+        expectInactiveChannelsSkipped([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                      [&](auto in, auto out) { b.processBlock(in, out, numSamples); },
+                                      false);
+    }
+    {
+        effects::Compressor<float> a(numChannels, sampleRate), b(numActive, sampleRate);
+        a.setThreshold(-20.0f, true);
+        b.setThreshold(-20.0f, true);
+        a.setActiveChannels(numActive);
+        expectInactiveChannelsSkipped([&](auto in, auto out) { a.processBlock(in, in, out, numSamples); },
+                                      [&](auto in, auto out) { b.processBlock(in, in, out, numSamples); });
+        EXPECT_EQ(a.getGainReduction(), b.getGainReduction());
+    }
+    {
+        effects::Distortion<float> a(numChannels, numSamples, sampleRate), b(numActive, numSamples, sampleRate);
+        for (auto* d : {&a, &b}) {
+            d->setOversamplingEnabled(true);
+            d->setDriveDb(12.0f, true);
+        }
+        a.setActiveChannels(numActive);
+        expectInactiveChannelsSkipped([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                      [&](auto in, auto out) { b.processBlock(in, out, numSamples); });
+    }
+}
@@ -0,0 +1,140 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the AudioFifo class
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/audio_fifo.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 2;
+
+// Sample value encoding channel and frame index
+float frameValue(size_t ch, size_t frame) { return static_cast<float>(frame % 100000) + 0.25f * float(ch); }
+} // namespace
+
+TEST(AudioFifoTest, RegionsWrapIntoTwoSpans) {
+    AudioFifo<float> fifo(numChannels, 6);
+    EXPECT_EQ(fifo.getCapacity(), 8u);
+
+    // Advance the positions to 6, then write across the end of the ring
+    AudioBuffer<float> scratch(numChannels, 8);
+    EXPECT_EQ(fifo.push(scratch.readPtrs(), 6), 6u);
+    EXPECT_EQ(fifo.pop(scratch.writePtrs(), 6), 6u);
+
+    auto write = fifo.beginWrite(5);
+    ASSERT_EQ(write.size(), 5u);
+    EXPECT_EQ(write.offset, 6u);
+    EXPECT_EQ(write.size1, 2u);
+    EXPECT_EQ(write.size2, 3u);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < write.size(); ++n)
+            (n < write.size1 ? write.span1(ch)[n] : write.span2(ch)[n - write.size1]) = frameValue(ch, n);
+    EXPECT_EQ(fifo.getNumReady(), 0u); // Not published yet
+    fifo.finishWrite(write.size());
+    EXPECT_EQ(fifo.getNumReady(), 5u);
+    EXPECT_EQ(fifo.getFreeSpace(), 3u);
+    EXPECT_DOUBLE_EQ(fifo.getFillLevel(), 5.0 / 8.0);
+
+    // Reading back in two steps sees the frames in order
+    auto read = fifo.beginRead(3);
+    ASSERT_EQ(read.size(), 3u);
+    EXPECT_EQ(read.size1, 2u);
+    EXPECT_EQ(read.span2(1)[0], frameValue(1, 2));
+    fifo.finishRead(3);
+    AudioBuffer<float> out(numChannels, 8);
+    EXPECT_EQ(fifo.pop(out.writePtrs(), 8), 2u);
+    EXPECT_EQ(out.readChannelPtr(0)[0], frameValue(0, 3));
+    EXPECT_EQ(out.readChannelPtr(1)[1], frameValue(1, 4));
+    EXPECT_EQ(fifo.getNumReady(), 0u);
+}
+
+TEST(AudioFifoTest, PushAndPopStopAtFullAndEmpty) {
+    AudioFifo<float> fifo(numChannels, 16);
+    AudioBuffer<float> block(numChannels, 32);
+    EXPECT_EQ(fifo.push(block.readPtrs(), 10), 10u);
+    EXPECT_EQ(fifo.push(block.readPtrs(), 10), 6u);
+    EXPECT_EQ(fifo.beginWrite(1).size(), 0u);
+    EXPECT_EQ(fifo.pop(block.writePtrs(), 32), 16u);
+    EXPECT_EQ(fifo.beginRead(1).size(), 0u);
+    EXPECT_EQ(fifo.pop(block.writePtrs(), 1), 0u);
+
+    fifo.push(block.readPtrs(), 4);
+    fifo.reset();
+    EXPECT_EQ(fifo.getNumReady(), 0u);
+}
+
+TEST(AudioFifoTest, StreamsBetweenThreadsWithoutLoss) {
+    constexpr size_t totalFrames = 400000;
+    AudioFifo<float> fifo(numChannels, 512);
+    std::atomic<bool> failed{false};
+
+    std::thread producer([&] {
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<size_t> chunk(1, 300);
+        for (size_t frame = 0; frame < totalFrames;) {
+            auto region = fifo.beginWrite(std::min(chunk(rng), totalFrames - frame));
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t n = 0; n < region.size(); ++n)
+                    (n < region.size1 ? region.span1(ch)[n] : region.span2(ch)[n - region.size1]) =
+                        frameValue(ch, frame + n);
+            fifo.finishWrite(region.size());
+            frame += region.size();
+            if (region.size() == 0)
+                std::this_thread::yield();
+        }
+    });
+
+    std::mt19937 rng(2);
+    std::uniform_int_distribution<size_t> chunk(1, 300);
+    AudioBuffer<float> out(numChannels, 300);
+    for (size_t frame = 0; frame < totalFrames && !failed;) {
+        const size_t numRead = fifo.pop(out.writePtrs(), chunk(rng));
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numRead; ++n)
+                if (out.readChannelPtr(ch)[n] != frameValue(ch, frame + n))
+                    failed = true;
+        frame += numRead;
+        if (numRead == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(fifo.getNumReady(), 0u);
+}
+
+TEST(AudioFifoTest, DriftHookReportsFillDeviation) {
+    AudioFifo<float> fifo(numChannels, 1024);
+    double lastError = 0.0;
+    int calls = 0;
+    fifo.setDriftHook(
+        [&](double fillError) {
+            lastError = fillError;
+            ++calls;
+        },
+        0.5);
+
+    // A producer running ahead keeps the FIFO at 3/4: the smoothed error approaches +0.25
+    AudioBuffer<float> block(numChannels, 768);
+    fifo.push(block.readPtrs(), 768);
+    for (int i = 0; i < 1000; ++i) {
+        fifo.push(block.readPtrs(), 64);
+        fifo.pop(block.writePtrs(), 64);
+    }
+    EXPECT_EQ(calls, 1000);
+    EXPECT_NEAR(lastError, 0.25, 1e-3);
+
+    // A slow producer drains it and the error turns negative
+    fifo.pop(block.writePtrs(), 64);
+    for (int i = 0; i < 500; ++i) {
+        fifo.push(block.readPtrs(), 1);
+        fifo.pop(block.writePtrs(), 2);
+    }
+    EXPECT_LT(lastError, 0.0);
+}
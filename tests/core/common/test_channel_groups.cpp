@@ -0,0 +1,77 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for cache-sized channel groups
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/channel_groups.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/models/saturation/saturation_stage.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr float sampleRate = 48000.0f;
+using Saturation = models::SaturationStage<float, WaveShaperType::Tanh, true, true, 4>;
+
+void fillInput(AudioBuffer<float>& buffer, size_t numChannels, size_t numSamples) {
+    buffer.resize(numChannels, numSamples);
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        float* data = buffer.writeChannelPtr(ch);
+        for (size_t n = 0; n < numSamples; ++n)
+            data[n] = 0.8f * std::sin(0.01f * float(n) * float(ch % 7 + 1));
+    }
+}
+} // namespace
+
+TEST(ChannelGroupsTest, GroupSizeFitsCacheBudget) {
+    // Within the budget whenever one channel fits, never less than one channel
+    for (size_t numBuffers : {1u, 2u, 3u}) {
+        for (size_t numSamples : {16u, 256u, 4096u, 8192u, 1u << 20}) {
+            const size_t groupSize = channelGroupSize<float>(numSamples, numBuffers);
+            const size_t bytesPerChannel = numSamples * numBuffers * sizeof(float);
+            EXPECT_GE(groupSize, 1u) << numSamples;
+            if (bytesPerChannel <= JONSSONIC_CHANNEL_GROUP_BYTES) {
+                EXPECT_LE(groupSize * bytesPerChannel, JONSSONIC_CHANNEL_GROUP_BYTES) << numSamples;
+                EXPECT_GT((groupSize + 1) * bytesPerChannel, JONSSONIC_CHANNEL_GROUP_BYTES) << numSamples;
+            } else {
+                EXPECT_EQ(groupSize, 1u) << numSamples;
+            }
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> groups;
+    forEachChannelGroup(40, 16, [&](size_t chBegin, size_t chEnd) { groups.emplace_back(chBegin, chEnd); });
+    const std::vector<std::pair<size_t, size_t>> expected = {{0, 16}, {16, 32}, {32, 40}};
+    EXPECT_EQ(groups, expected);
+}
+
+TEST(ChannelGroupsTest, LargeChannelCountsAreNotClamped) {
+    BiquadFilter<float> filter(512, sampleRate);
+    EXPECT_EQ(filter.getNumChannels(), std::min<size_t>(512, JONSSONIC_MAX_CHANNELS));
+}
+
+TEST(ChannelGroupsTest, GroupedStagesMatchWholeBlockStages) {
+    // Enough channels and samples for several groups
+    constexpr size_t numChannels = 96;
+    constexpr size_t numSamples = 512;
+    ASSERT_LT(channelGroupSize<float>(numSamples * 4), numChannels);
+
+    Saturation grouped, whole;
+    for (auto* stage : {&grouped, &whole}) {
+        stage->prepare(numChannels, numSamples, sampleRate);
+        stage->setDrive(Gain<float>::Decibels(18.0f), true);
+    }
+    AudioBuffer<float> input, groupedOut(numChannels, numSamples), wholeOut(numChannels, numSamples);
+    fillInput(input, numChannels, numSamples);
+
+    for (int block = 0; block < 2; ++block) {
+        grouped.processBlock(input.readPtrs(), groupedOut.writePtrs(), numSamples);
+        whole.processChannelRange(input.readPtrs(), wholeOut.writePtrs(), numSamples, 0, numChannels);
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                ASSERT_EQ(groupedOut.readChannelPtr(ch)[n], wholeOut.readChannelPtr(ch)[n]) << ch << " " << n;
+    }
+}
@@ -0,0 +1,137 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for DSP load measurement
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_load.h>
+#include <jonssonic/effects/distortion.h>
+#include <jonssonic/effects/reverb.h>
+#include <jonssonic/models/dynamics/dynamics_stage.h>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 2;
+constexpr size_t numSamples = 256;
+constexpr float sampleRate = 48000.0f;
+
+void spinFor(std::chrono::microseconds duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+void fillInput(AudioBuffer<float>& buffer) {
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < numSamples; ++n)
+            buffer.writeChannelPtr(ch)[n] = 0.8f * std::sin(0.05f * float(n) + float(ch));
+}
+} // namespace
+
+TEST(DspLoadTest, MeterConvertsTimeToBudgetPercentage) {
+    DspLoadMeter<2> meter;
+    meter.prepare(48000.0);
+
+    // A one-second block fully replaces the average: 100 ms -> 10 %, 50 ms -> 5 %
+    meter.addTime(0, 100000000);
+    meter.addTime(1, 50000000);
+    meter.commitBlock(48000);
+
+    if constexpr (dspLoadEnabled) {
+        EXPECT_NEAR(meter.getLoadPercent(0), 10.0f, 1e-3f);
+        EXPECT_NEAR(meter.getLoadPercent(1), 5.0f, 1e-3f);
+        EXPECT_NEAR(meter.getLoadPercent(), 15.0f, 1e-3f);
+        EXPECT_NEAR(meter.getPeakLoadPercent(), 15.0f, 1e-3f);
+
+        // Short blocks move the average gradually; the peak follows single blocks
+        meter.addTime(0, 5000000);
+        meter.commitBlock(480);
+        EXPECT_NEAR(meter.getLoadPercent(0), 10.8f, 1e-3f);
+        EXPECT_NEAR(meter.getPeakLoadPercent(), 50.0f, 1e-3f);
+        meter.resetPeak();
+        EXPECT_EQ(meter.getPeakLoadPercent(), 0.0f);
+    } else {
+        EXPECT_EQ(meter.getLoadPercent(), 0.0f);
+        EXPECT_EQ(meter.getPeakLoadPercent(), 0.0f);
+    }
+}
+
+TEST(DspLoadTest, ScopedTimerChargesStages) {
+    enum class Stage { Fast, Slow };
+    DspLoadMeter<2> meter;
+    meter.prepare(48000.0);
+    {
+        ScopedDspTimer timer(meter, 48000, Stage::Fast);
+        timer.next(Stage::Slow);
+        spinFor(std::chrono::microseconds(2000));
+    }
+    if constexpr (dspLoadEnabled) {
+        EXPECT_GE(meter.getLoadPercent(Stage::Slow), 0.2f);
+        EXPECT_LT(meter.getLoadPercent(Stage::Fast), meter.getLoadPercent(Stage::Slow));
+    } else {
+        EXPECT_EQ(meter.getLoadPercent(Stage::Slow), 0.0f);
+    }
+}
+
+TEST(DspLoadTest, CompositeProcessorsReportStages) {
+    AudioBuffer<float> input(numChannels, numSamples), output(numChannels, numSamples);
+    fillInput(input);
+    effects::Reverb<float> reverb(numChannels, sampleRate);
+    effects::Distortion<float> distortion(numChannels, numSamples, sampleRate);
+    distortion.setOversamplingEnabled(true);
+    models::CompressorRMSFeedforward<float> dynamics(numChannels, sampleRate);
+
+    for (int block = 0; block < 20; ++block) {
+        reverb.processBlock(input.readPtrs(), output.writePtrs(), numSamples);
+        distortion.processBlock(input.readPtrs(), output.writePtrs(), numSamples);
+        dynamics.processBlock(input.readPtrs(), input.readPtrs(), output.writePtrs(), numSamples);
+    }
+
+    using ReverbStage = effects::Reverb<float>::LoadStage;
+    using DistortionStage = effects::Distortion<float>::LoadStage;
+    using DynamicsStage = models::CompressorRMSFeedforward<float>::LoadStage;
+    const float reverbSum = reverb.getLoadPercent(ReverbStage::PreDelay) + reverb.getLoadPercent(ReverbStage::FDN) +
+                            reverb.getLoadPercent(ReverbStage::LowCut);
+    EXPECT_FLOAT_EQ(reverb.getLoadPercent(), reverbSum);
+    if constexpr (dspLoadEnabled) {
+        EXPECT_GT(reverb.getLoadPercent(ReverbStage::FDN), 0.0f);
+        EXPECT_GT(distortion.getLoadPercent(DistortionStage::Oversampling), 0.0f);
+        EXPECT_GT(distortion.getLoadPercent(DistortionStage::Shaping), 0.0f);
+        EXPECT_GT(distortion.getLoadPercent(DistortionStage::Mixing), 0.0f);
+        EXPECT_GT(dynamics.getLoadPercent(DynamicsStage::Detector), 0.0f);
+        EXPECT_GT(dynamics.getLoadPercent(DynamicsStage::Smoother), 0.0f);
+        EXPECT_GT(distortion.getLoadPercent(), distortion.getLoadPercent(DistortionStage::Mixing));
+    } else {
+        EXPECT_EQ(reverb.getLoadPercent(), 0.0f);
+        EXPECT_EQ(distortion.getLoadPercent(), 0.0f);
+        EXPECT_EQ(dynamics.getLoadPercent(), 0.0f);
+    }
+}
+
+TEST(DspLoadTest, StagedDynamicsBlockMatchesPerSampleProcessing) {
+    // The block path runs detector, computer and smoother chunk by chunk; results must not change
+    AudioBuffer<float> input(numChannels, numSamples), blockOut(numChannels, numSamples);
+    fillInput(input);
+    models::CompressorRMSFeedforward<float> block(numChannels, sampleRate), perSample(numChannels, sampleRate);
+    for (auto* stage : {&block, &perSample}) {
+        stage->setThreshold(-20.0f, true);
+        stage->setRatio(4.0f, true);
+    }
+
+    float gainReduction[numChannels];
+    block.processBlock(input.readPtrs(), input.readPtrs(), blockOut.writePtrs(), numSamples, gainReduction);
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        float minGain = 1.0f;
+        for (size_t n = 0; n < numSamples; ++n) {
+            const float x = input.readChannelPtr(ch)[n];
+            const float y = perSample.processSample(ch, x, x);
+            ASSERT_EQ(blockOut.readChannelPtr(ch)[n], y) << ch << " " << n;
+            if (x != 0.0f)
+                minGain = std::min(minGain, y / x);
+        }
+        EXPECT_NEAR(gainReduction[ch], minGain, 1e-4f);
+    }
+}
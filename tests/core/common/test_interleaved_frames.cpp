@@ -0,0 +1,137 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the interleaved-frame processBlock overloads
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/dsp_param.h>
+#include <jonssonic/core/dynamics/envelope_follower.h>
+#include <jonssonic/core/filters/biquad_bank.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/core/filters/one_pole_filter.h>
+#include <jonssonic/core/filters/state_variable_filter.h>
+#include <jonssonic/core/mixing/dry_wet_mixer.h>
+#include <jonssonic/core/nonlinear/wave_shaper_processor.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 3;
+constexpr size_t numFrames = 257;
+constexpr float sampleRate = 48000.0f;
+
+struct Signals {
+    AudioBuffer<float> planarIn, planarOut;
+    std::vector<float> interleavedIn, interleavedOut;
+
+    explicit Signals(float phase = 0.0f)
+        : planarIn(numChannels, numFrames), planarOut(numChannels, numFrames),
+          interleavedIn(numChannels * numFrames), interleavedOut(numChannels * numFrames) {
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t n = 0; n < numFrames; ++n) {
+                const float x = 0.7f * std::sin(0.07f * float(n) * float(ch + 1) + phase);
+                planarIn.writeChannelPtr(ch)[n] = x;
+                interleavedIn[n * numChannels + ch] = x;
+            }
+        }
+    }
+
+    void expectEqual() const {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numFrames; ++n)
+                ASSERT_EQ(interleavedOut[n * numChannels + ch], planarOut.readChannelPtr(ch)[n]) << ch << " " << n;
+    }
+};
+
+/// Run the planar and interleaved paths on twin processors for two blocks and compare
+template <typename Processor, typename Setup>
+void expectInterleavedMatchesPlanar(Setup setup) {
+    Processor planar(numChannels, sampleRate), interleaved(numChannels, sampleRate);
+    setup(planar);
+    setup(interleaved);
+    Signals signals;
+    for (int block = 0; block < 2; ++block) {
+        planar.processBlock(signals.planarIn.readPtrs(), signals.planarOut.writePtrs(), numFrames);
+        interleaved.processBlock(signals.interleavedIn.data(), signals.interleavedOut.data(), numFrames);
+        signals.expectEqual();
+    }
+}
+} // namespace
+
+TEST(InterleavedFramesTest, FiltersMatchPlanar) {
+    expectInterleavedMatchesPlanar<BiquadFilter<float>>([](auto& f) {
+        f.setResponse(BiquadFilter<float>::Response::Lowpass);
+        f.setFrequency(Frequency<float>::Hertz(1500.0f));
+    });
+    expectInterleavedMatchesPlanar<StateVariableFilter<float>>(
+        [](auto& f) { f.setFrequency(Frequency<float>::Hertz(800.0f)); });
+    expectInterleavedMatchesPlanar<OnePoleFilter<float>>(
+        [](auto& f) { f.setFrequency(Frequency<float>::Hertz(300.0f)); });
+}
+
+TEST(InterleavedFramesTest, ShapersAndFollowersMatchPlanar) {
+    expectInterleavedMatchesPlanar<WaveShaperProcessor<float, WaveShaperType::Tanh>>(
+        [](auto& s) { s.setInputGain(Gain<float>::Decibels(12.0f), true); });
+    expectInterleavedMatchesPlanar<EnvelopeFollower<float, EnvelopeType::Peak>>([](auto&) {});
+    expectInterleavedMatchesPlanar<EnvelopeFollower<float, EnvelopeType::RMS>>([](auto&) {});
+}
+
+TEST(InterleavedFramesTest, ActiveChannelsLeaveTheRestOfTheFrame) {
+    BiquadFilter<float> filter(numChannels, sampleRate);
+    filter.setActiveChannels(1);
+    Signals signals;
+    filter.processBlock(signals.interleavedIn.data(), signals.interleavedIn.data(), numFrames);
+    const Signals reference;
+    for (size_t n = 0; n < numFrames; ++n)
+        for (size_t ch = 1; ch < numChannels; ++ch)
+            ASSERT_EQ(signals.interleavedIn[n * numChannels + ch], reference.interleavedIn[n * numChannels + ch]);
+}
+
+TEST(InterleavedFramesTest, GainAndMixMatchPlanar) {
+    DspParam<float> planarGain, interleavedGain;
+    DryWetMixer<float> planarMixer, interleavedMixer;
+    for (auto* gain : {&planarGain, &interleavedGain}) {
+        gain->prepare(numChannels, sampleRate);
+        gain->setTarget(0.5f, true);
+        gain->setTarget(2.0f);
+    }
+    for (auto* mixer : {&planarMixer, &interleavedMixer}) {
+        mixer->prepare(numChannels, sampleRate, 8);
+        mixer->setMix(0.2f, true);
+        mixer->setMix(0.9f);
+    }
+
+    Signals signals, wet(1.0f);
+    for (int block = 0; block < 2; ++block) {
+        planarMixer.processBlock(
+            signals.planarIn.readPtrs(), wet.planarIn.readPtrs(), signals.planarOut.writePtrs(), numFrames, 5);
+        interleavedMixer.processBlock(
+            signals.interleavedIn.data(), wet.interleavedIn.data(), signals.interleavedOut.data(), numFrames, 5);
+        planarGain.applyToBuffer(signals.planarOut.writePtrs(), numFrames);
+        interleavedGain.applyToInterleaved(signals.interleavedOut.data(), numFrames, numChannels);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const float* planarOut = signals.planarOut.readChannelPtr(ch);
+            for (size_t n = 0; n < numFrames; ++n)
+                ASSERT_NEAR(signals.interleavedOut[n * numChannels + ch], planarOut[n], 1e-6f)
+                    << block << " " << ch << " " << n;
+        }
+    }
+}
+
+TEST(InterleavedFramesTest, BiquadBankFiltersFramesInPlace) {
+    BiquadBank<float> planar(numChannels, 64, 2), interleaved(numChannels, 64, 2);
+    for (auto* bank : {&planar, &interleaved}) {
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            bank->setCoeffs(ch, 0, 0.2f, 0.4f, 0.2f, -0.5f, 0.3f * float(ch) / float(numChannels));
+            bank->setCoeffs(ch, 1, 0.9f, -0.1f, 0.05f, 0.1f, 0.0f);
+        }
+    }
+    Signals signals;
+    for (int block = 0; block < 2; ++block) {
+        planar.processBlock(signals.planarIn.readPtrs(), signals.planarOut.writePtrs(), numFrames);
+        interleaved.processBlock(signals.interleavedIn.data(), signals.interleavedOut.data(), numFrames);
+        signals.expectEqual();
+    }
+}
@@ -0,0 +1,132 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the block-based modulation matrix
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/modulation_matrix.h>
+#include <jonssonic/core/delays/comb_filter.h>
+#include <jonssonic/core/dynamics/envelope_follower.h>
+#include <jonssonic/core/generators/oscillator.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t NUM_CHANNELS = 2;
+constexpr size_t BLOCK_SIZE = 37;
+
+// Ramp generator that counts how often it is rendered
+struct CountingRamp {
+    size_t numRenders = 0;
+    void processBlock(float* const* output, size_t numSamples) {
+        ++numRenders;
+        for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] = float(n) + 100.0f * float(ch);
+    }
+};
+} // namespace
+
+TEST(ModulationMatrixTest, SourcesRenderOncePerBlock) {
+    ModulationMatrix<float> matrix(NUM_CHANNELS, BLOCK_SIZE);
+    CountingRamp ramp;
+    const size_t source = matrix.addSource(ramp);
+    const size_t a = matrix.addDestination(1.0f);
+    const size_t b = matrix.addDestination();
+    const size_t c = matrix.addDestination(-2.0f);
+    matrix.connect(source, a, 0.5f);
+    matrix.connect(source, b, -1.0f);
+    matrix.connect(source, c, 2.0f);
+
+    matrix.process(BLOCK_SIZE);
+    EXPECT_EQ(ramp.numRenders, 1u);
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+        for (size_t n = 0; n < BLOCK_SIZE; ++n) {
+            const float x = float(n) + 100.0f * float(ch);
+            ASSERT_FLOAT_EQ(matrix.getDestination(a)[ch][n], 1.0f + 0.5f * x);
+            ASSERT_FLOAT_EQ(matrix.getDestination(b)[ch][n], -x);
+            ASSERT_FLOAT_EQ(matrix.getDestination(c)[ch][n], -2.0f + 2.0f * x);
+        }
+}
+
+TEST(ModulationMatrixTest, SumsSourcesAndUpdatesDepth) {
+    ModulationMatrix<float> matrix(NUM_CHANNELS, BLOCK_SIZE);
+    CountingRamp ramp;
+    std::vector<std::vector<float>> host(NUM_CHANNELS, std::vector<float>(BLOCK_SIZE, 3.0f));
+    const float* hostPtrs[] = {host[0].data(), host[1].data()};
+
+    const size_t rampSource = matrix.addSource(ramp);
+    const size_t hostSource = matrix.addExternalSource();
+    const size_t dest = matrix.addDestination(0.25f);
+    matrix.connect(rampSource, dest, 1.0f);
+    matrix.connect(hostSource, dest, 0.5f);
+
+    matrix.setExternalSource(hostSource, hostPtrs);
+    matrix.process(BLOCK_SIZE);
+    EXPECT_EQ(matrix.getSource(hostSource), hostPtrs);
+    EXPECT_FLOAT_EQ(matrix.getDestination(dest)[1][4], 0.25f + 104.0f + 1.5f);
+
+    // Reconnecting updates the depth instead of adding a second route
+    matrix.connect(hostSource, dest, 0.0f);
+    matrix.setDepth(rampSource, dest, 2.0f);
+    matrix.setDestinationBase(dest, 0.0f);
+    EXPECT_EQ(matrix.getNumRoutes(), 2u);
+    matrix.process(BLOCK_SIZE);
+    EXPECT_FLOAT_EQ(matrix.getDestination(dest)[1][4], 208.0f);
+}
+
+TEST(ModulationMatrixTest, LfoMatchesDirectRenderingOnEveryIsa) {
+    for (int i = 0; i <= static_cast<int>(getDetectedSimdIsa()); ++i) {
+        setForcedSimdIsa(static_cast<SimdIsa>(i));
+        Oscillator<float> lfo(NUM_CHANNELS, 48000.0f), reference(NUM_CHANNELS, 48000.0f);
+        lfo.setFrequency(Frequency<float>::Hertz(3.0f), true);
+        reference.setFrequency(Frequency<float>::Hertz(3.0f), true);
+
+        ModulationMatrix<float> matrix(NUM_CHANNELS, BLOCK_SIZE);
+        const size_t dest = matrix.addDestination(0.5f);
+        matrix.connect(matrix.addSource(lfo), dest, 0.5f);
+        matrix.process(BLOCK_SIZE);
+
+        std::vector<std::vector<float>> expected(NUM_CHANNELS, std::vector<float>(BLOCK_SIZE));
+        float* expectedPtrs[] = {expected[0].data(), expected[1].data()};
+        reference.processBlock(expectedPtrs, BLOCK_SIZE);
+        for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+            for (size_t n = 0; n < BLOCK_SIZE; ++n)
+                ASSERT_EQ(matrix.getDestination(dest)[ch][n], 0.5f + 0.5f * expected[ch][n]);
+    }
+    clearForcedSimdIsa();
+}
+
+TEST(ModulationMatrixTest, EnvelopeFollowerDrivesCombFilterBlockModulation) {
+    constexpr float sampleRate = 48000.0f;
+    EnvelopeFollower<float, EnvelopeType::Peak> follower(NUM_CHANNELS, sampleRate);
+    follower.setAttackTime(Time<float>::Milliseconds(0.1f), true);
+    follower.setReleaseTime(Time<float>::Milliseconds(50.0f), true);
+    CombFilter<float> comb(NUM_CHANNELS, sampleRate, Time<float>::Milliseconds(10.0f));
+    comb.setDelay(Time<float>::Samples(8.0f), true);
+
+    ModulationMatrix<float> matrix(NUM_CHANNELS, BLOCK_SIZE);
+    const size_t envelope = matrix.addSource(follower);
+    const size_t delay = matrix.addDestination(8.0f);
+    const size_t unity = matrix.addDestination(1.0f);
+    matrix.connect(envelope, delay, 4.0f);
+
+    std::vector<std::vector<float>> input(NUM_CHANNELS, std::vector<float>(BLOCK_SIZE, 0.5f));
+    std::vector<std::vector<float>> output(NUM_CHANNELS, std::vector<float>(BLOCK_SIZE));
+    const float* in[] = {input[0].data(), input[1].data()};
+    float* out[] = {output[0].data(), output[1].data()};
+    matrix.process(in, BLOCK_SIZE);
+
+    // The envelope rises towards the input level, so the modulated delay grows above its base
+    EXPECT_GT(matrix.getDestination(delay)[0][BLOCK_SIZE - 1], 8.0f);
+    EXPECT_LE(matrix.getDestination(delay)[0][BLOCK_SIZE - 1], 8.0f + 4.0f * 0.5f + 1e-4f);
+
+    CombMod::Block<float> mod;
+    mod.delayMod = matrix.getDestination(delay);
+    mod.feedbackMod = matrix.getDestination(unity);
+    mod.feedforwardMod = matrix.getDestination(unity);
+    comb.processBlock(in, out, mod, BLOCK_SIZE);
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+        for (size_t n = 0; n < BLOCK_SIZE; ++n)
+            ASSERT_TRUE(std::isfinite(output[ch][n]));
+}
@@ -0,0 +1,134 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the accumulating processBlockAdding variants
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/delays/allpass_filter.h>
+#include <jonssonic/core/delays/comb_filter.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/core/nonlinear/wave_shaper_processor.h>
+#include <jonssonic/effects/chorus.h>
+#include <jonssonic/effects/compressor.h>
+#include <jonssonic/effects/delay.h>
+#include <jonssonic/effects/distortion.h>
+#include <jonssonic/effects/reverb.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 2;
+constexpr size_t numSamples = 700; // Spans several internal chunks of the effects
+constexpr float sampleRate = 48000.0f;
+constexpr float sendGain = 0.3f;
+
+/**
+ * Render the same input through two identically configured processors: one replaces a scratch buffer that is
+ * then summed into a bus, the other accumulates into an identical bus directly. The buses must match.
+ */
+template <typename ProcessFn, typename AddFn>
+void expectAddingMatchesReplacing(ProcessFn process, AddFn add, float tolerance = 1e-6f) {
+    std::vector<std::vector<float>> input(numChannels, std::vector<float>(numSamples));
+    std::vector<std::vector<float>> scratch = input, expected = input, actual = input;
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        for (size_t n = 0; n < numSamples; ++n) {
+            input[ch][n] = 0.5f * std::sin(0.05f * float(n) + float(ch));
+            expected[ch][n] = actual[ch][n] = 0.25f * std::cos(0.01f * float(n));
+        }
+    }
+    const float* inPtrs[] = {input[0].data(), input[1].data()};
+    float* scratchPtrs[] = {scratch[0].data(), scratch[1].data()};
+    float* actualPtrs[] = {actual[0].data(), actual[1].data()};
+
+    // Two blocks, so that state carried between blocks is covered as well
+    for (size_t block = 0; block < 2; ++block) {
+        process(inPtrs, scratchPtrs);
+        add(inPtrs, actualPtrs);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t n = 0; n < numSamples; ++n) {
+                expected[ch][n] += sendGain * scratch[ch][n];
+                ASSERT_NEAR(actual[ch][n], expected[ch][n], tolerance) << block << " " << ch << " " << n;
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(OutputModeTest, StoreOutputReplacesOrAccumulates) {
+    float out = 1.0f;
+    detail::storeOutput<OutputMode::Replace>(out, 2.0f, 0.5f);
+    EXPECT_EQ(out, 2.0f);
+    detail::storeOutput<OutputMode::Add>(out, 2.0f, 0.5f);
+    EXPECT_EQ(out, 3.0f);
+}
+
+TEST(OutputModeTest, CoreProcessorsAccumulateIntoBus) {
+    {
+        BiquadFilter<float> a(numChannels, sampleRate), b(numChannels, sampleRate);
+        for (auto* f : {&a, &b}) {
+            f->setResponse(BiquadFilter<float>::Response::Lowpass);
+            f->setFrequency(Frequency<float>::Hertz(2000.0f));
+        }
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+    {
+        CombFilter<float> a(numChannels, sampleRate, Time<float>::Milliseconds(10.0f));
+        CombFilter<float> b(numChannels, sampleRate, Time<float>::Milliseconds(10.0f));
+        for (auto* f : {&a, &b}) {
+            f->setDelay(Time<float>::Samples(37.0f), true);
+            f->setFeedbackGain(Gain<float>::Linear(0.6f), true);
+        }
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+    {
+        AllpassFilter<float> a(numChannels, sampleRate, Time<float>::Milliseconds(10.0f));
+        AllpassFilter<float> b(numChannels, sampleRate, Time<float>::Milliseconds(10.0f));
+        for (auto* f : {&a, &b}) {
+            f->setDelay(Time<float>::Samples(23.0f), true);
+            f->setGain(Gain<float>::Linear(0.5f), true);
+        }
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+    {
+        WaveShaperProcessor<float, WaveShaperType::Tanh> a(numChannels, sampleRate), b(numChannels, sampleRate);
+        for (auto* f : {&a, &b})
+            f->setInputGain(Gain<float>::Decibels(12.0f), true);
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+}
+
+TEST(OutputModeTest, EffectsAccumulateIntoBus) {
+    {
+        effects::Chorus<float> a(numChannels, sampleRate), b(numChannels, sampleRate);
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+    {
+        effects::Delay<float> a(numChannels, numSamples, sampleRate), b(numChannels, numSamples, sampleRate);
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+    {
+        effects::Reverb<float> a(numChannels, sampleRate), b(numChannels, sampleRate);
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+    {
+        effects::Compressor<float> a(numChannels, sampleRate), b(numChannels, sampleRate);
+        a.setThreshold(-20.0f, true);
+        b.setThreshold(-20.0f, true);
+        expectAddingMatchesReplacing(
+            [&](auto in, auto out) { a.processBlock(in, in, out, numSamples); },
+            [&](auto in, auto out) { b.processBlockAdding(in, in, out, numSamples, sendGain); });
+    }
+    {
+        effects::Distortion<float> a(numChannels, numSamples, sampleRate), b(numChannels, numSamples, sampleRate);
+        expectAddingMatchesReplacing([&](auto in, auto out) { a.processBlock(in, out, numSamples); },
+                                     [&](auto in, auto out) { b.processBlockAdding(in, out, numSamples, sendGain); });
+    }
+}
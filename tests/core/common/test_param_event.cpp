@@ -0,0 +1,134 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for sample-accurate parameter events
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/param_event.h>
+#include <jonssonic/effects/equalizer.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+// Records sub-blocks and applied parameters; output is the current gain times input
+struct RecordingProcessor {
+    enum class Param : uint32_t { Gain, Offset };
+
+    float gain = 1.0f;
+    float offset = 0.0f;
+    std::vector<size_t> subBlockSizes;
+    std::vector<Param> applied;
+    size_t numUpdates = 0;
+    OffsetChannelPtrs<const float> subBlockIn;
+    OffsetChannelPtrs<float> subBlockOut;
+
+    RecordingProcessor() {
+        subBlockIn.resize(1);
+        subBlockOut.resize(1);
+    }
+
+    void setParam(Param param, float value, bool /*skipSmoothing*/) {
+        applied.push_back(param);
+        (param == Param::Gain ? gain : offset) = value;
+    }
+    void beginParamUpdate() {}
+    void endParamUpdate() { ++numUpdates; }
+
+    void processBlock(const float* const* input, float* const* output, size_t numSamples) {
+        subBlockSizes.push_back(numSamples);
+        for (size_t n = 0; n < numSamples; ++n)
+            output[0][n] = gain * input[0][n] + offset;
+    }
+};
+
+ParamEvent event(size_t offset, RecordingProcessor::Param param, double value) {
+    return {offset, static_cast<uint32_t>(param), value, false};
+}
+} // namespace
+
+TEST(ParamEventTest, SplitsAtEventOffsets) {
+    RecordingProcessor processor;
+    std::vector<float> input(128, 1.0f), output(128, 0.0f);
+    const float* in[] = {input.data()};
+    float* out[] = {output.data()};
+    const ParamEvent events[] = {event(32, RecordingProcessor::Param::Gain, 2.0),
+                                 event(100, RecordingProcessor::Param::Gain, 3.0)};
+
+    processBlockWithParamEvents(processor, in, out, 1, 128, events, 2, processor.subBlockIn, processor.subBlockOut);
+
+    EXPECT_EQ(processor.subBlockSizes, (std::vector<size_t>{32, 68, 28}));
+    EXPECT_FLOAT_EQ(output[31], 1.0f);
+    EXPECT_FLOAT_EQ(output[32], 2.0f);
+    EXPECT_FLOAT_EQ(output[99], 2.0f);
+    EXPECT_FLOAT_EQ(output[100], 3.0f);
+}
+
+TEST(ParamEventTest, CloseEventsAreDeferredAndCoalesced) {
+    RecordingProcessor processor;
+    std::vector<float> input(64, 1.0f), output(64, 0.0f);
+    const float* in[] = {input.data()};
+    float* out[] = {output.data()};
+    // Offsets 0, 4 and 9 are all closer than the minimum sub-block size of 16
+    const ParamEvent events[] = {event(0, RecordingProcessor::Param::Gain, 2.0),
+                                 event(4, RecordingProcessor::Param::Offset, 0.5),
+                                 event(9, RecordingProcessor::Param::Gain, 4.0),
+                                 event(9, RecordingProcessor::Param::Gain, 5.0)};
+
+    processBlockWithParamEvents(
+        processor, in, out, 1, 64, events, 4, processor.subBlockIn, processor.subBlockOut, 16);
+
+    EXPECT_EQ(processor.subBlockSizes, (std::vector<size_t>{16, 48}));
+    EXPECT_FLOAT_EQ(output[0], 2.0f);
+    EXPECT_FLOAT_EQ(output[16], 5.5f);
+    // One update per split; the superseded gain at offset 9 is never applied
+    EXPECT_EQ(processor.numUpdates, 2u);
+    EXPECT_EQ(processor.applied,
+              (std::vector<RecordingProcessor::Param>{
+                  RecordingProcessor::Param::Gain, RecordingProcessor::Param::Offset, RecordingProcessor::Param::Gain}));
+}
+
+TEST(ParamEventTest, EventsPastTheBlockApplyAfterwards) {
+    RecordingProcessor processor;
+    std::vector<float> input(32, 1.0f), output(32, 0.0f);
+    const float* in[] = {input.data()};
+    float* out[] = {output.data()};
+    const ParamEvent events[] = {event(40, RecordingProcessor::Param::Gain, 2.0)};
+
+    processBlockWithParamEvents(processor, in, out, 1, 32, events, 1, processor.subBlockIn, processor.subBlockOut);
+
+    EXPECT_EQ(processor.subBlockSizes, (std::vector<size_t>{32}));
+    EXPECT_FLOAT_EQ(output[31], 1.0f);
+    EXPECT_FLOAT_EQ(processor.gain, 2.0f);
+}
+
+TEST(ParamEventTest, EqualizerMatchesHostSplitBlocks) {
+    using Eq = effects::Equalizer<float>;
+    constexpr size_t numSamples = 256;
+    constexpr size_t split = 100;
+    Eq automated(2, numSamples, 48000.0f), reference(2, numSamples, 48000.0f);
+
+    std::vector<std::vector<float>> input(2, std::vector<float>(numSamples));
+    for (size_t n = 0; n < numSamples; ++n)
+        input[0][n] = input[1][n] = (n % 7 == 0) ? 1.0f : -0.25f;
+    std::vector<std::vector<float>> expected = input, actual = input;
+
+    // Reference: the host splits the block itself
+    const float* refIn[] = {input[0].data(), input[1].data()};
+    float* refOut[] = {expected[0].data(), expected[1].data()};
+    reference.processBlock(refIn, refOut, split);
+    reference.setLowMidFreq(400.0f, true);
+    reference.setLowMidGainDb(6.0f, true);
+    const float* refIn2[] = {input[0].data() + split, input[1].data() + split};
+    float* refOut2[] = {expected[0].data() + split, expected[1].data() + split};
+    reference.processBlock(refIn2, refOut2, numSamples - split);
+
+    const ParamEvent events[] = {{split, static_cast<uint32_t>(Eq::Param::LowMidFreq), 400.0, true},
+                                 {split, static_cast<uint32_t>(Eq::Param::LowMidGainDb), 6.0, true}};
+    const float* in[] = {input[0].data(), input[1].data()};
+    float* out[] = {actual[0].data(), actual[1].data()};
+    automated.processBlock(in, out, numSamples, events, 2);
+
+    for (size_t ch = 0; ch < 2; ++ch)
+        for (size_t n = 0; n < numSamples; ++n)
+            ASSERT_FLOAT_EQ(actual[ch][n], expected[ch][n]) << "ch " << ch << " n " << n;
+}
@@ -0,0 +1,191 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the ProbePoint class
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/probe_point.h>
+#include <jonssonic/core/common/channel_groups.h>
+#include <jonssonic/effects/reverb.h>
+#include <jonssonic/models/saturation/saturation_stage.h>
+#include <thread>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 2;
+constexpr size_t blockSize = 64;
+
+// Fill a block with a ramp continuing from position, channel ch offset by 0.5 * ch
+void fillRamp(AudioBuffer<float>& block, size_t position) {
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < blockSize; ++n)
+            block.writeChannelPtr(ch)[n] = static_cast<float>((position + n) % 1000000) + 0.5f * float(ch);
+}
+} // namespace
+
+TEST(ProbePointTest, DisarmedProbeCapturesNothing) {
+    ProbePoint<float> probe;
+    probe.prepare(numChannels, 32);
+    AudioBuffer<float> block(numChannels, blockSize);
+    for (size_t b = 0; b < 8; ++b) {
+        fillRamp(block, b * blockSize);
+        probe.tap(block.readPtrs(), blockSize);
+    }
+    ProbeFrame<float> frame;
+    EXPECT_FALSE(probe.isArmed());
+    EXPECT_EQ(probe.getNumFrames(), 0u);
+    EXPECT_FALSE(probe.readLatest(frame));
+}
+
+TEST(ProbePointTest, DecimatedFramesFollowTheStream) {
+    ProbePoint<float> probe;
+    probe.prepare(numChannels, 32);
+    ProbeSettings<float> settings;
+    settings.frameSize = 20;
+    settings.decimation = 3;
+    settings.numChannels = 2;
+    probe.arm(settings);
+
+    AudioBuffer<float> block(numChannels, blockSize);
+    ProbeFrame<float> frame;
+    for (size_t b = 0; b < 4; ++b) {
+        fillRamp(block, b * blockSize);
+        probe.tap(block.readPtrs(), blockSize);
+    }
+    // 256 samples decimated by 3 make 86 kept samples, i.e. 4 complete frames of 20
+    EXPECT_EQ(probe.getNumFrames(), 4u);
+    ASSERT_TRUE(probe.readLatest(frame));
+    EXPECT_EQ(frame.number, 4u);
+    EXPECT_EQ(frame.startSample, 3u * 20u * 3u);
+    EXPECT_EQ(frame.decimation, 3u);
+    ASSERT_EQ(frame.samples.size(), 2u);
+    ASSERT_EQ(frame.samples[1].size(), 20u);
+    for (size_t n = 0; n < 20; ++n) {
+        EXPECT_FLOAT_EQ(frame.samples[0][n], static_cast<float>(frame.startSample + 3 * n));
+        EXPECT_FLOAT_EQ(frame.samples[1][n], static_cast<float>(frame.startSample + 3 * n) + 0.5f);
+    }
+
+    // Nothing newer until the next frame completes
+    EXPECT_FALSE(probe.readLatest(frame));
+    probe.disarm();
+    probe.tap(block.readPtrs(), blockSize);
+    EXPECT_FALSE(probe.readLatest(frame));
+}
+
+TEST(ProbePointTest, TriggeredFramesStartAtRisingCrossings) {
+    ProbePoint<float> probe;
+    probe.prepare(1, 64);
+    ProbeSettings<float> settings;
+    settings.mode = ProbeMode::Triggered;
+    settings.frameSize = 16;
+    settings.triggerLevel = 0.0f;
+    probe.arm(settings);
+
+    // Period of 100 samples, rising zero crossings between samples 74 and 75 (mod 100)
+    constexpr size_t length = 1024;
+    std::vector<float> signal(length);
+    for (size_t n = 0; n < length; ++n)
+        signal[n] = std::cos(2.0f * 3.14159265f * (static_cast<float>(n) + 0.5f) / 100.0f);
+    for (size_t pos = 0; pos < length; pos += blockSize) {
+        const float* ptr = signal.data() + pos;
+        probe.tap(&ptr, blockSize);
+    }
+
+    ProbeFrame<float> frame;
+    ASSERT_TRUE(probe.readLatest(frame));
+    EXPECT_GT(frame.number, 5u);
+    EXPECT_EQ(frame.startSample % 100, 75u);
+    EXPECT_GE(frame.samples[0][0], 0.0f);
+    EXPECT_LT(signal[frame.startSample - 1], 0.0f);
+}
+
+TEST(ProbePointTest, ReaderGetsConsistentFramesWhileAudioRuns) {
+    ProbePoint<float> probe;
+    probe.prepare(numChannels, 256);
+    ProbeSettings<float> settings;
+    settings.frameSize = 256;
+    settings.numChannels = 2;
+    probe.arm(settings);
+
+    std::atomic<bool> running{true};
+    std::thread audio([&] {
+        AudioBuffer<float> block(numChannels, blockSize);
+        for (size_t b = 0; running.load(std::memory_order_relaxed); ++b) {
+            fillRamp(block, b * blockSize);
+            probe.tap(block.readPtrs(), blockSize);
+        }
+    });
+
+    ProbeFrame<float> frame;
+    size_t framesRead = 0;
+    while (framesRead < 200) {
+        if (!probe.readLatest(frame))
+            continue;
+        ++framesRead;
+        // A torn frame would mix samples from two laps of the ring
+        for (size_t n = 0; n < frame.samples[0].size(); ++n) {
+            const auto expected = static_cast<float>((frame.startSample + n) % 1000000);
+            ASSERT_FLOAT_EQ(frame.samples[0][n], expected);
+            ASSERT_FLOAT_EQ(frame.samples[1][n], expected + 0.5f);
+        }
+    }
+    running = false;
+    audio.join();
+}
+
+TEST(ProbePointTest, RangesWithoutCapturedChannelsDoNotAdvanceTheStream) {
+    // A processor working in channel groups taps every group of a block
+    constexpr size_t numGroupChannels = 24;
+    constexpr size_t groupBlockSize = 512;
+    constexpr size_t oversampling = 4;
+    using Saturation = models::SaturationStage<float, WaveShaperType::Tanh, false, false, oversampling>;
+    ASSERT_LT(channelGroupSize<float>(groupBlockSize * oversampling), numGroupChannels / 2);
+
+    Saturation stage;
+    stage.prepare(numGroupChannels, groupBlockSize, 48000.0f);
+    auto& probe = stage.getShaperProbe();
+    ProbeSettings<float> settings;
+    settings.frameSize = 256;
+    settings.firstChannel = numGroupChannels - 1; // In the last group
+    probe.arm(settings);
+
+    AudioBuffer<float> input(numGroupChannels, groupBlockSize), output(numGroupChannels, groupBlockSize);
+    constexpr size_t numBlocks = 3;
+    for (size_t b = 0; b < numBlocks; ++b)
+        stage.processBlock(input.readPtrs(), output.writePtrs(), groupBlockSize);
+
+    // Frames follow the oversampled stream of one channel, not of every group
+    constexpr size_t numFrames = numBlocks * groupBlockSize * oversampling / 256;
+    EXPECT_EQ(probe.getNumFrames(), numFrames);
+    ProbeFrame<float> frame;
+    ASSERT_TRUE(probe.readLatest(frame));
+    EXPECT_EQ(frame.number, numFrames);
+    EXPECT_EQ(frame.startSample, (numFrames - 1) * 256u);
+}
+
+TEST(ProbePointTest, ReverbExposesFdnOutput) {
+    effects::Reverb<float> reverb(numChannels, 48000.0f);
+    auto& probe = reverb.getProbe(effects::Reverb<float>::Probe::FDN);
+    ProbeSettings<float> settings;
+    settings.frameSize = 128;
+    probe.arm(settings);
+
+    AudioBuffer<float> input(numChannels, blockSize);
+    AudioBuffer<float> output(numChannels, blockSize);
+    input.writeChannelPtr(0)[0] = 1.0f;
+    float energy = 0.0f;
+    ProbeFrame<float> frame;
+    for (size_t b = 0; b < 200; ++b) {
+        reverb.processBlock(input.readPtrs(), output.writePtrs(), blockSize);
+        input.clear();
+        if (probe.readLatest(frame))
+            for (float x : frame.samples[0])
+                energy += x * x;
+    }
+    EXPECT_EQ(probe.getNumFrames(), 200u * blockSize / 128u);
+    EXPECT_GT(energy, 0.0f);
+}
@@ -0,0 +1,193 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for runtime instruction set dispatch
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/core/filters/biquad_bank.h>
+#include <jonssonic/core/filters/detail/df2t_biquad_topology.h>
+#include <jonssonic/core/oversampling/detail/oversampler_filters.h>
+#include <random>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t NUM_CHANNELS = 13;
+constexpr size_t NUM_SAMPLES = 517; // odd sizes exercise the vector loop remainders
+
+// Every instruction set this CPU can run, baseline first
+std::vector<SimdIsa> supportedIsas() {
+    std::vector<SimdIsa> isas;
+    for (int i = 0; i <= static_cast<int>(getDetectedSimdIsa()); ++i)
+        isas.push_back(static_cast<SimdIsa>(i));
+    return isas;
+}
+
+std::vector<std::vector<float>> randomChannels(size_t numChannels, size_t numSamples, float range = 1.0f) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-range, range);
+    std::vector<std::vector<float>> data(numChannels, std::vector<float>(numSamples));
+    for (auto& ch : data)
+        for (auto& x : ch)
+            x = dist(rng);
+    return data;
+}
+
+std::vector<const float*> readPtrs(const std::vector<std::vector<float>>& buffer) {
+    std::vector<const float*> ptrs;
+    for (const auto& ch : buffer)
+        ptrs.push_back(ch.data());
+    return ptrs;
+}
+
+std::vector<float*> writePtrs(std::vector<std::vector<float>>& buffer) {
+    std::vector<float*> ptrs;
+    for (auto& ch : buffer)
+        ptrs.push_back(ch.data());
+    return ptrs;
+}
+
+// Kernels are compiled without FMA contraction, so every build must match the baseline bit for bit
+void expectBitExact(const std::vector<std::vector<float>>& actual, const std::vector<std::vector<float>>& expected) {
+    for (size_t ch = 0; ch < expected.size(); ++ch)
+        for (size_t n = 0; n < expected[ch].size(); ++n)
+            ASSERT_EQ(actual[ch][n], expected[ch][n]) << "ch " << ch << " n " << n;
+}
+
+class ScopedForcedIsa {
+  public:
+    explicit ScopedForcedIsa(SimdIsa isa) { setForcedSimdIsa(isa); }
+    ~ScopedForcedIsa() { clearForcedSimdIsa(); }
+};
+} // namespace
+
+TEST(SimdDispatchTest, ForcedIsaOverridesAndIsCapped) {
+    const SimdIsa detected = getDetectedSimdIsa();
+    {
+        ScopedForcedIsa force(SimdIsa::Baseline);
+        EXPECT_EQ(getSimdIsa(), SimdIsa::Baseline);
+        EXPECT_EQ(&getSimdKernels<float>(), &getSimdKernels<float>(SimdIsa::Baseline));
+    }
+    {
+        // Forcing a level the CPU does not support falls back to the detected level
+        ScopedForcedIsa force(SimdIsa::AVX512);
+        EXPECT_EQ(getSimdIsa(), detected);
+    }
+    EXPECT_EQ(getSimdIsa(), detected);
+    EXPECT_STREQ(getSimdIsaName(SimdIsa::AVX2), "avx2");
+}
+
+TEST(SimdDispatchTest, InterleaveRoundTripMatchesBaseline) {
+    auto input = randomChannels(NUM_CHANNELS, NUM_SAMPLES);
+    for (size_t numChannels : {size_t(2), NUM_CHANNELS}) {
+        std::vector<float> reference(numChannels * NUM_SAMPLES);
+        getSimdKernels<float>(SimdIsa::Baseline).interleave(readPtrs(input).data(), reference.data(), numChannels,
+                                                             NUM_SAMPLES);
+        for (size_t n = 0; n < NUM_SAMPLES; ++n)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                ASSERT_EQ(reference[n * numChannels + ch], input[ch][n]);
+
+        for (SimdIsa isa : supportedIsas()) {
+            const auto& kernels = getSimdKernels<float>(isa);
+            std::vector<float> frames(numChannels * NUM_SAMPLES);
+            kernels.interleave(readPtrs(input).data(), frames.data(), numChannels, NUM_SAMPLES);
+            EXPECT_EQ(frames, reference) << getSimdIsaName(isa);
+
+            std::vector<std::vector<float>> output(numChannels, std::vector<float>(NUM_SAMPLES));
+            kernels.deinterleave(frames.data(), writePtrs(output).data(), numChannels, NUM_SAMPLES);
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                EXPECT_EQ(output[ch], input[ch]) << getSimdIsaName(isa);
+        }
+    }
+}
+
+TEST(SimdDispatchTest, WaveShaperKernelsMatchScalar) {
+    auto input = randomChannels(1, NUM_SAMPLES, 2.0f);
+    for (SimdIsa isa : supportedIsas()) {
+        const auto& kernels = getSimdKernels<float>(isa);
+        std::vector<float> hard(NUM_SAMPLES), cubic(NUM_SAMPLES);
+        kernels.hardClip(input[0].data(), hard.data(), NUM_SAMPLES);
+        kernels.cubicClip(input[0].data(), cubic.data(), NUM_SAMPLES);
+        for (size_t n = 0; n < NUM_SAMPLES; ++n) {
+            const float x = input[0][n];
+            ASSERT_EQ(hard[n], std::max(-1.0f, std::min(1.0f, x))) << getSimdIsaName(isa);
+            ASSERT_EQ(cubic[n], x - (1.0f / 3.0f) * x * x * x) << getSimdIsaName(isa);
+        }
+    }
+}
+
+TEST(SimdDispatchTest, GainKernelsMatchScalar) {
+    auto input = randomChannels(2, NUM_SAMPLES);
+    const float startGain = 0.25f, gainStep = 0.001f;
+    for (SimdIsa isa : supportedIsas()) {
+        const auto& kernels = getSimdKernels<float>(isa);
+        std::vector<float> scaled(NUM_SAMPLES), ramped = input[1];
+        kernels.scale(input[0].data(), scaled.data(), 0.5f, NUM_SAMPLES);
+        kernels.rampedAdd(input[0].data(), ramped.data(), startGain, gainStep, NUM_SAMPLES);
+        for (size_t n = 0; n < NUM_SAMPLES; ++n) {
+            const float x = input[0][n];
+            ASSERT_EQ(scaled[n], 0.5f * x) << getSimdIsaName(isa);
+            ASSERT_EQ(ramped[n], input[1][n] + (startGain + float(n) * gainStep) * x) << getSimdIsaName(isa);
+        }
+    }
+}
+
+TEST(SimdDispatchTest, BiquadBankMatchesDF2TTopologyOnEveryIsa) {
+    auto input = randomChannels(NUM_CHANNELS, NUM_SAMPLES);
+    const size_t numSections = 3;
+
+    // Reference: per-channel, per-sample DF2T cascade with distinct coefficients per channel
+    detail::DF2TBiquadTopology<float> reference(NUM_CHANNELS, numSections);
+    auto coeff = [](size_t ch, size_t s, size_t i) { return 0.05f * float(i + 1) + 0.01f * float(ch) - 0.02f * s; };
+    std::vector<std::vector<float>> expected(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+        for (size_t s = 0; s < numSections; ++s)
+            reference.setCoeffs(ch, s, coeff(ch, s, 0), coeff(ch, s, 1), coeff(ch, s, 2), -0.5f, coeff(ch, s, 3));
+        for (size_t n = 0; n < NUM_SAMPLES; ++n) {
+            float y = input[ch][n];
+            for (size_t s = 0; s < numSections; ++s)
+                y = reference.processSample(ch, s, y);
+            expected[ch][n] = y;
+        }
+    }
+
+    for (SimdIsa isa : supportedIsas()) {
+        ScopedForcedIsa force(isa);
+        BiquadBank<float> bank(NUM_CHANNELS, 64, numSections);
+        for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+            for (size_t s = 0; s < numSections; ++s)
+                bank.setCoeffs(ch, s, coeff(ch, s, 0), coeff(ch, s, 1), coeff(ch, s, 2), -0.5f, coeff(ch, s, 3));
+
+        std::vector<std::vector<float>> output(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+        bank.processBlock(readPtrs(input).data(), writePtrs(output).data(), NUM_SAMPLES);
+        SCOPED_TRACE(getSimdIsaName(isa));
+        expectBitExact(output, expected);
+    }
+}
+
+TEST(SimdDispatchTest, HalfbandStageMatchesBaselineOnEveryIsa) {
+    auto input = randomChannels(NUM_CHANNELS, NUM_SAMPLES);
+    std::vector<std::vector<float>> upReference, downReference;
+
+    for (SimdIsa isa : supportedIsas()) {
+        ScopedForcedIsa force(isa);
+        detail::FIRHalfbandStage<float> up, down;
+        up.prepare(NUM_CHANNELS);
+        down.prepare(NUM_CHANNELS);
+
+        std::vector<std::vector<float>> upsampled(NUM_CHANNELS, std::vector<float>(2 * NUM_SAMPLES));
+        std::vector<std::vector<float>> downsampled(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+        up.upsample(readPtrs(input).data(), writePtrs(upsampled).data(), NUM_SAMPLES);
+        down.downsample(readPtrs(upsampled).data(), writePtrs(downsampled).data(), NUM_SAMPLES);
+
+        if (isa == SimdIsa::Baseline) {
+            upReference = upsampled;
+            downReference = downsampled;
+            continue;
+        }
+        SCOPED_TRACE(getSimdIsaName(isa));
+        expectBitExact(upsampled, upReference);
+        expectBitExact(downsampled, downReference);
+    }
+}
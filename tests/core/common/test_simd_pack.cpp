@@ -0,0 +1,240 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for SimdPack and SimdChannelAdapter
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/detail/smoothed_value.h>
+#include <jonssonic/core/common/simd_channel_adapter.h>
+#include <jonssonic/core/common/simd_pack.h>
+#include <jonssonic/core/dynamics/envelope_follower.h>
+#include <jonssonic/core/filters/detail/df2t_biquad_topology.h>
+#include <jonssonic/core/filters/detail/tpt_svf_topology.h>
+#include <jonssonic/core/nonlinear/wave_shaper.h>
+#include <vector>
+
+using namespace jnsc;
+
+using Pack4 = SimdPack<float, 4>;
+using Pack8 = SimdPack<float, 8>;
+
+namespace {
+constexpr size_t NUM_CHANNELS = 6; // not a multiple of the lane count, so the last pack is partially used
+constexpr size_t NUM_SAMPLES = 256;
+
+std::vector<std::vector<float>> makeInput(size_t numChannels, size_t numSamples) {
+    std::vector<std::vector<float>> input(numChannels, std::vector<float>(numSamples));
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < numSamples; ++n)
+            input[ch][n] = 0.8f * std::sin(0.01f * (ch + 1) * n) + 0.1f * std::cos(0.37f * n + ch);
+    return input;
+}
+
+std::vector<const float*> readPtrs(const std::vector<std::vector<float>>& buffer) {
+    std::vector<const float*> ptrs;
+    for (const auto& ch : buffer)
+        ptrs.push_back(ch.data());
+    return ptrs;
+}
+
+std::vector<float*> writePtrs(std::vector<std::vector<float>>& buffer) {
+    std::vector<float*> ptrs;
+    for (auto& ch : buffer)
+        ptrs.push_back(ch.data());
+    return ptrs;
+}
+} // namespace
+
+TEST(SimdPackTest, ArithmeticIsLaneWise) {
+    Pack4 a;
+    Pack4 b;
+    for (size_t i = 0; i < 4; ++i) {
+        a[i] = float(i + 1);
+        b[i] = float(2 * i) - 3.0f;
+    }
+    Pack4 sum = a + b;
+    Pack4 prod = a * b;
+    Pack4 quot = b / a;
+    Pack4 mixed = 2.0f * a - 1;
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_FLOAT_EQ(sum[i], a[i] + b[i]);
+        EXPECT_FLOAT_EQ(prod[i], a[i] * b[i]);
+        EXPECT_FLOAT_EQ(quot[i], b[i] / a[i]);
+        EXPECT_FLOAT_EQ(mixed[i], 2.0f * a[i] - 1.0f);
+    }
+}
+
+TEST(SimdPackTest, ComparisonsReturnNumericMasks) {
+    Pack4 a;
+    for (size_t i = 0; i < 4; ++i)
+        a[i] = float(i) - 1.5f;
+    Pack4 mask = a > Pack4(0);
+    Pack4 selected = select(mask, a, Pack4(0));
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_FLOAT_EQ(mask[i], a[i] > 0.0f ? 1.0f : 0.0f);
+        EXPECT_FLOAT_EQ(selected[i], a[i] > 0.0f ? a[i] : 0.0f);
+    }
+    EXPECT_TRUE(anyOf(mask));
+    EXPECT_FALSE(allOf(mask));
+    EXPECT_TRUE(allOf(a < Pack4(10)));
+    EXPECT_FLOAT_EQ(reduceMax(a), 1.5f);
+}
+
+TEST(SimdPackTest, MathFunctionsMatchScalar) {
+    Pack8 x;
+    for (size_t i = 0; i < 8; ++i)
+        x[i] = -2.0f + 0.5f * float(i);
+    Pack8 t = tanh(x);
+    Pack8 at = atan(x);
+    Pack8 ab = abs(x);
+    Pack8 e = exp(x);
+    Pack8 c = clamp(x, Pack8(-1), Pack8(1));
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_FLOAT_EQ(t[i], std::tanh(x[i]));
+        EXPECT_FLOAT_EQ(at[i], std::atan(x[i]));
+        EXPECT_FLOAT_EQ(ab[i], std::abs(x[i]));
+        EXPECT_FLOAT_EQ(e[i], std::exp(x[i]));
+        EXPECT_FLOAT_EQ(c[i], std::clamp(x[i], -1.0f, 1.0f));
+    }
+}
+
+TEST(SimdChannelAdapterTest, PackUnpackRoundTrip) {
+    auto input = makeInput(NUM_CHANNELS, NUM_SAMPLES);
+    std::vector<std::vector<float>> output(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES, 0.0f));
+
+    SimdChannelAdapter<float, 4> adapter(NUM_CHANNELS, NUM_SAMPLES);
+    EXPECT_EQ(adapter.getNumPacks(), 2u);
+
+    adapter.pack(readPtrs(input).data(), NUM_SAMPLES);
+    const Pack4* const* packs = adapter.readPackPtrs();
+    EXPECT_FLOAT_EQ(packs[1][10][1], input[5][10]);
+    EXPECT_FLOAT_EQ(packs[1][10][3], 0.0f); // unused lane
+
+    adapter.unpack(writePtrs(output).data(), NUM_SAMPLES);
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+        for (size_t n = 0; n < NUM_SAMPLES; ++n)
+            EXPECT_FLOAT_EQ(output[ch][n], input[ch][n]);
+}
+
+TEST(SimdChannelAdapterTest, DF2TBiquadPackMatchesScalar) {
+    auto input = makeInput(NUM_CHANNELS, NUM_SAMPLES);
+    const float b0 = 0.2f, b1 = 0.4f, b2 = 0.2f, a1 = -0.6f, a2 = 0.25f;
+
+    detail::DF2TBiquadTopology<float> scalar(NUM_CHANNELS, 1);
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+        scalar.setCoeffs(ch, 0, b0, b1, b2, a1, a2);
+
+    SimdChannelAdapter<float, 4> adapter(NUM_CHANNELS, NUM_SAMPLES);
+    detail::DF2TBiquadTopology<Pack4> packed(adapter.getNumPacks(), 1);
+    for (size_t p = 0; p < adapter.getNumPacks(); ++p)
+        packed.setCoeffs(p, 0, b0, b1, b2, a1, a2);
+
+    std::vector<std::vector<float>> output(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+    adapter.pack(readPtrs(input).data(), NUM_SAMPLES);
+    Pack4* const* packs = adapter.writePackPtrs();
+    for (size_t p = 0; p < adapter.getNumPacks(); ++p)
+        for (size_t n = 0; n < NUM_SAMPLES; ++n)
+            packs[p][n] = packed.processSample(p, 0, packs[p][n]);
+    adapter.unpack(writePtrs(output).data(), NUM_SAMPLES);
+
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+        for (size_t n = 0; n < NUM_SAMPLES; ++n)
+            EXPECT_NEAR(output[ch][n], scalar.processSample(ch, 0, input[ch][n]), 1e-6f);
+}
+
+TEST(SimdChannelAdapterTest, TPTSVFPackMatchesScalar) {
+    auto input = makeInput(NUM_CHANNELS, NUM_SAMPLES);
+    const float g = 0.3f, twoR = 0.7f;
+
+    detail::TPTSVFTopology<float> scalar(NUM_CHANNELS, 1);
+    SimdChannelAdapter<float, 4> adapter(NUM_CHANNELS, NUM_SAMPLES);
+    detail::TPTSVFTopology<Pack4> packed(adapter.getNumPacks(), 1);
+
+    adapter.pack(readPtrs(input).data(), NUM_SAMPLES);
+    Pack4* const* packs = adapter.writePackPtrs();
+    for (size_t p = 0; p < adapter.getNumPacks(); ++p)
+        for (size_t n = 0; n < NUM_SAMPLES; ++n) {
+            Pack4 hp, bp, lp;
+            packed.processSample(p, 0, packs[p][n], g, twoR, hp, bp, lp);
+            packs[p][n] = lp;
+        }
+    std::vector<std::vector<float>> output(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+    adapter.unpack(writePtrs(output).data(), NUM_SAMPLES);
+
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+        for (size_t n = 0; n < NUM_SAMPLES; ++n) {
+            float hp, bp, lp;
+            scalar.processSample(ch, 0, input[ch][n], g, twoR, hp, bp, lp);
+            EXPECT_NEAR(output[ch][n], lp, 1e-6f);
+        }
+}
+
+TEST(SimdChannelAdapterTest, EnvelopeFollowerPackMatchesScalar) {
+    auto input = makeInput(NUM_CHANNELS, NUM_SAMPLES);
+
+    EnvelopeFollower<float, EnvelopeType::Peak> scalar(NUM_CHANNELS, 48000.0f);
+    scalar.setAttackTime(1.0_ms, true);
+    scalar.setReleaseTime(20.0_ms, true);
+
+    SimdChannelAdapter<float, 4> adapter(NUM_CHANNELS, NUM_SAMPLES);
+    EnvelopeFollower<Pack4, EnvelopeType::Peak> packed(adapter.getNumPacks(), 48000.0f);
+    packed.setAttackTime(Time<Pack4>::Milliseconds(1.0f), true);
+    packed.setReleaseTime(Time<Pack4>::Milliseconds(20.0f), true);
+
+    std::vector<std::vector<float>> expected(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+    std::vector<std::vector<float>> output(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+    scalar.processBlock(readPtrs(input).data(), writePtrs(expected).data(), NUM_SAMPLES);
+    adapter.processBlock(packed, readPtrs(input).data(), writePtrs(output).data(), NUM_SAMPLES);
+
+    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch)
+        for (size_t n = 0; n < NUM_SAMPLES; ++n)
+            EXPECT_NEAR(output[ch][n], expected[ch][n], 1e-5f);
+}
+
+TEST(SimdChannelAdapterTest, WaveShaperPackMatchesScalar) {
+    Pack8 x;
+    for (size_t i = 0; i < 8; ++i)
+        x[i] = -1.75f + 0.5f * float(i);
+
+    WaveShaper<float, WaveShaperType::HardClip> hardClip;
+    WaveShaper<Pack8, WaveShaperType::HardClip> hardClipPacked;
+    WaveShaper<float, WaveShaperType::Atan> atanShaper;
+    WaveShaper<Pack8, WaveShaperType::Atan> atanPacked;
+    WaveShaper<float, WaveShaperType::HalfWaveRectifier> halfWave;
+    WaveShaper<Pack8, WaveShaperType::HalfWaveRectifier> halfWavePacked;
+    WaveShaper<float, WaveShaperType::Dynamic> dynamic;
+    WaveShaper<Pack8, WaveShaperType::Dynamic> dynamicPacked;
+
+    Pack8 hc = hardClipPacked.processSample(x);
+    Pack8 at = atanPacked.processSample(x);
+    Pack8 hw = halfWavePacked.processSample(x);
+    Pack8 dy = dynamicPacked.processSample(x, Pack8(4.0f));
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_FLOAT_EQ(hc[i], hardClip.processSample(x[i]));
+        EXPECT_FLOAT_EQ(at[i], atanShaper.processSample(x[i]));
+        EXPECT_FLOAT_EQ(hw[i], halfWave.processSample(x[i]));
+        EXPECT_FLOAT_EQ(dy[i], dynamic.processSample(x[i], 4.0f));
+    }
+}
+
+TEST(SimdChannelAdapterTest, SmoothedValuePackMatchesScalar) {
+    detail::SmoothedValue<Pack4, SmootherType::OnePole, 2> packed(1, 48000.0f);
+    packed.setTime(Time<Pack4>::Milliseconds(5.0f));
+
+    Pack4 target;
+    for (size_t i = 0; i < 4; ++i)
+        target[i] = float(i);
+    packed.setTarget(0, target);
+
+    detail::SmoothedValue<float, SmootherType::OnePole, 2> lanes[4];
+    for (size_t i = 0; i < 4; ++i) {
+        lanes[i].prepare(1, 48000.0f);
+        lanes[i].setTime(5.0_ms);
+        lanes[i].setTarget(0, target[i]);
+    }
+    for (int n = 0; n < 500; ++n) {
+        Pack4 value = packed.getNextValue(0);
+        for (size_t i = 0; i < 4; ++i)
+            EXPECT_NEAR(value[i], lanes[i].getNextValue(0), 1e-5f);
+    }
+}
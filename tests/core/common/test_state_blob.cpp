@@ -0,0 +1,265 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for processor state snapshots
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/state_blob.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/core/filters/state_variable_filter.h>
+#include <jonssonic/core/generators/noise.h>
+#include <jonssonic/core/graph/processor_chain.h>
+#include <jonssonic/core/mixing/channel_mapper.h>
+#include <jonssonic/effects/chorus.h>
+#include <jonssonic/effects/compressor.h>
+#include <jonssonic/effects/delay.h>
+#include <jonssonic/effects/distortion.h>
+#include <jonssonic/effects/equalizer.h>
+#include <jonssonic/effects/flanger.h>
+#include <jonssonic/effects/reverb.h>
+#include <thread>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 2;
+constexpr size_t numSamples = 512;
+constexpr float sampleRate = 48000.0f;
+
+void fillInput(AudioBuffer<float>& buffer, float phase) {
+    buffer.resize(numChannels, numSamples);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < numSamples; ++n)
+            buffer.writeChannelPtr(ch)[n] = 0.6f * std::sin(0.013f * float(n) * float(ch + 1) + phase);
+}
+
+void expectEqualBuffers(const AudioBuffer<float>& a, const AudioBuffer<float>& b) {
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < numSamples; ++n)
+            ASSERT_EQ(a.readChannelPtr(ch)[n], b.readChannelPtr(ch)[n]) << ch << " " << n;
+}
+
+/**
+ * Warm a processor up, snapshot it, and render the next block three times: straight on, after restoring the
+ * snapshot into the same processor, and after restoring it into a second, freshly prepared processor (as a
+ * segment renderer would). All three renders must match.
+ */
+template <typename Processor, typename Make, typename Process>
+void expectSnapshotContinuesExactly(Make make, Process process) {
+    std::unique_ptr<Processor> processor = make(), twin = make();
+    AudioBuffer<float> warmUp, next, straight(numChannels, numSamples), restored(numChannels, numSamples),
+        segment(numChannels, numSamples);
+    fillInput(warmUp, 0.0f);
+    fillInput(next, 1.0f);
+
+    for (int block = 0; block < 3; ++block)
+        process(*processor, warmUp, straight);
+    StateBlob blob;
+    processor->saveState(blob.clear());
+    const size_t capacity = blob.capacity();
+
+    process(*processor, next, straight);
+    StateReader reader(blob);
+    processor->restoreState(reader);
+    ASSERT_TRUE(reader.fullyRead());
+    process(*processor, next, restored);
+    StateReader twinReader(blob);
+    twin->restoreState(twinReader);
+    ASSERT_TRUE(twinReader.fullyRead());
+    process(*twin, next, segment);
+
+    expectEqualBuffers(straight, restored);
+    expectEqualBuffers(straight, segment);
+
+    // Saving the same layout again reuses the storage
+    processor->saveState(blob.clear());
+    EXPECT_EQ(blob.capacity(), capacity);
+}
+
+auto processInOut = [](auto& p, const AudioBuffer<float>& in, AudioBuffer<float>& out) {
+    p.processBlock(in.readPtrs(), out.writePtrs(), numSamples);
+};
+} // namespace
+
+TEST(StateBlobTest, ValuesAndArraysRoundTrip) {
+    StateBlob blob(64);
+    const std::vector<float> values = {1.0f, 2.0f, 3.0f};
+    blob.write(size_t(7));
+    blob.write(values);
+    EXPECT_EQ(blob.size(), 2 * sizeof(size_t) + 3 * sizeof(float));
+
+    size_t seven = 0;
+    std::vector<float> readBack(3);
+    StateReader reader(blob);
+    reader.read(seven);
+    reader.read(readBack);
+    EXPECT_EQ(seven, 7u);
+    EXPECT_EQ(readBack, values);
+    EXPECT_TRUE(reader.fullyRead());
+}
+
+TEST(StateBlobTest, MismatchedLayoutFailsWithoutWriting) {
+    StateBlob blob;
+    blob.write(std::vector<float>(4, 1.0f));
+    std::vector<float> tooShort(3, 0.0f);
+    StateReader shortReader(blob);
+    shortReader.read(tooShort);
+    EXPECT_FALSE(shortReader.ok());
+    EXPECT_EQ(tooShort, std::vector<float>(3, 0.0f));
+
+    // Reading past the end fails as well
+    std::vector<float> exact(4, 0.0f);
+    double extra = 0.0;
+    StateReader exactReader(blob);
+    exactReader.read(exact);
+    EXPECT_TRUE(exactReader.fullyRead());
+    exactReader.read(extra);
+    EXPECT_FALSE(exactReader.ok());
+
+    // A processor prepared with another channel count rejects the snapshot
+    BiquadFilter<float> stereo(2, sampleRate), mono(1, sampleRate);
+    stereo.saveState(blob.clear());
+    StateReader monoReader(blob);
+    mono.restoreState(monoReader);
+    EXPECT_FALSE(monoReader.ok());
+}
+
+TEST(StateBlobTest, CoreProcessorsContinueFromSnapshot) {
+    expectSnapshotContinuesExactly<BiquadFilter<float>>(
+        [] {
+            auto f = std::make_unique<BiquadFilter<float>>(numChannels, sampleRate);
+            f->setResponse(BiquadFilter<float>::Response::Lowpass);
+            f->setFrequency(Frequency<float>::Hertz(900.0f));
+            return f;
+        },
+        processInOut);
+    expectSnapshotContinuesExactly<StateVariableFilter<float>>(
+        [] {
+            auto f = std::make_unique<StateVariableFilter<float>>(numChannels, sampleRate);
+            f->setFrequency(Frequency<float>::Hertz(300.0f));
+            return f;
+        },
+        processInOut);
+    expectSnapshotContinuesExactly<Noise<float, NoiseType::Gaussian>>(
+        [] { return std::make_unique<Noise<float, NoiseType::Gaussian>>(numChannels); },
+        [](auto& noise, const AudioBuffer<float>&, AudioBuffer<float>& out) {
+            noise.processBlock(out.writePtrs(), numSamples);
+        });
+}
+
+TEST(StateBlobTest, EffectsContinueFromSnapshot) {
+    expectSnapshotContinuesExactly<effects::Chorus<float>>(
+        [] { return std::make_unique<effects::Chorus<float>>(numChannels, sampleRate); }, processInOut);
+    expectSnapshotContinuesExactly<effects::Flanger<float>>(
+        [] { return std::make_unique<effects::Flanger<float>>(numChannels, sampleRate); }, processInOut);
+    expectSnapshotContinuesExactly<effects::Delay<float>>(
+        [] { return std::make_unique<effects::Delay<float>>(numChannels, numSamples, sampleRate); }, processInOut);
+    expectSnapshotContinuesExactly<effects::Reverb<float>>(
+        [] { return std::make_unique<effects::Reverb<float>>(numChannels, sampleRate); }, processInOut);
+    expectSnapshotContinuesExactly<effects::Equalizer<float>>(
+        [] { return std::make_unique<effects::Equalizer<float>>(numChannels, numSamples, sampleRate); },
+        processInOut);
+    expectSnapshotContinuesExactly<effects::Distortion<float>>(
+        [] {
+            auto d = std::make_unique<effects::Distortion<float>>(numChannels, numSamples, sampleRate);
+            d->setOversamplingEnabled(true);
+            d->setDriveDb(18.0f, true);
+            return d;
+        },
+        processInOut);
+    expectSnapshotContinuesExactly<effects::Compressor<float>>(
+        [] {
+            auto c = std::make_unique<effects::Compressor<float>>(numChannels, sampleRate);
+            c->setThreshold(-24.0f, true);
+            return c;
+        },
+        [](auto& c, const AudioBuffer<float>& in, AudioBuffer<float>& out) {
+            c.processBlock(in.readPtrs(), in.readPtrs(), out.writePtrs(), numSamples);
+        });
+}
+
+TEST(StateBlobTest, PresetSwitchRestoresParameters) {
+    // A/B: snapshot two settings of one processor and switch between them
+    effects::Chorus<float> chorus(numChannels, sampleRate);
+    AudioBuffer<float> input, a(numChannels, numSamples), b(numChannels, numSamples);
+    fillInput(input, 0.0f);
+    StateBlob presetA, presetB;
+
+    chorus.setDepth(0.2f, true);
+    chorus.processBlock(input.readPtrs(), a.writePtrs(), numSamples);
+    chorus.saveState(presetA.clear());
+    chorus.setDepth(0.9f, true);
+    chorus.processBlock(input.readPtrs(), b.writePtrs(), numSamples);
+    chorus.saveState(presetB.clear());
+
+    StateReader readerA(presetA), readerB(presetB), readerAgainA(presetA);
+    chorus.restoreState(readerA);
+    chorus.processBlock(input.readPtrs(), a.writePtrs(), numSamples);
+    chorus.restoreState(readerB);
+    chorus.processBlock(input.readPtrs(), b.writePtrs(), numSamples);
+    chorus.restoreState(readerAgainA);
+    AudioBuffer<float> againA(numChannels, numSamples);
+    chorus.processBlock(input.readPtrs(), againA.writePtrs(), numSamples);
+    expectEqualBuffers(a, againA);
+    EXPECT_TRUE(readerAgainA.fullyRead());
+}
+
+TEST(StateBlobTest, ChainAndMapperSnapshots) {
+    using Chain = ProcessorChain<float, BiquadFilter<float>, effects::Reverb<float>>;
+    expectSnapshotContinuesExactly<Chain>(
+        [] {
+            auto chain = std::make_unique<Chain>();
+            chain->prepare(numChannels, numSamples, sampleRate);
+            return chain;
+        },
+        processInOut);
+
+    // Mid-ramp mapper state, including the rebuilt route list
+    expectSnapshotContinuesExactly<ChannelMapper<float>>(
+        [] {
+            auto mapper = std::make_unique<ChannelMapper<float>>(numChannels, numChannels);
+            mapper->setGain(0, 1, 0.5f, 4 * numSamples);
+            return mapper;
+        },
+        processInOut);
+}
+
+TEST(StateBlobTest, ConcurrentRestoresFromOneSnapshot) {
+    // One warmed-up snapshot restored into several segment renderers at once
+    AudioBuffer<float> warmUp, next, straight(numChannels, numSamples);
+    fillInput(warmUp, 0.0f);
+    fillInput(next, 1.0f);
+    effects::Reverb<float> source(numChannels, sampleRate);
+    for (int block = 0; block < 3; ++block)
+        source.processBlock(warmUp.readPtrs(), straight.writePtrs(), numSamples);
+    StateBlob blob;
+    source.saveState(blob.clear());
+    source.processBlock(next.readPtrs(), straight.writePtrs(), numSamples);
+
+    const StateBlob& snapshot = blob;
+    constexpr size_t numSegments = 4;
+    std::vector<AudioBuffer<float>> segments;
+    for (size_t i = 0; i < numSegments; ++i)
+        segments.emplace_back(numChannels, numSamples);
+    std::vector<int> fullyRead(numSegments, 0);
+    const float* const* nextPtrs = next.readPtrs(); // Refreshes the pointer cache, so not from the renderers
+    std::vector<std::thread> renderers;
+    for (size_t i = 0; i < numSegments; ++i) {
+        renderers.emplace_back([&, i] {
+            effects::Reverb<float> segment(numChannels, sampleRate);
+            StateReader reader(snapshot);
+            segment.restoreState(reader);
+            fullyRead[i] = reader.fullyRead();
+            segment.processBlock(nextPtrs, segments[i].writePtrs(), numSamples);
+        });
+    }
+    for (auto& renderer : renderers)
+        renderer.join();
+
+    for (size_t i = 0; i < numSegments; ++i) {
+        EXPECT_TRUE(fullyRead[i]);
+        expectEqualBuffers(straight, segments[i]);
+    }
+}
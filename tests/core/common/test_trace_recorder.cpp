@@ -0,0 +1,144 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the scope trace recorder
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/common/trace_recorder.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/effects/reverb.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 2;
+constexpr size_t numSamples = 128;
+constexpr float sampleRate = 48000.0f;
+
+size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        ++count;
+    return count;
+}
+
+// Export the recorder into a string, returning the number of events
+size_t exportTrace(std::string& json) {
+    std::ostringstream out;
+    const size_t numEvents = TraceRecorder::instance().writeChromeTrace(out);
+    json = out.str();
+    return numEvents;
+}
+} // namespace
+
+TEST(TraceRecorderTest, RecordsArmedScopesOnly) {
+    auto& recorder = TraceRecorder::instance();
+    recorder.registerThread("test");
+    recorder.clear();
+
+    AudioBuffer<float> input(numChannels, numSamples), output(numChannels, numSamples);
+    effects::Reverb<float> reverb(numChannels, sampleRate);
+    reverb.processBlock(input.readPtrs(), output.writePtrs(), numSamples); // Not armed yet
+
+    recorder.setArmed(true);
+    reverb.processBlock(input.readPtrs(), output.writePtrs(), numSamples);
+    reverb.setDampingCrossoverFreqHz(3000.0f);
+    recorder.setArmed(false);
+    reverb.processBlock(input.readPtrs(), output.writePtrs(), numSamples);
+
+    std::string json;
+    const size_t numEvents = exportTrace(json);
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    if constexpr (traceEnabled) {
+        EXPECT_EQ(countOccurrences(json, "\"ph\":\"X\""), numEvents);
+        EXPECT_EQ(countOccurrences(json, "\"Reverb::processBlock\""), 1u);
+        EXPECT_GE(countOccurrences(json, "\"FeedbackDelayNetwork::processBlock\""), 1u);
+        EXPECT_GE(countOccurrences(json, "\"FeedbackDelayNetwork::updateDampingFilter\""), 1u);
+        EXPECT_NE(json.find("\"cat\":\"process\""), std::string::npos);
+        EXPECT_NE(json.find("\"cat\":\"parameter\""), std::string::npos);
+        EXPECT_NE(json.find("\"args\":{\"name\":\"test\"}"), std::string::npos);
+        EXPECT_EQ(json.find("\"cat\":\"prepare\""), std::string::npos); // Prepared before arming
+    } else {
+        EXPECT_EQ(numEvents, 0u);
+    }
+    recorder.clear();
+}
+
+TEST(TraceRecorderTest, TracesParameterRecomputationPerThread) {
+    auto& recorder = TraceRecorder::instance();
+    recorder.clear();
+    recorder.setArmed(true);
+
+    BiquadFilter<float> filter;
+    std::thread worker([&] {
+        TraceRecorder::instance().registerThread("control");
+        filter.prepare(numChannels, sampleRate, 1);
+        filter.setFrequency(Frequency<float>::Hertz(1000.0f));
+    });
+    worker.join();
+    recorder.setArmed(false);
+
+    std::string json;
+    const size_t numEvents = exportTrace(json);
+    if constexpr (traceEnabled) {
+        EXPECT_GE(numEvents, numChannels);
+        EXPECT_GE(countOccurrences(json, "\"BiquadFilter::applyDesignToTopology\""), numChannels);
+        EXPECT_NE(json.find("\"args\":{\"name\":\"control\"}"), std::string::npos);
+
+        // Clearing drops the events but keeps the thread list
+        recorder.clear();
+        EXPECT_EQ(exportTrace(json), 0u);
+        EXPECT_NE(json.find("\"args\":{\"name\":\"control\"}"), std::string::npos);
+    } else {
+        EXPECT_EQ(numEvents, 0u);
+    }
+}
+
+TEST(TraceRecorderTest, RingKeepsNewestEvents) {
+    static const char* const names[] = {"old", "new"};
+    detail::TraceRing ring("ring");
+    const uint64_t total = detail::TraceRing::CAPACITY + 10;
+    for (uint64_t i = 0; i < total; ++i)
+        ring.push({names[i >= 10 ? 1 : 0], nullptr, i, i + 1, TraceCategory::Process});
+
+    // The oldest slot is the next one the writer reuses, so it is not exported
+    uint64_t count = 0, expectedStart = 11;
+    bool ordered = true;
+    ring.forEach([&](const detail::TraceRing::Event& event) {
+        ordered = ordered && event.start == expectedStart++ && event.name == names[1];
+        ++count;
+    });
+    EXPECT_EQ(count, detail::TraceRing::CAPACITY - 1);
+    EXPECT_TRUE(ordered);
+
+    ring.clear();
+    count = 0;
+    ring.forEach([&](const detail::TraceRing::Event&) { ++count; });
+    EXPECT_EQ(count, 0u);
+}
+
+TEST(TraceRecorderTest, RingNeverExportsTornEvents) {
+    static const char* const names[] = {"even", "odd"};
+    detail::TraceRing ring("ring");
+    std::atomic<bool> running{true};
+    std::thread writer([&] {
+        for (uint64_t i = 0; running.load(std::memory_order_relaxed); ++i)
+            ring.push({names[i % 2], names + i % 2, i, i + 1, TraceCategory::Process});
+    });
+
+    // Every field of an exported event must come from the same push
+    bool consistent = true;
+    for (int pass = 0; pass < 50 && consistent; ++pass) {
+        ring.forEach([&](const detail::TraceRing::Event& event) {
+            consistent = consistent && event.end == event.start + 1 && event.name == names[event.start % 2] &&
+                         event.id == names + event.start % 2;
+        });
+    }
+    running = false;
+    writer.join();
+    EXPECT_TRUE(consistent);
+}
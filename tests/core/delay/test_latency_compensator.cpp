@@ -0,0 +1,74 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the LatencyCompensator class and latency reporting
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/delays/latency_compensator.h>
+#include <jonssonic/core/mixing/dry_wet_mixer.h>
+#include <jonssonic/core/oversampling/oversampler.h>
+#include <jonssonic/effects/distortion.h>
+#include <vector>
+
+using namespace jnsc;
+
+TEST(LatencyCompensatorTest, BlockMatchesPerSampleForAnyBlockSize) {
+    constexpr size_t numSamples = 1000;
+    std::vector<float> input(numSamples);
+    for (size_t n = 0; n < numSamples; ++n)
+        input[n] = float(n + 1);
+
+    for (size_t delay : {0u, 1u, 37u, 64u, 200u}) {
+        LatencyCompensator<float> block(1, 200), reference(1, 200);
+        block.setDelay(delay);
+        reference.setDelay(delay);
+        EXPECT_FLOAT_EQ(block.getLatencySamples(), float(delay));
+
+        // Varying block sizes, including blocks longer than the ring headroom, processed in place
+        std::vector<float> output = input;
+        const size_t blockSizes[] = {1, 7, 64, 300, 13};
+        for (size_t offset = 0, b = 0; offset < numSamples; ++b) {
+            const size_t len = std::min(blockSizes[b % 5], numSamples - offset);
+            block.processChannel(0, output.data() + offset, output.data() + offset, len);
+            offset += len;
+        }
+        for (size_t n = 0; n < numSamples; ++n) {
+            ASSERT_EQ(output[n], reference.processSample(0, input[n])) << "delay " << delay << " n " << n;
+            ASSERT_EQ(output[n], n < delay ? 0.0f : input[n - delay]);
+        }
+    }
+}
+
+TEST(LatencyCompensatorTest, RoundsFractionalLatency) {
+    EXPECT_EQ(LatencyCompensator<float>::latencyToSamples(22.5f), 23u);
+    EXPECT_EQ(LatencyCompensator<float>::latencyToSamples(28.125f), 28u);
+    EXPECT_EQ(LatencyCompensator<float>::latencyToSamples(-1.0f), 0u);
+
+    // Oversampler stages past the first run at higher rates and contribute fractional latency
+    Oversampler<float, 4> oversampler(1, 64);
+    EXPECT_FLOAT_EQ(oversampler.getLatencySamples(), 15.0f + 7.5f);
+}
+
+TEST(LatencyCompensatorTest, DryWetMixerDelaysDrySignal) {
+    constexpr size_t numSamples = 100;
+    constexpr size_t dryDelay = 5;
+    DryWetMixer<float> mixer;
+    mixer.prepare(1, 48000.0f, dryDelay);
+    mixer.setMix(0.0f, true); // Full dry
+
+    std::vector<float> dry(numSamples), wet(numSamples, 1.0f), output(numSamples);
+    for (size_t n = 0; n < numSamples; ++n)
+        dry[n] = float(n);
+    const float* dryPtr[] = {dry.data()};
+    const float* wetPtr[] = {wet.data()};
+    float* outPtr[] = {output.data()};
+    mixer.processBlock(dryPtr, wetPtr, outPtr, numSamples, dryDelay);
+    for (size_t n = 0; n < numSamples; ++n)
+        EXPECT_NEAR(output[n], n < dryDelay ? 0.0f : float(n - dryDelay), 1e-5f);
+}
+
+TEST(LatencyCompensatorTest, DistortionReportsOversamplingLatency) {
+    effects::Distortion<float> distortion(2, 64, 48000.0f);
+    EXPECT_FLOAT_EQ(distortion.getLatencySamples(), 0.0f);
+    distortion.setOversamplingEnabled(true);
+    EXPECT_FLOAT_EQ(distortion.getLatencySamples(), 15.0f + 7.5f + 3.75f + 1.875f);
+}
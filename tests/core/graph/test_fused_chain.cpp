@@ -0,0 +1,85 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the FusedChain expression templates
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <jonssonic/core/graph/fused_chain.h>
+
+using namespace jnsc;
+
+class FusedChainTest : public ::testing::Test {
+  protected:
+    static constexpr size_t numChannels = 2;
+    static constexpr size_t blockSize = 256;
+    static constexpr float sampleRate = 48000.0f;
+
+    AudioBuffer<float> input{numChannels, blockSize};
+
+    void SetUp() override {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < blockSize; ++n)
+                input[ch][n] = 0.8f * std::sin(0.03f * float(n) + float(ch));
+    }
+
+    // Configure a processor set identically for fused and reference processing
+    template <typename Shaper, typename OnePole, typename Biquad, typename Mixer>
+    void configure(Shaper& shaper, OnePole& onePole, Biquad& biquad, Mixer& mixer) {
+        shaper.prepare(numChannels, sampleRate);
+        shaper.setInputGain(Gain<float>::Decibels(12.0f), true);
+        onePole.prepare(numChannels, sampleRate);
+        onePole.setResponse(OnePole::Response::Lowpass);
+        onePole.setFrequency(2000.0_hz);
+        biquad.prepare(numChannels, sampleRate);
+        biquad.setResponse(Biquad::Response::Highpass);
+        biquad.setFrequency(100.0_hz);
+        mixer.prepare(numChannels, sampleRate);
+        mixer.setMix(0.7f, true);
+    }
+};
+
+TEST_F(FusedChainTest, MatchesSeparateBlockPasses) {
+    WaveShaperProcessor<float, WaveShaperType::Tanh> shaperA, shaperB;
+    OnePoleFilter<float> onePoleA, onePoleB;
+    BiquadFilter<float> biquadA, biquadB;
+    DryWetMixer<float> mixerA, mixerB;
+    configure(shaperA, onePoleA, biquadA, mixerA);
+    configure(shaperB, onePoleB, biquadB, mixerB);
+
+    auto fused = shaperA >> onePoleA >> biquadA >> mixerA;
+    static_assert(decltype(fused)::getNumStages() == 4);
+    EXPECT_EQ(fused.getNumChannels(), numChannels);
+
+    AudioBuffer<float> fusedOut(numChannels, blockSize), wet(numChannels, blockSize), refOut(numChannels, blockSize);
+    fused.processBlock(input.readPtrs(), fusedOut.writePtrs(), blockSize);
+
+    shaperB.processBlock(input.readPtrs(), wet.writePtrs(), blockSize);
+    onePoleB.processBlock(wet.readPtrs(), wet.writePtrs(), blockSize);
+    biquadB.processBlock(wet.readPtrs(), wet.writePtrs(), blockSize);
+    mixerB.processBlock(input.readPtrs(), wet.readPtrs(), refOut.writePtrs(), blockSize);
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < blockSize; ++n)
+            EXPECT_NEAR(fusedOut[ch][n], refOut[ch][n], 1e-6f);
+}
+
+TEST_F(FusedChainTest, InPlaceProcessing) {
+    OnePoleFilter<float> onePoleA, onePoleB;
+    BiquadFilter<float> biquadA, biquadB;
+    for (auto* f : {&onePoleA, &onePoleB}) {
+        f->prepare(numChannels, sampleRate);
+        f->setResponse(OnePoleFilter<float>::Response::Lowpass);
+    }
+    for (auto* f : {&biquadA, &biquadB})
+        f->prepare(numChannels, sampleRate);
+
+    AudioBuffer<float> buffer(numChannels, blockSize);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        std::copy(input.readChannelPtr(ch), input.readChannelPtr(ch) + blockSize, buffer.writeChannelPtr(ch));
+    auto fused = onePoleA >> biquadA;
+    fused.processBlock(buffer.readPtrs(), buffer.writePtrs(), blockSize);
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < blockSize; ++n)
+            EXPECT_FLOAT_EQ(buffer[ch][n], biquadB.processSample(ch, onePoleB.processSample(ch, input[ch][n])));
+}
@@ -0,0 +1,242 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the HotSwap class
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/graph/hot_swap.h>
+#include <thread>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t maxChannels = 4;
+constexpr size_t blockSize = 64;
+
+std::atomic<int> liveInstances{0};
+
+/// Multiplies by a gain and records how it was prepared
+struct GainProcessor {
+    size_t numChannels = 0;
+    float sampleRate = 0.0f;
+    float gain = 1.0f;
+    float latency = 0.0f;
+
+    GainProcessor() { liveInstances.fetch_add(1); }
+    ~GainProcessor() { liveInstances.fetch_sub(1); }
+
+    void prepare(size_t newNumChannels, float newSampleRate) {
+        numChannels = newNumChannels;
+        sampleRate = newSampleRate;
+    }
+    void processBlock(const float* const* input, float* const* output, size_t numSamples) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] = gain * input[ch][n];
+    }
+    float getLatencySamples() const { return latency; }
+};
+
+/// Delays its input by a whole number of samples and reports it as latency
+struct DelayProcessor {
+    size_t numChannels = 0;
+    size_t delay = 0;
+    std::vector<std::vector<float>> history;
+
+    void prepare(size_t newNumChannels, float) {
+        numChannels = newNumChannels;
+        history.assign(numChannels, std::vector<float>(delay, 0.0f));
+    }
+    void processBlock(const float* const* input, float* const* output, size_t numSamples) {
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            auto& h = history[ch];
+            for (size_t n = 0; n < numSamples; ++n) {
+                const float x = input[ch][n];
+                if (delay == 0) {
+                    output[ch][n] = x;
+                    continue;
+                }
+                output[ch][n] = h.front();
+                h.erase(h.begin());
+                h.push_back(x);
+            }
+        }
+    }
+    float getLatencySamples() const { return static_cast<float>(delay); }
+};
+
+/// Multiplies by a gain and flags blocks larger than it was prepared for
+struct BlockSizeProcessor {
+    size_t numChannels = 0;
+    size_t maxBlockSize = 0;
+    float gain = 1.0f;
+    bool overrun = false;
+
+    void prepare(size_t newNumChannels, size_t newMaxBlockSize, float) {
+        numChannels = newNumChannels;
+        maxBlockSize = newMaxBlockSize;
+    }
+    void processBlock(const float* const* input, float* const* output, size_t numSamples) {
+        overrun = overrun || numSamples > maxBlockSize;
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] = gain * input[ch][n];
+    }
+};
+
+using Swap = HotSwap<float, GainProcessor>;
+
+// Run blocks until the pending instance has been swapped in and the background thread is done
+void processUntilSwapped(Swap& swap, AudioBuffer<float>& in, AudioBuffer<float>& out) {
+    for (int i = 0; i < 10000 && swap.isSwapPending(); ++i) {
+        swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    ASSERT_FALSE(swap.isSwapPending());
+}
+} // namespace
+
+TEST(HotSwapTest, SwapsInNewLayoutAtBlockBoundary) {
+    AudioBuffer<float> in(maxChannels, blockSize), out(maxChannels, blockSize);
+    for (size_t ch = 0; ch < maxChannels; ++ch)
+        std::fill(in.writeChannelPtr(ch), in.writeChannelPtr(ch) + blockSize, 1.0f);
+    {
+        Swap swap;
+        swap.prepare(2, blockSize, 48000.0f);
+        swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+        EXPECT_EQ(out.readChannelPtr(1)[0], 1.0f);
+
+        ASSERT_TRUE(swap.requestPrepare(4, blockSize, 96000.0f, 0, [](GainProcessor& p) { p.gain = 0.5f; }));
+        EXPECT_FALSE(swap.requestPrepare(4, blockSize, 96000.0f)); // One reconfiguration at a time
+        processUntilSwapped(swap, in, out);
+
+        EXPECT_EQ(swap.getNumChannels(), 4u);
+        EXPECT_EQ(swap.getSampleRate(), 96000.0f);
+        EXPECT_EQ(swap.get()->gain, 0.5f);
+        swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+        EXPECT_EQ(out.readChannelPtr(3)[blockSize - 1], 0.5f);
+
+        // The old instance was reclaimed off the audio thread
+        EXPECT_EQ(liveInstances.load(), 1);
+    }
+    EXPECT_EQ(liveInstances.load(), 0);
+}
+
+TEST(HotSwapTest, CrossfadesWhenLayoutMatches) {
+    constexpr size_t fadeSamples = 4 * blockSize;
+    AudioBuffer<float> in(2, blockSize), out(2, blockSize);
+    for (size_t ch = 0; ch < 2; ++ch)
+        std::fill(in.writeChannelPtr(ch), in.writeChannelPtr(ch) + blockSize, 1.0f);
+
+    Swap swap;
+    swap.prepare(2, blockSize, 48000.0f);
+    ASSERT_TRUE(swap.requestPrepare(2, blockSize, 48000.0f, fadeSamples, [](GainProcessor& p) { p.gain = 0.0f; }));
+
+    // Wait for the build, then the first block that sees the new instance starts the fade
+    std::vector<float> rendered;
+    for (int i = 0; i < 10000 && swap.isSwapPending(); ++i) {
+        swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+        rendered.insert(rendered.end(), out.readChannelPtr(0), out.readChannelPtr(0) + blockSize);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    ASSERT_FALSE(swap.isSwapPending());
+
+    // Gain 1 blocks, then an equal-power fade to silence lasting fadeSamples. The fade starts on a block boundary
+    // and its first sample still has gain 1
+    size_t fadeStart = 0;
+    while (fadeStart < rendered.size() && rendered[fadeStart] == 1.0f)
+        ++fadeStart;
+    fadeStart -= fadeStart % blockSize;
+    ASSERT_GE(rendered.size(), fadeStart + fadeSamples);
+    for (size_t n = fadeStart + 1; n < fadeStart + fadeSamples; ++n)
+        EXPECT_LE(rendered[n], rendered[n - 1] + 1e-6f);
+    EXPECT_NEAR(rendered[fadeStart + fadeSamples / 2], std::sqrt(0.5f), 0.02f);
+    EXPECT_NEAR(rendered[fadeStart + fadeSamples - 1], 0.0f, 1e-6f);
+
+    swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+    EXPECT_EQ(out.readChannelPtr(1)[0], 0.0f);
+}
+
+TEST(HotSwapTest, ChangedSampleRateSwitchesWithoutFade) {
+    AudioBuffer<float> in(2, blockSize), out(2, blockSize);
+    for (size_t ch = 0; ch < 2; ++ch)
+        std::fill(in.writeChannelPtr(ch), in.writeChannelPtr(ch) + blockSize, 1.0f);
+
+    Swap swap;
+    swap.prepare(2, blockSize, 44100.0f);
+    ASSERT_TRUE(swap.requestPrepare(2, blockSize, 48000.0f, 1000, [](GainProcessor& p) { p.gain = 2.0f; }));
+    while (swap.getSampleRate() != 48000.0f)
+        swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+    EXPECT_EQ(out.readChannelPtr(0)[0], 2.0f);
+    processUntilSwapped(swap, in, out);
+}
+
+TEST(HotSwapTest, PrepareWhileRequestIsPendingDoesNotBlock) {
+    {
+        Swap swap;
+        swap.prepare(2, blockSize, 48000.0f);
+        ASSERT_TRUE(swap.requestPrepare(2, blockSize, 48000.0f, 256));
+
+        // Audio is stopped, so the requested instance is never taken
+        swap.prepare(2, blockSize, 44100.0f);
+        EXPECT_FALSE(swap.isSwapPending());
+        EXPECT_EQ(swap.getSampleRate(), 44100.0f);
+        EXPECT_EQ(liveInstances.load(), 1);
+        EXPECT_TRUE(swap.requestPrepare(2, blockSize, 48000.0f));
+    }
+    EXPECT_EQ(liveInstances.load(), 0);
+}
+
+TEST(HotSwapTest, CrossfadeAlignsInstanceWithLessLatency) {
+    // Alternating input: a one-sample misalignment would cancel the two instances in the middle of the fade
+    AudioBuffer<float> in(1, blockSize), out(1, blockSize);
+    for (size_t n = 0; n < blockSize; ++n)
+        in.writeChannelPtr(0)[n] = n % 2 == 0 ? 1.0f : -1.0f;
+
+    HotSwap<float, DelayProcessor> swap;
+    swap.prepare(1, blockSize, 48000.0f, [](DelayProcessor& p) {
+        p.delay = 3;
+        p.prepare(1, 48000.0f);
+    });
+    swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+    ASSERT_TRUE(swap.requestPrepare(1, blockSize, 48000.0f, 4 * blockSize));
+
+    while (swap.isSwapPending()) {
+        swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+        for (size_t n = 0; n < blockSize; ++n)
+            ASSERT_GT(std::abs(out.readChannelPtr(0)[n]), 0.99f);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    EXPECT_EQ(swap.getLatencySamples(), 3.0f);
+}
+
+TEST(HotSwapTest, GrowingBlockSizeSwitchesWithoutFade) {
+    constexpr size_t largeBlock = 2 * blockSize;
+    AudioBuffer<float> in(2, largeBlock), out(2, largeBlock);
+    for (size_t ch = 0; ch < 2; ++ch)
+        std::fill(in.writeChannelPtr(ch), in.writeChannelPtr(ch) + largeBlock, 1.0f);
+
+    HotSwap<float, BlockSizeProcessor> swap;
+    swap.prepare(2, blockSize, 48000.0f);
+    BlockSizeProcessor* old = swap.get();
+    ASSERT_TRUE(swap.requestPrepare(
+        2, largeBlock, 48000.0f, 4 * blockSize, [](BlockSizeProcessor& p) { p.gain = 0.5f; }));
+
+    // The caller switches to larger blocks once the new maximum is current
+    while (swap.getMaxBlockSize() != largeBlock) {
+        ASSERT_FALSE(old->overrun);
+        swap.processBlock(in.readPtrs(), out.writePtrs(), blockSize);
+    }
+    for (int i = 0; i < 10000 && swap.isSwapPending(); ++i) {
+        swap.processBlock(in.readPtrs(), out.writePtrs(), largeBlock);
+        EXPECT_EQ(out.readChannelPtr(0)[0], 0.5f); // No fade: the outgoing instance would need larger blocks
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    ASSERT_FALSE(swap.isSwapPending());
+    EXPECT_FALSE(swap.get()->overrun);
+}
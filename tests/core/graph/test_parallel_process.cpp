@@ -0,0 +1,112 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for channel-sharded parallel processing
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/delays/delay_line.h>
+#include <jonssonic/core/dynamics/envelope_follower.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/core/generators/oscillator.h>
+#include <jonssonic/core/graph/parallel_process.h>
+#include <jonssonic/core/oversampling/detail/oversampler_filters.h>
+
+using namespace jnsc;
+
+class ParallelProcessTest : public ::testing::Test {
+  protected:
+    static constexpr size_t numChannels = 64;
+    static constexpr size_t blockSize = 128;
+    static constexpr float sampleRate = 48000.0f;
+
+    ThreadPool pool{3, false};
+    AudioBuffer<float> input{numChannels, blockSize};
+    AudioBuffer<float> parallelOut{numChannels, blockSize};
+    AudioBuffer<float> serialOut{numChannels, blockSize};
+
+    void SetUp() override {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < blockSize; ++n)
+                input[ch][n] = std::sin(0.01f * float((ch + 1) * n));
+    }
+
+    void expectEqualOutputs() {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < blockSize; ++n)
+                ASSERT_FLOAT_EQ(parallelOut[ch][n], serialOut[ch][n]) << "ch " << ch << " n " << n;
+    }
+};
+
+TEST_F(ParallelProcessTest, ShardsCoverAllChannelsOnce) {
+    std::vector<std::atomic<int>> hits(numChannels);
+    std::atomic<size_t> numShards{0};
+    parallelForChannels(pool, numChannels, channelShardGranularity<float>(), [&](size_t begin, size_t end) {
+        EXPECT_EQ(begin % channelShardGranularity<float>(), 0u);
+        numShards.fetch_add(1);
+        for (size_t ch = begin; ch < end; ++ch)
+            hits[ch].fetch_add(1);
+    });
+    EXPECT_EQ(numShards.load(), 4u);
+    for (auto& h : hits)
+        EXPECT_EQ(h.load(), 1);
+}
+
+TEST_F(ParallelProcessTest, StateStorageIsCacheAligned) {
+    AudioBuffer<float> buffer(3, 5);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % detail::STORAGE_ALIGNMENT, 0u);
+}
+
+TEST_F(ParallelProcessTest, BiquadFilterMatchesSerial) {
+    BiquadFilter<float> parallelFilter(numChannels, sampleRate, 2), serialFilter(numChannels, sampleRate, 2);
+    for (auto* f : {&parallelFilter, &serialFilter}) {
+        f->setResponse(BiquadFilter<float>::Response::Lowpass);
+        f->setFrequency(1000.0_hz);
+    }
+    for (int block = 0; block < 3; ++block) {
+        parallelProcessBlock(pool, parallelFilter, input.readPtrs(), parallelOut.writePtrs(), blockSize);
+        serialFilter.processBlock(input.readPtrs(), serialOut.writePtrs(), blockSize);
+        expectEqualOutputs();
+    }
+}
+
+TEST_F(ParallelProcessTest, DelayLineAndEnvelopeMatchSerial) {
+    LinearDelayLine<float> parallelDelay, serialDelay;
+    for (auto* d : {&parallelDelay, &serialDelay}) {
+        d->prepare(numChannels, sampleRate, 10.0_ms);
+        d->setDelay(Time<float>::Samples(17.5f), true);
+    }
+    parallelProcessBlock(pool, parallelDelay, input.readPtrs(), parallelOut.writePtrs(), blockSize, 1);
+    serialDelay.processBlock(input.readPtrs(), serialOut.writePtrs(), blockSize);
+    expectEqualOutputs();
+
+    EnvelopeFollower<float, EnvelopeType::Peak> parallelEnv(numChannels, sampleRate), serialEnv(numChannels, sampleRate);
+    parallelProcessBlock(pool, parallelEnv, input.readPtrs(), parallelOut.writePtrs(), blockSize);
+    serialEnv.processBlock(input.readPtrs(), serialOut.writePtrs(), blockSize);
+    expectEqualOutputs();
+}
+
+TEST_F(ParallelProcessTest, OscillatorMatchesSerial) {
+    Oscillator<float> parallelOsc(numChannels, sampleRate), serialOsc(numChannels, sampleRate);
+    for (auto* o : {&parallelOsc, &serialOsc})
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            o->setFrequency(ch, Frequency<float>::Hertz(100.0f + 10.0f * float(ch)), true);
+
+    parallelProcessBlock(pool, parallelOsc, parallelOut.writePtrs(), blockSize);
+    serialOsc.processBlock(serialOut.writePtrs(), blockSize);
+    expectEqualOutputs();
+}
+
+TEST_F(ParallelProcessTest, HalfbandStageChannelRanges) {
+    detail::FIRHalfbandStage<float> parallelStage, serialStage;
+    parallelStage.prepare(numChannels);
+    serialStage.prepare(numChannels);
+    AudioBuffer<float> parallelUp(numChannels, 2 * blockSize), serialUp(numChannels, 2 * blockSize);
+
+    parallelForChannels(pool, numChannels, channelShardGranularity<float>(), [&](size_t begin, size_t end) {
+        parallelStage.upsample(input.readPtrs(), parallelUp.writePtrs(), blockSize, begin, end);
+    });
+    serialStage.upsample(input.readPtrs(), serialUp.writePtrs(), blockSize);
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < 2 * blockSize; ++n)
+            ASSERT_FLOAT_EQ(parallelUp[ch][n], serialUp[ch][n]);
+}
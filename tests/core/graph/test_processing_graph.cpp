@@ -0,0 +1,131 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the ProcessingGraph class
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/graph/processing_graph.h>
+
+using namespace jnsc;
+
+namespace {
+// Adds a constant to its input
+struct OffsetStage {
+    float offset = 0.0f;
+    size_t numChannels = 0;
+    void prepare(size_t newNumChannels, float) { numChannels = newNumChannels; }
+    void reset() {}
+    void processBlock(const float* const* in, float* const* out, size_t n) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t i = 0; i < n; ++i)
+                out[ch][i] = in[ch][i] + offset;
+    }
+};
+
+// Busy-waits for a fixed time per block
+struct SlowStage : OffsetStage {
+    void processBlock(const float* const* in, float* const* out, size_t n) {
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        OffsetStage::processBlock(in, out, n);
+    }
+};
+
+// Pure delay reporting its latency
+struct LatentStage {
+    LatencyCompensator<float> delay;
+    void prepare(size_t newNumChannels, size_t, float) { delay.prepare(newNumChannels, 3); }
+    void reset() { delay.reset(); }
+    float getLatencySamples() const { return 2.6f; }
+    void processBlock(const float* const* in, float* const* out, size_t n) { delay.processBlock(in, out, n); }
+};
+} // namespace
+
+class ProcessingGraphTest : public ::testing::Test {
+  protected:
+    static constexpr size_t numChannels = 2;
+    static constexpr size_t blockSize = 64;
+    static constexpr float sampleRate = 48000.0f;
+
+    // in -> a -> b -> out, and a -> bus (send 0.5) -> out
+    OffsetStage a, b, bus;
+    ProcessingGraph<float> graph;
+
+    void SetUp() override {
+        auto na = graph.addNode(a);
+        auto nb = graph.addNode(b);
+        auto nbus = graph.addNode(bus);
+        graph.connect(na, nb);
+        graph.connect(na, nbus, 0.5f);
+        graph.prepare(numChannels, blockSize, sampleRate);
+        a.offset = 1.0f;
+        b.offset = 2.0f;
+        bus.offset = 10.0f;
+    }
+
+    void expectOutput() {
+        AudioBuffer<float> input, output(numChannels, blockSize);
+        input.resize(numChannels, blockSize, 1.0f);
+        graph.processBlock(input.readPtrs(), output.writePtrs(), blockSize);
+        // a = 2, b = 4, bus = 0.5 * 2 + 10 = 11
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < blockSize; ++n)
+                EXPECT_FLOAT_EQ(output[ch][n], 15.0f);
+    }
+};
+
+TEST_F(ProcessingGraphTest, SerialExecution) { expectOutput(); }
+
+TEST_F(ProcessingGraphTest, ParallelExecution) {
+    ThreadPool pool(3, false);
+    graph.setThreadPool(&pool);
+    for (int i = 0; i < 100; ++i)
+        expectOutput();
+    EXPECT_EQ(graph.getNumDeadlineMisses(), 0u);
+    graph.setThreadPool(nullptr);
+}
+
+TEST(ProcessingGraphDeadlineTest, SkipsNodesAfterDeadline) {
+    SlowStage first, second;
+    ProcessingGraph<float> graph;
+    auto firstNode = graph.addNode(first);
+    auto secondNode = graph.addNode(second);
+    graph.connect(firstNode, secondNode);
+    graph.prepare(1, 16, 48000.0f);
+    graph.setDeadline(Time<float>::Milliseconds(1.0f));
+    first.offset = 1.0f;
+    second.offset = 1.0f;
+
+    AudioBuffer<float> input(1, 16), output;
+    output.resize(1, 16, 5.0f);
+    graph.processBlock(input.readPtrs(), output.writePtrs(), 16);
+    EXPECT_EQ(graph.getNumDeadlineMisses(), 1u);
+    EXPECT_FLOAT_EQ(output[0][0], 0.0f);
+    EXPECT_GT(graph.getNodeCost(firstNode), 0.0);
+    EXPECT_EQ(graph.getNodeCost(secondNode), 0.0);
+}
+
+TEST(ProcessingGraphLatencyTest, AlignsParallelBranches) {
+    // in -> latent -> sum, in -> dry -> sum, and the dry path is also a sink next to the latent sum
+    LatentStage latent;
+    OffsetStage dry, sum, dryOut;
+    ProcessingGraph<float> graph;
+    auto nLatent = graph.addNode(latent);
+    auto nDry = graph.addNode(dry);
+    auto nSum = graph.addNode(sum);
+    auto nDryOut = graph.addNode(dryOut);
+    graph.connect(nLatent, nSum);
+    graph.connect(nDry, nSum);
+    graph.connect(nDry, nDryOut);
+    graph.prepare(1, 8, 48000.0f);
+    EXPECT_FLOAT_EQ(graph.getLatencySamples(), 2.6f);
+
+    std::vector<float> input(8, 0.0f), output(8);
+    input[0] = 1.0f;
+    const float* in[] = {input.data()};
+    float* out[] = {output.data()};
+    graph.processBlock(in, out, 8);
+    // Both branches of the sum and the dry sink arrive together after three samples
+    for (size_t n = 0; n < 8; ++n)
+        EXPECT_FLOAT_EQ(output[n], n == 3 ? 3.0f : 0.0f) << n;
+}
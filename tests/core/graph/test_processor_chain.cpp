@@ -0,0 +1,139 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the ProcessorChain class
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/core/graph/processor_chain.h>
+#include <jonssonic/effects/distortion.h>
+
+using namespace jnsc;
+
+namespace {
+// Minimal in-place processor scaling its input
+struct GainStage {
+    float gain = 2.0f;
+    size_t numChannels = 0;
+    void prepare(size_t newNumChannels, float) { numChannels = newNumChannels; }
+    void reset() {}
+    void processBlock(const float* const* in, float* const* out, size_t n) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t i = 0; i < n; ++i)
+                out[ch][i] = in[ch][i] * gain;
+    }
+};
+
+// Time-reversing processor which produces wrong results when input and output alias
+struct ReverseStage {
+    size_t numChannels = 0;
+    void prepare(size_t newNumChannels, size_t, float) { numChannels = newNumChannels; }
+    void reset() {}
+    size_t getLatencySamples() const { return 3; }
+    void processBlock(const float* const* in, float* const* out, size_t n) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t i = 0; i < n; ++i)
+                out[ch][i] = in[ch][n - 1 - i];
+    }
+};
+} // namespace
+
+template <>
+struct jnsc::SupportsInPlace<ReverseStage> : std::false_type {};
+
+TEST(ProcessorChainTest, InPlaceChainNeedsNoScratch) {
+    using Chain = ProcessorChain<float, GainStage, GainStage, GainStage, GainStage, GainStage>;
+    static_assert(Chain::NUM_SCRATCH_BUFFERS == 0);
+
+    Chain chain(2, 64, 48000.0f);
+    EXPECT_EQ(chain.getScratchMemoryBytes(), 0u);
+    EXPECT_GT(chain.getUnsharedMemoryBytes(), 0u);
+    EXPECT_EQ(chain.getLatencySamples(), 0u);
+
+    std::vector<float> data(2 * 64, 1.0f);
+    float* ptrs[2] = {data.data(), data.data() + 64};
+    chain.processBlock(ptrs, ptrs, 64);
+    for (float v : data)
+        EXPECT_FLOAT_EQ(v, 32.0f);
+}
+
+TEST(ProcessorChainTest, OutOfPlaceStagesShareOneScratchBuffer) {
+    using Chain = ProcessorChain<float, GainStage, ReverseStage, ReverseStage, GainStage, ReverseStage>;
+    static_assert(Chain::NUM_SCRATCH_BUFFERS == 1);
+    static_assert(Chain::BUFFER_PLAN[4] == 0);
+
+    Chain chain(1, 8, 48000.0f);
+    EXPECT_EQ(chain.getScratchMemoryBytes(), 8 * sizeof(float));
+    EXPECT_EQ(chain.getLatencySamples(), 9u);
+
+    std::vector<float> in(8), out(8);
+    for (size_t i = 0; i < 8; ++i)
+        in[i] = float(i);
+    const float* inPtr[1] = {in.data()};
+    float* outPtr[1] = {out.data()};
+    chain.processBlock(inPtr, outPtr, 8);
+
+    // Three reversals leave the block reversed, two gain stages scale by four
+    for (size_t i = 0; i < 8; ++i)
+        EXPECT_FLOAT_EQ(out[i], 4.0f * float(7 - i));
+}
+
+TEST(ProcessorChainTest, MatchesManualChaining) {
+    constexpr size_t numChannels = 2;
+    constexpr size_t blockSize = 128;
+    constexpr float fs = 48000.0f;
+
+    ProcessorChain<float, BiquadFilter<float>, effects::Distortion<float>, BiquadFilter<float>> chain(
+        numChannels, blockSize, fs);
+    chain.get<0>().setResponse(BiquadFilter<float>::Response::Highpass);
+    chain.get<0>().setFrequency(100.0_hz);
+    chain.get<2>().setResponse(BiquadFilter<float>::Response::Lowpass);
+    chain.get<2>().setFrequency(5000.0_hz);
+
+    BiquadFilter<float> hp(numChannels, fs), lp(numChannels, fs);
+    effects::Distortion<float> dist(numChannels, blockSize, fs);
+    hp.setResponse(BiquadFilter<float>::Response::Highpass);
+    hp.setFrequency(100.0_hz);
+    lp.setResponse(BiquadFilter<float>::Response::Lowpass);
+    lp.setFrequency(5000.0_hz);
+
+    EXPECT_EQ(chain.getLatencySamples(), dist.getLatencySamples());
+
+    AudioBuffer<float> input(numChannels, blockSize), chained(numChannels, blockSize), manual(numChannels, blockSize);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t n = 0; n < blockSize; ++n)
+            input[ch][n] = std::sin(0.05f * float(n + ch));
+
+    for (int block = 0; block < 4; ++block) {
+        chain.processBlock(input.readPtrs(), chained.writePtrs(), blockSize);
+        hp.processBlock(input.readPtrs(), manual.writePtrs(), blockSize);
+        dist.processBlock(manual.readPtrs(), manual.writePtrs(), blockSize);
+        lp.processBlock(manual.readPtrs(), manual.writePtrs(), blockSize);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < blockSize; ++n)
+                EXPECT_FLOAT_EQ(chained[ch][n], manual[ch][n]);
+    }
+}
+
+TEST(ProcessorChainTest, StageProbesCaptureIntermediateOutputs) {
+    ProcessorChain<float, GainStage, GainStage> chain(1, 64, 48000.0f);
+    chain.get<1>().gain = 3.0f;
+    ProbeSettings<float> settings;
+    settings.frameSize = 32;
+    chain.getProbe(0).arm(settings);
+    chain.getProbe(1).arm(settings);
+
+    AudioBuffer<float> input(1, 64), output(1, 64);
+    for (size_t n = 0; n < 64; ++n)
+        input[0][n] = float(n);
+    chain.processBlock(input.readPtrs(), output.writePtrs(), 64);
+
+    ProbeFrame<float> first, second;
+    ASSERT_TRUE(chain.getProbe(0).readLatest(first));
+    ASSERT_TRUE(chain.getProbe(1).readLatest(second));
+    EXPECT_EQ(first.startSample, 32u);
+    for (size_t n = 0; n < 32; ++n) {
+        EXPECT_FLOAT_EQ(first.samples[0][n], 2.0f * float(32 + n));
+        EXPECT_FLOAT_EQ(second.samples[0][n], 6.0f * float(32 + n));
+    }
+}
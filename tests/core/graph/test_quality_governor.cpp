@@ -0,0 +1,140 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the QualityGovernor class
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/common/audio_buffer.h>
+#include <jonssonic/core/delays/latency_compensator.h>
+#include <jonssonic/core/graph/quality_governor.h>
+#include <jonssonic/effects/reverb.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numChannels = 2;
+constexpr size_t blockSize = 64;
+constexpr float sampleRate = 48000.0f;
+
+/// Gain with a fixed latency, standing in for a tier of an oversampled processor
+template <size_t Latency>
+struct GainTier {
+    float gain = 1.0f;
+    LatencyCompensator<float> delay;
+
+    void prepare(size_t newNumChannels, float) { delay.prepare(newNumChannels, Latency); }
+    void reset() { delay.reset(); }
+    void processBlock(const float* const* input, float* const* output, size_t numSamples) {
+        delay.processBlock(input, output, numSamples);
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t n = 0; n < numSamples; ++n)
+                output[ch][n] *= gain;
+    }
+    float getLatencySamples() const { return static_cast<float>(Latency); }
+};
+
+// Process a constant signal and collect channel 0 of the output
+template <typename Governor>
+std::vector<float> render(Governor& governor, size_t numBlocks, float value = 1.0f) {
+    AudioBuffer<float> buffer(numChannels, blockSize);
+    std::vector<float> rendered;
+    for (size_t block = 0; block < numBlocks; ++block) {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            std::fill(buffer.writeChannelPtr(ch), buffer.writeChannelPtr(ch) + blockSize, value);
+        governor.processBlock(buffer.readPtrs(), buffer.writePtrs(), blockSize);
+        rendered.insert(rendered.end(), buffer.readChannelPtr(0), buffer.readChannelPtr(0) + blockSize);
+    }
+    return rendered;
+}
+
+// Position of the first output sample after an impulse at the start of a block
+template <typename Governor>
+size_t measureDelay(Governor& governor) {
+    AudioBuffer<float> buffer(numChannels, blockSize);
+    buffer.clear();
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        buffer.writeChannelPtr(ch)[0] = 1.0f;
+    governor.processBlock(buffer.readPtrs(), buffer.writePtrs(), blockSize);
+    const float* out = buffer.readChannelPtr(0);
+    return static_cast<size_t>(std::find(out, out + blockSize, 1.0f) - out);
+}
+
+size_t blocksFor(float ms) { return static_cast<size_t>(std::ceil(ms * sampleRate / 1000.0f / blockSize)); }
+} // namespace
+
+TEST(QualityGovernorTest, StepsDownUnderLoadAndBackUpWithHysteresis) {
+    QualityGovernor<float, effects::Reverb<float, 16>, effects::Reverb<float, 8>, effects::Reverb<float, 4>> governor(
+        numChannels, blockSize, sampleRate);
+    governor.setLoadThresholds(200.0f, 100.0f); // Far above what the reverbs cost, so only reported load counts
+    EXPECT_EQ(governor.getTier(), 0u);
+
+    // Sustained overload steps down one tier at a time; after the crossfade (20 ms) the load of the new tier
+    // settles (500 ms) before the next hold time (50 ms) starts
+    governor.reportLoad(300.0f);
+    render(governor, blocksFor(50.0f) + 1);
+    EXPECT_EQ(governor.getTier(), 1u);
+    render(governor, blocksFor(20.0f + 500.0f + 50.0f) + 2);
+    EXPECT_EQ(governor.getTier(), 2u);
+    render(governor, blocksFor(600.0f));
+    EXPECT_EQ(governor.getTier(), 2u); // Cheapest tier
+
+    // Between the thresholds nothing changes
+    governor.reportLoad(150.0f);
+    render(governor, blocksFor(3000.0f));
+    EXPECT_EQ(governor.getTier(), 2u);
+
+    // Headroom steps back up only after the longer hold time
+    governor.reportLoad(0.0f);
+    render(governor, blocksFor(1000.0f));
+    EXPECT_EQ(governor.getTier(), 2u);
+    render(governor, blocksFor(1000.0f) + 1);
+    EXPECT_EQ(governor.getTier(), 1u);
+
+    // Without automatic governing only manual requests switch
+    governor.setAutomatic(false);
+    governor.reportLoad(300.0f);
+    render(governor, blocksFor(1000.0f));
+    EXPECT_EQ(governor.getTier(), 1u);
+    governor.setTier(0);
+    render(governor, 1);
+    EXPECT_EQ(governor.getTier(), 0u);
+}
+
+TEST(QualityGovernorTest, AlignsTierLatencies) {
+    QualityGovernor<float, GainTier<12>, GainTier<0>> governor(numChannels, blockSize, sampleRate);
+    governor.setAutomatic(false);
+    EXPECT_EQ(governor.getLatencySamples(), 12.0f);
+
+    render(governor, 1, 0.0f);
+    EXPECT_EQ(measureDelay(governor), 12u);
+
+    // The cheaper tier is delayed to the same latency
+    governor.setTier(1);
+    render(governor, blocksFor(20.0f) + 1, 0.0f);
+    EXPECT_FALSE(governor.isSwitching());
+    EXPECT_EQ(measureDelay(governor), 12u);
+}
+
+TEST(QualityGovernorTest, CrossfadesTierSwitches) {
+    QualityGovernor<float, GainTier<0>, GainTier<0>> governor(numChannels, blockSize, sampleRate);
+    governor.setAutomatic(false);
+    governor.setCrossfadeTimeMs(10.0f);
+    governor.get<1>().gain = 0.5f;
+
+    render(governor, 4);
+    governor.setTier(1);
+    const std::vector<float> rendered = render(governor, blocksFor(10.0f) + 2);
+    EXPECT_TRUE(governor.getTier() == 1u && !governor.isSwitching());
+
+    // Equal-power fade from gain 1 to gain 0.5 without steps
+    EXPECT_NEAR(rendered.front(), 1.0f, 1e-3f);
+    EXPECT_FLOAT_EQ(rendered.back(), 0.5f);
+    for (size_t n = 1; n < rendered.size(); ++n)
+        EXPECT_LT(std::abs(rendered[n] - rendered[n - 1]), 0.01f) << n;
+
+    // Parameters can be applied to all tiers at once
+    governor.forEachTier([](auto& tier) { tier.gain = 0.25f; });
+    EXPECT_FLOAT_EQ(render(governor, 1).back(), 0.25f);
+}
@@ -0,0 +1,94 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the ThreadPool class
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <jonssonic/core/graph/thread_pool.h>
+#include <thread>
+
+using namespace jnsc;
+
+namespace {
+struct CountContext {
+    std::vector<std::atomic<int>> hits;
+    explicit CountContext(size_t n) : hits(n) {}
+};
+
+void countTask(void* context, size_t task, size_t) {
+    static_cast<CountContext*>(context)->hits[task].fetch_add(1);
+}
+
+// Binary tree of tasks: task i spawns 2i+1 and 2i+2
+struct TreeContext {
+    ThreadPool* pool;
+    size_t numTasks;
+    std::atomic<size_t> executed{0};
+};
+
+void treeTask(void* context, size_t task, size_t worker) {
+    auto* ctx = static_cast<TreeContext*>(context);
+    ctx->executed.fetch_add(1);
+    for (size_t child = 2 * task + 1; child <= 2 * task + 2; ++child)
+        if (child < ctx->numTasks)
+            ctx->pool->spawn(worker, child);
+}
+} // namespace
+
+TEST(ThreadPoolTest, ParallelForRunsEveryTaskOnce) {
+    ThreadPool pool(3, false);
+    pool.reserve(1000);
+    EXPECT_EQ(pool.getNumThreads(), 4u);
+
+    CountContext ctx(1000);
+    for (int rep = 0; rep < 50; ++rep)
+        pool.parallelFor(ctx.hits.size(), &countTask, &ctx);
+
+    for (auto& h : ctx.hits)
+        EXPECT_EQ(h.load(), 50);
+}
+
+TEST(ThreadPoolTest, SpawnedTasksComplete) {
+    ThreadPool pool(2, false);
+    pool.reserve(256);
+    TreeContext ctx{&pool, 255};
+    size_t root = 0;
+    for (int rep = 0; rep < 20; ++rep)
+        pool.run(&treeTask, &ctx, &root, 1, ctx.numTasks);
+    EXPECT_EQ(ctx.executed.load(), 20u * 255u);
+}
+
+TEST(ThreadPoolTest, WorksWithoutWorkers) {
+    ThreadPool pool;
+    CountContext ctx(300);
+    pool.parallelFor(ctx.hits.size(), &countTask, &ctx);
+    for (auto& h : ctx.hits)
+        EXPECT_EQ(h.load(), 1);
+}
+
+TEST(ThreadPoolTest, SleepingWorkersWakeForEachDispatch) {
+    // Pauses longer than the spin phase put the workers to sleep on their semaphores between dispatches
+    ThreadPool pool(3, false);
+    pool.reserve(64);
+    CountContext ctx(64);
+    for (int rep = 0; rep < 10; ++rep) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pool.parallelFor(ctx.hits.size(), &countTask, &ctx);
+    }
+    for (auto& h : ctx.hits)
+        EXPECT_EQ(h.load(), 10);
+
+    // Stopping wakes sleeping workers as well
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pool.stop();
+    EXPECT_EQ(pool.getNumWorkers(), 0u);
+}
+
+TEST(ThreadPoolTest, QueueOverflowRunsInline) {
+    ThreadPool pool(1, false);
+    pool.reserve(4);
+    CountContext ctx(100);
+    pool.parallelFor(ctx.hits.size(), &countTask, &ctx);
+    for (auto& h : ctx.hits)
+        EXPECT_EQ(h.load(), 1);
+}
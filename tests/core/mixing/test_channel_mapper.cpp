@@ -0,0 +1,125 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the ChannelMapper class and mapChannels
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <jonssonic/core/mixing/channel_mapper.h>
+#include <jonssonic/utils/buffer_utils.h>
+#include <vector>
+
+using namespace jnsc;
+
+namespace {
+constexpr size_t numSamples = 300;
+
+// Channel ch holds the constant value ch + 1
+std::vector<std::vector<float>> constantChannels(size_t numChannels) {
+    std::vector<std::vector<float>> data(numChannels, std::vector<float>(numSamples));
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        std::fill(data[ch].begin(), data[ch].end(), float(ch + 1));
+    return data;
+}
+
+struct Buffers {
+    std::vector<std::vector<float>> input, output;
+    std::vector<const float*> in;
+    std::vector<float*> out;
+
+    Buffers(size_t numInputs, size_t numOutputs)
+        : input(constantChannels(numInputs)), output(numOutputs, std::vector<float>(numSamples, -1.0f)) {
+        for (auto& ch : input)
+            in.push_back(ch.data());
+        for (auto& ch : output)
+            out.push_back(ch.data());
+    }
+};
+} // namespace
+
+TEST(ChannelMapperTest, DefaultsToIdentityAndZerosUnmappedOutputs) {
+    ChannelMapper<float> mapper(2, 3);
+    Buffers buffers(2, 3);
+    mapper.processBlock(buffers.in.data(), buffers.out.data(), numSamples);
+    EXPECT_EQ(buffers.output[0], buffers.input[0]);
+    EXPECT_EQ(buffers.output[1], buffers.input[1]);
+    EXPECT_EQ(buffers.output[2], std::vector<float>(numSamples, 0.0f));
+    EXPECT_EQ(mapper.getNumActiveRoutes(), 2u);
+}
+
+TEST(ChannelMapperTest, SparseRoutesSkipZeroEntries) {
+    ChannelMapper<float> mapper(4, 2);
+    const ChannelMapper<float>::Route routes[] = {{3, 0, 1.0f}, {0, 1, 0.5f}, {2, 1, -1.0f}};
+    mapper.setRoutes(routes, 3);
+    EXPECT_EQ(mapper.getNumActiveRoutes(), 3u);
+
+    Buffers buffers(4, 2);
+    mapper.processBlock(buffers.in.data(), buffers.out.data(), numSamples);
+    for (size_t n = 0; n < numSamples; ++n) {
+        ASSERT_EQ(buffers.output[0][n], 4.0f);
+        ASSERT_EQ(buffers.output[1][n], 0.5f * 1.0f - 3.0f);
+    }
+}
+
+TEST(ChannelMapperTest, StandardDownmixes) {
+    const float g = utils::inv_sqrt2<float>;
+
+    // 5.1 -> stereo: L + g C + g Ls, LFE dropped
+    ChannelMapper<float> toStereo(6, 2);
+    toStereo.setDownmix(ChannelLayout::Surround51, ChannelLayout::Stereo);
+    EXPECT_FLOAT_EQ(toStereo.getGain(0, 0), 1.0f);
+    EXPECT_FLOAT_EQ(toStereo.getGain(0, 2), g);
+    EXPECT_FLOAT_EQ(toStereo.getGain(1, 2), g);
+    EXPECT_FLOAT_EQ(toStereo.getGain(0, 3), 0.0f);
+    EXPECT_FLOAT_EQ(toStereo.getGain(1, 5), g);
+    EXPECT_FLOAT_EQ(toStereo.getGain(0, 1), 0.0f);
+
+    // 7.1.4 -> 5.1 chains the height and back fold-downs
+    ChannelMapper<float> to51(12, 6);
+    to51.setDownmix(ChannelLayout::Surround714, ChannelLayout::Surround51);
+    EXPECT_FLOAT_EQ(to51.getGain(0, 8), g);  // Ltf -> L
+    EXPECT_FLOAT_EQ(to51.getGain(4, 6), g);  // Lb -> Ls
+    EXPECT_FLOAT_EQ(to51.getGain(4, 10), g); // Ltb -> Ls
+    EXPECT_FLOAT_EQ(to51.getGain(3, 3), 1.0f);
+
+    // 7.1.4 -> stereo equals the product of the single steps
+    ChannelMapper<float> direct(12, 2);
+    direct.setDownmix(ChannelLayout::Surround714, ChannelLayout::Stereo);
+    EXPECT_FLOAT_EQ(direct.getGain(0, 10), g * g); // Ltb -> Ls -> L
+    Buffers buffers(12, 2), staged(12, 6);
+    direct.processBlock(buffers.in.data(), buffers.out.data(), numSamples);
+    to51.processBlock(staged.in.data(), staged.out.data(), numSamples);
+    std::vector<const float*> mid(staged.out.begin(), staged.out.end());
+    std::vector<float> l(numSamples), r(numSamples);
+    float* stereoOut[] = {l.data(), r.data()};
+    toStereo.processBlock(mid.data(), stereoOut, numSamples);
+    for (size_t n = 0; n < numSamples; ++n) {
+        ASSERT_NEAR(buffers.output[0][n], l[n], 1e-5f);
+        ASSERT_NEAR(buffers.output[1][n], r[n], 1e-5f);
+    }
+}
+
+TEST(ChannelMapperTest, RampsMatrixChangesAcrossBlocks) {
+    constexpr size_t rampSamples = 400;
+    ChannelMapper<float> mapper(1, 1);
+    mapper.setGain(0, 0, 0.0f);
+    mapper.setGain(0, 0, 1.0f, rampSamples);
+    EXPECT_TRUE(mapper.isRamping());
+
+    Buffers buffers(1, 1); // Input is constant 1, so the output is the gain curve
+    for (size_t block = 0; block < 2; ++block) {
+        mapper.processBlock(buffers.in.data(), buffers.out.data(), numSamples);
+        for (size_t n = 0; n < numSamples; ++n) {
+            const size_t pos = block * numSamples + n;
+            const float expected = pos < rampSamples ? float(pos) / float(rampSamples) : 1.0f;
+            ASSERT_NEAR(buffers.output[0][n], expected, 1e-5f) << pos;
+        }
+    }
+    EXPECT_FALSE(mapper.isRamping());
+    EXPECT_EQ(mapper.getNumActiveRoutes(), 1u);
+}
+
+TEST(ChannelMapperTest, MapChannelsAveragesGroups) {
+    Buffers buffers(4, 2);
+    utils::mapChannels<float>(buffers.in.data(), buffers.out.data(), 4, 2, numSamples);
+    EXPECT_FLOAT_EQ(buffers.output[0][0], 1.5f);
+    EXPECT_FLOAT_EQ(buffers.output[1][numSamples - 1], 3.5f);
+}
@@ -0,0 +1,122 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Unit tests for the block equal-power gains of DryWetMixer, Crossfader and crossfadeBuffers
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <jonssonic/core/mixing/crossfader.h>
+#include <jonssonic/core/mixing/dry_wet_mixer.h>
+#include <jonssonic/utils/buffer_utils.h>
+#include <vector>
+
+using namespace jnsc;
+
+TEST(EqualPowerMixingTest, GainCurvesMatchTrigonometry) {
+    constexpr size_t numSamples = 1000;
+    std::vector<float> gainA(numSamples), gainB(numSamples);
+    const float step = 1.0f / float(numSamples - 1);
+    utils::equalPowerRamp(0.0f, step, gainA.data(), gainB.data(), numSamples);
+    for (size_t n = 0; n < numSamples; ++n) {
+        const double angle = double(n) / double(numSamples - 1) * utils::pi_over_2<double>;
+        ASSERT_NEAR(gainA[n], std::cos(angle), 2e-6) << n;
+        ASSERT_NEAR(gainB[n], std::sin(angle), 2e-6) << n;
+    }
+
+    const auto& table = detail::EqualPowerTable<float>::get();
+    EXPECT_EQ(table.sine(0.0f), 0.0f);
+    EXPECT_EQ(table.sine(1.0f), 1.0f);
+    for (int i = 0; i <= 997; ++i) {
+        const float p = float(i) / 997.0f;
+        ASSERT_NEAR(table.sine(p), std::sin(double(p) * utils::pi_over_2<double>), 2e-6) << p;
+    }
+}
+
+TEST(EqualPowerMixingTest, DryWetMixerSmoothsAndSettles) {
+    constexpr size_t numSamples = 600;
+    DryWetMixer<float> mixer, reference;
+    mixer.prepare(2, 48000.0f);
+    reference.prepare(2, 48000.0f);
+    mixer.setMix(0.25f, true);
+    reference.setMix(0.25f, true);
+    mixer.setMix(0.75f);
+    reference.setMix(0.75f);
+
+    std::vector<float> dry(numSamples, 1.0f), wet(numSamples, -0.5f), output(numSamples), second(numSamples);
+    const float* dryPtrs[] = {dry.data(), dry.data()};
+    const float* wetPtrs[] = {wet.data(), wet.data()};
+    float* outPtrs[] = {output.data(), second.data()};
+    mixer.processBlock(dryPtrs, wetPtrs, outPtrs, numSamples);
+
+    // Block processing matches the per-sample path, channel by channel
+    for (size_t n = 0; n < numSamples; ++n)
+        ASSERT_NEAR(output[n], reference.processSample(0, dry[n], wet[n]), 1e-6f) << n;
+    EXPECT_EQ(output, second);
+
+    // Once settled, the gains are the equal-power gains of the target
+    mixer.setMix(1.0f, true);
+    mixer.processBlock(dryPtrs, wetPtrs, outPtrs, numSamples);
+    for (size_t n = 0; n < numSamples; ++n)
+        ASSERT_EQ(output[n], -0.5f);
+}
+
+TEST(EqualPowerMixingTest, DryWetMixerReturnsToConstantGainsAfterSmoothing) {
+    constexpr size_t numSamples = 512;
+    constexpr float sampleRate = 48000.0f;
+    DryWetMixer<float> mixer;
+    mixer.prepare(1, sampleRate);
+    mixer.setMix(0.25f, true);
+    mixer.setMix(0.75f);
+
+    std::vector<float> dry(numSamples, 1.0f), wet(numSamples, -0.5f), output(numSamples);
+    const float* dryPtr = dry.data();
+    const float* wetPtr = wet.data();
+    float* outPtr = output.data();
+    mixer.processBlock(&dryPtr, &wetPtr, &outPtr, numSamples);
+    EXPECT_FALSE(mixer.isMixSettled(0));
+
+    // The one-pole smoother never reaches its target by itself; one second is far past the smoothing time
+    for (size_t n = 0; n < static_cast<size_t>(sampleRate); n += numSamples)
+        mixer.processBlock(&dryPtr, &wetPtr, &outPtr, numSamples);
+    ASSERT_TRUE(mixer.isMixSettled(0));
+
+    // Constant gains of the exact target across the whole block
+    const auto& table = detail::EqualPowerTable<float>::get();
+    const float expected = table.sine(0.25f) * 1.0f + table.sine(0.75f) * -0.5f;
+    mixer.processBlock(&dryPtr, &wetPtr, &outPtr, numSamples);
+    for (size_t n = 0; n < numSamples; ++n)
+        ASSERT_NEAR(output[n], expected, 1e-6f) << n;
+}
+
+TEST(EqualPowerMixingTest, CrossfaderFadesAcrossBlocks) {
+    constexpr size_t fadeSamples = 300;
+    constexpr size_t blockSize = 128;
+    Crossfader<float> crossfader;
+    crossfader.prepare(1);
+    crossfader.startCrossfade(fadeSamples);
+
+    std::vector<float> one(blockSize, 1.0f), zero(blockSize, 0.0f), output(blockSize);
+    const float* in1[] = {one.data()};
+    const float* in2[] = {zero.data()};
+    float* out[] = {output.data()};
+    for (size_t block = 0; block < 4; ++block) {
+        crossfader.processBlock(in1, in2, out, blockSize);
+        for (size_t n = 0; n < blockSize; ++n) {
+            const size_t pos = std::min(block * blockSize + n, fadeSamples - 1);
+            const double expected = std::cos(double(pos) / double(fadeSamples - 1) * utils::pi_over_2<double>);
+            ASSERT_NEAR(output[n], expected, 2e-6) << block << " " << n;
+        }
+    }
+}
+
+TEST(EqualPowerMixingTest, CrossfadeBuffersSharesGainsAcrossChannels) {
+    constexpr size_t numSamples = 700;
+    std::vector<float> a(numSamples, 1.0f), b(numSamples, 2.0f), out0(numSamples), out1(numSamples);
+    const float* aPtrs[] = {a.data(), a.data()};
+    const float* bPtrs[] = {b.data(), b.data()};
+    float* outPtrs[] = {out0.data(), out1.data()};
+    utils::crossfadeBuffers(aPtrs, bPtrs, outPtrs, 2, numSamples);
+    EXPECT_EQ(out0, out1);
+    EXPECT_NEAR(out0.front(), 1.0f, 1e-5f);
+    EXPECT_NEAR(out0.back(), 2.0f, 1e-5f);
+    EXPECT_NEAR(out0[numSamples / 2], std::sqrt(0.5) * 3.0, 1e-2);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <jonssonic/effects/reverb.h>
+#include <sstream>
+#include <string>
 using namespace jnsc::effects;
 
 class ReverbTest : public ::testing::Test {
@@ -43,3 +45,48 @@ TEST_F(ReverbTest, SettersWork) {
     reverb.setDampingCrossoverFreqHz(800.0f);
     SUCCEED();
 }
+
+TEST_F(ReverbTest, EventsAtOneOffsetRecomputeDampingOnce) {
+    using Param = Reverb<float>::Param;
+    auto id = [](Param p) { return static_cast<uint32_t>(p); };
+    const jnsc::ParamEvent events[] = {{0, id(Param::ReverbTimeLowS), 3.0, true},
+                                       {0, id(Param::ReverbTimeHighS), 0.5, true},
+                                       {0, id(Param::DampingCrossoverFreqHz), 1500.0, true},
+                                       {0, id(Param::Diffusion), 0.3, true}};
+    float input[numChannels][blockSize] = {{1.0f}};
+    float output[numChannels][blockSize] = {};
+    const float* inPtrs[numChannels] = {input[0], input[1]};
+    float* outPtrs[numChannels] = {output[0], output[1]};
+
+    auto& recorder = jnsc::TraceRecorder::instance();
+    recorder.registerThread("test");
+    recorder.clear();
+    recorder.setArmed(true);
+    reverb.processBlock(inPtrs, outPtrs, blockSize, events, 4);
+    recorder.setArmed(false);
+
+    // Same result as setting the parameters one by one
+    Reverb<float> reference(numChannels, sampleRate);
+    reference.setReverbTimeLowS(3.0f, true);
+    reference.setReverbTimeHighS(0.5f, true);
+    reference.setDampingCrossoverFreqHz(1500.0f);
+    reference.setDiffusion(0.3f, true);
+    float expected[numChannels][blockSize] = {};
+    float* refPtrs[numChannels] = {expected[0], expected[1]};
+    reference.processBlock(inPtrs, refPtrs, blockSize);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        for (size_t i = 0; i < blockSize; ++i)
+            EXPECT_FLOAT_EQ(output[ch][i], expected[ch][i]);
+
+    if constexpr (jnsc::traceEnabled) {
+        std::ostringstream json;
+        recorder.writeChromeTrace(json);
+        const std::string text = json.str();
+        const std::string scope = "\"FeedbackDelayNetwork::updateDampingFilter\"";
+        size_t count = 0;
+        for (size_t pos = text.find(scope); pos != std::string::npos; pos = text.find(scope, pos + 1))
+            ++count;
+        EXPECT_EQ(count, 1u);
+    }
+    recorder.clear();
+}
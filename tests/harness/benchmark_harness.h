@@ -0,0 +1,133 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Benchmark harness reporting time and hardware counters per sample
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include "perf_counters.h"
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace jnsc::testing {
+
+/// Signal and block configuration of a benchmark run
+struct BenchmarkConfig {
+    size_t numChannels = 2;
+    size_t blockSize = 256;
+    size_t numBlocks = 200;
+    size_t warmupBlocks = 10;   // Processed before measuring (caches, branch predictors, smoothers)
+    bool collectCounters = true; // Read hardware counters when the system provides them
+    uint32_t seed = 0x5eed;
+};
+
+/**
+ * @brief Result of one benchmark.
+ * @details Time and counters are divided by the number of processed samples over all channels, so processors
+ *          benchmarked at different channel counts and block sizes compare directly. Instructions per cycle and the
+ *          miss rates tell whether a processor is compute-bound (high IPC), memory-bound (cache misses, low IPC)
+ *          or branch-bound (branch misses).
+ */
+struct BenchmarkReport {
+    std::string processorName;
+    size_t numChannels = 0;
+    size_t numSamples = 0; // Measured samples per channel
+    double seconds = 0.0;
+    PerfCounterValues counters;    // Totals over the measured blocks
+    std::string countersUnavailable; // Reason the counters are missing (empty if collected)
+
+    /// Processed samples over all channels
+    double totalSamples() const { return static_cast<double>(numChannels * numSamples); }
+
+    /// Wall time per sample in nanoseconds
+    double nsPerSample() const { return totalSamples() > 0.0 ? seconds * 1.0e9 / totalSamples() : 0.0; }
+
+    /// True if the counter was read
+    bool hasCounter(PerfCounter counter) const { return counters.isValid(counter); }
+
+    /// Counter value per sample (0 if the counter is unavailable)
+    double perSample(PerfCounter counter) const {
+        return hasCounter(counter) && totalSamples() > 0.0 ? counters.get(counter) / totalSamples() : 0.0;
+    }
+
+    /// Instructions per cycle (0 if either counter is unavailable)
+    double instructionsPerCycle() const {
+        if (!hasCounter(PerfCounter::Cycles) || !hasCounter(PerfCounter::Instructions))
+            return 0.0;
+        const double cycles = counters.get(PerfCounter::Cycles);
+        return cycles > 0.0 ? counters.get(PerfCounter::Instructions) / cycles : 0.0;
+    }
+
+    /// Human-readable summary (one line)
+    std::string describe() const {
+        std::ostringstream os;
+        os.precision(4);
+        os << processorName << " (" << numChannels << " ch): " << nsPerSample() << " ns/sample";
+        for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+            const auto counter = static_cast<PerfCounter>(i);
+            if (hasCounter(counter))
+                os << ", " << perSample(counter) << " " << getPerfCounterName(counter) << "/sample";
+        }
+        if (instructionsPerCycle() > 0.0)
+            os << ", IPC " << instructionsPerCycle();
+        if (!countersUnavailable.empty())
+            os << " (counters unavailable: " << countersUnavailable << ")";
+        return os.str();
+    }
+};
+
+/**
+ * @brief Benchmark the block processing of a prepared processor.
+ * @details Feeds white noise block by block; the warm-up blocks are processed before the timer and the counters
+ *          start. Only `processBlock` is inside the measured region.
+ * @tparam T Sample type
+ * @tparam P Processor with `processBlock(const T* const*, T* const*, size_t)`, prepared for at least
+ *         config.numChannels channels and config.blockSize samples
+ * @param processorName Name used in the report
+ * @param processor Processor to benchmark
+ * @param config Block configuration
+ */
+template <typename T, typename P>
+BenchmarkReport runBenchmark(std::string processorName, P& processor, const BenchmarkConfig& config = {}) {
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<std::vector<T>> input(config.numChannels, std::vector<T>(config.blockSize));
+    std::vector<std::vector<T>> output(config.numChannels, std::vector<T>(config.blockSize));
+    std::vector<const T*> inPtrs(config.numChannels);
+    std::vector<T*> outPtrs(config.numChannels);
+    for (size_t ch = 0; ch < config.numChannels; ++ch) {
+        for (auto& x : input[ch])
+            x = static_cast<T>(uniform(rng));
+        inPtrs[ch] = input[ch].data();
+        outPtrs[ch] = output[ch].data();
+    }
+
+    for (size_t block = 0; block < config.warmupBlocks; ++block)
+        processor.processBlock(inPtrs.data(), outPtrs.data(), config.blockSize);
+
+    BenchmarkReport report;
+    report.processorName = std::move(processorName);
+    report.numChannels = config.numChannels;
+    report.numSamples = config.numBlocks * config.blockSize;
+
+    PerfCounters counters;
+    const bool useCounters = config.collectCounters && counters.isAvailable();
+    if (!config.collectCounters)
+        report.countersUnavailable = "disabled";
+    else if (!useCounters)
+        report.countersUnavailable = counters.getUnavailableReason();
+
+    if (useCounters)
+        counters.start();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t block = 0; block < config.numBlocks; ++block)
+        processor.processBlock(inPtrs.data(), outPtrs.data(), config.blockSize);
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (useCounters)
+        report.counters = counters.stop();
+    return report;
+}
+
+} // namespace jnsc::testing
@@ -0,0 +1,313 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Differential test harness comparing reference scalar paths against optimized paths
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <jonssonic/core/common/simd_dispatch.h>
+#include <jonssonic/utils/math_utils.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jnsc::testing {
+
+/// Error statistics of one optimized path against the reference
+struct ErrorStats {
+    double maxAbsError = 0.0;     // Largest absolute sample difference
+    double maxUlpError = 0.0;     // Largest difference in units in the last place
+    double snrDb = std::numeric_limits<double>::infinity(); // Reference energy over error energy (inf if identical)
+    double maxImpulseError = 0.0; // Largest absolute difference of the impulse responses
+};
+
+/**
+ * @brief Allowed deviation of an optimized path from the reference.
+ * @note The defaults demand bit-exact output.
+ */
+struct ToleranceBudget {
+    double maxAbsError = 0.0;
+    double maxUlpError = 0.0;
+    double minSnrDb = std::numeric_limits<double>::infinity();
+    double maxImpulseError = 0.0;
+
+    /// Budget for paths that only reorder or approximate arithmetic
+    static ToleranceBudget approximate(double absError, double snrDb) {
+        return {absError, std::numeric_limits<double>::infinity(), snrDb, absError};
+    }
+};
+
+/// Signal and block configuration of a differential run
+struct DifferentialConfig {
+    size_t numChannels = 3;
+    size_t numSamples = 4096;
+    size_t blockSize = 128;
+    size_t impulseLength = 1024;
+    double sampleRate = 48000.0;
+    uint32_t seed = 0x5eed;
+};
+
+/// Result of one optimized path
+struct PathReport {
+    std::string name;
+    ErrorStats stats;
+    bool passed = true;
+};
+
+/// Results of all optimized paths of one processor
+struct DifferentialReport {
+    std::string processorName;
+    std::vector<PathReport> paths;
+
+    bool passed() const {
+        return std::all_of(paths.begin(), paths.end(), [](const PathReport& p) { return p.passed; });
+    }
+
+    /// Human-readable summary (one line per path)
+    std::string describe() const {
+        std::ostringstream os;
+        for (const auto& p : paths)
+            os << processorName << " [" << p.name << "] " << (p.passed ? "ok" : "FAILED")
+               << ": maxAbs=" << p.stats.maxAbsError << " maxUlp=" << p.stats.maxUlpError
+               << " snr=" << p.stats.snrDb << "dB impulse=" << p.stats.maxImpulseError << "\n";
+        return os.str();
+    }
+};
+
+// =============================================================================
+// Error measures
+// =============================================================================
+/// Distance between two floating-point values in units in the last place
+template <typename T>
+double ulpDistance(T a, T b) {
+    static_assert(std::is_floating_point<T>::value, "T must be floating-point");
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    if (a == b)
+        return 0.0;
+    if (std::isnan(a) || std::isnan(b))
+        return std::numeric_limits<double>::infinity();
+    // Map the sign-magnitude bit patterns onto a monotonic unsigned line (exact integer difference)
+    auto ordered = [](T x) {
+        constexpr Bits signBit = Bits(1) << (8 * sizeof(T) - 1);
+        Bits bits;
+        std::memcpy(&bits, &x, sizeof(T));
+        return (bits & signBit) ? signBit - (bits & ~signBit) : signBit + bits;
+    };
+    const Bits ua = ordered(a), ub = ordered(b);
+    return static_cast<double>(ua > ub ? ua - ub : ub - ua);
+}
+
+/// Accumulate the error of @p test against @p reference into @p stats
+template <typename T>
+void accumulateError(const std::vector<std::vector<T>>& reference,
+                     const std::vector<std::vector<T>>& test,
+                     ErrorStats& stats,
+                     double& signalEnergy,
+                     double& errorEnergy) {
+    for (size_t ch = 0; ch < reference.size(); ++ch)
+        for (size_t n = 0; n < reference[ch].size(); ++n) {
+            const double r = reference[ch][n];
+            const double e = static_cast<double>(test[ch][n]) - r;
+            stats.maxAbsError = std::max(stats.maxAbsError, std::abs(e));
+            stats.maxUlpError = std::max(stats.maxUlpError, ulpDistance(reference[ch][n], test[ch][n]));
+            signalEnergy += r * r;
+            errorEnergy += e * e;
+        }
+}
+
+// =============================================================================
+// Paths
+// =============================================================================
+/**
+ * @brief A way of rendering a signal. Each call starts from a freshly prepared processor.
+ * @param input Input channels
+ * @param output Output channels (same size as input)
+ */
+template <typename T>
+using RenderFunction =
+    std::function<void(const std::vector<std::vector<T>>& input, std::vector<std::vector<T>>& output)>;
+
+/// Detects `processSample(size_t, T)`
+template <typename P, typename T, typename = void>
+struct HasProcessSample : std::false_type {};
+template <typename P, typename T>
+struct HasProcessSample<P, T, std::void_t<decltype(std::declval<P&>().processSample(size_t(0), T(0)))>>
+    : std::true_type {};
+
+/// Forces an instruction set while in scope
+class ScopedSimdIsa {
+  public:
+    explicit ScopedSimdIsa(SimdIsa isa) { setForcedSimdIsa(isa); }
+    ~ScopedSimdIsa() { clearForcedSimdIsa(); }
+};
+
+/**
+ * @brief Differential harness comparing a reference path against optimized paths of the same processing.
+ * @details Every path renders the same randomized signals (white noise, a log sweep with noise bursts) and a
+ *          unit impulse per channel. Errors are measured against the reference and checked against a
+ *          @ref ToleranceBudget.
+ *
+ *          @ref forProcessor builds the paths of a processor type automatically: the reference runs the scalar
+ *          per-sample path (`processSample`, or `processBlock` when there is none) with the baseline kernels,
+ *          and one optimized path runs `processBlock` for every instruction set the CPU supports. New block
+ *          paths and new dispatched kernels are therefore covered without touching the tests.
+ * @tparam T Sample type
+ */
+template <typename T>
+class DifferentialHarness {
+  public:
+    DifferentialHarness(std::string newName, ToleranceBudget newBudget, DifferentialConfig newConfig = {})
+        : name(std::move(newName)), budget(newBudget), config(newConfig) {}
+
+    /// Set the reference path
+    void setReference(RenderFunction<T> render) { reference = std::move(render); }
+
+    /// Add an optimized path
+    void addPath(std::string pathName, RenderFunction<T> render) {
+        paths.emplace_back(std::move(pathName), std::move(render));
+    }
+
+    /**
+     * @brief Build a harness for a processor type.
+     * @tparam P Processor with `processBlock(const T* const*, T* const*, size_t)`
+     * @param processorName Name used in reports
+     * @param factory Creates a prepared, configured processor: `std::unique_ptr<P>(size_t numChannels, double fs)`
+     * @param automation Optional parameter automation applied before every block:
+     *        `void(P&, size_t blockIndex, std::mt19937& rng)`. Every path sees the same random sequence.
+     * @param budget Tolerance budget of the optimized paths
+     * @param config Signal and block configuration
+     */
+    template <typename P, typename Factory, typename Automation = std::nullptr_t>
+    static DifferentialHarness forProcessor(std::string processorName,
+                                            Factory factory,
+                                            ToleranceBudget budget,
+                                            Automation automation = nullptr,
+                                            DifferentialConfig config = {}) {
+        DifferentialHarness harness(std::move(processorName), budget, config);
+        harness.setReference(makeProcessorPath<P>(factory, automation, config, SimdIsa::Baseline, true));
+        for (int i = 0; i <= static_cast<int>(getDetectedSimdIsa()); ++i) {
+            const SimdIsa isa = static_cast<SimdIsa>(i);
+            harness.addPath(std::string("processBlock/") + getSimdIsaName(isa),
+                            makeProcessorPath<P>(factory, automation, config, isa, false));
+        }
+        return harness;
+    }
+
+    /// Render all signals on every path and compare against the reference
+    DifferentialReport run() const {
+        DifferentialReport report{name, {}};
+        const auto signals = makeSignals();
+        const auto impulse = makeImpulse();
+
+        std::vector<std::vector<std::vector<T>>> referenceOutputs;
+        for (const auto& signal : signals)
+            referenceOutputs.push_back(render(reference, signal));
+        const auto referenceImpulse = render(reference, impulse);
+
+        for (const auto& [pathName, path] : paths) {
+            PathReport pathReport{pathName, {}, true};
+            double signalEnergy = 0.0, errorEnergy = 0.0;
+            for (size_t i = 0; i < signals.size(); ++i)
+                accumulateError(referenceOutputs[i], render(path, signals[i]), pathReport.stats, signalEnergy,
+                                errorEnergy);
+            pathReport.stats.snrDb = errorEnergy > 0.0 ? 10.0 * std::log10(signalEnergy / errorEnergy)
+                                                       : std::numeric_limits<double>::infinity();
+
+            ErrorStats impulseStats;
+            double unused0 = 0.0, unused1 = 0.0;
+            accumulateError(referenceImpulse, render(path, impulse), impulseStats, unused0, unused1);
+            pathReport.stats.maxImpulseError = impulseStats.maxAbsError;
+
+            const auto& s = pathReport.stats;
+            pathReport.passed = s.maxAbsError <= budget.maxAbsError && s.maxUlpError <= budget.maxUlpError &&
+                                s.snrDb >= budget.minSnrDb && s.maxImpulseError <= budget.maxImpulseError;
+            report.paths.push_back(pathReport);
+        }
+        return report;
+    }
+
+  private:
+    using Signal = std::vector<std::vector<T>>;
+
+    std::string name;
+    ToleranceBudget budget;
+    DifferentialConfig config;
+    RenderFunction<T> reference;
+    std::vector<std::pair<std::string, RenderFunction<T>>> paths;
+
+    static Signal render(const RenderFunction<T>& path, const Signal& input) {
+        Signal output(input.size(), std::vector<T>(input.empty() ? 0 : input[0].size(), T(0)));
+        path(input, output);
+        return output;
+    }
+
+    std::vector<Signal> makeSignals() const {
+        std::mt19937 rng(config.seed);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        Signal noise(config.numChannels, std::vector<T>(config.numSamples));
+        Signal sweep(config.numChannels, std::vector<T>(config.numSamples));
+        const double f0 = 20.0, f1 = 0.45 * config.sampleRate;
+        const double duration = config.numSamples / config.sampleRate;
+        const double k = std::log(f1 / f0);
+        for (size_t ch = 0; ch < config.numChannels; ++ch)
+            for (size_t n = 0; n < config.numSamples; ++n) {
+                noise[ch][n] = static_cast<T>(uniform(rng));
+                // Log sweep with a noise burst in every eighth of the signal
+                const double t = n / config.sampleRate;
+                const double phase = utils::two_pi<double> * f0 * duration / k * (std::exp(t / duration * k) - 1.0);
+                const bool burst = (n * 8 / config.numSamples) % 2 == 1 && (n % 512) < 64;
+                sweep[ch][n] = static_cast<T>(0.8 * std::sin(phase + ch) + (burst ? 0.5 * uniform(rng) : 0.0));
+            }
+        return {noise, sweep};
+    }
+
+    Signal makeImpulse() const {
+        Signal impulse(config.numChannels, std::vector<T>(config.impulseLength, T(0)));
+        for (auto& ch : impulse)
+            ch[0] = T(1);
+        return impulse;
+    }
+
+    template <typename P, typename Factory, typename Automation>
+    static RenderFunction<T> makeProcessorPath(
+        Factory factory, Automation automation, DifferentialConfig config, SimdIsa isa, bool perSample) {
+        return [=](const Signal& input, Signal& output) {
+            ScopedSimdIsa forceIsa(isa);
+            std::unique_ptr<P> processor = factory(input.size(), config.sampleRate);
+            std::mt19937 rng(config.seed + 1);
+            std::vector<const T*> inPtrs(input.size());
+            std::vector<T*> outPtrs(output.size());
+            const size_t numSamples = input.empty() ? 0 : input[0].size();
+
+            for (size_t offset = 0, block = 0; offset < numSamples; offset += config.blockSize, ++block) {
+                const size_t len = std::min(config.blockSize, numSamples - offset);
+                if constexpr (!std::is_same<Automation, std::nullptr_t>::value)
+                    automation(*processor, block, rng);
+
+                if constexpr (HasProcessSample<P, T>::value) {
+                    if (perSample) {
+                        for (size_t ch = 0; ch < input.size(); ++ch)
+                            for (size_t n = offset; n < offset + len; ++n)
+                                output[ch][n] = processor->processSample(ch, input[ch][n]);
+                        continue;
+                    }
+                }
+                for (size_t ch = 0; ch < input.size(); ++ch) {
+                    inPtrs[ch] = input[ch].data() + offset;
+                    outPtrs[ch] = output[ch].data() + offset;
+                }
+                processor->processBlock(inPtrs.data(), outPtrs.data(), len);
+            }
+        };
+    }
+};
+
+} // namespace jnsc::testing
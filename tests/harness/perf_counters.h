@@ -0,0 +1,176 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Hardware performance counters (Linux perf_event_open) for benchmarks
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace jnsc::testing {
+
+/// Hardware events counted around a benchmark
+enum class PerfCounter {
+    Cycles,       /**< CPU cycles */
+    Instructions, /**< Retired instructions */
+    L1DMisses,    /**< L1 data cache read misses */
+    LLCMisses,    /**< Last-level cache misses */
+    BranchMisses, /**< Mispredicted branches */
+    Count
+};
+
+inline constexpr size_t NUM_PERF_COUNTERS = static_cast<size_t>(PerfCounter::Count);
+
+/// Short name of a counter for reports
+inline const char* getPerfCounterName(PerfCounter counter) {
+    switch (counter) {
+    case PerfCounter::Cycles:
+        return "cycles";
+    case PerfCounter::Instructions:
+        return "instructions";
+    case PerfCounter::L1DMisses:
+        return "L1D-misses";
+    case PerfCounter::LLCMisses:
+        return "LLC-misses";
+    default:
+        return "branch-misses";
+    }
+}
+
+/// Counter totals of one measurement; a counter the kernel refused is marked invalid
+struct PerfCounterValues {
+    std::array<double, NUM_PERF_COUNTERS> values{};
+    std::array<bool, NUM_PERF_COUNTERS> valid{};
+
+    bool isValid(PerfCounter counter) const { return valid[static_cast<size_t>(counter)]; }
+    double get(PerfCounter counter) const { return values[static_cast<size_t>(counter)]; }
+};
+
+/**
+ * @brief Counts hardware events of the calling thread between @ref start and @ref stop.
+ * @details Every event is opened on its own rather than as a group, so a CPU or hypervisor that lacks one event
+ *          (often the cache events in VMs) still reports the others. When the kernel multiplexes counters, the
+ *          values are scaled by enabled/running time. If perf_event_open is unavailable (non-Linux systems,
+ *          containers without the syscall, perf_event_paranoid too strict, no PMU) nothing is counted,
+ *          @ref isAvailable returns false and @ref getUnavailableReason says why.
+ */
+class PerfCounters {
+  public:
+    PerfCounters() {
+        fds.fill(-1);
+#if defined(__linux__)
+        for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            setEvent(static_cast<PerfCounter>(i), attr);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds[i] < 0 && unavailableReason.empty())
+                unavailableReason = std::string("perf_event_open: ") + std::strerror(errno);
+        }
+#else
+        unavailableReason = "perf_event_open requires Linux";
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+#endif
+    }
+
+    /// No copy nor move semantics
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    PerfCounters(PerfCounters&&) = delete;
+    PerfCounters& operator=(PerfCounters&&) = delete;
+
+    /// True if at least one counter could be opened
+    bool isAvailable() const {
+        for (int fd : fds)
+            if (fd >= 0)
+                return true;
+        return false;
+    }
+
+    /// Why the first counter that failed could not be opened (empty if all opened)
+    const std::string& getUnavailableReason() const { return unavailableReason; }
+
+    /// Reset and start all counters
+    void start() {
+#if defined(__linux__)
+        for (int fd : fds)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+    }
+
+    /// Stop all counters and read the totals since @ref start
+    PerfCounterValues stop() {
+        PerfCounterValues result;
+#if defined(__linux__)
+        for (int fd : fds)
+            if (fd >= 0)
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+            uint64_t data[3] = {}; // value, time enabled, time running
+            if (fds[i] < 0 || read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+                continue;
+            if (data[2] == 0)
+                continue; // Never scheduled on the PMU
+            result.values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / double(data[2]);
+            result.valid[i] = true;
+        }
+#endif
+        return result;
+    }
+
+  private:
+    std::array<int, NUM_PERF_COUNTERS> fds;
+    std::string unavailableReason;
+
+#if defined(__linux__)
+    static void setEvent(PerfCounter counter, perf_event_attr& attr) {
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (counter) {
+        case PerfCounter::Cycles:
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfCounter::Instructions:
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfCounter::L1DMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PerfCounter::LLCMisses:
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        default:
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        }
+    }
+#endif
+};
+
+} // namespace jnsc::testing
@@ -0,0 +1,134 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Benchmarks with hardware counters for memory- and compute-heavy processors
+// SPDX-License-Identifier: MIT
+
+#include "harness/benchmark_harness.h"
+#include <gtest/gtest.h>
+#include <iostream>
+#include <jonssonic/core/delays/delay_line.h>
+#include <jonssonic/core/graph/processing_graph.h>
+#include <jonssonic/core/graph/thread_pool.h>
+#include <jonssonic/effects/distortion.h>
+#include <jonssonic/effects/reverb.h>
+#include <jonssonic/models/saturation/saturation_stage.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace jnsc;
+using namespace jnsc::testing;
+
+namespace {
+constexpr float sampleRate = 48000.0f;
+
+// Check a report whether or not the system provides counters
+void expectConsistent(const BenchmarkReport& report) {
+    std::cout << "[ BENCH    ] " << report.describe() << std::endl;
+    EXPECT_GT(report.nsPerSample(), 0.0);
+    if (report.hasCounter(PerfCounter::Cycles)) {
+        EXPECT_GT(report.perSample(PerfCounter::Cycles), 0.0);
+        EXPECT_TRUE(report.countersUnavailable.empty());
+    }
+    if (report.hasCounter(PerfCounter::Instructions)) {
+        EXPECT_GT(report.perSample(PerfCounter::Instructions), 1.0); // At least a load and a store per sample
+    }
+    if (!report.hasCounter(PerfCounter::Cycles) || !report.hasCounter(PerfCounter::Instructions)) {
+        EXPECT_EQ(report.instructionsPerCycle(), 0.0);
+    }
+}
+} // namespace
+
+TEST(BenchmarkHarnessTest, DegradesGracefullyWithoutCounters) {
+    PerfCounters counters;
+    if (!counters.isAvailable()) {
+        EXPECT_FALSE(counters.getUnavailableReason().empty());
+    }
+    counters.start();
+    const PerfCounterValues values = counters.stop();
+    if (!counters.isAvailable()) {
+        for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i)
+            EXPECT_FALSE(values.valid[i]);
+    }
+
+    // Disabled collection still reports time
+    DelayLine<float> delay;
+    delay.prepare(2, sampleRate, Time<float>::Milliseconds(10.0f));
+    BenchmarkConfig config;
+    config.collectCounters = false;
+    config.numBlocks = 20;
+    const BenchmarkReport report = runBenchmark<float>("DelayLine", delay, config);
+    EXPECT_EQ(report.countersUnavailable, "disabled");
+    EXPECT_FALSE(report.hasCounter(PerfCounter::Cycles));
+    EXPECT_EQ(report.perSample(PerfCounter::Cycles), 0.0);
+    EXPECT_GT(report.nsPerSample(), 0.0);
+}
+
+TEST(BenchmarkHarnessTest, MultichannelDelayLine) {
+    // Long delays across many channels stress the data cache rather than the ALUs
+    for (size_t numChannels : {2u, 32u}) {
+        DelayLine<float> delay;
+        delay.prepare(numChannels, sampleRate, Time<float>::Milliseconds(1000.0f));
+        delay.setDelay(Time<float>::Milliseconds(750.0f), true);
+        BenchmarkConfig config;
+        config.numChannels = numChannels;
+        config.numBlocks = 100;
+        expectConsistent(runBenchmark<float>("DelayLine", delay, config));
+    }
+}
+
+TEST(BenchmarkHarnessTest, DistortionWithAndWithoutOversampling) {
+    BenchmarkConfig config;
+    config.numBlocks = 100;
+    for (bool oversampling : {false, true}) {
+        effects::Distortion<float> distortion(config.numChannels, config.blockSize, sampleRate);
+        distortion.setOversamplingEnabled(oversampling);
+        expectConsistent(
+            runBenchmark<float>(oversampling ? "Distortion/oversampled" : "Distortion", distortion, config));
+    }
+}
+
+TEST(BenchmarkHarnessTest, SaturationStageChannelScaling) {
+    // Channel groups keep the per-channel cost flat as the channel count grows past the cache budget. Reported
+    // rather than asserted: wall-clock ratios are not stable on loaded machines.
+    if (JONSSONIC_MAX_CHANNELS < 512)
+        GTEST_SKIP() << "Needs JONSSONIC_MAX_CHANNELS >= 512";
+    using Saturation = models::SaturationStage<float, WaveShaperType::Tanh, true, true, 4>;
+    BenchmarkConfig config;
+    config.numBlocks = 20;
+    double baseline = 0.0;
+    for (size_t numChannels : {128u, 256u, 512u}) {
+        config.numChannels = numChannels;
+        Saturation stage;
+        stage.prepare(numChannels, config.blockSize, sampleRate);
+        const BenchmarkReport report = runBenchmark<float>("SaturationStage", stage, config);
+        expectConsistent(report);
+        if (baseline == 0.0)
+            baseline = report.nsPerSample();
+        std::cout << "[ BENCH    ] " << numChannels << " channels: " << report.nsPerSample() / baseline
+                  << "x the per-sample cost at 128 channels" << std::endl;
+    }
+}
+
+TEST(BenchmarkHarnessTest, ProcessingGraphParallelSpeedup) {
+    // Independent reverbs, first on the calling thread only, then across all cores. Reported rather than asserted:
+    // wall-clock ratios are not stable on loaded machines.
+    const size_t numCores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<std::unique_ptr<effects::Reverb<float>>> reverbs;
+    ProcessingGraph<float> graph;
+    for (size_t i = 0; i < numCores; ++i) {
+        reverbs.push_back(std::make_unique<effects::Reverb<float>>());
+        graph.addNode(*reverbs.back());
+    }
+    BenchmarkConfig config;
+    config.numBlocks = 40;
+    graph.prepare(config.numChannels, config.blockSize, sampleRate);
+
+    const BenchmarkReport serial = runBenchmark<float>("ProcessingGraph/serial", graph, config);
+    expectConsistent(serial);
+    ThreadPool pool(numCores - 1);
+    graph.setThreadPool(&pool);
+    const BenchmarkReport parallel = runBenchmark<float>("ProcessingGraph/parallel", graph, config);
+    expectConsistent(parallel);
+    std::cout << "[ BENCH    ] " << serial.nsPerSample() / parallel.nsPerSample() << "x speedup with " << numCores
+              << " reverbs on " << numCores << " cores" << std::endl;
+}
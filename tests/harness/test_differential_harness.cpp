@@ -0,0 +1,185 @@
+// JonssonicDSP - A Modular Realtime C++ Audio DSP Library
+// Differential tests of reference scalar paths against optimized paths
+// SPDX-License-Identifier: MIT
+
+#include "harness/differential_harness.h"
+#include <gtest/gtest.h>
+#include <jonssonic/core/dynamics/envelope_follower.h>
+#include <jonssonic/core/filters/biquad_bank.h>
+#include <jonssonic/core/filters/biquad_filter.h>
+#include <jonssonic/core/nonlinear/wave_shaper.h>
+#include <jonssonic/core/nonlinear/wave_shaper_processor.h>
+#include <jonssonic/core/oversampling/detail/oversampler_filters.h>
+
+using namespace jnsc;
+using namespace jnsc::testing;
+
+TEST(DifferentialHarnessTest, UlpDistance) {
+    EXPECT_EQ(ulpDistance(1.0f, 1.0f), 0.0);
+    EXPECT_EQ(ulpDistance(1.0f, std::nextafter(1.0f, 2.0f)), 1.0);
+    EXPECT_EQ(ulpDistance(-0.0f, 0.0f), 0.0);
+    // Crossing zero counts the representable values on both sides
+    const float tiny = std::numeric_limits<float>::denorm_min();
+    EXPECT_EQ(ulpDistance(-tiny, tiny), 2.0);
+    EXPECT_EQ(ulpDistance(1.0, std::nextafter(std::nextafter(1.0, 0.0), 0.0)), 2.0);
+    EXPECT_TRUE(std::isinf(ulpDistance(1.0f, std::numeric_limits<float>::quiet_NaN())));
+}
+
+TEST(DifferentialHarnessTest, ReportsErrorsOfDeviatingPaths) {
+    DifferentialConfig config;
+    config.numChannels = 2;
+    config.numSamples = 1000;
+    DifferentialHarness<float> harness("gain", ToleranceBudget::approximate(1e-3, 60.0), config);
+    auto gain = [](float g) {
+        return [g](const std::vector<std::vector<float>>& in, std::vector<std::vector<float>>& out) {
+            for (size_t ch = 0; ch < in.size(); ++ch)
+                for (size_t n = 0; n < in[ch].size(); ++n)
+                    out[ch][n] = g * in[ch][n];
+        };
+    };
+    harness.setReference(gain(1.0f));
+    harness.addPath("exact", gain(1.0f));
+    harness.addPath("close", gain(1.0001f));
+    harness.addPath("off", gain(1.1f));
+
+    const auto report = harness.run();
+    ASSERT_EQ(report.paths.size(), 3u);
+    EXPECT_TRUE(report.paths[0].passed);
+    EXPECT_EQ(report.paths[0].stats.maxAbsError, 0.0);
+    EXPECT_TRUE(std::isinf(report.paths[0].stats.snrDb));
+
+    // A gain error of 1e-4 is -80 dB relative to the signal
+    EXPECT_TRUE(report.paths[1].passed) << report.describe();
+    EXPECT_NEAR(report.paths[1].stats.snrDb, 80.0, 0.5);
+    EXPECT_NEAR(report.paths[1].stats.maxImpulseError, 1e-4, 1e-6);
+
+    EXPECT_FALSE(report.paths[2].passed);
+    EXPECT_NEAR(report.paths[2].stats.snrDb, 20.0, 0.5);
+    EXPECT_FALSE(report.passed());
+}
+
+// =============================================================================
+// Processors: processSample on the baseline kernels vs processBlock on every instruction set
+// =============================================================================
+TEST(DifferentialHarnessTest, BiquadFilterWithAutomation) {
+    using Filter = BiquadFilter<float>;
+    auto factory = [](size_t numChannels, double fs) {
+        auto filter = std::make_unique<Filter>(numChannels, float(fs), 2);
+        filter->setResponse(Filter::Response::Lowpass);
+        filter->setQ(0.9f);
+        return filter;
+    };
+    auto automation = [](Filter& filter, size_t, std::mt19937& rng) {
+        filter.setFrequency(Frequency<float>::Hertz(std::uniform_real_distribution<float>(100.0f, 12000.0f)(rng)));
+    };
+    const auto report =
+        DifferentialHarness<float>::forProcessor<Filter>("BiquadFilter", factory, ToleranceBudget{}, automation)
+            .run();
+    EXPECT_TRUE(report.passed()) << report.describe();
+}
+
+TEST(DifferentialHarnessTest, BiquadBankMatchesAcrossIsas) {
+    // Coefficients of a gentle resonant lowpass per channel (no processSample: baseline processBlock is the reference)
+    auto factory = [](size_t numChannels, double) {
+        auto bank = std::make_unique<BiquadBank<float>>(numChannels, 64, 3);
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t s = 0; s < 3; ++s)
+                bank->setCoeffs(ch, s, 0.2f + 0.01f * ch, 0.3f, 0.2f - 0.02f * s, -0.5f, 0.1f + 0.01f * ch);
+        return bank;
+    };
+    DifferentialConfig config;
+    config.numChannels = 13;
+    const auto report = DifferentialHarness<float>::forProcessor<BiquadBank<float>>(
+                            "BiquadBank", factory, ToleranceBudget{}, nullptr, config)
+                            .run();
+    EXPECT_EQ(report.paths.size(), static_cast<size_t>(getDetectedSimdIsa()) + 1);
+    EXPECT_TRUE(report.passed()) << report.describe();
+}
+
+TEST(DifferentialHarnessTest, WaveShaperProcessorWithAutomation) {
+    using Shaper = WaveShaperProcessor<float, WaveShaperType::Tanh>;
+    auto factory = [](size_t numChannels, double fs) { return std::make_unique<Shaper>(numChannels, float(fs)); };
+    auto automation = [](Shaper& shaper, size_t, std::mt19937& rng) {
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+        shaper.setInputGain(Gain<float>::Decibels(24.0f * dist(rng)));
+        shaper.setBias(0.2f * dist(rng));
+        shaper.setAsymmetry(0.5f * dist(rng));
+    };
+    const auto report =
+        DifferentialHarness<float>::forProcessor<Shaper>("WaveShaperProcessor<Tanh>", factory, ToleranceBudget{},
+                                                          automation)
+            .run();
+    EXPECT_TRUE(report.passed()) << report.describe();
+}
+
+TEST(DifferentialHarnessTest, EnvelopeFollowerWithAutomation) {
+    using Follower = EnvelopeFollower<float, EnvelopeType::RMS>;
+    auto factory = [](size_t numChannels, double fs) { return std::make_unique<Follower>(numChannels, float(fs)); };
+    auto automation = [](Follower& follower, size_t block, std::mt19937&) {
+        follower.setAttackTime(Time<float>::Milliseconds(block % 2 ? 1.0f : 10.0f));
+        follower.setReleaseTime(Time<float>::Milliseconds(block % 3 ? 50.0f : 200.0f));
+    };
+    const auto report =
+        DifferentialHarness<float>::forProcessor<Follower>("EnvelopeFollower<RMS>", factory, ToleranceBudget{},
+                                                           automation)
+            .run();
+    EXPECT_TRUE(report.passed()) << report.describe();
+}
+
+TEST(DifferentialHarnessTest, WaveShaperKernelsAgainstScalarShaper) {
+    // Custom paths: the stateless shaper's dispatched block kernels against its own per-sample function
+    DifferentialHarness<float> harness("WaveShaper<HardClip>", ToleranceBudget{});
+    harness.setReference([](const auto& in, auto& out) {
+        ScopedSimdIsa baseline(SimdIsa::Baseline);
+        WaveShaper<float, WaveShaperType::HardClip> shaper;
+        for (size_t ch = 0; ch < in.size(); ++ch)
+            for (size_t n = 0; n < in[ch].size(); ++n)
+                out[ch][n] = shaper.processSample(2.0f * in[ch][n]);
+    });
+    for (int i = 0; i <= static_cast<int>(getDetectedSimdIsa()); ++i) {
+        const SimdIsa isa = static_cast<SimdIsa>(i);
+        harness.addPath(getSimdIsaName(isa), [isa](const auto& in, auto& out) {
+            ScopedSimdIsa force(isa);
+            WaveShaper<float, WaveShaperType::HardClip> shaper;
+            std::vector<float*> ptrs;
+            for (size_t ch = 0; ch < in.size(); ++ch) {
+                for (size_t n = 0; n < in[ch].size(); ++n)
+                    out[ch][n] = 2.0f * in[ch][n];
+                ptrs.push_back(out[ch].data());
+            }
+            shaper.processBlock(ptrs.data(), ptrs.data(), ptrs.size(), in[0].size());
+        });
+    }
+    const auto report = harness.run();
+    EXPECT_TRUE(report.passed()) << report.describe();
+}
+
+TEST(DifferentialHarnessTest, HalfbandStageRoundTrip) {
+    // Upsample then downsample; each instruction set build against the baseline build
+    auto roundTrip = [](SimdIsa isa) {
+        return [isa](const std::vector<std::vector<float>>& in, std::vector<std::vector<float>>& out) {
+            ScopedSimdIsa force(isa);
+            detail::FIRHalfbandStage<float> up, down;
+            up.prepare(in.size());
+            down.prepare(in.size());
+            const size_t numSamples = in[0].size();
+            std::vector<std::vector<float>> upsampled(in.size(), std::vector<float>(2 * numSamples));
+            std::vector<const float*> inPtrs, upReadPtrs;
+            std::vector<float*> upPtrs, outPtrs;
+            for (size_t ch = 0; ch < in.size(); ++ch) {
+                inPtrs.push_back(in[ch].data());
+                upPtrs.push_back(upsampled[ch].data());
+                upReadPtrs.push_back(upsampled[ch].data());
+                outPtrs.push_back(out[ch].data());
+            }
+            up.upsample(inPtrs.data(), upPtrs.data(), numSamples);
+            down.downsample(upReadPtrs.data(), outPtrs.data(), numSamples);
+        };
+    };
+    DifferentialHarness<float> harness("FIRHalfbandStage", ToleranceBudget{});
+    harness.setReference(roundTrip(SimdIsa::Baseline));
+    for (int i = 1; i <= static_cast<int>(getDetectedSimdIsa()); ++i)
+        harness.addPath(getSimdIsaName(static_cast<SimdIsa>(i)), roundTrip(static_cast<SimdIsa>(i)));
+    const auto report = harness.run();
+    EXPECT_TRUE(report.passed()) << report.describe();
+}